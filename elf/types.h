@@ -114,6 +114,7 @@ enum E_SH_TYPE {
     SH_TYPE_OPENCL_DEV_DEBUG = 0xff000008,        // Device debug
     SH_TYPE_SPIRV = 0xff000009,                   // SPIRV
     SH_TYPE_NON_COHERENT_DEV_BINARY = 0xff00000a, // Non-coherent Device binary
+    SH_TYPE_OPENCL_KERNEL_INFO = 0xff00000b,      // Pre-decoded kernel info of device binary
 };
 
 // E_SH_FLAG - List of section header flags.
@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "offline_compiler/batch_compiler.h"
+#include "offline_compiler/offline_compiler.h"
+#include "runtime/helpers/file_io.h"
+#include "runtime/os_interface/os_library.h"
+
+#include <CL/cl.h>
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+namespace OCLRT {
+
+////////////////////////////////////////////////////////////////////////////////
+// splitManifestLine
+////////////////////////////////////////////////////////////////////////////////
+std::vector<std::string> splitManifestLine(const std::string &line) {
+    std::vector<std::string> args;
+    std::string arg;
+    bool inQuotes = false;
+    bool hasArg = false;
+
+    for (auto c : line) {
+        if (c == '"') {
+            inQuotes = !inQuotes;
+            hasArg = true;
+        } else if (!inQuotes && (c == ' ' || c == '\t' || c == '\r')) {
+            if (hasArg) {
+                args.push_back(arg);
+                arg.clear();
+                hasArg = false;
+            }
+        } else {
+            arg += c;
+            hasArg = true;
+        }
+    }
+    if (hasArg) {
+        args.push_back(arg);
+    }
+
+    return args;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// getOutputFileBase
+////////////////////////////////////////////////////////////////////////////////
+std::string getOutputFileBase(const std::string &outputDirectory, const std::string &inputFile,
+                              const std::string &deviceName, const std::string &optionsSuffix) {
+    // identifies the files OfflineCompiler::writeOutAllFiles creates for an input, whatever their extension
+    size_t slashPos = inputFile.find_last_of("\\/", inputFile.size()) + 1;
+    size_t extPos = inputFile.find_last_of(".", inputFile.size());
+    if (extPos == std::string::npos || extPos < slashPos) {
+        extPos = inputFile.size();
+    }
+
+    std::string outputFileBase = outputDirectory.empty() ? "" : outputDirectory + "/";
+    outputFileBase.append(inputFile.substr(slashPos, extPos - slashPos) + "_" + deviceName);
+    if (optionsSuffix.empty() == false) {
+        outputFileBase.append("." + optionsSuffix);
+    }
+
+    return outputFileBase;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ctor
+////////////////////////////////////////////////////////////////////////////////
+BatchCompiler::BatchCompiler() = default;
+
+////////////////////////////////////////////////////////////////////////////////
+// dtor
+////////////////////////////////////////////////////////////////////////////////
+BatchCompiler::~BatchCompiler() = default;
+
+////////////////////////////////////////////////////////////////////////////////
+// isBatchCommandLine
+////////////////////////////////////////////////////////////////////////////////
+bool BatchCompiler::isBatchCommandLine(uint32_t numArgs, const char **argv) {
+    for (uint32_t argIndex = 1; argIndex < numArgs; argIndex++) {
+        if (strcmp(argv[argIndex], "-batch") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Create
+////////////////////////////////////////////////////////////////////////////////
+BatchCompiler *BatchCompiler::create(uint32_t numArgs, const char **argv, int &retVal) {
+    auto pBatchCompiler = new BatchCompiler();
+
+    retVal = pBatchCompiler->initialize(numArgs, argv);
+
+    if (retVal != CL_SUCCESS) {
+        delete pBatchCompiler;
+        pBatchCompiler = nullptr;
+    }
+
+    return pBatchCompiler;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Initialize
+////////////////////////////////////////////////////////////////////////////////
+int BatchCompiler::initialize(uint32_t numArgs, const char **argv) {
+    int retVal = parseCommandLine(numArgs, argv);
+    if (retVal != CL_SUCCESS) {
+        return retVal;
+    }
+
+    void *pManifest = nullptr;
+    size_t manifestSize = loadDataFromFile(manifestFile.c_str(), pManifest);
+    if (manifestSize == 0) {
+        deleteDataReadFromFile(pManifest);
+        printf("Error: Cannot read batch manifest %s.\n", manifestFile.c_str());
+        return INVALID_FILE;
+    }
+
+    std::string manifest(static_cast<const char *>(pManifest), manifestSize);
+    deleteDataReadFromFile(pManifest);
+
+    retVal = parseManifest(manifest);
+    if (retVal != CL_SUCCESS) {
+        return retVal;
+    }
+
+    // a device is never compiled for by more than one worker, so more workers than devices would idle
+    if (numThreads == 0) {
+        numThreads = static_cast<uint32_t>(std::min(static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency())), deviceIndices.size()));
+    }
+
+    return CL_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ParseCommandLine
+////////////////////////////////////////////////////////////////////////////////
+int BatchCompiler::parseCommandLine(uint32_t numArgs, const char **argv) {
+    for (uint32_t argIndex = 1; argIndex < numArgs; argIndex++) {
+        if ((strcmp(argv[argIndex], "-batch") == 0) &&
+            (argIndex + 1 < numArgs)) {
+            manifestFile = argv[argIndex + 1];
+            argIndex++;
+        } else if ((strcmp(argv[argIndex], "-threads") == 0) &&
+                   (argIndex + 1 < numArgs)) {
+            numThreads = static_cast<uint32_t>(atoi(argv[argIndex + 1]));
+            if (numThreads == 0) {
+                printf("Error: Invalid number of threads %s.\n", argv[argIndex + 1]);
+                return INVALID_COMMAND_LINE;
+            }
+            argIndex++;
+        } else {
+            // everything else is passed through to every entry of the manifest
+            if (strcmp(argv[argIndex], "-q") == 0) {
+                quiet = true;
+            }
+            commonArgs.push_back(argv[argIndex]);
+        }
+    }
+
+    if (manifestFile.empty()) {
+        printf("Error: Batch manifest name missing.\n");
+        return INVALID_COMMAND_LINE;
+    }
+
+    return CL_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ParseManifest
+////////////////////////////////////////////////////////////////////////////////
+int BatchCompiler::parseManifest(const std::string &manifest) {
+    std::istringstream stream(manifest);
+    std::string line;
+
+    while (std::getline(stream, line)) {
+        auto firstChar = line.find_first_not_of(" \t\r");
+        if (firstChar == std::string::npos || line[firstChar] == '#') {
+            continue;
+        }
+
+        BatchEntry entry;
+        entry.args = splitManifestLine(line);
+
+        // the arguments given in the entry take precedence over the common ones
+        std::vector<std::string> allArgs(commonArgs);
+        allArgs.insert(allArgs.end(), entry.args.begin(), entry.args.end());
+        std::string outputDirectory;
+        std::string options;
+        bool useOptionsSuffix = false;
+        for (size_t argIndex = 0; argIndex < allArgs.size(); argIndex++) {
+            bool hasValue = (argIndex + 1 < allArgs.size());
+            if (allArgs[argIndex] == "-options_name") {
+                useOptionsSuffix = true;
+            } else if (hasValue && (allArgs[argIndex] == "-device")) {
+                entry.deviceName = allArgs[++argIndex];
+            } else if (hasValue && (allArgs[argIndex] == "-file")) {
+                entry.inputFile = allArgs[++argIndex];
+            } else if (hasValue && (allArgs[argIndex] == "-out_dir")) {
+                outputDirectory = allArgs[++argIndex];
+            } else if (hasValue && (allArgs[argIndex] == "-options")) {
+                options = allArgs[++argIndex];
+            }
+        }
+        if (useOptionsSuffix) {
+            std::replace(options.begin(), options.end(), ' ', '_');
+        } else {
+            options.clear();
+        }
+        entry.outputFileBase = getOutputFileBase(outputDirectory, entry.inputFile, entry.deviceName, options);
+
+        // entries are compiled concurrently, so two of them must never write the same files
+        auto sameOutput = std::find_if(entries.begin(), entries.end(),
+                                       [&](const BatchEntry &other) { return other.outputFileBase == entry.outputFileBase; });
+        if (sameOutput != entries.end()) {
+            printf("Error: Batch manifest %s has more than one entry writing %s outputs.\n", manifestFile.c_str(), entry.outputFileBase.c_str());
+            return INVALID_COMMAND_LINE;
+        }
+
+        deviceIndices.insert(std::make_pair(entry.deviceName, deviceIndices.size()));
+        entries.push_back(std::move(entry));
+    }
+
+    if (entries.empty()) {
+        printf("Error: Batch manifest %s has no entries.\n", manifestFile.c_str());
+        return INVALID_FILE;
+    }
+
+    return CL_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// CompileEntries
+////////////////////////////////////////////////////////////////////////////////
+void BatchCompiler::compileEntries(size_t workerIndex, size_t numWorkers) {
+    // devices are split between the workers and each device has a single compiler, so FCL/IGC are
+    // loaded once per device and a device context is only ever used by one thread; builds for
+    // different devices run in parallel, builds for the same device run one after another
+    std::map<std::string, std::unique_ptr<OfflineCompiler>> compilers;
+
+    for (auto &entry : entries) {
+        if (deviceIndices.at(entry.deviceName) % numWorkers != workerIndex) {
+            continue;
+        }
+
+        std::vector<const char *> argv;
+        argv.push_back("cloc");
+        for (auto &arg : commonArgs) {
+            argv.push_back(arg.c_str());
+        }
+        for (auto &arg : entry.args) {
+            argv.push_back(arg.c_str());
+        }
+        auto numArgs = static_cast<uint32_t>(argv.size());
+
+        // messages are kept with the entry and printed in manifest order once all workers are done
+        auto &compiler = compilers[entry.deviceName];
+        if (compiler == nullptr) {
+            compiler.reset(OfflineCompiler::create(numArgs, argv.data(), entry.retVal, &entry.messages));
+        } else {
+            compiler->setMessagesOutput(&entry.messages);
+            entry.retVal = compiler->reinitialize(numArgs, argv.data());
+        }
+
+        if (entry.retVal == CL_SUCCESS) {
+            entry.retVal = compiler->build();
+            entry.buildLog = compiler->getBuildLog();
+        }
+        if (compiler != nullptr) {
+            compiler->setMessagesOutput(nullptr);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Build
+////////////////////////////////////////////////////////////////////////////////
+int BatchCompiler::build() {
+    size_t numWorkers = std::min(static_cast<size_t>(numThreads), deviceIndices.size());
+    std::vector<std::thread> workers;
+
+    for (size_t i = 1; i < numWorkers; i++) {
+        workers.emplace_back(&BatchCompiler::compileEntries, this, i, numWorkers);
+    }
+    compileEntries(0, numWorkers);
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    int retVal = CL_SUCCESS;
+    for (auto &entry : entries) {
+        if (entry.retVal != CL_SUCCESS) {
+            retVal = entry.retVal;
+            break;
+        }
+    }
+
+    return retVal;
+}
+} // namespace OCLRT
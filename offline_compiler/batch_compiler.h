@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace OCLRT {
+
+struct BatchEntry {
+    std::vector<std::string> args;
+    std::string deviceName;
+    std::string inputFile;
+    std::string outputFileBase;
+    std::string buildLog;
+    std::string messages;
+    int retVal = 0;
+};
+
+std::vector<std::string> splitManifestLine(const std::string &line);
+std::string getOutputFileBase(const std::string &outputDirectory, const std::string &inputFile,
+                              const std::string &deviceName, const std::string &optionsSuffix);
+
+class BatchCompiler {
+  public:
+    static bool isBatchCommandLine(uint32_t numArgs, const char **argv);
+    static BatchCompiler *create(uint32_t numArgs, const char **argv, int &retVal);
+    int build();
+
+    BatchCompiler &operator=(const BatchCompiler &) = delete;
+    BatchCompiler(const BatchCompiler &) = delete;
+    ~BatchCompiler();
+
+    const std::vector<BatchEntry> &getEntries() const {
+        return entries;
+    }
+
+    uint32_t getNumThreads() const {
+        return numThreads;
+    }
+
+    bool isQuiet() const {
+        return quiet;
+    }
+
+  protected:
+    BatchCompiler();
+
+    int initialize(uint32_t numArgs, const char **argv);
+    int parseCommandLine(uint32_t numArgs, const char **argv);
+    int parseManifest(const std::string &manifest);
+    void compileEntries(size_t workerIndex, size_t numWorkers);
+
+    std::string manifestFile;
+    std::vector<std::string> commonArgs;
+    std::vector<BatchEntry> entries;
+    // devices in order of their first entry, all entries of a device are compiled by the same worker
+    std::map<std::string, size_t> deviceIndices;
+    uint32_t numThreads = 0;
+    bool quiet = false;
+};
+} // namespace OCLRT
@@ -22,6 +22,7 @@
 
 #include "config.h"
 
+#include "offline_compiler/batch_compiler.h"
 #include "offline_compiler/offline_compiler.h"
 #include "runtime/os_interface/os_library.h"
 
@@ -29,7 +30,40 @@
 
 using namespace OCLRT;
 
+int buildBatch(int numArgs, const char *argv[]) {
+    int retVal = CL_SUCCESS;
+    BatchCompiler *pBatchCompiler = BatchCompiler::create(numArgs, argv, retVal);
+
+    if (retVal == CL_SUCCESS) {
+        retVal = pBatchCompiler->build();
+
+        for (auto &entry : pBatchCompiler->getEntries()) {
+            if (entry.messages.empty() == false) {
+                printf("%s", entry.messages.c_str());
+            }
+
+            if (entry.buildLog.empty() == false) {
+                printf("%s\n", entry.buildLog.c_str());
+            }
+
+            if (entry.retVal == CL_SUCCESS) {
+                if (!pBatchCompiler->isQuiet())
+                    printf("%s (%s): Build succeeded.\n", entry.inputFile.c_str(), entry.deviceName.c_str());
+            } else {
+                printf("%s (%s): Build failed with error code: %d\n", entry.inputFile.c_str(), entry.deviceName.c_str(), entry.retVal);
+            }
+        }
+    }
+
+    delete pBatchCompiler;
+    return retVal;
+}
+
 int main(int numArgs, const char *argv[]) {
+    if (BatchCompiler::isBatchCommandLine(numArgs, argv)) {
+        return buildBatch(numArgs, argv);
+    }
+
     int retVal = CL_SUCCESS;
     OfflineCompiler *pCompiler = OfflineCompiler::create(numArgs, argv, retVal);
 
@@ -58,6 +58,8 @@ namespace OCLRT {
 
 CIF::CIFMain *createMainNoSanitize(CIF::CreateCIFMainFunc_t createFunc);
 
+std::mutex OfflineCompiler::compilerLibrariesMutex;
+
 ////////////////////////////////////////////////////////////////////////////////
 // StringsAreEqual
 ////////////////////////////////////////////////////////////////////////////////
@@ -96,6 +98,15 @@ OfflineCompiler::OfflineCompiler() = default;
 // dtor
 ////////////////////////////////////////////////////////////////////////////////
 OfflineCompiler::~OfflineCompiler() {
+    {
+        std::lock_guard<std::mutex> lock(compilerLibrariesMutex);
+        fclDeviceCtx.reset();
+        fclMain.reset();
+        fclLib.reset();
+        igcDeviceCtx.reset();
+        igcMain.reset();
+        igcLib.reset();
+    }
     delete[] llvmBinary;
     delete[] genBinary;
     delete[] elfBinary;
@@ -104,11 +115,12 @@ OfflineCompiler::~OfflineCompiler() {
 ////////////////////////////////////////////////////////////////////////////////
 // Create
 ////////////////////////////////////////////////////////////////////////////////
-OfflineCompiler *OfflineCompiler::create(uint32_t numArgs, const char **argv, int &retVal) {
+OfflineCompiler *OfflineCompiler::create(uint32_t numArgs, const char **argv, int &retVal, std::string *messagesOutput) {
     retVal = CL_SUCCESS;
     auto pOffCompiler = new OfflineCompiler();
 
     if (pOffCompiler) {
+        pOffCompiler->setMessagesOutput(messagesOutput);
         retVal = pOffCompiler->initialize(numArgs, argv);
     }
 
@@ -216,6 +228,17 @@ void OfflineCompiler::updateBuildLog(const char *pErrorString, const size_t erro
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// printMessage
+////////////////////////////////////////////////////////////////////////////////
+void OfflineCompiler::printMessage(const char *message) {
+    if (messagesOutput == nullptr) {
+        printf("%s", message);
+        return;
+    }
+    messagesOutput->append(message);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // getBuildLog
 ////////////////////////////////////////////////////////////////////////////////
@@ -263,6 +286,66 @@ std::string OfflineCompiler::getStringWithinDelimiters(const std::string &src) {
 // Initialize
 ////////////////////////////////////////////////////////////////////////////////
 int OfflineCompiler::initialize(uint32_t numArgs, const char **argv) {
+    int retVal = initializeInput(numArgs, argv);
+    if (retVal != CL_SUCCESS) {
+        return retVal;
+    }
+
+    return initializeCompilers();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Reinitialize
+////////////////////////////////////////////////////////////////////////////////
+int OfflineCompiler::reinitialize(uint32_t numArgs, const char **argv) {
+    // compilers are already loaded and set up for hwInfo,
+    // so only the next input may be taken as long as it targets the same device
+    auto currentHwInfo = hwInfo;
+
+    resetInput();
+    int retVal = initializeInput(numArgs, argv);
+    if (retVal == CL_SUCCESS && hwInfo != currentHwInfo) {
+        printMessage("Error: Device %s differs from the one compiler was initialized for.\n", deviceName.c_str());
+        retVal = CL_INVALID_DEVICE;
+    }
+    hwInfo = currentHwInfo;
+
+    return retVal;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ResetInput
+////////////////////////////////////////////////////////////////////////////////
+void OfflineCompiler::resetInput() {
+    deviceName.clear();
+    inputFile.clear();
+    outputFile.clear();
+    outputDirectory.clear();
+    options.clear();
+    internalOptions.clear();
+    sourceCode.clear();
+    buildLog.clear();
+
+    useLlvmText = false;
+    useCppFile = false;
+    useOptionsSuffix = false;
+    quiet = false;
+
+    delete[] elfBinary;
+    elfBinary = nullptr;
+    elfBinarySize = 0;
+    delete[] genBinary;
+    genBinary = nullptr;
+    genBinarySize = 0;
+    delete[] llvmBinary;
+    llvmBinary = nullptr;
+    llvmBinarySize = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// InitializeInput
+////////////////////////////////////////////////////////////////////////////////
+int OfflineCompiler::initializeInput(uint32_t numArgs, const char **argv) {
     int retVal = CL_SUCCESS;
     const char *pSource = nullptr;
     void *pSourceFromFile = nullptr;
@@ -298,7 +381,7 @@ int OfflineCompiler::initialize(uint32_t numArgs, const char **argv) {
                 auto trimPos = options.find_last_not_of(" \n\r");
                 options = options.substr(0, trimPos + 1);
                 if (!isQuiet())
-                    printf("Building with options:\n%s\n", options.c_str());
+                    printMessage("Building with options:\n%s\n", options.c_str());
             }
             deleteDataReadFromFile(pOptions);
         }
@@ -319,6 +402,16 @@ int OfflineCompiler::initialize(uint32_t numArgs, const char **argv) {
     pSource = strstr((const char *)pSourceFromFile, "R\"===(");
     sourceCode = (pSource != nullptr) ? getStringWithinDelimiters((char *)pSourceFromFile) : (char *)pSourceFromFile;
 
+    return retVal;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// InitializeCompilers
+////////////////////////////////////////////////////////////////////////////////
+int OfflineCompiler::initializeCompilers() {
+    int retVal = CL_SUCCESS;
+    std::lock_guard<std::mutex> lock(compilerLibrariesMutex);
+
     this->fclLib.reset(OsLibrary::load(Os::frontEndDllName));
     if (this->fclLib == nullptr) {
         return CL_OUT_OF_HOST_MEMORY;
@@ -466,7 +559,7 @@ int OfflineCompiler::parseCommandLine(uint32_t numArgs, const char **argv) {
             printUsage();
             retVal = PRINT_USAGE;
         } else {
-            printf("Invalid option (arg %d): %s\n", argIndex, argv[argIndex]);
+            printMessage("Invalid option (arg %d): %s\n", argIndex, argv[argIndex]);
             retVal = INVALID_COMMAND_LINE;
             break;
         }
@@ -474,21 +567,21 @@ int OfflineCompiler::parseCommandLine(uint32_t numArgs, const char **argv) {
 
     if (retVal == CL_SUCCESS) {
         if (compile32 && compile64) {
-            printf("Error: Cannot compile for 32-bit and 64-bit, please choose one.\n");
+            printMessage("Error: Cannot compile for 32-bit and 64-bit, please choose one.\n");
             retVal = INVALID_COMMAND_LINE;
         } else if (inputFile.empty()) {
-            printf("Error: Input file name missing.\n");
+            printMessage("Error: Input file name missing.\n");
             retVal = INVALID_COMMAND_LINE;
         } else if (deviceName.empty()) {
-            printf("Error: Device name missing.\n");
+            printMessage("Error: Device name missing.\n");
             retVal = INVALID_COMMAND_LINE;
         } else if (!fileExists(inputFile)) {
-            printf("Error: Input file %s missing.\n", inputFile.c_str());
+            printMessage("Error: Input file %s missing.\n", inputFile.c_str());
             retVal = INVALID_FILE;
         } else {
             retVal = getHardwareInfo(deviceName.c_str());
             if (retVal != CL_SUCCESS) {
-                printf("Error: Cannot get HW Info for device %s.\n", deviceName.c_str());
+                printMessage("Error: Cannot get HW Info for device %s.\n", deviceName.c_str());
             }
             std::string extensionsList = getExtensionsList(*hwInfo);
             internalOptions.append(convertEnabledExtensionsToCompilerInternalOptions(extensionsList.c_str()));
@@ -601,7 +694,8 @@ std::string getDevicesTypes() {
 void OfflineCompiler::printUsage() {
 
     printf("Compiles CL files into llvm (.bc or .ll), gen isa (.gen), and binary files (.bin)\n\n");
-    printf("cloc -file <filename> -device <device_type> [-outdir <output_dir>]\n\n");
+    printf("cloc -file <filename> -device <device_type> [-outdir <output_dir>]\n");
+    printf("cloc -batch <manifest> [-threads <count>] [-outdir <output_dir>]\n\n");
     printf("  -file <filename>        Indicates the CL kernel file to be compiled.\n");
     printf("  -device <device_type>   Indicates which device for which we will compile.\n");
     printf("                          <device_type> can be: %s\n", getDevicesTypes().c_str());
@@ -615,6 +709,13 @@ void OfflineCompiler::printUsage() {
     printf("  -32                     Force compile to 32-bit binary.\n");
     printf("  -64                     Force compile to 64-bit binary.\n");
     printf("  -q                      Be more quiet. print only warnings and errors.\n");
+    printf("  -batch <manifest>       Compiles every entry of the manifest file in a single run.\n");
+    printf("                          Each non-empty line not starting with '#' holds the\n");
+    printf("                          arguments for one input, e.g. -file <filename> -device <device_type>.\n");
+    printf("                          Remaining command line arguments are applied to all entries.\n");
+    printf("  -threads <count>        Maximum number of batch workers, defaults to the number of CPU\n");
+    printf("                          cores. Inputs of the same device are compiled one after another\n");
+    printf("                          by a single worker, so at most one worker per device is used.\n");
     printf("  -?                      Print this usage message.\n");
 }
 
@@ -25,8 +25,11 @@
 #include "ocl_igc_interface/igc_ocl_device_ctx.h"
 #include "ocl_igc_interface/fcl_ocl_device_ctx.h"
 #include <cstdint>
+#include <cstdio>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace OCLRT {
 
@@ -43,7 +46,8 @@ enum ErrorCode {
 
 class OfflineCompiler {
   public:
-    static OfflineCompiler *create(uint32_t numArgs, const char **argv, int &retVal);
+    static OfflineCompiler *create(uint32_t numArgs, const char **argv, int &retVal, std::string *messagesOutput = nullptr);
+    int reinitialize(uint32_t numArgs, const char **argv);
     int build();
     std::string &getBuildLog();
     void printUsage();
@@ -56,6 +60,15 @@ class OfflineCompiler {
         return quiet;
     }
 
+    const std::string &getDeviceName() const {
+        return deviceName;
+    }
+
+    // messages are appended to messagesOutput instead of being printed when it is set
+    void setMessagesOutput(std::string *messagesOutput) {
+        this->messagesOutput = messagesOutput;
+    }
+
     std::string parseBinAsCharArray(uint8_t *binary, size_t size, std::string &deviceName, std::string &fileName);
 
   protected:
@@ -65,6 +78,9 @@ class OfflineCompiler {
     std::string getFileNameTrunk(std::string &filePath);
     std::string getStringWithinDelimiters(const std::string &src);
     int initialize(uint32_t numArgs, const char **argv);
+    int initializeInput(uint32_t numArgs, const char **argv);
+    int initializeCompilers();
+    void resetInput();
     int parseCommandLine(uint32_t numArgs, const char **argv);
     void parseDebugSettings();
     void storeBinary(char *&pDst, size_t &dstSize, const void *pSrc, const size_t srcSize);
@@ -72,6 +88,26 @@ class OfflineCompiler {
     void updateBuildLog(const char *pErrorString, const size_t errorStringSize);
     bool generateElfBinary();
     void writeOutAllFiles();
+
+    void printMessage(const char *message);
+    template <typename ArgT, typename... ArgsT>
+    void printMessage(const char *format, ArgT arg, ArgsT... args) {
+        if (messagesOutput == nullptr) {
+            printf(format, arg, args...);
+            return;
+        }
+        auto messageSize = snprintf(nullptr, 0, format, arg, args...);
+        if (messageSize > 0) {
+            std::vector<char> message(messageSize + 1);
+            snprintf(message.data(), message.size(), format, arg, args...);
+            messagesOutput->append(message.data(), messageSize);
+        }
+    }
+
+    // serializes loading and unloading FCL and IGC; a compiler's device contexts are only
+    // used by the thread owning it, so translations of different compilers run in parallel
+    static std::mutex compilerLibrariesMutex;
+
     const HardwareInfo *hwInfo = nullptr;
 
     std::string deviceName;
@@ -82,6 +118,7 @@ class OfflineCompiler {
     std::string internalOptions;
     std::string sourceCode;
     std::string buildLog;
+    std::string *messagesOutput = nullptr;
 
     bool useLlvmText = false;
     bool useCppFile = false;
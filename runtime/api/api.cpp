@@ -48,6 +48,7 @@
 #include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/os_interface/os_inc.h"
 #include "runtime/platform/platform.h"
+#include "runtime/program/async_build_handler.h"
 #include "runtime/program/program.h"
 #include "runtime/sampler/sampler.h"
 #include "runtime/sharings/sharing_factory.h"
@@ -1171,7 +1172,12 @@ cl_int CL_API_CALL clBuildProgram(cl_program program,
     auto pProgram = castToObject<Program>(program);
 
     if (pProgram) {
-        retVal = pProgram->build(numDevices, deviceList, options, funcNotify, userData, clCacheEnabled);
+        auto asyncBuildHandler = platform()->getAsyncBuildHandler();
+        if ((funcNotify != nullptr) && (asyncBuildHandler != nullptr) && asyncBuildHandler->isAsyncBuildEnabled()) {
+            retVal = pProgram->buildAsync(numDevices, deviceList, options, funcNotify, userData, clCacheEnabled, *asyncBuildHandler);
+        } else {
+            retVal = pProgram->build(numDevices, deviceList, options, funcNotify, userData, clCacheEnabled);
+        }
     }
 
     return retVal;
@@ -1301,6 +1307,11 @@ cl_kernel CL_API_CALL clCreateKernel(cl_program clProgram,
             break;
         }
 
+        if (pProgram->isBuildInProgress()) {
+            retVal = CL_INVALID_PROGRAM_EXECUTABLE;
+            break;
+        }
+
         const KernelInfo *pKernelInfo = pProgram->getKernelInfo(kernelName);
         if (!pKernelInfo) {
             retVal = CL_INVALID_KERNEL_NAME;
@@ -1336,6 +1347,9 @@ cl_int CL_API_CALL clCreateKernelsInProgram(cl_program clProgram,
     API_ENTER(0);
     auto program = castToObject<Program>(clProgram);
     if (program) {
+        if (program->isBuildInProgress()) {
+            return CL_INVALID_PROGRAM_EXECUTABLE;
+        }
         auto numKernels = program->getNumKernels();
         for (unsigned int ordinal = 0; ordinal < numKernels; ++ordinal) {
             const auto kernelInfo = program->getKernelInfo(ordinal);
@@ -262,7 +262,15 @@ template <typename... KernelsDescArgsT>
 void BuiltinDispatchInfoBuilder::populate(Context &context, Device &device, EBuiltInOps op, const char *options, KernelsDescArgsT &&... desc) {
     auto src = kernelsLib.getBuiltinsLib().getBuiltinCode(op, BuiltinCode::ECodeType::Any, device);
     prog.reset(BuiltinsLib::createProgramFromCode(src, context, device).release());
-    prog->build(0, nullptr, options, nullptr, nullptr, kernelsLib.isCacheingEnabled());
+    auto retVal = prog ? prog->build(0, nullptr, options, nullptr, nullptr, kernelsLib.isCacheingEnabled()) : CL_INVALID_PROGRAM;
+
+    if ((retVal != CL_SUCCESS) && (src.type == BuiltinCode::ECodeType::Binary)) {
+        // embedded binary doesn't match this runtime (e.g. stale device binary version), compile from source instead
+        src = kernelsLib.getBuiltinsLib().getBuiltinCode(op, BuiltinCode::ECodeType::Source, device);
+        prog.reset(BuiltinsLib::createProgramFromCode(src, context, device).release());
+        retVal = prog ? prog->build(0, nullptr, options, nullptr, nullptr, kernelsLib.isCacheingEnabled()) : CL_INVALID_PROGRAM;
+    }
+    UNRECOVERABLE_IF(retVal != CL_SUCCESS);
     grabKernels(std::forward<KernelsDescArgsT>(desc)...);
 }
 
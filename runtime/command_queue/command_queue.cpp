@@ -29,6 +29,7 @@
 #include "runtime/event/event.h"
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/array_count.h"
+#include "runtime/helpers/basic_math.h"
 #include "runtime/helpers/get_info.h"
 #include "runtime/helpers/options.h"
 #include "runtime/helpers/ptr_math.h"
@@ -36,11 +37,13 @@
 #include "runtime/mem_obj/image.h"
 #include "runtime/helpers/surface_formats.h"
 #include "runtime/memory_manager/memory_manager.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/helpers/string.h"
 #include "CL/cl_ext.h"
 #include "runtime/utilities/api_intercept.h"
 #include "runtime/helpers/convert_color.h"
 #include "runtime/helpers/queue_helpers.h"
+#include <algorithm>
 #include <map>
 
 namespace OCLRT {
@@ -71,6 +74,7 @@ CommandQueue::CommandQueue(Context *context,
                                                                     context(context),
                                                                     device(deviceId),
                                                                     priority(QueuePriority::MEDIUM),
+                                                                    throttle(QueueThrottle::MEDIUM),
                                                                     perfCountersEnabled(false),
                                                                     perfCountersConfig(UINT32_MAX),
                                                                     perfCountersUserRegistersNumber(0),
@@ -86,6 +90,10 @@ CommandQueue::CommandQueue(Context *context,
     }
     commandQueueProperties = getCmdQueueProperties<cl_command_queue_properties>(properties);
     flushStamp.reset(new FlushStampTracker(true));
+
+    batchedFlushThresholds.commandBuffers = static_cast<uint32_t>(std::max(DebugManager.flags.BatchedFlushCommandBuffersThreshold.get(), 0));
+    batchedFlushThresholds.bytes = static_cast<size_t>(std::max(DebugManager.flags.BatchedFlushSizeThresholdKB.get(), 0)) * KB;
+    batchedFlushThresholds.ageUs = std::max(DebugManager.flags.BatchedFlushAgeThresholdUs.get(), 0);
 }
 
 CommandQueue::~CommandQueue() {
@@ -154,7 +162,7 @@ void CommandQueue::waitUntilComplete(uint32_t taskCountToWait, FlushStamp flushS
     DBG_LOG(LogTaskCounts, __FUNCTION__, "Waiting for taskCount:", taskCountToWait);
     DBG_LOG(LogTaskCounts, __FUNCTION__, "Line: ", __LINE__, "Current taskCount:", getHwTag());
 
-    device->getCommandStreamReceiver().waitForTaskCountWithKmdNotifyFallback(taskCountToWait, flushStampToWait);
+    device->getCommandStreamReceiver().waitForTaskCountWithKmdNotifyFallback(taskCountToWait, flushStampToWait, throttle);
 
     DEBUG_BREAK_IF(getHwTag() < taskCountToWait);
     latestTaskCountWaited = taskCountToWait;
@@ -406,6 +414,7 @@ void CommandQueue::flushWaitList(
             ;
     }
 
+    TakeOwnershipWrapper<CommandQueue> queueOwnership(*this);
     TakeOwnershipWrapper<Device> deviceOwnership(*device);
     device->getCommandStreamReceiver().flushBatchedSubmissions();
 
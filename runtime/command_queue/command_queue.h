@@ -22,6 +22,7 @@
 
 #pragma once
 #include "runtime/api/cl_types.h"
+#include "runtime/command_stream/csr_definitions.h"
 #include "runtime/indirect_heap/indirect_heap.h"
 #include "runtime/helpers/base_object.h"
 #include "runtime/helpers/completion_stamp.h"
@@ -386,6 +387,18 @@ class CommandQueue : public BaseObject<_cl_command_queue> {
         return priority;
     }
 
+    QueueThrottle getThrottle() const {
+        return throttle;
+    }
+
+    const BatchedFlushThresholds &getBatchedFlushThresholds() const {
+        return batchedFlushThresholds;
+    }
+
+    void setBatchedFlushThresholds(const BatchedFlushThresholds &thresholds) {
+        batchedFlushThresholds = thresholds;
+    }
+
     // taskCount of last task
     uint32_t taskCount;
 
@@ -406,6 +419,8 @@ class CommandQueue : public BaseObject<_cl_command_queue> {
     cl_command_queue_properties commandQueueProperties;
 
     QueuePriority priority;
+    QueueThrottle throttle;
+    BatchedFlushThresholds batchedFlushThresholds;
 
     bool perfCountersEnabled;
     cl_uint perfCountersConfig;
@@ -48,8 +48,8 @@ void *CommandQueueHw<GfxFamily>::cpuDataTransferHandler(MemObj *memObj,
         *event = eventBuilder.getEvent();
     }
 
-    TakeOwnershipWrapper<Device> deviceOwnership(*device);
     TakeOwnershipWrapper<CommandQueueHw<GfxFamily>> queueOwnership(*this);
+    TakeOwnershipWrapper<Device> deviceOwnership(*device);
 
     auto blockQueue = false;
     auto taskLevel = 0u;
@@ -71,8 +71,8 @@ void *CommandQueueHw<GfxFamily>::cpuDataTransferHandler(MemObj *memObj,
                                                 eventBuilder);
     }
 
-    queueOwnership.unlock();
     deviceOwnership.unlock();
+    queueOwnership.unlock();
 
     // read/write buffers are always blocking
     if (!blockQueue || blocking) {
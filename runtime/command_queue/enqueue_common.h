@@ -153,8 +153,6 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
 
     HwTimeStamps *hwTimeStamps = nullptr;
 
-    TakeOwnershipWrapper<Device> deviceOwnership(*device);
-
     TimeStampData queueTimeStamp;
     if (isProfilingEnabled() && event) {
         this->getDevice().getOSTime()->getCpuGpuTime(&queueTimeStamp);
@@ -182,11 +180,20 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
     bool slmUsed = false;
     EngineType engineType = device->getEngineType();
     TakeOwnershipWrapper<CommandQueueHw<GfxFamily>> queueOwnership(*this);
+    for (auto &dispatchInfo : multiDispatchInfo) {
+        dispatchInfo.getKernel()->takeOwnership(true);
+    }
 
     auto blockQueue = false;
     auto taskLevel = 0u;
     obtainTaskLevelAndBlockedStatus(taskLevel, numEventsInWaitList, eventWaitList, blockQueue, commandType);
 
+    // Commands are recorded into this queue's own stream and heaps, so the device lock is only needed
+    // once they are handed over to the CSR. Blocked queues, the device queue and profiling allocators
+    // are shared with other queues, so those enqueues keep holding it for the whole dispatch.
+    bool deviceOwnershipRequired = blockQueue || executionModelKernel || profilingRequired || perfCountersRequired;
+    TakeOwnershipWrapper<Device> deviceOwnership(*device, deviceOwnershipRequired);
+
     auto &commandStream = getCommandStream<GfxFamily, commandType>(*this, profilingRequired, perfCountersRequired, multiDispatchInfo);
     auto commandStreamStart = commandStream.getUsed();
     auto &commandStreamReceiver = device->getCommandStreamReceiver();
@@ -245,11 +252,14 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
             blockQueue,
             commandType);
 
-        commandStreamReceiver.setRequiredScratchSize(multiDispatchInfo.getRequiredScratchSize());
-
         slmUsed = multiDispatchInfo.usesSlm();
     }
 
+    deviceOwnership.lock();
+    if (multiDispatchInfo.empty() == false) {
+        commandStreamReceiver.setRequiredScratchSize(multiDispatchInfo.getRequiredScratchSize());
+    }
+
     CompletionStamp completionStamp;
     if (!blockQueue) {
         if (executionModelKernel) {
@@ -392,8 +402,11 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
             std::move(printfHandler));
     }
 
-    queueOwnership.unlock();
     deviceOwnership.unlock();
+    for (auto &dispatchInfo : multiDispatchInfo) {
+        dispatchInfo.getKernel()->releaseOwnership();
+    }
+    queueOwnership.unlock();
 
     if (blocking) {
         if (blockQueue) {
@@ -539,6 +552,7 @@ CompletionStamp CommandQueueHw<GfxFamily>::enqueueNonBlocked(
     dispatchFlags.flushStampReference = this->flushStamp->getStampReference();
     dispatchFlags.preemptionMode = PreemptionHelper::taskPreemptionMode(*device, multiDispatchInfo);
     dispatchFlags.outOfOrderExecutionAllowed = this->isOOQEnabled();
+    dispatchFlags.batchedFlushThresholds = batchedFlushThresholds;
 
     DEBUG_BREAK_IF(taskLevel >= Event::eventNotReady);
 
@@ -90,8 +90,8 @@ void *CommandQueueHw<GfxFamily>::enqueueMapImage(cl_mem image, cl_bool blockingM
     }
 
     EventBuilder eventBuilder;
-    TakeOwnershipWrapper<Device> deviceOwnership(*device);
     TakeOwnershipWrapper<CommandQueueHw<GfxFamily>> queueOwnership(*this);
+    TakeOwnershipWrapper<Device> deviceOwnership(*device);
     auto blockQueue = false;
     auto taskLevel = 0u;
     obtainTaskLevelAndBlockedStatus(taskLevel, numEventsInWaitList, eventWaitList, blockQueue, CL_COMMAND_MAP_IMAGE);
@@ -110,8 +110,8 @@ void *CommandQueueHw<GfxFamily>::enqueueMapImage(cl_mem image, cl_bool blockingM
                                                 eventBuilder);
     }
 
-    queueOwnership.unlock();
     deviceOwnership.unlock();
+    queueOwnership.unlock();
 
     if (blockingMap && blockQueue) {
         errcodeRet = this->virtualEvent->waitForEvents(numEventsInWaitList, eventWaitList);
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_stream/batched_submission_flusher.h"
+#include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/helpers/debug_helpers.h"
+
+namespace OCLRT {
+BatchedSubmissionFlusher::BatchedSubmissionFlusher(CommandStreamReceiver &csr) : csr(csr) {
+}
+
+BatchedSubmissionFlusher::~BatchedSubmissionFlusher() {
+    closeThread();
+}
+
+void BatchedSubmissionFlusher::scheduleFlush(std::chrono::steady_clock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(flusherMtx);
+    //Create on first use
+    openThread();
+
+    if (!flushScheduled || deadline < this->deadline) {
+        this->deadline = deadline;
+        flushScheduled = true;
+        flusherCond.notify_one();
+    }
+}
+
+void BatchedSubmissionFlusher::asyncProcess() {
+    std::unique_lock<std::mutex> lock(flusherMtx);
+
+    while (allowAsyncProcess) {
+        if (!flushScheduled) {
+            flusherCond.wait(lock);
+            continue;
+        }
+        if (std::chrono::steady_clock::now() < deadline) {
+            flusherCond.wait_until(lock, deadline);
+            continue;
+        }
+        flushScheduled = false;
+        lock.unlock();
+        csr.flushExpiredBatchedSubmissions();
+        lock.lock();
+    }
+}
+
+void BatchedSubmissionFlusher::closeThread() {
+    std::unique_lock<std::mutex> lock(flusherMtx);
+    if (allowAsyncProcess) {
+        allowAsyncProcess = false;
+        flusherCond.notify_one();
+        lock.unlock();
+        thread->join();
+        thread.reset(nullptr);
+    }
+}
+
+void BatchedSubmissionFlusher::openThread() {
+    if (!thread.get()) {
+        DEBUG_BREAK_IF(allowAsyncProcess);
+        allowAsyncProcess = true;
+        thread.reset(new std::thread([this] { asyncProcess(); }));
+    }
+}
+} // namespace OCLRT
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace OCLRT {
+class CommandStreamReceiver;
+
+// Background thread submitting command buffers aggregated in batched dispatch mode
+// once the oldest of them reaches its age threshold. It sleeps until the earliest
+// scheduled deadline and is created on first use.
+class BatchedSubmissionFlusher {
+  public:
+    BatchedSubmissionFlusher(CommandStreamReceiver &csr);
+    virtual ~BatchedSubmissionFlusher();
+
+    void scheduleFlush(std::chrono::steady_clock::time_point deadline);
+    void closeThread();
+
+  protected:
+    void asyncProcess();
+    MOCKABLE_VIRTUAL void openThread();
+
+    CommandStreamReceiver &csr;
+    std::unique_ptr<std::thread> thread;
+    std::mutex flusherMtx;
+    std::condition_variable flusherCond;
+    std::chrono::steady_clock::time_point deadline;
+    bool flushScheduled = false;
+    bool allowAsyncProcess = false;
+};
+} // namespace OCLRT
@@ -21,6 +21,7 @@
  */
 
 #include "runtime/built_ins/built_ins.h"
+#include "runtime/command_stream/batched_submission_flusher.h"
 #include "runtime/command_stream/command_stream_receiver.h"
 #include "runtime/command_stream/preemption.h"
 #include "runtime/device/device.h"
@@ -29,6 +30,12 @@
 #include "runtime/os_interface/os_interface.h"
 #include "runtime/event/event.h"
 #include "runtime/event/event_builder.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+#include "runtime/utilities/cpu_intrinsics.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
 
 namespace OCLRT {
 // Global table of CommandStreamReceiver factories for HW and tests
@@ -44,7 +51,22 @@ CommandStreamReceiver::CommandStreamReceiver() {
 }
 
 CommandStreamReceiver::~CommandStreamReceiver() {
+    closeBatchedSubmissionFlusher();
     cleanupResources();
+
+    auto statistics = getWaitStatistics();
+    printDebugString(DebugManager.flags.PrintDebugMessages.get() && statistics.waits > 0, stdout,
+                     "CSR waits: %llu, spinning %llu us, yielding %llu us, %llu kernel waits taking %llu us\n",
+                     static_cast<unsigned long long>(statistics.waits), static_cast<unsigned long long>(statistics.spinTimeUs),
+                     static_cast<unsigned long long>(statistics.yieldTimeUs), static_cast<unsigned long long>(statistics.kmdWaits),
+                     static_cast<unsigned long long>(statistics.kmdWaitTimeUs));
+
+    auto batchingStatistics = getBatchingStatistics();
+    printDebugString(DebugManager.flags.PrintDebugMessages.get() && dispatchMode != ImmediateDispatch, stdout,
+                     "CSR batched flushes: %llu explicit, %llu implicit, %llu command buffer limit, %llu byte limit, %llu age limit\n",
+                     static_cast<unsigned long long>(batchingStatistics.explicitFlushes), static_cast<unsigned long long>(batchingStatistics.implicitFlushes),
+                     static_cast<unsigned long long>(batchingStatistics.commandBufferLimitFlushes), static_cast<unsigned long long>(batchingStatistics.byteLimitFlushes),
+                     static_cast<unsigned long long>(batchingStatistics.ageLimitFlushes));
 }
 
 void CommandStreamReceiver::makeResident(GraphicsAllocation &gfxAllocation) {
@@ -170,7 +192,7 @@ void CommandStreamReceiver::cleanupResources() {
 }
 
 bool CommandStreamReceiver::waitForCompletionWithTimeout(bool enableTimeout, int64_t timeoutMs, uint32_t taskCountToWait) {
-    std::chrono::high_resolution_clock::time_point time1, time2;
+    std::chrono::high_resolution_clock::time_point time1, time2, phaseStart;
     int64_t timeDiff = 0;
 
     uint32_t latestSentTaskCount = this->latestFlushedTaskCount;
@@ -178,19 +200,138 @@ bool CommandStreamReceiver::waitForCompletionWithTimeout(bool enableTimeout, int
         this->flushBatchedSubmissions();
     }
 
+    if (*getTagAddress() >= taskCountToWait) {
+        return true;
+    }
+    if (enableTimeout && timeoutMs == 0) {
+        // no polling is wanted, the caller falls back to the kernel wait straight away
+        return false;
+    }
+    waitCount++;
+
+    // poll with a cpu pause first, then keep polling but give the cpu away between reads;
+    // the clock is only read every few pauses, as it is much more expensive than the pause itself
+    const uint32_t clockCheckInterval = 64;
+    auto spinIterations = static_cast<uint32_t>(std::max(DebugManager.flags.WaitSpinIterations.get(), 0));
+    uint32_t iteration = 0;
+    bool yielding = false;
+
     time1 = std::chrono::high_resolution_clock::now();
+    phaseStart = time1;
     while (*getTagAddress() < taskCountToWait && timeDiff <= timeoutMs) {
+        if (iteration < spinIterations) {
+            CpuIntrinsics::pause();
+            if (++iteration % clockCheckInterval != 0) {
+                continue;
+            }
+        } else {
+            if (!yielding) {
+                time2 = std::chrono::high_resolution_clock::now();
+                spinTimeUs += std::chrono::duration_cast<std::chrono::microseconds>(time2 - phaseStart).count();
+                phaseStart = time2;
+                yielding = true;
+            }
+            std::this_thread::yield();
+        }
         if (enableTimeout) {
             time2 = std::chrono::high_resolution_clock::now();
             timeDiff = std::chrono::duration_cast<std::chrono::milliseconds>(time2 - time1).count();
         }
     }
+
+    time2 = std::chrono::high_resolution_clock::now();
+    auto phaseTimeUs = std::chrono::duration_cast<std::chrono::microseconds>(time2 - phaseStart).count();
+    if (yielding) {
+        yieldTimeUs += phaseTimeUs;
+    } else {
+        spinTimeUs += phaseTimeUs;
+    }
+
     if (*getTagAddress() >= taskCountToWait) {
         return true;
     }
     return false;
 }
 
+CommandStreamReceiver::WaitStatistics CommandStreamReceiver::getWaitStatistics() const {
+    WaitStatistics statistics;
+    statistics.waits = waitCount;
+    statistics.spinTimeUs = spinTimeUs;
+    statistics.yieldTimeUs = yieldTimeUs;
+    statistics.kmdWaits = kmdWaitCount;
+    statistics.kmdWaitTimeUs = kmdWaitTimeUs;
+    return statistics;
+}
+
+bool CommandStreamReceiver::trackBatchedCommandBuffer(size_t commandBufferSize, const BatchedFlushThresholds &thresholds) {
+    batchedCommandBuffers++;
+    batchedBytes += commandBufferSize;
+
+    if (thresholds.commandBuffers > 0 && batchedCommandBuffers >= thresholds.commandBuffers) {
+        batchedFlushReason = BatchedFlushReason::COMMAND_BUFFERS;
+        return true;
+    }
+    if (thresholds.bytes > 0 && batchedBytes >= thresholds.bytes) {
+        batchedFlushReason = BatchedFlushReason::BYTES;
+        return true;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (batchedFlushDeadlineSet && now >= batchedFlushDeadline) {
+        batchedFlushReason = BatchedFlushReason::AGE;
+        return true;
+    }
+    if (thresholds.ageUs > 0) {
+        auto deadline = now + std::chrono::microseconds(thresholds.ageUs);
+        if (!batchedFlushDeadlineSet || deadline < batchedFlushDeadline) {
+            batchedFlushDeadline = deadline;
+            batchedFlushDeadlineSet = true;
+            if (!batchedSubmissionFlusher) {
+                batchedSubmissionFlusher.reset(new BatchedSubmissionFlusher(*this));
+            }
+            batchedSubmissionFlusher->scheduleFlush(deadline);
+        }
+    }
+    return false;
+}
+
+void CommandStreamReceiver::resetBatchedCommandBufferTracking() {
+    batchedCommandBuffers = 0;
+    batchedBytes = 0;
+    batchedFlushDeadlineSet = false;
+}
+
+void CommandStreamReceiver::flushExpiredBatchedSubmissions() {
+    TakeOwnershipWrapper<Device> deviceOwnership(*getMemoryManager()->device);
+
+    if (!batchedFlushDeadlineSet) {
+        return;
+    }
+    if (std::chrono::steady_clock::now() < batchedFlushDeadline) {
+        //command buffers that were due got flushed meanwhile, wait for the next ones
+        batchedSubmissionFlusher->scheduleFlush(batchedFlushDeadline);
+        return;
+    }
+    batchedFlushReason = BatchedFlushReason::AGE;
+    flushBatchedSubmissions();
+}
+
+void CommandStreamReceiver::closeBatchedSubmissionFlusher() {
+    if (batchedSubmissionFlusher) {
+        batchedSubmissionFlusher->closeThread();
+    }
+}
+
+CommandStreamReceiver::BatchingStatistics CommandStreamReceiver::getBatchingStatistics() const {
+    BatchingStatistics statistics;
+    statistics.explicitFlushes = batchedFlushCounts[static_cast<size_t>(BatchedFlushReason::EXPLICIT)];
+    statistics.implicitFlushes = batchedFlushCounts[static_cast<size_t>(BatchedFlushReason::IMPLICIT)];
+    statistics.commandBufferLimitFlushes = batchedFlushCounts[static_cast<size_t>(BatchedFlushReason::COMMAND_BUFFERS)];
+    statistics.byteLimitFlushes = batchedFlushCounts[static_cast<size_t>(BatchedFlushReason::BYTES)];
+    statistics.ageLimitFlushes = batchedFlushCounts[static_cast<size_t>(BatchedFlushReason::AGE)];
+    return statistics;
+}
+
 void CommandStreamReceiver::setTagAllocation(GraphicsAllocation *allocation) {
     this->tagAllocation = allocation;
     this->tagAddress = allocation ? reinterpret_cast<uint32_t *>(allocation->getUnderlyingBuffer()) : nullptr;
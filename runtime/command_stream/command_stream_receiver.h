@@ -28,10 +28,12 @@
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/flush_stamp.h"
 #include "runtime/command_stream/csr_definitions.h"
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 
 namespace OCLRT {
+class BatchedSubmissionFlusher;
 class Device;
 class EventBuilder;
 class LinearStream;
@@ -41,6 +43,23 @@ class GraphicsAllocation;
 
 class CommandStreamReceiver {
   public:
+    struct WaitStatistics {
+        uint64_t waits;         // waits that found the task count not reached yet
+        uint64_t spinTimeUs;    // time spent polling with cpu pause
+        uint64_t yieldTimeUs;   // time spent polling with yielding the cpu
+        uint64_t kmdWaits;      // waits that fell back to the kernel
+        uint64_t kmdWaitTimeUs; // time spent waiting in the kernel
+    };
+
+    // number of batched submissions flushed for each BatchedFlushReason
+    struct BatchingStatistics {
+        uint64_t explicitFlushes;
+        uint64_t implicitFlushes;
+        uint64_t commandBufferLimitFlushes;
+        uint64_t byteLimitFlushes;
+        uint64_t ageLimitFlushes;
+    };
+
     enum DispatchMode {
         DeviceDefault = 0,          //default for given device
         ImmediateDispatch,          //everything is submitted to the HW immediately
@@ -60,6 +79,9 @@ class CommandStreamReceiver {
                                       uint32_t taskLevel, DispatchFlags &dispatchFlags) = 0;
 
     virtual void flushBatchedSubmissions() = 0;
+    void flushExpiredBatchedSubmissions();
+    void closeBatchedSubmissionFlusher();
+    BatchingStatistics getBatchingStatistics() const;
 
     virtual void makeCoherent(void *address, size_t length){};
     virtual void makeResident(GraphicsAllocation &gfxAllocation);
@@ -106,8 +128,10 @@ class CommandStreamReceiver {
 
     void requestThreadArbitrationPolicy(uint32_t requiredPolicy) { this->requiredThreadArbitrationPolicy = requiredPolicy; }
 
-    virtual void waitForTaskCountWithKmdNotifyFallback(uint32_t taskCountToWait, FlushStamp flushStampToWait) = 0;
+    virtual void waitForTaskCountWithKmdNotifyFallback(uint32_t taskCountToWait, FlushStamp flushStampToWait, QueueThrottle throttle) = 0;
+    // polls the completion tag, a zero timeout with enableTimeout set only checks it once
     MOCKABLE_VIRTUAL bool waitForCompletionWithTimeout(bool enableTimeout, int64_t timeoutMs, uint32_t taskCountToWait);
+    WaitStatistics getWaitStatistics() const;
 
     // returns size of block that needs to be reserved at the beginning of each instruction heap for CommandStreamReceiver
     MOCKABLE_VIRTUAL size_t getInstructionHeapCmdStreamReceiverReservedSize() const;
@@ -116,6 +140,9 @@ class CommandStreamReceiver {
     MOCKABLE_VIRTUAL void initializeInstructionHeapCmdStreamReceiverReservedBlock(LinearStream &ih) const;
 
   protected:
+    bool trackBatchedCommandBuffer(size_t commandBufferSize, const BatchedFlushThresholds &thresholds);
+    void resetBatchedCommandBufferTracking();
+
     // taskCount - # of tasks submitted
     uint32_t taskCount = 0;
     // current taskLevel.  Used for determining if a PIPE_CONTROL is needed.
@@ -156,6 +183,21 @@ class CommandStreamReceiver {
     bool disableL3Cache = 0;
     uint32_t requiredScratchSize = 0;
     uint64_t totalMemoryUsed = 0u;
+
+    std::atomic<uint64_t> waitCount{0};
+    std::atomic<uint64_t> spinTimeUs{0};
+    std::atomic<uint64_t> yieldTimeUs{0};
+    std::atomic<uint64_t> kmdWaitCount{0};
+    std::atomic<uint64_t> kmdWaitTimeUs{0};
+
+    // state of command buffers waiting in submissionAggregator, guarded by the device lock
+    std::unique_ptr<BatchedSubmissionFlusher> batchedSubmissionFlusher;
+    BatchedFlushReason batchedFlushReason = BatchedFlushReason::EXPLICIT;
+    uint32_t batchedCommandBuffers = 0;
+    size_t batchedBytes = 0;
+    bool batchedFlushDeadlineSet = false;
+    std::chrono::steady_clock::time_point batchedFlushDeadline;
+    std::atomic<uint64_t> batchedFlushCounts[static_cast<size_t>(BatchedFlushReason::AGE) + 1] = {};
 };
 
 typedef CommandStreamReceiver *(*CommandStreamReceiverCreateFunc)(const HardwareInfo &hwInfoIn, bool withAubDump);
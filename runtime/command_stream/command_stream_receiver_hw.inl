@@ -34,6 +34,8 @@
 #include "runtime/command_queue/dispatch_walker.h"
 #include "command_stream_receiver_hw.h"
 
+#include <chrono>
+
 namespace OCLRT {
 
 template <typename GfxFamily>
@@ -337,6 +339,7 @@ CompletionStamp CommandStreamReceiverHw<GfxFamily>::flushTask(
     auto &streamToSubmit = submitCommandStreamFromCsr ? commandStreamCSR : commandStreamTask;
     BatchBuffer batchBuffer{streamToSubmit.getGraphicsAllocation(), startOffset, dispatchFlags.requiresCoherency, dispatchFlags.lowPriority, streamToSubmit.getUsed(), &streamToSubmit};
     EngineType engineType = device->getEngineType();
+    bool batchedFlushThresholdReached = false;
 
     if (submitCSR | submitTask) {
         if (this->dispatchMode == DispatchMode::ImmediateDispatch) {
@@ -352,6 +355,7 @@ CompletionStamp CommandStreamReceiverHw<GfxFamily>::flushTask(
             commandBuffer->flushStamp->replaceStampObject(dispatchFlags.flushStampReference);
             commandBuffer->pipeControlLocation = currentPipeControlForNooping;
             this->submissionAggregator->recordCommandBuffer(commandBuffer);
+            batchedFlushThresholdReached = this->trackBatchedCommandBuffer(batchBuffer.usedSize - batchBuffer.startOffset, dispatchFlags.batchedFlushThresholds);
         }
     } else {
         this->makeSurfacePackNonResident(nullptr);
@@ -365,6 +369,9 @@ CompletionStamp CommandStreamReceiverHw<GfxFamily>::flushTask(
     }
 
     if (this->dispatchMode == DispatchMode::BatchedDispatch && (dispatchFlags.blocking || dispatchFlags.implicitFlush)) {
+        this->batchedFlushReason = BatchedFlushReason::IMPLICIT;
+        this->flushBatchedSubmissions();
+    } else if (batchedFlushThresholdReached) {
         this->flushBatchedSubmissions();
     }
 
@@ -393,8 +400,12 @@ inline void CommandStreamReceiverHw<GfxFamily>::flushBatchedSubmissions() {
     TakeOwnershipWrapper<Device> deviceOwnership(*device);
     EngineType engineType = device->getEngineType();
 
+    auto flushReason = this->batchedFlushReason;
+    this->batchedFlushReason = BatchedFlushReason::EXPLICIT;
+
     auto &commandBufferList = this->submissionAggregator->peekCmdBufferList();
     if (!commandBufferList.peekIsEmpty()) {
+        this->batchedFlushCounts[static_cast<size_t>(flushReason)]++;
         ResidencyContainer surfacesForSubmit;
         ResourcePackage resourcePackage;
         auto pipeControlLocationSize = getRequiredPipeControlSize();
@@ -448,6 +459,7 @@ inline void CommandStreamReceiverHw<GfxFamily>::flushBatchedSubmissions() {
             resourcePackage.clear();
         }
         this->totalMemoryUsed = 0;
+        this->resetBatchedCommandBufferTracking();
     }
 }
 
@@ -520,12 +532,24 @@ inline void CommandStreamReceiverHw<GfxFamily>::emitNoop(LinearStream &commandSt
 }
 
 template <typename GfxFamily>
-inline void CommandStreamReceiverHw<GfxFamily>::waitForTaskCountWithKmdNotifyFallback(uint32_t taskCountToWait, FlushStamp flushStampToWait) {
-    auto status = waitForCompletionWithTimeout(this->hwInfo.capabilityTable.enableKmdNotify, this->hwInfo.capabilityTable.delayKmdNotifyMs, taskCountToWait);
+inline void CommandStreamReceiverHw<GfxFamily>::waitForTaskCountWithKmdNotifyFallback(uint32_t taskCountToWait, FlushStamp flushStampToWait, QueueThrottle throttle) {
+    bool enableKmdNotify = this->hwInfo.capabilityTable.enableKmdNotify;
+    int64_t delayKmdNotifyMs = this->hwInfo.capabilityTable.delayKmdNotifyMs;
+    if (throttle == QueueThrottle::LOW) {
+        enableKmdNotify = true;
+        delayKmdNotifyMs = 0;
+    } else if (throttle == QueueThrottle::HIGH) {
+        enableKmdNotify = false;
+    }
+
+    auto status = waitForCompletionWithTimeout(enableKmdNotify, delayKmdNotifyMs, taskCountToWait);
     if (!status) {
+        auto kmdWaitStart = std::chrono::high_resolution_clock::now();
         waitForFlushStamp(flushStampToWait);
+        this->kmdWaitCount++;
+        this->kmdWaitTimeUs += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - kmdWaitStart).count();
         //now call blocking wait, this is to ensure that task count is reached
-        waitForCompletionWithTimeout(false, this->hwInfo.capabilityTable.delayKmdNotifyMs, taskCountToWait);
+        waitForCompletionWithTimeout(false, delayKmdNotifyMs, taskCountToWait);
     }
 
     UNRECOVERABLE_IF(*getTagAddress() < taskCountToWait);
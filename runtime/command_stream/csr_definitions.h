@@ -42,6 +42,28 @@ namespace TimeoutControls {
 constexpr int64_t maxTimeout = std::numeric_limits<int64_t>::max();
 }
 
+// cl_khr_throttle_hints, selects how completion is waited for
+enum class QueueThrottle {
+    LOW,    // hand the wait over to the kernel as soon as possible
+    MEDIUM, // device defaults
+    HIGH    // keep polling for lowest latency
+};
+
+// limits after which command buffers aggregated in batched dispatch mode are submitted, 0 means no limit
+struct BatchedFlushThresholds {
+    uint32_t commandBuffers = 0; // number of pending command buffers
+    size_t bytes = 0;            // total size of pending command buffers
+    int64_t ageUs = 0;           // time the oldest pending command buffer waits for submission
+};
+
+enum class BatchedFlushReason {
+    EXPLICIT,       // clFlush, clFinish, waits and other explicit requests
+    IMPLICIT,       // blocking or implicitly flushed task, memory budget exhausted
+    COMMAND_BUFFERS,
+    BYTES,
+    AGE
+};
+
 struct DispatchFlags {
     bool blocking = false;
     bool dcFlush = false;
@@ -55,6 +77,7 @@ struct DispatchFlags {
     bool outOfOrderExecutionAllowed = false;
     FlushStampTrackingObj *flushStampReference = nullptr;
     PreemptionMode preemptionMode = PreemptionMode::Disabled;
+    BatchedFlushThresholds batchedFlushThresholds;
 };
 
 struct CsrSizeRequestFlags {
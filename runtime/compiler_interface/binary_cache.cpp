@@ -27,21 +27,39 @@
 #include <runtime/helpers/file_io.h>
 #include <runtime/helpers/hash.h>
 #include <runtime/helpers/hw_info.h>
+#include <runtime/os_interface/debug_settings_manager.h>
+#include <runtime/helpers/string.h>
 #include <runtime/os_interface/os_inc.h>
+#include <runtime/os_interface/os_mapped_file.h>
 #include <runtime/program/program.h>
 
 #include <cstring>
+#include <functional>
 #include <string>
 #include <sstream>
 #include <iomanip>
 #include <mutex>
+#include <vector>
 
 namespace OCLRT {
-std::mutex BinaryCache::cacheAccessMtx;
+std::mutex BinaryCache::entryLocks[BinaryCache::entryLocksCount];
+
+BinaryCache::BinaryCache() = default;
+
+BinaryCacheIndex *BinaryCache::getIndex() {
+    std::call_once(indexCreated, [this]() {
+        uint64_t sizeLimit = defaultSizeLimit;
+        if (DebugManager.flags.BinaryCacheSizeLimitMB.get() != -1) {
+            sizeLimit = static_cast<uint64_t>(DebugManager.flags.BinaryCacheSizeLimitMB.get()) * MemoryConstants::megaByte;
+        }
+        index.reset(new BinaryCacheIndex(CL_CACHE_LOCATION, sizeLimit));
+    });
+    return index.get();
+}
 
 const std::string BinaryCache::getCachedFileName(const HardwareInfo &hwInfo, const ArrayRef<const char> input,
                                                  const ArrayRef<const char> options, const ArrayRef<const char> internalOptions) {
-    Hash hash;
+    Hash128 hash;
 
     hash.update("----", 4);
     hash.update(&*input.begin(), input.size());
@@ -60,45 +78,85 @@ const std::string BinaryCache::getCachedFileName(const HardwareInfo &hwInfo, con
     auto res = hash.finish();
     std::stringstream stream;
     stream << std::setfill('0')
-           << std::setw(sizeof(res) * 2)
            << std::hex
-           << res;
+           << std::setw(sizeof(res.hi) * 2)
+           << res.hi
+           << std::setw(sizeof(res.lo) * 2)
+           << res.lo;
     return stream.str();
 }
 
-bool BinaryCache::cacheBinary(const std::string kernelFileHash, const char *pBinary, uint32_t binarySize) {
-    if (pBinary == nullptr || binarySize == 0) {
-        return false;
-    }
+std::string BinaryCache::getCacheFilePath(const std::string &fileName) {
+    std::string filePath = CL_CACHE_LOCATION;
+    filePath.append(Os::fileSeparator);
+    filePath.append(fileName);
+    return filePath;
+}
 
-    std::string hashFilePath = CL_CACHE_LOCATION;
-    hashFilePath.append(Os::fileSeparator);
-    hashFilePath.append(kernelFileHash + ".cl_cache");
+std::mutex &BinaryCache::getEntryLock(const std::string &fileName) {
+    return entryLocks[std::hash<std::string>()(fileName) % entryLocksCount];
+}
 
-    std::lock_guard<std::mutex> lock(cacheAccessMtx);
-    if (writeDataToFile(
-            hashFilePath.c_str(),
-            pBinary,
-            binarySize) == 0) {
-        return false;
+bool BinaryCache::storeCacheFile(const std::string &fileName, const void *pData, size_t dataSize) {
+    {
+        std::lock_guard<std::mutex> lock(getEntryLock(fileName));
+        if (BinaryCacheIndex::publishFile(getCacheFilePath(fileName), pData, dataSize) == false) {
+            return false;
+        }
     }
 
+    getIndex()->insert(fileName, dataSize);
     return true;
 }
 
-bool BinaryCache::loadCachedBinary(const std::string kernelFileHash, Program &program) {
-    void *pBinary = nullptr;
-    size_t binarySize = 0;
+OsMappedFile *BinaryCache::mapCacheFile(const std::string &fileName) {
+    OsMappedFile *mappedFile = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(getEntryLock(fileName));
+        mappedFile = OsMappedFile::open(getCacheFilePath(fileName));
+    }
 
-    std::string hashFilePath = CL_CACHE_LOCATION;
-    hashFilePath.append(Os::fileSeparator);
-    hashFilePath.append(kernelFileHash + ".cl_cache");
+    if (mappedFile != nullptr) {
+        getIndex()->touch(fileName);
+    }
+    return mappedFile;
+}
 
+size_t BinaryCache::loadCacheFile(const std::string &fileName, void *&pData) {
+    size_t dataSize = 0;
     {
-        std::lock_guard<std::mutex> lock(cacheAccessMtx);
-        binarySize = loadDataFromFile(hashFilePath.c_str(), pBinary);
+        std::lock_guard<std::mutex> lock(getEntryLock(fileName));
+        dataSize = loadDataFromFile(getCacheFilePath(fileName).c_str(), pData);
     }
 
+    if ((pData != nullptr) && (dataSize != 0)) {
+        getIndex()->touch(fileName);
+    }
+    return dataSize;
+}
+
+bool BinaryCache::cacheBinary(const std::string kernelFileHash, const char *pBinary, uint32_t binarySize) {
+    if (pBinary == nullptr || binarySize == 0) {
+        return false;
+    }
+
+    return storeCacheFile(kernelFileHash + ".cl_cache", pBinary, binarySize);
+}
+
+bool BinaryCache::loadCachedBinary(const std::string kernelFileHash, Program &program) {
+    if (DebugManager.flags.EnableMappedBinaryCache.get()) {
+        std::unique_ptr<OsMappedFile> mappedFile(mapCacheFile(kernelFileHash + ".cl_cache"));
+        if (mappedFile == nullptr) {
+            return false;
+        }
+        auto binarySize = mappedFile->getSize();
+        program.storeGenBinary(std::move(mappedFile), 0, binarySize);
+        return true;
+    }
+
+    void *pBinary = nullptr;
+    size_t binarySize = loadCacheFile(kernelFileHash + ".cl_cache", pBinary);
+
     if ((pBinary == nullptr) || (binarySize == 0)) {
         deleteDataReadFromFile(pBinary);
         return false;
@@ -110,4 +168,117 @@ bool BinaryCache::loadCachedBinary(const std::string kernelFileHash, Program &pr
     return true;
 }
 
+bool BinaryCache::isSourceCacheable(ArrayRef<const char> source, ArrayRef<const char> options) {
+    static const char includeDirective[] = "include";
+    static const size_t includeDirectiveLength = sizeof(includeDirective) - 1;
+
+    for (size_t i = 0; i < source.size(); i++) {
+        if (source[i] != '#') {
+            continue;
+        }
+        size_t pos = i + 1;
+        while (pos < source.size() && (source[pos] == ' ' || source[pos] == '\t')) {
+            pos++;
+        }
+        if ((source.size() - pos >= includeDirectiveLength) && (strncmp(&source[pos], includeDirective, includeDirectiveLength) == 0)) {
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i + 1 < options.size(); i++) {
+        if (options[i] == '-' && options[i + 1] == 'I') {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BinaryCache::cacheSourceBinary(const std::string sourceFileHash, const Program &program) {
+    size_t genBinarySize = 0;
+    size_t llvmBinarySize = 0;
+    size_t debugDataSize = 0;
+    auto pGenBinary = program.getGenBinary(genBinarySize);
+    auto pLlvmBinary = program.getLlvmBinary(llvmBinarySize);
+    auto pDebugData = program.getDebugData(debugDataSize);
+
+    if (pGenBinary == nullptr || genBinarySize == 0 || pLlvmBinary == nullptr || llvmBinarySize == 0) {
+        return false;
+    }
+
+    SourceCacheHeader header = {};
+    header.headerMagic = SourceCacheHeader::magic;
+    header.headerVersion = SourceCacheHeader::version;
+    header.genBinarySize = static_cast<uint32_t>(genBinarySize);
+    header.llvmBinarySize = static_cast<uint32_t>(llvmBinarySize);
+    header.debugDataSize = (pDebugData != nullptr) ? static_cast<uint32_t>(debugDataSize) : 0u;
+
+    std::vector<char> entry(sizeof(header) + header.genBinarySize + header.llvmBinarySize + header.debugDataSize);
+    auto pDst = entry.data();
+    memcpy_s(pDst, sizeof(header), &header, sizeof(header));
+    pDst += sizeof(header);
+    memcpy_s(pDst, header.genBinarySize, pGenBinary, header.genBinarySize);
+    pDst += header.genBinarySize;
+    memcpy_s(pDst, header.llvmBinarySize, pLlvmBinary, header.llvmBinarySize);
+    pDst += header.llvmBinarySize;
+    if (header.debugDataSize != 0) {
+        memcpy_s(pDst, header.debugDataSize, pDebugData, header.debugDataSize);
+    }
+
+    return storeCacheFile(sourceFileHash + ".cl_src_cache", entry.data(), entry.size());
+}
+
+bool BinaryCache::validateSourceCacheEntry(const void *pEntry, size_t entrySize, SourceCacheHeader &header) {
+    if ((pEntry == nullptr) || (entrySize < sizeof(SourceCacheHeader))) {
+        return false;
+    }
+
+    memcpy_s(&header, sizeof(header), pEntry, sizeof(header));
+    size_t expectedSize = sizeof(header) + static_cast<size_t>(header.genBinarySize) + header.llvmBinarySize + header.debugDataSize;
+    return (header.headerMagic == SourceCacheHeader::magic) &&
+           (header.headerVersion == SourceCacheHeader::version) &&
+           (header.genBinarySize != 0) && (header.llvmBinarySize != 0) &&
+           (expectedSize == entrySize);
+}
+
+bool BinaryCache::loadCachedSourceBinary(const std::string sourceFileHash, Program &program) {
+    SourceCacheHeader header;
+
+    if (DebugManager.flags.EnableMappedBinaryCache.get()) {
+        std::unique_ptr<OsMappedFile> mappedFile(mapCacheFile(sourceFileHash + ".cl_src_cache"));
+        if ((mappedFile == nullptr) || !validateSourceCacheEntry(mappedFile->getData(), mappedFile->getSize(), header)) {
+            return false;
+        }
+
+        auto pSrc = reinterpret_cast<const char *>(mappedFile->getData()) + sizeof(header) + header.genBinarySize;
+        program.storeLlvmBinary(pSrc, header.llvmBinarySize);
+        pSrc += header.llvmBinarySize;
+        if (header.debugDataSize != 0) {
+            program.storeDebugData(pSrc, header.debugDataSize);
+        }
+        program.storeGenBinary(std::move(mappedFile), sizeof(header), header.genBinarySize);
+        return true;
+    }
+
+    void *pEntry = nullptr;
+    size_t entrySize = loadCacheFile(sourceFileHash + ".cl_src_cache", pEntry);
+
+    if (!validateSourceCacheEntry(pEntry, entrySize, header)) {
+        deleteDataReadFromFile(pEntry);
+        return false;
+    }
+
+    auto pSrc = reinterpret_cast<const char *>(pEntry) + sizeof(header);
+    program.storeGenBinary(pSrc, header.genBinarySize);
+    pSrc += header.genBinarySize;
+    program.storeLlvmBinary(pSrc, header.llvmBinarySize);
+    pSrc += header.llvmBinarySize;
+    if (header.debugDataSize != 0) {
+        program.storeDebugData(pSrc, header.debugDataSize);
+    }
+
+    deleteDataReadFromFile(pEntry);
+
+    return true;
+}
+
 } // namesapce OCLRT
@@ -24,27 +24,69 @@
 
 #include <cstdint>
 #include <cstring>
+#include <memory>
 #include <string>
 #include <mutex>
 
+#include "runtime/compiler_interface/binary_cache_index.h"
+#include "runtime/memory_manager/memory_constants.h"
 #include "runtime/utilities/arrayref.h"
 
 namespace OCLRT {
 
 struct HardwareInfo;
+class OsMappedFile;
 class Program;
 class BinaryCache {
   public:
     const std::string getCachedFileName(const HardwareInfo &hwInfo, ArrayRef<const char> input,
                                         ArrayRef<const char> options, ArrayRef<const char> internalOptions);
 
+    static const uint64_t defaultSizeLimit = MemoryConstants::gigaByte;
+
+    BinaryCache();
     virtual ~BinaryCache(){};
 
     virtual bool cacheBinary(const std::string kernelFileHash, const char *pBinary, uint32_t binarySize);
     virtual bool loadCachedBinary(const std::string kernelFileHash, Program &program);
 
+    // source-level tier - keyed on the high level source, holds both the gen and llvm binaries
+    // so that a hit does not require the frontend translation at all
+    virtual bool cacheSourceBinary(const std::string sourceFileHash, const Program &program);
+    virtual bool loadCachedSourceBinary(const std::string sourceFileHash, Program &program);
+    // the source-level key covers only the main source and options, so sources that may pull in
+    // headers (#include directives or -I search paths) cannot be served from that tier
+    static bool isSourceCacheable(ArrayRef<const char> source, ArrayRef<const char> options);
+
+    struct SourceCacheHeader {
+        static const uint32_t magic = 0x53434C43; // "CLCS"
+        static const uint32_t version = 1;
+
+        uint32_t headerMagic;
+        uint32_t headerVersion;
+        uint32_t genBinarySize;
+        uint32_t llvmBinarySize;
+        uint32_t debugDataSize;
+    };
+
+    // the index locks and scans the cache directory, so it is only created once the cache is used
+    BinaryCacheIndex *getIndex();
+
   protected:
-    static std::mutex cacheAccessMtx;
+    static std::string getCacheFilePath(const std::string &fileName);
+    static std::mutex &getEntryLock(const std::string &fileName);
+
+    bool storeCacheFile(const std::string &fileName, const void *pData, size_t dataSize);
+    size_t loadCacheFile(const std::string &fileName, void *&pData);
+    OsMappedFile *mapCacheFile(const std::string &fileName);
+
+    static bool validateSourceCacheEntry(const void *pEntry, size_t entrySize, SourceCacheHeader &header);
+
+    static const size_t entryLocksCount = 64;
+    static std::mutex entryLocks[entryLocksCount];
+
+    std::unique_ptr<BinaryCacheIndex> index;
+    std::once_flag indexCreated;
 };
 
 } // namesapce OCLRT
@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/compiler_interface/binary_cache_index.h"
+#include "runtime/helpers/file_io.h"
+#include "runtime/helpers/string.h"
+#include "runtime/os_interface/os_file_lock.h"
+#include "runtime/os_interface/os_inc.h"
+#include "runtime/utilities/directory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <random>
+#include <thread>
+
+namespace OCLRT {
+const char *BinaryCacheIndex::indexFileName = "cl_cache.idx";
+const char *BinaryCacheIndex::lockFileName = "cl_cache.lock";
+
+namespace {
+struct IndexHeader {
+    uint32_t indexMagic;
+    uint32_t indexVersion;
+    uint64_t entriesCount;
+};
+
+struct IndexEntryHeader {
+    uint64_t size;
+    uint64_t lastAccess;
+    uint32_t nameLength;
+};
+} // namespace
+
+BinaryCacheIndex::BinaryCacheIndex(const std::string &cacheDirectory, uint64_t sizeLimit, uint32_t saveBatchSize)
+    : cacheDirectory(cacheDirectory), sizeLimit(sizeLimit), saveBatchSize(saveBatchSize) {
+    std::unique_ptr<OsFileLock> fileLock(OsFileLock::lock(getFilePath(lockFileName)));
+    std::lock_guard<std::mutex> lock(indexMtx);
+    mergeFromDisk();
+    if (importUnindexedFiles()) {
+        evictAndSave("");
+    }
+}
+
+BinaryCacheIndex::~BinaryCacheIndex() {
+    flush();
+}
+
+std::string BinaryCacheIndex::getFilePath(const std::string &fileName) const {
+    std::string filePath = cacheDirectory;
+    filePath.append(Os::fileSeparator);
+    filePath.append(fileName);
+    return filePath;
+}
+
+std::vector<std::string> BinaryCacheIndex::insert(const std::string &fileName, uint64_t fileSize) {
+    std::lock_guard<std::mutex> lock(indexMtx);
+    // merge, evict and save must not interleave with other processes, or their entries
+    // get dropped from the index and their files are never evicted
+    std::unique_ptr<OsFileLock> fileLock(OsFileLock::lock(getFilePath(lockFileName)));
+    mergeFromDisk();
+
+    auto it = entries.find(fileName);
+    if (it != entries.end()) {
+        totalSize -= it->second.size;
+    }
+    entries[fileName] = {fileSize, ++accessClock};
+    totalSize += fileSize;
+    pendingInserts.insert(fileName);
+    pendingUpdates++;
+
+    bool overBudget = (sizeLimit != 0) && (totalSize > sizeLimit);
+    if ((pendingUpdates < saveBatchSize) && (overBudget == false)) {
+        return {};
+    }
+    return evictAndSave(fileName);
+}
+
+void BinaryCacheIndex::touch(const std::string &fileName) {
+    std::lock_guard<std::mutex> lock(indexMtx);
+    auto it = entries.find(fileName);
+    if (it != entries.end()) {
+        it->second.lastAccess = ++accessClock;
+        pendingUpdates++;
+    }
+}
+
+std::vector<std::string> BinaryCacheIndex::flush() {
+    std::lock_guard<std::mutex> lock(indexMtx);
+    if (pendingUpdates == 0) {
+        return {};
+    }
+    std::unique_ptr<OsFileLock> fileLock(OsFileLock::lock(getFilePath(lockFileName)));
+    mergeFromDisk();
+    return evictAndSave("");
+}
+
+std::vector<std::string> BinaryCacheIndex::evictAndSave(const std::string &fileToKeep) {
+    auto evicted = evict(fileToKeep);
+    saveToDisk();
+
+    pendingInserts.clear();
+    pendingUpdates = 0;
+    return evicted;
+}
+
+void BinaryCacheIndex::remove(const std::string &fileName) {
+    std::lock_guard<std::mutex> lock(indexMtx);
+    auto it = entries.find(fileName);
+    if (it != entries.end()) {
+        totalSize -= it->second.size;
+        entries.erase(it);
+    }
+    pendingInserts.erase(fileName);
+}
+
+uint64_t BinaryCacheIndex::getTotalSize() const {
+    std::lock_guard<std::mutex> lock(indexMtx);
+    return totalSize;
+}
+
+size_t BinaryCacheIndex::getEntriesCount() const {
+    std::lock_guard<std::mutex> lock(indexMtx);
+    return entries.size();
+}
+
+bool BinaryCacheIndex::contains(const std::string &fileName) const {
+    std::lock_guard<std::mutex> lock(indexMtx);
+    return entries.find(fileName) != entries.end();
+}
+
+std::vector<std::string> BinaryCacheIndex::evict(const std::string &fileToKeep) {
+    std::vector<std::string> evicted;
+    if ((sizeLimit == 0) || (totalSize <= sizeLimit)) {
+        return evicted;
+    }
+
+    std::vector<std::pair<uint64_t, std::string>> byAge;
+    byAge.reserve(entries.size());
+    for (auto &entry : entries) {
+        if (entry.first != fileToKeep) {
+            byAge.push_back({entry.second.lastAccess, entry.first});
+        }
+    }
+    std::sort(byAge.begin(), byAge.end());
+
+    for (auto &candidate : byAge) {
+        if (totalSize <= sizeLimit) {
+            break;
+        }
+        auto it = entries.find(candidate.second);
+        totalSize -= it->second.size;
+        entries.erase(it);
+        removeFile(candidate.second);
+        evicted.push_back(candidate.second);
+    }
+    return evicted;
+}
+
+void BinaryCacheIndex::removeFile(const std::string &fileName) {
+    std::remove(getFilePath(fileName).c_str());
+}
+
+void BinaryCacheIndex::mergeFromDisk() {
+    void *pData = nullptr;
+    size_t dataSize = loadDataFromFile(getFilePath(indexFileName).c_str(), pData);
+
+    std::unordered_map<std::string, Entry> diskEntries;
+    bool valid = (pData != nullptr) && deserialize(reinterpret_cast<const char *>(pData), dataSize, diskEntries);
+    deleteDataReadFromFile(pData);
+    if (valid == false) {
+        return;
+    }
+
+    // files evicted by other processes disappear from the on-disk index,
+    // files published by other processes appear in it
+    std::unordered_map<std::string, Entry> merged;
+    for (auto &diskEntry : diskEntries) {
+        auto entry = diskEntry.second;
+        auto it = entries.find(diskEntry.first);
+        if (it != entries.end()) {
+            entry.lastAccess = std::max(entry.lastAccess, it->second.lastAccess);
+        }
+        accessClock = std::max(accessClock, entry.lastAccess);
+        merged[diskEntry.first] = entry;
+    }
+    for (auto &fileName : pendingInserts) {
+        auto it = entries.find(fileName);
+        if ((it != entries.end()) && (merged.find(fileName) == merged.end())) {
+            merged[fileName] = it->second;
+        }
+    }
+
+    entries.swap(merged);
+    totalSize = 0;
+    for (auto &entry : entries) {
+        totalSize += entry.second.size;
+    }
+}
+
+bool BinaryCacheIndex::isCacheFileName(const std::string &fileName) {
+    static const std::string extensions[] = {".cl_cache", ".cl_src_cache"};
+    for (auto &extension : extensions) {
+        if ((fileName.size() > extension.size()) &&
+            (fileName.compare(fileName.size() - extension.size(), extension.size(), extension) == 0)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool BinaryCacheIndex::importUnindexedFiles() {
+    bool imported = false;
+    for (auto &filePath : Directory::getFiles(cacheDirectory)) {
+        auto fileName = filePath.substr(std::min(filePath.size(), cacheDirectory.size() + 1));
+        if (!isCacheFileName(fileName) || (entries.find(fileName) != entries.end())) {
+            continue;
+        }
+        // no recency is known for these, so they go first when the budget is exceeded
+        auto fileSize = static_cast<uint64_t>(getFileSize(filePath));
+        entries[fileName] = {fileSize, 0};
+        totalSize += fileSize;
+        pendingInserts.insert(fileName);
+        pendingUpdates++;
+        imported = true;
+    }
+    return imported;
+}
+
+bool BinaryCacheIndex::saveToDisk() const {
+    auto data = serialize(entries);
+    return publishFile(getFilePath(indexFileName), data.data(), data.size());
+}
+
+std::vector<char> BinaryCacheIndex::serialize(const std::unordered_map<std::string, Entry> &entries) {
+    size_t dataSize = sizeof(IndexHeader);
+    for (auto &entry : entries) {
+        dataSize += sizeof(IndexEntryHeader) + entry.first.size();
+    }
+
+    std::vector<char> data(dataSize);
+    auto pDst = data.data();
+
+    IndexHeader header = {magic, version, static_cast<uint64_t>(entries.size())};
+    memcpy_s(pDst, sizeof(header), &header, sizeof(header));
+    pDst += sizeof(header);
+
+    for (auto &entry : entries) {
+        IndexEntryHeader entryHeader = {entry.second.size, entry.second.lastAccess, static_cast<uint32_t>(entry.first.size())};
+        memcpy_s(pDst, sizeof(entryHeader), &entryHeader, sizeof(entryHeader));
+        pDst += sizeof(entryHeader);
+        memcpy_s(pDst, entryHeader.nameLength, entry.first.c_str(), entryHeader.nameLength);
+        pDst += entryHeader.nameLength;
+    }
+
+    return data;
+}
+
+bool BinaryCacheIndex::deserialize(const char *data, size_t dataSize, std::unordered_map<std::string, Entry> &entries) {
+    if (dataSize < sizeof(IndexHeader)) {
+        return false;
+    }
+
+    IndexHeader header;
+    memcpy_s(&header, sizeof(header), data, sizeof(header));
+    if ((header.indexMagic != magic) || (header.indexVersion != version)) {
+        return false;
+    }
+
+    size_t offset = sizeof(header);
+    for (uint64_t i = 0; i < header.entriesCount; i++) {
+        IndexEntryHeader entryHeader;
+        if (dataSize - offset < sizeof(entryHeader)) {
+            return false;
+        }
+        memcpy_s(&entryHeader, sizeof(entryHeader), data + offset, sizeof(entryHeader));
+        offset += sizeof(entryHeader);
+
+        if (dataSize - offset < entryHeader.nameLength) {
+            return false;
+        }
+        entries[std::string(data + offset, entryHeader.nameLength)] = {entryHeader.size, entryHeader.lastAccess};
+        offset += entryHeader.nameLength;
+    }
+
+    return offset == dataSize;
+}
+
+bool BinaryCacheIndex::publishFile(const std::string &filePath, const void *data, size_t dataSize) {
+    static const auto processTag = std::random_device{}();
+    static std::atomic<uint32_t> publishCounter{0};
+
+    std::string tmpFilePath = filePath;
+    tmpFilePath.append("." + std::to_string(processTag));
+    tmpFilePath.append("." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())));
+    tmpFilePath.append("." + std::to_string(publishCounter++));
+    tmpFilePath.append(".tmp");
+
+    if (writeDataToFile(tmpFilePath.c_str(), data, dataSize) != dataSize) {
+        std::remove(tmpFilePath.c_str());
+        return false;
+    }
+
+    if (std::rename(tmpFilePath.c_str(), filePath.c_str()) != 0) {
+        // rename does not replace existing files on all platforms
+        std::remove(filePath.c_str());
+        if (std::rename(tmpFilePath.c_str(), filePath.c_str()) != 0) {
+            std::remove(tmpFilePath.c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+} // namespace OCLRT
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace OCLRT {
+
+// Tracks size and recency of every file in the on-disk binary cache. The index is persisted
+// next to the cached files and used to evict least recently used entries once the configured
+// byte budget is exceeded. Merging with the on-disk copy, evicting and writing back all happen
+// under a file lock, so several processes may share one cache directory; saves are batched.
+// Cache files missing from the index, e.g. published before it existed or under an older
+// naming scheme, are imported as least recently used when the index is created.
+class BinaryCacheIndex {
+  public:
+    static const uint32_t magic = 0x49434C43; // "CLCI"
+    static const uint32_t version = 1;
+    static const char *indexFileName;
+    static const char *lockFileName;
+    static const uint32_t defaultSaveBatchSize = 16;
+
+    struct Entry {
+        uint64_t size;
+        uint64_t lastAccess;
+    };
+
+    BinaryCacheIndex(const std::string &cacheDirectory, uint64_t sizeLimit, uint32_t saveBatchSize = defaultSaveBatchSize);
+    ~BinaryCacheIndex();
+
+    // records a newly published file; once saveBatchSize updates are pending or the budget is
+    // exceeded, saves the index, evicting least recently used files, and returns the evicted file names
+    std::vector<std::string> insert(const std::string &fileName, uint64_t fileSize);
+
+    // marks file as most recently used, persisted together with the next save
+    void touch(const std::string &fileName);
+
+    // saves pending updates
+    std::vector<std::string> flush();
+
+    void remove(const std::string &fileName);
+
+    uint64_t getTotalSize() const;
+    uint64_t getSizeLimit() const { return sizeLimit; }
+    size_t getEntriesCount() const;
+    bool contains(const std::string &fileName) const;
+
+    static std::vector<char> serialize(const std::unordered_map<std::string, Entry> &entries);
+    static bool deserialize(const char *data, size_t dataSize, std::unordered_map<std::string, Entry> &entries);
+
+    // writes data to a temporary file and renames it over the destination, so readers never see partial files
+    static bool publishFile(const std::string &filePath, const void *data, size_t dataSize);
+
+  protected:
+    // callers hold indexMtx and the cache directory file lock
+    void mergeFromDisk();
+    bool importUnindexedFiles();
+    bool saveToDisk() const;
+    std::vector<std::string> evictAndSave(const std::string &fileToKeep);
+    std::vector<std::string> evict(const std::string &fileToKeep);
+    static bool isCacheFileName(const std::string &fileName);
+    void removeFile(const std::string &fileName);
+
+    std::string getFilePath(const std::string &fileName) const;
+
+    std::string cacheDirectory;
+    uint64_t sizeLimit;
+    uint64_t totalSize = 0;
+    uint64_t accessClock = 0;
+    uint32_t saveBatchSize;
+    uint32_t pendingUpdates = 0;
+    std::unordered_map<std::string, Entry> entries;
+    // inserted since the last save, kept when missing from the on-disk index
+    std::unordered_set<std::string> pendingInserts;
+    mutable std::mutex indexMtx;
+};
+} // namespace OCLRT
@@ -74,6 +74,18 @@ cl_int CompilerInterface::build(
         const auto &device = program.getDevice(i);
         UNRECOVERABLE_IF(intermediateCodeType == IGC::CodeType::undefined);
 
+        std::string sourceFileHash;
+        if (enableCaching && (highLevelCodeType != IGC::CodeType::undefined) &&
+            BinaryCache::isSourceCacheable(ArrayRef<const char>(inputArgs.pInput, inputArgs.InputSize),
+                                           ArrayRef<const char>(inputArgs.pOptions, inputArgs.OptionsSize))) {
+            sourceFileHash = cache->getCachedFileName(device.getHardwareInfo(), ArrayRef<const char>(inputArgs.pInput, inputArgs.InputSize),
+                                                      ArrayRef<const char>(inputArgs.pOptions, inputArgs.OptionsSize),
+                                                      ArrayRef<const char>(inputArgs.pInternalOptions, inputArgs.InternalOptionsSize));
+            if (cache->loadCachedSourceBinary(sourceFileHash, program)) {
+                continue;
+            }
+        }
+
         auto inSrc = CIF::Builtins::CreateConstBuffer(fclMain.get(), inputArgs.pInput, inputArgs.InputSize);
         auto fclOptions = CIF::Builtins::CreateConstBuffer(fclMain.get(), inputArgs.pOptions, inputArgs.OptionsSize);
         auto fclInternalOptions = CIF::Builtins::CreateConstBuffer(fclMain.get(), inputArgs.pInternalOptions, inputArgs.InternalOptionsSize);
@@ -136,6 +148,10 @@ cl_int CompilerInterface::build(
                 program.storeDebugData(igcOutput->GetDebugData()->GetMemory<char>(), igcOutput->GetDebugData()->GetSizeRaw());
             }
         }
+
+        if (sourceFileHash.empty() == false) {
+            cache->cacheSourceBinary(sourceFileHash, program);
+        }
     }
 
     return CL_SUCCESS;
@@ -334,14 +350,10 @@ BinaryCache *CompilerInterface::replaceBinaryCache(BinaryCache *newCache) {
 }
 
 CIF::RAII::UPtr_t<IGC::FclOclTranslationCtxTagOCL> CompilerInterface::createFclTranslationCtx(const Device &device, IGC::CodeType::CodeType_t inType, IGC::CodeType::CodeType_t outType) {
-    auto it = fclDeviceContexts.find(&device);
-    if (it != fclDeviceContexts.end()) {
-        return it->second->CreateTranslationCtx(inType, outType);
-    }
-
     {
+        // programs may be built concurrently (async clBuildProgram), so contexts map is accessed only under lock
         auto ulock = this->lock();
-        it = fclDeviceContexts.find(&device);
+        auto it = fclDeviceContexts.find(&device);
         if (it != fclDeviceContexts.end()) {
             return it->second->CreateTranslationCtx(inType, outType);
         }
@@ -368,14 +380,10 @@ CIF::RAII::UPtr_t<IGC::FclOclTranslationCtxTagOCL> CompilerInterface::createFclT
 }
 
 CIF::RAII::UPtr_t<IGC::IgcOclTranslationCtxTagOCL> CompilerInterface::createIgcTranslationCtx(const Device &device, IGC::CodeType::CodeType_t inType, IGC::CodeType::CodeType_t outType) {
-    auto it = igcDeviceContexts.find(&device);
-    if (it != igcDeviceContexts.end()) {
-        return it->second->CreateTranslationCtx(inType, outType);
-    }
-
     {
+        // programs may be built concurrently (async clBuildProgram), so contexts map is accessed only under lock
         auto ulock = this->lock();
-        it = igcDeviceContexts.find(&device);
+        auto it = igcDeviceContexts.find(&device);
         if (it != igcDeviceContexts.end()) {
             return it->second->CreateTranslationCtx(inType, outType);
         }
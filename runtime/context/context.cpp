@@ -24,6 +24,7 @@
 #include "runtime/helpers/surface_formats.h"
 #include "runtime/device/device.h"
 #include "runtime/device_queue/device_queue.h"
+#include "runtime/mem_obj/buffer_pool_allocator.h"
 #include "runtime/mem_obj/image.h"
 #include "runtime/helpers/get_info.h"
 #include "runtime/helpers/ptr_math.h"
@@ -35,6 +36,7 @@
 #include "runtime/memory_manager/svm_memory_manager.h"
 #include "runtime/memory_manager/deferred_deleter.h"
 #include "runtime/memory_manager/memory_manager.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/sharings/sharing_factory.h"
 #include "runtime/sharings/sharing.h"
 #include <algorithm>
@@ -58,6 +60,7 @@ Context::Context(
 }
 
 Context::~Context() {
+    bufferPoolAllocator.reset();
     delete[] properties;
     if (specialQueue) {
         delete specialQueue;
@@ -165,6 +168,7 @@ bool Context::createImpl(const cl_context_properties *properties,
         if (memoryManager->isAsyncDeleterEnabled()) {
             memoryManager->getDeferredDeleter()->addClient();
         }
+        initBufferPoolAllocator();
     }
 
     auto commandQueue = CommandQueue::create(this, devices[0], nullptr, errcodeRet);
@@ -174,6 +178,14 @@ bool Context::createImpl(const cl_context_properties *properties,
     return true;
 }
 
+void Context::initBufferPoolAllocator() {
+    if (DebugManager.flags.SmallBufferPoolMaxSizeKB.get() > 0) {
+        auto maxBufferSize = static_cast<size_t>(DebugManager.flags.SmallBufferPoolMaxSizeKB.get()) * KB;
+        auto slotAlignment = getDevice(0)->getDeviceInfo().memBaseAddressAlign / 8;
+        bufferPoolAllocator.reset(new BufferPoolAllocator(this, BufferPoolAllocator::defaultPoolSize, maxBufferSize, slotAlignment));
+    }
+}
+
 cl_int Context::getInfo(cl_context_info paramName, size_t paramValueSize,
                         void *paramValue, size_t *paramValueSizeRet) {
     cl_int retVal;
@@ -24,10 +24,12 @@
 #include "runtime/device/device_vector.h"
 #include "runtime/event/event.h"
 #include "runtime/context/driver_diagnostics.h"
+#include <memory>
 #include <vector>
 
 namespace OCLRT {
 
+class BufferPoolAllocator;
 class Device;
 class DeviceQueue;
 class MemoryManager;
@@ -87,6 +89,10 @@ class Context : public BaseObject<_cl_context> {
         return svmAllocsManager;
     }
 
+    BufferPoolAllocator *getBufferPoolAllocator() const {
+        return bufferPoolAllocator.get();
+    }
+
     DeviceQueue *getDefaultDeviceQueue();
     void setDefaultDeviceQueue(DeviceQueue *queue);
 
@@ -125,6 +131,7 @@ class Context : public BaseObject<_cl_context> {
     // OS specific implementation
     cl_int createContextOsProperties(cl_context_properties &propertyType, cl_context_properties &propertyValue);
     void *getOsContextInfo(cl_context_info &paramName, size_t *srcParamSize);
+    void initBufferPoolAllocator();
 
     const cl_context_properties *properties;
     size_t numProperties;
@@ -134,6 +141,7 @@ class Context : public BaseObject<_cl_context> {
     DeviceVector devices;
     MemoryManager *memoryManager;
     SVMAllocsManager *svmAllocsManager = nullptr;
+    std::unique_ptr<BufferPoolAllocator> bufferPoolAllocator;
     CommandQueue *specialQueue;
     DeviceQueue *defaultDeviceQueue;
     std::vector<std::unique_ptr<SharingFunctions>> sharingFunctions;
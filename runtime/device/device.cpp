@@ -86,6 +86,9 @@ Device::~Device() {
     if (performanceCounters) {
         performanceCounters->shutdown();
     }
+    if (commandStreamReceiver) {
+        commandStreamReceiver->closeBatchedSubmissionFlusher();
+    }
     delete commandStreamReceiver;
     commandStreamReceiver = nullptr;
     if (memoryManager) {
@@ -374,9 +374,15 @@ void Event::unblockEventsBlockedByThis(int32_t transitionStatus) {
 
         childEvent->unblockEventBy(*this, taskLevelToPropagate, transitionStatus);
 
-        if (childEvent->getCommandQueue() && childEvent->isCurrentCmdQVirtualEvent()) {
+        auto childQueue = childEvent->getCommandQueue();
+        if (childQueue && childEvent->isCurrentCmdQVirtualEvent()) {
             // Check virtual event state and delete it if possible.
-            childEvent->getCommandQueue()->isQueueBlocked();
+            // Queues are locked before the device, so skip the cleanup if another thread is enqueueing;
+            // it will release the virtual event itself.
+            if (childQueue->takeOwnership(false)) {
+                childQueue->isQueueBlocked();
+                childQueue->releaseOwnership();
+            }
         }
 
         childEvent->decRefInternal();
@@ -23,6 +23,7 @@
 #pragma once
 #include "runtime/helpers/aligned_memory.h"
 #include <cstdint>
+#include <cstring>
 
 namespace OCLRT {
 // clang-format off
@@ -118,4 +119,168 @@ class Hash {
   protected:
     uint32_t a, hi, lo;
 };
+
+struct Hash128Value {
+    uint64_t hi;
+    uint64_t lo;
+
+    bool operator==(const Hash128Value &other) const {
+        return (hi == other.hi) && (lo == other.lo);
+    }
+    bool operator!=(const Hash128Value &other) const {
+        return !(*this == other);
+    }
+};
+
+// Streaming 128-bit hash processing input in 32-byte stripes over four independent
+// 64-bit multiply-rotate lanes (xxHash64 style), which keeps the lanes out of each
+// other's dependency chains. The 256-bit lane state is folded twice with different
+// orderings to produce the two halves of the result.
+class Hash128 {
+  public:
+    static const size_t stripeSize = 32;
+
+    Hash128() {
+        reset();
+    };
+
+    void update(const char *buff, size_t size) {
+        if (buff == nullptr)
+            return;
+
+        totalSize += size;
+
+        if (pendingSize > 0) {
+            size_t toCopy = stripeSize - pendingSize;
+            if (toCopy > size) {
+                toCopy = size;
+            }
+            memcpy(pending + pendingSize, buff, toCopy);
+            pendingSize += toCopy;
+            buff += toCopy;
+            size -= toCopy;
+            if (pendingSize < stripeSize) {
+                return;
+            }
+            processStripe(pending);
+            pendingSize = 0;
+        }
+
+        while (size >= stripeSize) {
+            processStripe(buff);
+            buff += stripeSize;
+            size -= stripeSize;
+        }
+
+        if (size > 0) {
+            memcpy(pending, buff, size);
+            pendingSize = size;
+        }
+    }
+
+    Hash128Value finish() {
+        Hash128Value value;
+        uint64_t lo = 0;
+        uint64_t hi = 0;
+        if (totalSize >= stripeSize) {
+            lo = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18);
+            hi = rotl(lanes[3], 1) + rotl(lanes[2], 7) + rotl(lanes[1], 12) + rotl(lanes[0], 18);
+            for (auto lane : lanes) {
+                lo = mergeLane(lo, lane);
+            }
+            for (auto lane = 4; lane > 0; lane--) {
+                hi = mergeLane(hi, lanes[lane - 1]);
+            }
+        } else {
+            lo = lanes[2] + prime5;
+            hi = lanes[2] + prime4;
+        }
+        lo += totalSize;
+        hi ^= totalSize * prime1;
+
+        size_t offset = 0;
+        for (; offset + sizeof(uint64_t) <= pendingSize; offset += sizeof(uint64_t)) {
+            auto k = round(0, read64(pending + offset));
+            lo ^= k;
+            lo = rotl(lo, 27) * prime1 + prime4;
+            hi += k;
+            hi = rotl(hi, 31) * prime2 + prime3;
+        }
+        for (; offset < pendingSize; offset++) {
+            uint64_t k = static_cast<unsigned char>(pending[offset]);
+            lo ^= k * prime5;
+            lo = rotl(lo, 11) * prime1;
+            hi += k * prime1;
+            hi = rotl(hi, 17) * prime5;
+        }
+
+        value.lo = avalanche(lo);
+        value.hi = avalanche(hi ^ value.lo);
+        return value;
+    }
+
+    void reset() {
+        lanes[0] = prime1 + prime2;
+        lanes[1] = prime2;
+        lanes[2] = 0;
+        lanes[3] = 0 - prime1;
+        totalSize = 0;
+        pendingSize = 0;
+    }
+
+    static Hash128Value hash(const char *buff, size_t size) {
+        Hash128 hash;
+        hash.update(buff, size);
+        return hash.finish();
+    }
+
+  protected:
+    static const uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+    static const uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+    static const uint64_t prime3 = 0x165667B19E3779F9ULL;
+    static const uint64_t prime4 = 0x85EBCA77C2B2AE63ULL;
+    static const uint64_t prime5 = 0x27D4EB2F165667C5ULL;
+
+    static uint64_t rotl(uint64_t value, unsigned int shift) {
+        return (value << shift) | (value >> (64 - shift));
+    }
+
+    static uint64_t read64(const char *data) {
+        uint64_t value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    static uint64_t round(uint64_t acc, uint64_t input) {
+        acc += input * prime2;
+        acc = rotl(acc, 31);
+        return acc * prime1;
+    }
+
+    static uint64_t mergeLane(uint64_t acc, uint64_t lane) {
+        acc ^= round(0, lane);
+        return acc * prime1 + prime4;
+    }
+
+    static uint64_t avalanche(uint64_t value) {
+        value ^= value >> 33;
+        value *= prime2;
+        value ^= value >> 29;
+        value *= prime3;
+        value ^= value >> 32;
+        return value;
+    }
+
+    void processStripe(const char *stripe) {
+        lanes[0] = round(lanes[0], read64(stripe));
+        lanes[1] = round(lanes[1], read64(stripe + 8));
+        lanes[2] = round(lanes[2], read64(stripe + 16));
+        lanes[3] = round(lanes[3], read64(stripe + 24));
+    }
+
+    uint64_t lanes[4];
+    uint64_t totalSize;
+    char pending[stripeSize];
+    size_t pendingSize;
+};
 }
@@ -49,6 +49,10 @@ struct KernelCommandsHelper : public PerThreadDataHelper {
         IndirectHeap &indirectHeap,
         const KernelInfo &kernelInfo);
 
+    static size_t obtainKernelBinary(
+        IndirectHeap &indirectHeap,
+        const KernelInfo &kernelInfo);
+
     static size_t sendInterfaceDescriptorData(
         const IndirectHeap &indirectHeap,
         uint64_t offsetInterfaceDescriptor,
@@ -159,6 +159,20 @@ size_t KernelCommandsHelper<GfxFamily>::copyKernelBinary(
     return kernelStartOffset;
 }
 
+template <typename GfxFamily>
+size_t KernelCommandsHelper<GfxFamily>::obtainKernelBinary(
+    IndirectHeap &indirectHeap,
+    const KernelInfo &kernelInfo) {
+    size_t kernelStartOffset = 0;
+    if (indirectHeap.getKernelIsaOffset(kernelInfo.kernelIsaKey, kernelStartOffset)) {
+        return kernelStartOffset;
+    }
+
+    kernelStartOffset = copyKernelBinary(indirectHeap, kernelInfo);
+    indirectHeap.storeKernelIsaOffset(kernelInfo.kernelIsaKey, kernelStartOffset);
+    return kernelStartOffset;
+}
+
 template <typename GfxFamily>
 size_t KernelCommandsHelper<GfxFamily>::sendInterfaceDescriptorData(
     const IndirectHeap &indirectHeap,
@@ -334,8 +348,8 @@ size_t KernelCommandsHelper<GfxFamily>::sendIndirectState(
 
     DEBUG_BREAK_IF(simd != 8 && simd != 16 && simd != 32);
 
-    // Copy the kernel over to the ISH
-    auto kernelStartOffset = copyKernelBinary(ih, kernel.getKernelInfo());
+    // Copy the kernel over to the ISH, unless it is already there
+    auto kernelStartOffset = obtainKernelBinary(ih, kernel.getKernelInfo());
 
     const auto &kernelInfo = kernel.getKernelInfo();
     const auto &patchInfo = kernelInfo.patchInfo;
@@ -24,6 +24,7 @@
 #include "runtime/command_stream/linear_stream.h"
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/ptr_math.h"
+#include <unordered_map>
 
 namespace OCLRT {
 class GraphicsAllocation;
@@ -49,10 +50,37 @@ class IndirectHeap : public LinearStream {
     IndirectHeap &operator=(const IndirectHeap &) = delete;
 
     void align(size_t alignment);
+
+    void replaceBuffer(void *buffer, size_t bufferSize);
+
+    // Kernel ISA already copied to this heap can be referenced again, until the buffer is replaced
+    bool getKernelIsaOffset(uint64_t kernelIsaKey, size_t &offset) const;
+    void storeKernelIsaOffset(uint64_t kernelIsaKey, size_t offset);
+
+  protected:
+    std::unordered_map<uint64_t, size_t> kernelIsaOffsets;
 };
 
 inline void IndirectHeap::align(size_t alignment) {
     auto address = alignUp(ptrOffset(buffer, sizeUsed), alignment);
     sizeUsed = ptrDiff(address, buffer);
 }
+
+inline void IndirectHeap::replaceBuffer(void *buffer, size_t bufferSize) {
+    BaseClass::replaceBuffer(buffer, bufferSize);
+    kernelIsaOffsets.clear();
+}
+
+inline bool IndirectHeap::getKernelIsaOffset(uint64_t kernelIsaKey, size_t &offset) const {
+    auto it = kernelIsaOffsets.find(kernelIsaKey);
+    if (it == kernelIsaOffsets.end()) {
+        return false;
+    }
+    offset = it->second;
+    return true;
+}
+
+inline void IndirectHeap::storeKernelIsaOffset(uint64_t kernelIsaKey, size_t offset) {
+    kernelIsaOffsets[kernelIsaKey] = offset;
+}
 }
@@ -690,6 +690,7 @@ void Kernel::substituteKernelHeap(void *newKernelHeap, size_t newKernelHeapSize)
     *pKernelHeap = newKernelHeap;
     SKernelBinaryHeaderCommon *pHeader = const_cast<SKernelBinaryHeaderCommon *>(pKernelInfo->heapInfo.pKernelHeader);
     pHeader->KernelHeapSize = static_cast<uint32_t>(newKernelHeapSize);
+    pKernelInfo->regenerateKernelIsaKey();
 }
 
 uint64_t Kernel::getKernelId() const {
@@ -24,6 +24,7 @@
 #include "runtime/context/context.h"
 #include "runtime/device/device.h"
 #include "runtime/mem_obj/buffer.h"
+#include "runtime/mem_obj/buffer_pool_allocator.h"
 #include "runtime/memory_manager/memory_manager.h"
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/hw_info.h"
@@ -63,7 +64,14 @@ Buffer::Buffer(Context *context,
 Buffer::Buffer() : MemObj(nullptr, CL_MEM_OBJECT_BUFFER, 0, 0, nullptr, nullptr, nullptr, false, false, false) {
 }
 
-Buffer::~Buffer() = default;
+Buffer::~Buffer() {
+    if (bufferPoolAllocator) {
+        // the parent allocation is owned by the pool, only the slot is given back
+        bufferPoolAllocator->free(poolParent, poolOffset, poolSlotSize);
+        graphicsAllocation = nullptr;
+        context->decRefInternal();
+    }
+}
 
 bool Buffer::isSubBuffer() {
     return this->associatedMemObject != nullptr;
@@ -111,6 +119,15 @@ Buffer *Buffer::create(Context *context,
         copyMemoryFromHostPtr = false;
         allocateMemory = false;
     }
+
+    auto bufferPoolAllocator = context->getBufferPoolAllocator();
+    if (errcodeRet == CL_SUCCESS && bufferPoolAllocator && !context->isSharedContext && bufferPoolAllocator->isSuitable(flags, size)) {
+        pBuffer = createPooledBuffer(context, flags, size, hostPtr, bufferPoolAllocator);
+        if (pBuffer) {
+            return pBuffer;
+        }
+    }
+
     if (errcodeRet == CL_SUCCESS) {
         while (true) {
             if (flags & CL_MEM_USE_HOST_PTR) {
@@ -174,6 +191,48 @@ Buffer *Buffer::create(Context *context,
     return pBuffer;
 }
 
+Buffer *Buffer::createPooledBuffer(Context *context,
+                                   cl_mem_flags flags,
+                                   size_t size,
+                                   void *hostPtr,
+                                   BufferPoolAllocator *allocator) {
+    size_t slotSize = size;
+    size_t slotOffset = 0;
+    auto parent = allocator->allocate(slotSize, slotOffset);
+    if (!parent) {
+        return nullptr;
+    }
+
+    auto memoryStorage = ptrOffset(parent->getCpuAddress(), slotOffset);
+    if (flags & CL_MEM_COPY_HOST_PTR) {
+        memcpy_s(memoryStorage, size, hostPtr, size);
+    }
+
+    auto pBuffer = createBufferHw(context,
+                                  flags,
+                                  size,
+                                  memoryStorage,
+                                  hostPtr,
+                                  parent->getGraphicsAllocation(),
+                                  true,
+                                  false,
+                                  false);
+    if (!pBuffer) {
+        allocator->free(parent, slotOffset, slotSize);
+        return nullptr;
+    }
+
+    DBG_LOG(LogMemoryObject, __FUNCTION__, "size:", size, "pool offset:", slotOffset, "memoryStorage:", memoryStorage);
+
+    pBuffer->bufferPoolAllocator = allocator;
+    pBuffer->poolParent = parent;
+    pBuffer->poolOffset = slotOffset;
+    pBuffer->poolSlotSize = slotSize;
+    // the pool lives in the context, keep it until the slot is released
+    context->incRefInternal();
+    return pBuffer;
+}
+
 Buffer *Buffer::createSharedBuffer(Context *context, cl_mem_flags flags, SharingHandler *sharingHandler,
                                    GraphicsAllocation *graphicsAllocation) {
     auto sharedBuffer = createBufferHw(context, flags, graphicsAllocation->getUnderlyingBufferSize(), nullptr, nullptr, graphicsAllocation, false, false, false);
@@ -245,6 +304,7 @@ Buffer *Buffer::createSubBuffer(cl_mem_flags flags,
 
     buffer->associatedMemObject = this;
     buffer->offset = region->origin;
+    buffer->poolOffset = this->poolOffset;
     buffer->setParentSharingHandler(this->getSharingHandler());
     this->incRefInternal();
 
@@ -253,8 +313,8 @@ Buffer *Buffer::createSubBuffer(cl_mem_flags flags,
 }
 
 void Buffer::setArgStateless(void *memory, uint32_t patchSize, bool set32BitAddressing) {
-    // Subbuffers have offset that graphicsAllocation is not aware of
-    uintptr_t addressToPatch = ((set32BitAddressing) ? static_cast<uintptr_t>(graphicsAllocation->getGpuAddressToPatch()) : static_cast<uintptr_t>(graphicsAllocation->getGpuAddress())) + this->offset;
+    // Subbuffers and pooled buffers have offset that graphicsAllocation is not aware of
+    uintptr_t addressToPatch = ((set32BitAddressing) ? static_cast<uintptr_t>(graphicsAllocation->getGpuAddressToPatch()) : static_cast<uintptr_t>(graphicsAllocation->getGpuAddress())) + getAllocationOffset();
     DEBUG_BREAK_IF(!(graphicsAllocation->isLocked() || (this->getCpuAddress() == reinterpret_cast<void *>(addressToPatch)) || (graphicsAllocation->gpuBaseAddress != 0) || (this->getCpuAddress() == nullptr && this->getGraphicsAllocation()->peekSharedHandle())));
 
     patchWithRequiredSize(memory, patchSize, addressToPatch);
@@ -28,6 +28,7 @@
 
 namespace OCLRT {
 class Buffer;
+class BufferPoolAllocator;
 class MemoryManager;
 
 typedef Buffer *(*BufferCreatFunc)(Context *context,
@@ -88,6 +89,9 @@ class Buffer : public MemObj {
 
     BufferCreatFunc createFunction = nullptr;
     bool isSubBuffer();
+    bool isPooledBuffer() const { return bufferPoolAllocator != nullptr; }
+    // offset of the buffer storage in its graphics allocation, covers both sub-buffer origin and pool slot
+    size_t getAllocationOffset() const { return offset + poolOffset; }
     bool isValidSubBufferOffset(size_t offset);
     void setArgStateless(void *memory, uint32_t patchSize, bool set32BitAddressing = false);
     virtual void setArgStateful(void *memory) = 0;
@@ -120,6 +124,12 @@ class Buffer : public MemObj {
 
     Buffer();
 
+    static Buffer *createPooledBuffer(Context *context,
+                                      cl_mem_flags flags,
+                                      size_t size,
+                                      void *hostPtr,
+                                      BufferPoolAllocator *allocator);
+
     static void checkMemory(cl_mem_flags flags,
                             size_t size,
                             void *hostPtr,
@@ -128,6 +138,11 @@ class Buffer : public MemObj {
                             bool &allocateMemory,
                             bool &copyMemoryFromHostPtr,
                             MemoryManager *memMngr);
+
+    BufferPoolAllocator *bufferPoolAllocator = nullptr;
+    Buffer *poolParent = nullptr;
+    size_t poolOffset = 0;
+    size_t poolSlotSize = 0;
 };
 
 template <typename GfxFamily>
@@ -54,7 +54,7 @@ void BufferHw<GfxFamily>::setArgStateful(void *memory) {
 
     // The graphics allocation for Host Ptr surface will be created in makeResident call and GPU address is expected to be the same as CPU address
     auto bufferAddress = (getGraphicsAllocation() != nullptr) ? getGraphicsAllocation()->getGpuAddress() : reinterpret_cast<uint64_t>(getHostPtr());
-    bufferAddress += this->offset;
+    bufferAddress += getAllocationOffset();
 
     auto bufferSize = (getGraphicsAllocation() != nullptr) ? getGraphicsAllocation()->getUnderlyingBufferSize() : getSize();
 
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/mem_obj/buffer_pool_allocator.h"
+#include "runtime/context/context.h"
+#include "runtime/device/device.h"
+#include "runtime/helpers/ptr_math.h"
+#include "runtime/mem_obj/buffer.h"
+#include "runtime/memory_manager/memory_manager.h"
+
+#include <algorithm>
+
+namespace OCLRT {
+
+const size_t BufferPoolAllocator::defaultPoolSize;
+
+BufferPoolAllocator::BufferPoolAllocator(Context *context, size_t poolSize, size_t maxBufferSize, size_t slotAlignment)
+    : context(context), memoryManager(context->getMemoryManager()), poolSize(poolSize),
+      maxBufferSize(std::min(maxBufferSize, poolSize / 2)), slotAlignment(slotAlignment) {
+}
+
+BufferPoolAllocator::~BufferPoolAllocator() {
+    for (auto &pool : pools) {
+        pool->parent->release();
+    }
+}
+
+Buffer *BufferPoolAllocator::allocate(size_t &size, size_t &offset) {
+    std::lock_guard<std::mutex> lock(mtx);
+    releaseCompletedSlots();
+
+    for (auto &pool : pools) {
+        auto ptr = allocateFromPool(*pool, size);
+        if (ptr) {
+            offset = ptrDiff(ptr, pool->parent->getCpuAddress());
+            return pool->parent;
+        }
+    }
+
+    cl_int retVal = CL_SUCCESS;
+    auto parent = Buffer::create(context, CL_MEM_READ_WRITE, poolSize, nullptr, retVal);
+    if (!parent) {
+        return nullptr;
+    }
+    pools.emplace_back(new BufferPool(parent, parent->getCpuAddress(), poolSize, slotAlignment));
+
+    auto ptr = allocateFromPool(*pools.back(), size);
+    DEBUG_BREAK_IF(ptr == nullptr);
+    offset = ptrDiff(ptr, parent->getCpuAddress());
+    return parent;
+}
+
+void BufferPoolAllocator::free(Buffer *parent, size_t offset, size_t size) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto pool = findPool(parent);
+    DEBUG_BREAK_IF(pool == nullptr);
+
+    auto ptr = ptrOffset(parent->getCpuAddress(), offset);
+    auto taskCount = parent->getGraphicsAllocation()->taskCount;
+    if (!isCompleted(taskCount)) {
+        // the parent allocation may still be in use by a submission that referenced this slot
+        pendingSlots.push_back({pool, ptr, size, taskCount});
+        return;
+    }
+    pool->heap.free(ptr, size);
+    pool->slotCount--;
+}
+
+void *BufferPoolAllocator::allocateFromPool(BufferPool &pool, size_t &size) {
+    if (pool.heap.getLeftSize() < size) {
+        return nullptr;
+    }
+    auto ptr = pool.heap.allocate(size);
+    if (ptr) {
+        pool.slotCount++;
+    }
+    return ptr;
+}
+
+void BufferPoolAllocator::releaseCompletedSlots() {
+    for (auto slot = pendingSlots.begin(); slot != pendingSlots.end();) {
+        if (isCompleted(slot->taskCount)) {
+            slot->pool->heap.free(slot->ptr, slot->size);
+            slot->pool->slotCount--;
+            slot = pendingSlots.erase(slot);
+        } else {
+            ++slot;
+        }
+    }
+}
+
+bool BufferPoolAllocator::isCompleted(uint32_t taskCount) const {
+    if (taskCount == ObjectNotUsed || memoryManager->device == nullptr) {
+        return true;
+    }
+    return *memoryManager->device->getTagAddress() >= taskCount;
+}
+
+BufferPool *BufferPoolAllocator::findPool(Buffer *parent) {
+    for (auto &pool : pools) {
+        if (pool->parent == parent) {
+            return pool.get();
+        }
+    }
+    return nullptr;
+}
+} // namespace OCLRT
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/api/cl_types.h"
+#include "runtime/helpers/basic_math.h"
+#include "runtime/utilities/heap_allocator.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace OCLRT {
+class Buffer;
+class Context;
+class MemoryManager;
+
+struct BufferPool {
+    BufferPool(Buffer *parent, void *address, size_t size, size_t alignment) : parent(parent), heap(address, size, size, alignment) {}
+
+    Buffer *parent;
+    HeapAllocator heap;
+    size_t slotCount = 0;
+};
+
+// Carves small buffers out of large parent buffers owned by the context, so they share one graphics
+// allocation the way sub-buffers share their parent's. Released slots are handed out again only after
+// the GPU completed the last submission using the parent allocation.
+class BufferPoolAllocator {
+  public:
+    static const size_t defaultPoolSize = 2 * MB;
+
+    BufferPoolAllocator(Context *context, size_t poolSize, size_t maxBufferSize, size_t slotAlignment);
+    ~BufferPoolAllocator();
+    BufferPoolAllocator(const BufferPoolAllocator &) = delete;
+    BufferPoolAllocator &operator=(const BufferPoolAllocator &) = delete;
+
+    bool isSuitable(cl_mem_flags flags, size_t size) const {
+        return size != 0 && size <= maxBufferSize && !(flags & CL_MEM_USE_HOST_PTR);
+    }
+
+    // returns the parent buffer and the slot offset in it, size is updated to the reserved slot size
+    Buffer *allocate(size_t &size, size_t &offset);
+    void free(Buffer *parent, size_t offset, size_t size);
+
+    size_t getPoolSize() const { return poolSize; }
+    size_t peekNumPools() const { return pools.size(); }
+    size_t peekNumPendingSlots() const { return pendingSlots.size(); }
+
+  protected:
+    struct PendingSlot {
+        BufferPool *pool;
+        void *ptr;
+        size_t size;
+        uint32_t taskCount;
+    };
+
+    void *allocateFromPool(BufferPool &pool, size_t &size);
+    void releaseCompletedSlots();
+    bool isCompleted(uint32_t taskCount) const;
+    BufferPool *findPool(Buffer *parent);
+
+    Context *context;
+    MemoryManager *memoryManager;
+    size_t poolSize;
+    size_t maxBufferSize;
+    size_t slotAlignment;
+    std::vector<std::unique_ptr<BufferPool>> pools;
+    std::vector<PendingSlot> pendingSlots;
+    std::mutex mtx;
+};
+} // namespace OCLRT
@@ -183,6 +183,7 @@ Image *Image::create(Context *context,
         bool transferNeeded = false;
         bool imageRedescribed = false;
         bool copyRequired = false;
+        size_t bufferOffset = 0;
         if (((imageDesc->image_type == CL_MEM_OBJECT_IMAGE1D_BUFFER) || (imageDesc->image_type == CL_MEM_OBJECT_IMAGE2D)) && (parentBuffer != nullptr)) {
             imageRedescribed = true;
             memory = parentBuffer->getGraphicsAllocation();
@@ -192,13 +193,19 @@ Image *Image::create(Context *context,
             hostPtrToSet = const_cast<void *>(hostPtr);
             parentBuffer->incRefInternal();
             Gmm::queryImgFromBufferParams(imgInfo, memory);
+            // pooled buffers and sub-buffers own only a range of the parent allocation
+            bufferOffset = parentBuffer->getAllocationOffset();
+            if (parentBuffer->isPooledBuffer() || parentBuffer->isSubBuffer()) {
+                imgInfo.size = parentBuffer->getSize();
+                imgInfo.offset = static_cast<uint32_t>(bufferOffset);
+            }
             if (memoryManager->peekVirtualPaddingSupport() && (imageDesc->image_type == CL_MEM_OBJECT_IMAGE2D)) {
                 // Retrieve sizes from GMM and apply virtual padding if buffer storage is not big enough
                 auto queryGmmImgInfo(imgInfo);
                 std::unique_ptr<Gmm> gmm(Gmm::createGmmAndQueryImgParams(queryGmmImgInfo, hwInfo));
                 auto gmmAllocationSize = gmm->gmmResourceInfo->getSizeAllocation();
-                if (gmmAllocationSize > memory->getUnderlyingBufferSize()) {
-                    memory = memoryManager->createGraphicsAllocationWithPadding(memory, gmmAllocationSize);
+                if (imgInfo.offset + gmmAllocationSize > memory->getUnderlyingBufferSize()) {
+                    memory = memoryManager->createGraphicsAllocationWithPadding(memory, imgInfo.offset + gmmAllocationSize);
                 }
             }
         }
@@ -316,6 +323,9 @@ Image *Image::create(Context *context,
         if (imageDesc->image_type != CL_MEM_OBJECT_IMAGE1D_ARRAY && imageDesc->image_type != CL_MEM_OBJECT_IMAGE2D_ARRAY) {
             image->imageDesc.image_array_size = 0;
         }
+        if (bufferOffset != 0) {
+            image->memoryStorage = parentBuffer->getCpuAddress();
+        }
         if ((imageDesc->image_type == CL_MEM_OBJECT_IMAGE1D_BUFFER) || ((imageDesc->image_type == CL_MEM_OBJECT_IMAGE2D) && (imageDesc->mem_object != nullptr))) {
             image->associatedMemObject = castToObject<MemObj>(imageDesc->mem_object);
         }
@@ -821,6 +831,7 @@ Image *Image::redescribeFillImage() {
                                 this->mipLevel,
                                 surfaceFormat,
                                 &this->surfaceOffsets);
+    image->memoryStorage = this->memoryStorage;
     image->setQPitch(this->getQPitch());
     image->setCubeFaceIndex(this->getCubeFaceIndex());
     return image;
@@ -865,6 +876,7 @@ Image *Image::redescribe() {
                                 this->mipLevel,
                                 surfaceFormat,
                                 &this->surfaceOffsets);
+    image->memoryStorage = this->memoryStorage;
     image->setQPitch(this->getQPitch());
     image->setCubeFaceIndex(this->getCubeFaceIndex());
     return image;
@@ -21,6 +21,7 @@
  */
 
 #pragma once
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <vector>
@@ -108,6 +109,7 @@ class GraphicsAllocation : public IDNode<GraphicsAllocation> {
     int getAllocationType() const { return allocationType; }
 
     uint32_t taskCount = ObjectNotUsed;
+    std::chrono::steady_clock::time_point reuseTimestamp;
     OsHandleStorage fragmentsStorage;
     bool isL3Capable();
     bool is32BitAllocation = false;
@@ -26,16 +26,60 @@
 
 using namespace OCLRT;
 
-std::map<void *, FragmentStorage>::iterator OCLRT::HostPtrManager::findElement(void *ptr) {
-    auto nextElement = partialAllocations.lower_bound(ptr);
+OCLRT::HostPtrManager::~HostPtrManager() {
+    for (uint32_t i = 0; i < shardCount; i++) {
+        for (auto &element : shards[i].fragments) {
+            // fragment is owned by the shard its start address falls into
+            if (getShardIndex(element.first) == i) {
+                delete element.second;
+            }
+        }
+    }
+}
+
+uint32_t OCLRT::HostPtrManager::getShardIndex(const void *ptr) {
+    return static_cast<uint32_t>((reinterpret_cast<uintptr_t>(ptr) >> shardGranularityShift) % shardCount);
+}
+
+uint32_t OCLRT::HostPtrManager::getShardsMask(const void *ptr, size_t size) {
+    auto firstGranule = reinterpret_cast<uintptr_t>(ptr) >> shardGranularityShift;
+    auto lastGranule = (reinterpret_cast<uintptr_t>(ptr) + (size ? size - 1 : 0)) >> shardGranularityShift;
+    if (lastGranule - firstGranule + 1 >= shardCount) {
+        return static_cast<uint32_t>(~0u);
+    }
+    uint32_t shardsMask = 0u;
+    for (auto granule = firstGranule; granule <= lastGranule; granule++) {
+        shardsMask |= 1u << (granule % shardCount);
+    }
+    return shardsMask;
+}
+
+void OCLRT::HostPtrManager::lockShards(uint32_t shardsMask) {
+    for (uint32_t i = 0; i < shardCount; i++) {
+        if (shardsMask & (1u << i)) {
+            shards[i].mtx.lock();
+        }
+    }
+}
+
+void OCLRT::HostPtrManager::unlockShards(uint32_t shardsMask) {
+    for (uint32_t i = shardCount; i > 0; i--) {
+        if (shardsMask & (1u << (i - 1))) {
+            shards[i - 1].mtx.unlock();
+        }
+    }
+}
+
+HostPtrFragmentsContainer::iterator OCLRT::HostPtrManager::findElement(HostPtrFragmentsContainer &fragments, void *ptr) {
+    auto nextElement = fragments.lower_bound(ptr);
     auto element = nextElement;
-    if (element != partialAllocations.end()) {
-        auto &storedFragment = element->second;
+    if (element != fragments.end()) {
+        auto &storedFragment = *element->second;
         if (storedFragment.fragmentCpuPointer <= ptr) {
             return element;
-        } else if (element != partialAllocations.begin()) {
+        } else if (element != fragments.begin()) {
             element--;
-            auto &storedFragment = element->second;
+            auto &storedFragment = *element->second;
             auto storedEndAddress = (uintptr_t)storedFragment.fragmentCpuPointer + storedFragment.fragmentSize;
             if (storedFragment.fragmentSize == 0) {
                 storedEndAddress++;
@@ -44,9 +88,9 @@ std::map<void *, FragmentStorage>::iterator OCLRT::HostPtrManager::findElement(v
                 return element;
             }
         }
-    } else if (element != partialAllocations.begin()) {
+    } else if (element != fragments.begin()) {
         element--;
-        auto &storedFragment = element->second;
+        auto &storedFragment = *element->second;
         auto storedEndAddress = (uintptr_t)storedFragment.fragmentCpuPointer + storedFragment.fragmentSize;
         if (storedFragment.fragmentSize == 0) {
             storedEndAddress++;
@@ -55,7 +99,7 @@ std::map<void *, FragmentStorage>::iterator OCLRT::HostPtrManager::findElement(v
             return element;
         }
     }
-    return partialAllocations.end();
+    return fragments.end();
 }
 
 AllocationRequirements OCLRT::HostPtrManager::getAllocationRequirements(const void *inputPtr, size_t size) {
@@ -105,6 +149,7 @@ AllocationRequirements OCLRT::HostPtrManager::getAllocationRequirements(const vo
 }
 
 OsHandleStorage OCLRT::HostPtrManager::populateAlreadyAllocatedFragments(AllocationRequirements &requirements, CheckedFragments *checkedFragments) {
+    HostPtrRangeLock rangeLock(*this, requirements);
     OsHandleStorage handleStorage;
     for (unsigned int i = 0; i < requirements.requiredFragmentsCount; i++) {
         OverlapStatus overlapStatus = OverlapStatus::FRAGMENT_NOT_CHECKED;
@@ -149,14 +194,23 @@ OsHandleStorage OCLRT::HostPtrManager::populateAlreadyAllocatedFragments(Allocat
 }
 
 void OCLRT::HostPtrManager::storeFragment(FragmentStorage &fragment) {
-    std::lock_guard<std::mutex> lock(allocationsMutex);
-    auto element = findElement(fragment.fragmentCpuPointer);
-    if (element != partialAllocations.end()) {
-        element->second.refCount++;
+    auto shardsMask = getShardsMask(fragment.fragmentCpuPointer, fragment.fragmentSize);
+    lockShards(shardsMask);
+    auto &ownerFragments = shards[getShardIndex(fragment.fragmentCpuPointer)].fragments;
+    auto element = findElement(ownerFragments, fragment.fragmentCpuPointer);
+    if (element != ownerFragments.end()) {
+        element->second->refCount++;
     } else {
         fragment.refCount++;
-        partialAllocations.insert(std::pair<void *, FragmentStorage>(fragment.fragmentCpuPointer, fragment));
+        auto storedFragment = new FragmentStorage(fragment);
+        for (uint32_t i = 0; i < shardCount; i++) {
+            if (shardsMask & (1u << i)) {
+                shards[i].fragments.insert(std::pair<void *, FragmentStorage *>(fragment.fragmentCpuPointer, storedFragment));
+            }
+        }
+        fragmentCount++;
     }
+    unlockShards(shardsMask);
 }
 
 void OCLRT::HostPtrManager::storeFragment(AllocationStorageData &storageData) {
@@ -177,48 +231,84 @@ void OCLRT::HostPtrManager::releaseHandleStorage(OsHandleStorage &fragments) {
 }
 
 bool OCLRT::HostPtrManager::releaseHostPtr(void *ptr) {
-    std::lock_guard<std::mutex> lock(allocationsMutex);
     bool fragmentReadyToBeReleased = false;
+    FragmentStorage *storedFragment = nullptr;
+    {
+        std::lock_guard<std::recursive_mutex> lock(shards[getShardIndex(ptr)].mtx);
+        auto &fragments = shards[getShardIndex(ptr)].fragments;
+        auto element = findElement(fragments, ptr);
+        DEBUG_BREAK_IF(element == fragments.end());
+        storedFragment = element->second;
+    }
 
-    auto element = findElement(ptr);
-
-    DEBUG_BREAK_IF(element == partialAllocations.end());
-
-    element->second.refCount--;
-    if (element->second.refCount <= 0) {
+    // fragment may span more shards than the one ptr falls into, its ref count is guarded by all of them
+    HostPtrRangeLock rangeLock(*this, storedFragment->fragmentCpuPointer, storedFragment->fragmentSize);
+    storedFragment->refCount--;
+    if (storedFragment->refCount <= 0) {
         fragmentReadyToBeReleased = true;
-        partialAllocations.erase(element);
+        auto shardsMask = getShardsMask(storedFragment->fragmentCpuPointer, storedFragment->fragmentSize);
+        for (uint32_t i = 0; i < shardCount; i++) {
+            if (shardsMask & (1u << i)) {
+                shards[i].fragments.erase(storedFragment->fragmentCpuPointer);
+            }
+        }
+        fragmentCount--;
+        delete storedFragment;
     }
 
     return fragmentReadyToBeReleased;
 }
 
 FragmentStorage *OCLRT::HostPtrManager::getFragment(void *inputPtr) {
-    std::lock_guard<std::mutex> lock(allocationsMutex);
-    auto element = findElement(inputPtr);
-    if (element != partialAllocations.end()) {
-        return &element->second;
+    auto &shard = shards[getShardIndex(inputPtr)];
+    std::lock_guard<std::recursive_mutex> lock(shard.mtx);
+    auto element = findElement(shard.fragments, inputPtr);
+    if (element != shard.fragments.end()) {
+        return element->second;
     }
     return nullptr;
 }
 
 //for given inputs see if any allocation overlaps
 FragmentStorage *OCLRT::HostPtrManager::getFragmentAndCheckForOverlaps(const void *inPtr, size_t size, OverlapStatus &overlappingStatus) {
-    std::lock_guard<std::mutex> lock(allocationsMutex);
     void *inputPtr = const_cast<void *>(inPtr);
-    auto nextElement = partialAllocations.lower_bound(inputPtr);
+    auto shardsMask = getShardsMask(inputPtr, size);
+    HostPtrRangeLock rangeLock(*this, inputPtr, size);
+    overlappingStatus = OverlapStatus::FRAGMENT_NOT_OVERLAPING_WITH_ANY_OTHER;
+
+    // every fragment intersecting the range is registered in at least one of the covered shards
+    FragmentStorage *fragment = nullptr;
+    for (uint32_t i = 0; i < shardCount; i++) {
+        if (shardsMask & (1u << i)) {
+            OverlapStatus shardStatus;
+            auto shardFragment = checkForOverlaps(shards[i].fragments, inputPtr, size, shardStatus);
+            if (shardStatus == OverlapStatus::FRAGMENT_OVERLAPING_AND_BIGGER_THEN_STORED_FRAGMENT) {
+                overlappingStatus = shardStatus;
+                return nullptr;
+            }
+            if (shardFragment != nullptr) {
+                overlappingStatus = shardStatus;
+                fragment = shardFragment;
+            }
+        }
+    }
+    return fragment;
+}
+
+FragmentStorage *OCLRT::HostPtrManager::checkForOverlaps(HostPtrFragmentsContainer &fragments, void *inputPtr, size_t size, OverlapStatus &overlappingStatus) {
+    auto nextElement = fragments.lower_bound(inputPtr);
     auto element = nextElement;
     overlappingStatus = OverlapStatus::FRAGMENT_NOT_OVERLAPING_WITH_ANY_OTHER;
 
-    if (element != partialAllocations.begin()) {
+    if (element != fragments.begin()) {
         element--;
     }
 
-    if (element != partialAllocations.end()) {
-        auto &storedFragment = element->second;
+    if (element != fragments.end()) {
+        auto &storedFragment = *element->second;
         if (storedFragment.fragmentCpuPointer == inputPtr && storedFragment.fragmentSize == size) {
             overlappingStatus = OverlapStatus::FRAGMENT_WITH_EXACT_SIZE_AS_STORED_FRAGMENT;
-            return &element->second;
+            return element->second;
         }
 
         auto storedEndAddress = (uintptr_t)storedFragment.fragmentCpuPointer + storedFragment.fragmentSize;
@@ -227,15 +317,15 @@ FragmentStorage *OCLRT::HostPtrManager::getFragmentAndCheckForOverlaps(const voi
         if (inputPtr >= storedFragment.fragmentCpuPointer && (uintptr_t)inputPtr < (uintptr_t)storedEndAddress) {
             if (inputEndAddress <= storedEndAddress) {
                 overlappingStatus = OverlapStatus::FRAGMENT_WITHIN_STORED_FRAGMENT;
-                return &element->second;
+                return element->second;
             } else {
                 overlappingStatus = OverlapStatus::FRAGMENT_OVERLAPING_AND_BIGGER_THEN_STORED_FRAGMENT;
                 return nullptr;
             }
         }
         //next fragment doesn't have to be after the inputPtr
-        if (nextElement != partialAllocations.end()) {
-            auto &storedNextElement = nextElement->second;
+        if (nextElement != fragments.end()) {
+            auto &storedNextElement = *nextElement->second;
             auto storedNextEndAddress = (uintptr_t)storedNextElement.fragmentCpuPointer + storedNextElement.fragmentSize;
             auto storedNextStartAddress = (uintptr_t)storedNextElement.fragmentCpuPointer;
             //check if this allocation is after the inputPtr
@@ -255,9 +345,26 @@ FragmentStorage *OCLRT::HostPtrManager::getFragmentAndCheckForOverlaps(const voi
                     DEBUG_BREAK_IF(inputEndAddress != storedNextEndAddress);
                     overlappingStatus = OverlapStatus::FRAGMENT_WITH_EXACT_SIZE_AS_STORED_FRAGMENT;
                 }
-                return &nextElement->second;
+                return nextElement->second;
             }
         }
     }
     return nullptr;
 }
+
+HostPtrRangeLock::HostPtrRangeLock(HostPtrManager &hostPtrManager, const void *ptr, size_t size)
+    : hostPtrManager(hostPtrManager), shardsMask(HostPtrManager::getShardsMask(ptr, size)) {
+    hostPtrManager.lockShards(shardsMask);
+}
+
+HostPtrRangeLock::HostPtrRangeLock(HostPtrManager &hostPtrManager, const AllocationRequirements &requirements)
+    : hostPtrManager(hostPtrManager), shardsMask(0u) {
+    for (uint32_t i = 0; i < requirements.requiredFragmentsCount; i++) {
+        shardsMask |= HostPtrManager::getShardsMask(requirements.AllocationFragments[i].allocationPtr, requirements.AllocationFragments[i].allocationSize);
+    }
+    hostPtrManager.lockShards(shardsMask);
+}
+
+HostPtrRangeLock::~HostPtrRangeLock() {
+    hostPtrManager.unlockShards(shardsMask);
+}
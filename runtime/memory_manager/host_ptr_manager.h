@@ -21,17 +21,28 @@
  */
 
 #pragma once
+#include <atomic>
 #include <map>
+#include <mutex>
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/memory_manager/graphics_allocation.h"
 #include "runtime/memory_manager/host_ptr_defines.h"
 
 namespace OCLRT {
 
-typedef std::map<void *, FragmentStorage> HostPtrFragmentsContainer;
+// fragments never overlap, so an address-ordered map answers interval queries with a single predecessor lookup
+typedef std::map<void *, FragmentStorage *> HostPtrFragmentsContainer;
 
 class HostPtrManager {
   public:
+    // address space is split into granules hashed onto shards, each with its own lock;
+    // a fragment is registered in every shard its range touches
+    static const uint32_t shardCount = 32;
+    static const uint32_t shardGranularityShift = 20;
+
+    HostPtrManager() = default;
+    ~HostPtrManager();
+
     static AllocationRequirements getAllocationRequirements(const void *inputPtr, size_t size);
     OsHandleStorage populateAlreadyAllocatedFragments(AllocationRequirements &requirements, CheckedFragments *checkedFragments);
     void storeFragment(FragmentStorage &fragment);
@@ -41,13 +52,44 @@ class HostPtrManager {
     bool releaseHostPtr(void *ptr);
 
     FragmentStorage *getFragment(void *inputPtr);
-    size_t getFragmentCount() { return partialAllocations.size(); }
+    size_t getFragmentCount() { return fragmentCount; }
     FragmentStorage *getFragmentAndCheckForOverlaps(const void *inputPtr, size_t size, OverlapStatus &overlappingStatus);
 
-  private:
-    std::map<void *, FragmentStorage>::iterator findElement(void *ptr);
+    static uint32_t getShardIndex(const void *ptr);
+    static uint32_t getShardsMask(const void *ptr, size_t size);
+
+  protected:
+    friend class HostPtrRangeLock;
+
+    struct Shard {
+        std::recursive_mutex mtx;
+        HostPtrFragmentsContainer fragments;
+    };
+
+    void lockShards(uint32_t shardsMask);
+    void unlockShards(uint32_t shardsMask);
+
+    static HostPtrFragmentsContainer::iterator findElement(HostPtrFragmentsContainer &fragments, void *ptr);
+    static FragmentStorage *checkForOverlaps(HostPtrFragmentsContainer &fragments, void *inputPtr, size_t size, OverlapStatus &overlappingStatus);
+
+    Shard shards[shardCount];
+    std::atomic<size_t> fragmentCount{0};
+};
+
+// Holds the shards covering a host pointer range, so that overlap checking, os handle creation and
+// fragment registration for that range happen atomically without blocking unrelated ranges.
+// Shards are always taken in ascending order and are recursive, so nested HostPtrManager calls are safe.
+class HostPtrRangeLock {
+  public:
+    HostPtrRangeLock(HostPtrManager &hostPtrManager, const void *ptr, size_t size);
+    HostPtrRangeLock(HostPtrManager &hostPtrManager, const AllocationRequirements &requirements);
+    ~HostPtrRangeLock();
+
+    HostPtrRangeLock(const HostPtrRangeLock &) = delete;
+    HostPtrRangeLock &operator=(const HostPtrRangeLock &) = delete;
 
-    HostPtrFragmentsContainer partialAllocations;
-    std::mutex allocationsMutex;
+  protected:
+    HostPtrManager &hostPtrManager;
+    uint32_t shardsMask;
 };
 } // namespace OCLRT
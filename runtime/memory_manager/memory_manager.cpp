@@ -28,6 +28,7 @@
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/basic_math.h"
 #include "runtime/helpers/options.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/command_stream/command_stream_receiver.h"
 #include "runtime/utilities/stackvec.h"
 #include "runtime/utilities/tag_allocator.h"
@@ -66,10 +67,22 @@ GraphicsAllocation *AllocationsList::detachAllocationImpl(GraphicsAllocation *,
 }
 MemoryManager::MemoryManager(bool enable64kbpages) : allocator32Bit(nullptr), enable64kbpages(enable64kbpages) {
     residencyAllocations.reserve(20);
+    if (DebugManager.flags.ReusableAllocationsLimitMB.get() != -1) {
+        allocationsForReuse.setMaxBytes(static_cast<size_t>(DebugManager.flags.ReusableAllocationsLimitMB.get()) * MemoryConstants::megaByte);
+    }
+    if (DebugManager.flags.ReusableAllocationsMaxIdleMs.get() != -1) {
+        allocationsForReuse.setMaxIdleTime(std::chrono::milliseconds(DebugManager.flags.ReusableAllocationsMaxIdleMs.get()));
+    }
 };
 MemoryManager::~MemoryManager() {
+    auto &statistics = allocationsForReuse.getStatistics();
+    printDebugString(DebugManager.flags.PrintDebugMessages.get(), stdout,
+                     "Reusable allocations: %llu hits, %llu misses, %llu trimmed (%llu bytes)\n",
+                     static_cast<unsigned long long>(statistics.hits), static_cast<unsigned long long>(statistics.misses),
+                     static_cast<unsigned long long>(statistics.trimmedAllocations), static_cast<unsigned long long>(statistics.trimmedBytes));
+
     freeAllocationsList(-1, graphicsAllocations);
-    freeAllocationsList(-1, allocationsForReuse);
+    freeAllocationsChain(allocationsForReuse.detachCompletedAllocations(-1));
 }
 
 void *MemoryManager::allocateSystemMemory(size_t size, size_t alignment) {
@@ -123,20 +136,53 @@ void MemoryManager::freeGmm(GraphicsAllocation *gfxAllocation) {
 }
 
 GraphicsAllocation *MemoryManager::allocateGraphicsMemory(size_t size, const void *ptr, bool forcePin) {
-    std::lock_guard<decltype(mtx)> lock(mtx);
     auto requirements = HostPtrManager::getAllocationRequirements(ptr, size);
 
     if (deferredDeleter) {
         deferredDeleter->drain(true);
     }
 
-    //check for overlaping
     CheckedFragments checkedFragments;
-    if (checkAllocationsForOverlapping(&requirements, &checkedFragments) == RequirementsStatus::FATAL) {
-        //abort whole application instead of silently passing.
-        abortExecution();
+    {
+        // a host pointer whose fragments are all stored already only takes references on them, which its
+        // host ptr manager shards protect; creating OS handles for new fragments stays under the memory manager lock
+        HostPtrRangeLock rangeLock(hostPtrManager, requirements);
+        if (checkFragmentsForOverlapping(&requirements, &checkedFragments) && areAllFragmentsStored(checkedFragments)) {
+            auto osStorage = hostPtrManager.populateAlreadyAllocatedFragments(requirements, &checkedFragments);
+            return createGraphicsAllocation(osStorage, size, ptr);
+        }
     }
 
+    // overlapping fragments may belong to temporary allocations; releasing them takes the memory manager lock
+    // and shards outside of the range, so it has to happen before the range is locked again
+    std::lock_guard<decltype(mtx)> lock(mtx);
+
+    while (true) {
+        //check for overlaping
+        if (checkAllocationsForOverlapping(&requirements, &checkedFragments) == RequirementsStatus::FATAL) {
+            //abort whole application instead of silently passing.
+            abortExecution();
+        }
+
+        HostPtrRangeLock rangeLock(hostPtrManager, requirements);
+        if (checkFragmentsForOverlapping(&requirements, &checkedFragments)) {
+            return createGraphicsAllocationFromFragments(requirements, checkedFragments, size, ptr);
+        }
+        // a fragment was released after the cleanup above, drop the range and check again
+    }
+}
+
+bool MemoryManager::areAllFragmentsStored(const CheckedFragments &checkedFragments) {
+    for (size_t i = 0; i < checkedFragments.count; i++) {
+        if ((checkedFragments.status[i] != OverlapStatus::FRAGMENT_WITHIN_STORED_FRAGMENT) &&
+            (checkedFragments.status[i] != OverlapStatus::FRAGMENT_WITH_EXACT_SIZE_AS_STORED_FRAGMENT)) {
+            return false;
+        }
+    }
+    return checkedFragments.count > 0;
+}
+
+GraphicsAllocation *MemoryManager::createGraphicsAllocationFromFragments(AllocationRequirements &requirements, CheckedFragments &checkedFragments, size_t size, const void *ptr) {
     auto osStorage = hostPtrManager.populateAlreadyAllocatedFragments(requirements, &checkedFragments);
     if (osStorage.fragmentCount == 0) {
         return nullptr;
@@ -198,9 +244,14 @@ void MemoryManager::storeAllocation(std::unique_ptr<GraphicsAllocation> gfxAlloc
         }
     }
 
-    auto &allocationsList = (allocationType == TEMPORARY_ALLOCATION) ? graphicsAllocations : allocationsForReuse;
     gfxAllocation->taskCount = taskCount;
-    allocationsList.pushTailOne(*gfxAllocation.release());
+    if (allocationType == TEMPORARY_ALLOCATION) {
+        graphicsAllocations.pushTailOne(*gfxAllocation.release());
+        return;
+    }
+
+    allocationsForReuse.pushTailOne(*gfxAllocation.release());
+    freeAllocationsChain(allocationsForReuse.detachAllocationsToTrim(csr ? csr->getTagAddress() : nullptr, std::chrono::steady_clock::now()));
 }
 
 std::unique_ptr<GraphicsAllocation> MemoryManager::obtainReusableAllocation(size_t requiredSize) {
@@ -209,6 +260,16 @@ std::unique_ptr<GraphicsAllocation> MemoryManager::obtainReusableAllocation(size
     return allocation;
 }
 
+void MemoryManager::freeAllocationsChain(GraphicsAllocation *allocations) {
+    while (allocations != nullptr) {
+        auto next = allocations->next;
+        allocations->next = nullptr;
+        allocations->prev = nullptr;
+        freeGraphicsMemory(allocations);
+        allocations = next;
+    }
+}
+
 void MemoryManager::applyCommonCleanup() {
     if (this->paddingAllocation) {
         this->freeGraphicsMemory(this->paddingAllocation);
@@ -225,10 +286,21 @@ void MemoryManager::applyCommonCleanup() {
 
 bool MemoryManager::cleanAllocationList(uint32_t waitTaskCount, uint32_t allocationType) {
     std::lock_guard<decltype(mtx)> lock(mtx);
-    freeAllocationsList(waitTaskCount, (allocationType == TEMPORARY_ALLOCATION) ? graphicsAllocations : allocationsForReuse);
+    if (allocationType == TEMPORARY_ALLOCATION) {
+        freeAllocationsList(waitTaskCount, graphicsAllocations);
+    } else {
+        freeAllocationsChain(allocationsForReuse.detachCompletedAllocations(waitTaskCount));
+    }
     return false;
 }
 
+void MemoryManager::releaseIdleAllocations(size_t reusableBytesToRelease) {
+    std::lock_guard<decltype(mtx)> lock(mtx);
+    auto csrTagAddress = csr ? csr->getTagAddress() : nullptr;
+    freeAllocationsList(csrTagAddress ? *csrTagAddress : -1, graphicsAllocations);
+    freeAllocationsChain(allocationsForReuse.detachLeastRecentlyStored(csrTagAddress, reusableBytesToRelease));
+}
+
 void MemoryManager::freeAllocationsList(uint32_t waitTaskCount, AllocationsList &allocationsList) {
     GraphicsAllocation *curr = allocationsList.detachNodes();
 
@@ -305,6 +377,23 @@ bool MemoryManager::isMemoryBudgetExhausted() const {
     return false;
 }
 
+bool MemoryManager::checkFragmentsForOverlapping(AllocationRequirements *requirements, CheckedFragments *checkedFragments) {
+    checkedFragments->count = 0;
+    for (unsigned int i = 0; i < max_fragments_count; i++) {
+        checkedFragments->status[i] = OverlapStatus::FRAGMENT_NOT_CHECKED;
+        checkedFragments->fragments[i] = nullptr;
+    }
+
+    for (unsigned int i = 0; i < requirements->requiredFragmentsCount; i++) {
+        checkedFragments->count++;
+        checkedFragments->fragments[i] = hostPtrManager.getFragmentAndCheckForOverlaps(requirements->AllocationFragments[i].allocationPtr, requirements->AllocationFragments[i].allocationSize, checkedFragments->status[i]);
+        if (checkedFragments->status[i] == OverlapStatus::FRAGMENT_OVERLAPING_AND_BIGGER_THEN_STORED_FRAGMENT) {
+            return false;
+        }
+    }
+    return true;
+}
+
 RequirementsStatus MemoryManager::checkAllocationsForOverlapping(AllocationRequirements *requirements, CheckedFragments *checkedFragments) {
     DEBUG_BREAK_IF(requirements == nullptr);
     DEBUG_BREAK_IF(checkedFragments == nullptr);
@@ -24,6 +24,7 @@
 #include "runtime/memory_manager/host_ptr_defines.h"
 #include "runtime/memory_manager/host_ptr_manager.h"
 #include "runtime/memory_manager/graphics_allocation.h"
+#include "runtime/memory_manager/reusable_allocations_pool.h"
 #include "runtime/os_interface/32bit_memory.h"
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/utilities/tag_allocator_base.h"
@@ -154,13 +155,15 @@ class MemoryManager {
     //intrusive list of allocation
     AllocationsList graphicsAllocations;
 
-    //intrusive list of allocation for re-use
-    AllocationsList allocationsForReuse;
+    //size-bucketed pool of allocations for re-use
+    ReusableAllocationsPool allocationsForReuse;
 
     CommandStreamReceiver *csr = nullptr;
     Device *device = nullptr;
     HostPtrManager hostPtrManager;
 
+    // called without the memory manager lock when all fragments of the host pointer are stored already,
+    // so implementations must not touch memory manager state beyond the returned allocation
     virtual GraphicsAllocation *createGraphicsAllocation(OsHandleStorage &handleStorage, size_t hostPtrSize, const void *hostPtr) = 0;
 
     bool peekForce32BitAllocations() { return force32bitAllocations; }
@@ -231,6 +234,12 @@ class MemoryManager {
     bool virtualPaddingAvailable = false;
     GraphicsAllocation *paddingAllocation = nullptr;
     void applyCommonCleanup();
+    void freeAllocationsChain(GraphicsAllocation *allocations);
+    // frees completed temporary allocations and completed reusable ones, least recently stored first
+    void releaseIdleAllocations(size_t reusableBytesToRelease);
+    MOCKABLE_VIRTUAL bool checkFragmentsForOverlapping(AllocationRequirements *requirements, CheckedFragments *checkedFragments);
+    GraphicsAllocation *createGraphicsAllocationFromFragments(AllocationRequirements &requirements, CheckedFragments &checkedFragments, size_t size, const void *ptr);
+    static bool areAllFragmentsStored(const CheckedFragments &checkedFragments);
     ResidencyContainer residencyAllocations;
     ResidencyContainer evictionAllocations;
     std::unique_ptr<DeferredDeleter> deferredDeleter;
@@ -23,6 +23,7 @@
 #pragma once
 #include "runtime/memory_manager/memory_manager.h"
 #include "runtime/helpers/basic_math.h"
+#include <atomic>
 #include <map>
 
 namespace OCLRT {
@@ -84,7 +85,7 @@ class OsAgnosticMemoryManager : public MemoryManager {
 
   private:
     PointerMap allocationMap;
-    unsigned long long counter = 0;
+    std::atomic<unsigned long long> counter{0};
     bool fakeBigAllocations = false;
 };
 } // namespace OCLRT
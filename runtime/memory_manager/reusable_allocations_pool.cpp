@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/memory_manager/reusable_allocations_pool.h"
+#include "runtime/helpers/basic_math.h"
+#include "runtime/memory_manager/memory_constants.h"
+
+#include <algorithm>
+
+namespace OCLRT {
+
+const uint32_t ReusableAllocationsPool::bucketsCount;
+const size_t ReusableAllocationsPool::defaultMaxBytes;
+const uint32_t ReusableAllocationsPool::defaultMaxIdleTimeMs;
+
+uint32_t ReusableAllocationsPool::getBucketIndex(size_t size) {
+    // bucket n keeps allocations spanning [2^n, 2^(n+1)) pages
+    uint64_t pages = size / MemoryConstants::pageSize + ((size % MemoryConstants::pageSize) ? 1 : 0);
+    if (pages <= 1) {
+        return 0;
+    }
+    return static_cast<uint32_t>(std::min(Math::log2(pages), static_cast<uint64_t>(bucketsCount - 1)));
+}
+
+bool ReusableAllocationsPool::isCompleted(GraphicsAllocation &allocation, volatile uint32_t *csrTagAddress) {
+    auto currentTagValue = csrTagAddress ? *csrTagAddress : -1;
+    return (currentTagValue > allocation.taskCount) || (allocation.taskCount == 0);
+}
+
+GraphicsAllocation *ReusableAllocationsPool::removeOne(uint32_t bucketIndex, GraphicsAllocation &allocation) {
+    bytes -= allocation.getUnderlyingBufferSize();
+    return buckets[bucketIndex].removeOne(allocation).release();
+}
+
+void ReusableAllocationsPool::pushTailOne(GraphicsAllocation &allocation) {
+    allocation.reuseTimestamp = std::chrono::steady_clock::now();
+    bytes += allocation.getUnderlyingBufferSize();
+    buckets[getBucketIndex(allocation.getUnderlyingBufferSize())].pushTailOne(allocation);
+}
+
+std::unique_ptr<GraphicsAllocation> ReusableAllocationsPool::detachAllocation(size_t requiredMinimalSize, volatile uint32_t *csrTagAddress) {
+    for (auto bucketIndex = getBucketIndex(requiredMinimalSize); bucketIndex < bucketsCount; bucketIndex++) {
+        GraphicsAllocation *bestFit = nullptr;
+        for (auto curr = buckets[bucketIndex].peekHead(); curr != nullptr; curr = curr->next) {
+            auto currSize = curr->getUnderlyingBufferSize();
+            if ((currSize >= requiredMinimalSize) && isCompleted(*curr, csrTagAddress) &&
+                ((bestFit == nullptr) || (currSize < bestFit->getUnderlyingBufferSize()))) {
+                bestFit = curr;
+            }
+        }
+        if (bestFit != nullptr) {
+            statistics.hits++;
+            return std::unique_ptr<GraphicsAllocation>(removeOne(bucketIndex, *bestFit));
+        }
+    }
+    statistics.misses++;
+    return nullptr;
+}
+
+GraphicsAllocation *ReusableAllocationsPool::detachCompletedAllocations(uint32_t waitTaskCount) {
+    IDList<GraphicsAllocation, false, false> detached;
+
+    for (uint32_t bucketIndex = 0; bucketIndex < bucketsCount; bucketIndex++) {
+        auto curr = buckets[bucketIndex].peekHead();
+        while (curr != nullptr) {
+            auto next = curr->next;
+            if (curr->taskCount <= waitTaskCount) {
+                detached.pushTailOne(*removeOne(bucketIndex, *curr));
+            }
+            curr = next;
+        }
+    }
+
+    return detached.detachNodes();
+}
+
+GraphicsAllocation *ReusableAllocationsPool::detachAllocationsToTrim(volatile uint32_t *csrTagAddress, std::chrono::steady_clock::time_point now) {
+    IDList<GraphicsAllocation, false, false> detached;
+
+    auto trimOne = [&](uint32_t bucketIndex, GraphicsAllocation &allocation) {
+        statistics.trimmedAllocations++;
+        statistics.trimmedBytes += allocation.getUnderlyingBufferSize();
+        detached.pushTailOne(*removeOne(bucketIndex, allocation));
+    };
+
+    // buckets are kept in store order, so idle entries are found at their heads
+    if (maxIdleTime.count() != 0) {
+        for (uint32_t bucketIndex = 0; bucketIndex < bucketsCount; bucketIndex++) {
+            auto curr = buckets[bucketIndex].peekHead();
+            while (curr != nullptr && (now - curr->reuseTimestamp) > maxIdleTime) {
+                auto next = curr->next;
+                if (isCompleted(*curr, csrTagAddress)) {
+                    trimOne(bucketIndex, *curr);
+                }
+                curr = next;
+            }
+        }
+    }
+
+    // above the cap the least recently stored allocations go first, ones still used by GPU are kept
+    while (maxBytes != 0 && bytes > maxBytes) {
+        uint32_t oldestBucketIndex = 0;
+        auto oldest = findLeastRecentlyStored(csrTagAddress, oldestBucketIndex);
+        if (oldest == nullptr) {
+            break;
+        }
+        trimOne(oldestBucketIndex, *oldest);
+    }
+
+    return detached.detachNodes();
+}
+
+GraphicsAllocation *ReusableAllocationsPool::detachLeastRecentlyStored(volatile uint32_t *csrTagAddress, size_t bytesToRelease) {
+    IDList<GraphicsAllocation, false, false> detached;
+
+    size_t released = 0;
+    while (released < bytesToRelease) {
+        uint32_t oldestBucketIndex = 0;
+        auto oldest = findLeastRecentlyStored(csrTagAddress, oldestBucketIndex);
+        if (oldest == nullptr) {
+            break;
+        }
+        released += oldest->getUnderlyingBufferSize();
+        statistics.trimmedAllocations++;
+        statistics.trimmedBytes += oldest->getUnderlyingBufferSize();
+        detached.pushTailOne(*removeOne(oldestBucketIndex, *oldest));
+    }
+
+    return detached.detachNodes();
+}
+
+GraphicsAllocation *ReusableAllocationsPool::findLeastRecentlyStored(volatile uint32_t *csrTagAddress, uint32_t &bucketIndexOut) {
+    GraphicsAllocation *oldest = nullptr;
+    for (uint32_t bucketIndex = 0; bucketIndex < bucketsCount; bucketIndex++) {
+        auto curr = buckets[bucketIndex].peekHead();
+        while (curr != nullptr && !isCompleted(*curr, csrTagAddress)) {
+            curr = curr->next;
+        }
+        if (curr != nullptr && (oldest == nullptr || curr->reuseTimestamp < oldest->reuseTimestamp)) {
+            oldest = curr;
+            bucketIndexOut = bucketIndex;
+        }
+    }
+    return oldest;
+}
+
+GraphicsAllocation *ReusableAllocationsPool::peekHead() {
+    for (auto &bucket : buckets) {
+        if (!bucket.peekIsEmpty()) {
+            return bucket.peekHead();
+        }
+    }
+    return nullptr;
+}
+
+GraphicsAllocation *ReusableAllocationsPool::peekTail() {
+    for (auto bucketIndex = bucketsCount; bucketIndex > 0; bucketIndex--) {
+        if (!buckets[bucketIndex - 1].peekIsEmpty()) {
+            return buckets[bucketIndex - 1].peekTail();
+        }
+    }
+    return nullptr;
+}
+
+bool ReusableAllocationsPool::peekIsEmpty() {
+    return peekHead() == nullptr;
+}
+
+bool ReusableAllocationsPool::peekContains(GraphicsAllocation &allocation) {
+    return buckets[getBucketIndex(allocation.getUnderlyingBufferSize())].peekContains(allocation);
+}
+} // namespace OCLRT
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/memory_manager/graphics_allocation.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace OCLRT {
+
+// Allocations kept for reuse, segregated into power-of-two page classes.
+// Not thread safe on its own - accessed only under MemoryManager lock.
+class ReusableAllocationsPool {
+  public:
+    using AllocationsBucket = IDList<GraphicsAllocation, false, true>;
+
+    static const uint32_t bucketsCount = 20;
+    static const size_t defaultMaxBytes = 256 * 1024 * 1024;
+    static const uint32_t defaultMaxIdleTimeMs = 10000;
+
+    struct Statistics {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t trimmedAllocations = 0;
+        uint64_t trimmedBytes = 0;
+    };
+
+    static uint32_t getBucketIndex(size_t size);
+
+    void pushTailOne(GraphicsAllocation &allocation);
+    std::unique_ptr<GraphicsAllocation> detachAllocation(size_t requiredMinimalSize, volatile uint32_t *csrTagAddress = nullptr);
+
+    // returned allocations are chained through next and have to be freed by the caller
+    GraphicsAllocation *detachCompletedAllocations(uint32_t waitTaskCount);
+    GraphicsAllocation *detachAllocationsToTrim(volatile uint32_t *csrTagAddress, std::chrono::steady_clock::time_point now);
+    // completed allocations, least recently stored first, until at least bytesToRelease bytes are detached
+    GraphicsAllocation *detachLeastRecentlyStored(volatile uint32_t *csrTagAddress, size_t bytesToRelease);
+
+    GraphicsAllocation *peekHead();
+    GraphicsAllocation *peekTail();
+    bool peekIsEmpty();
+    bool peekContains(GraphicsAllocation &allocation);
+
+    size_t peekBytes() const { return bytes; }
+    const Statistics &getStatistics() const { return statistics; }
+
+    void setMaxBytes(size_t maxBytes) { this->maxBytes = maxBytes; }
+    void setMaxIdleTime(std::chrono::milliseconds maxIdleTime) { this->maxIdleTime = maxIdleTime; }
+
+  protected:
+    static bool isCompleted(GraphicsAllocation &allocation, volatile uint32_t *csrTagAddress);
+    GraphicsAllocation *removeOne(uint32_t bucketIndex, GraphicsAllocation &allocation);
+    GraphicsAllocation *findLeastRecentlyStored(volatile uint32_t *csrTagAddress, uint32_t &bucketIndexOut);
+
+    AllocationsBucket buckets[bucketsCount];
+    size_t bytes = 0;
+    size_t maxBytes = defaultMaxBytes;
+    std::chrono::milliseconds maxIdleTime = std::chrono::milliseconds(defaultMaxIdleTimeMs);
+    Statistics statistics;
+};
+} // namespace OCLRT
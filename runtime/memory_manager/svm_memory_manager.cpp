@@ -27,36 +27,102 @@
 
 namespace OCLRT {
 
+SVMPageDirectory::Node::Node() {
+    for (auto &entry : entries) {
+        entry.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+SVMPageDirectory::~SVMPageDirectory() {
+    for (auto &entry : root.entries) {
+        freeNode(static_cast<Node *>(entry.load(std::memory_order_relaxed)), levels - 2);
+    }
+}
+
+void SVMPageDirectory::freeNode(Node *node, uint32_t level) {
+    if (node == nullptr) {
+        return;
+    }
+    // entries of level 0 nodes are allocations
+    if (level > 0) {
+        for (auto &entry : node->entries) {
+            freeNode(static_cast<Node *>(entry.load(std::memory_order_relaxed)), level - 1);
+        }
+    }
+    delete node;
+}
+
+std::atomic<void *> *SVMPageDirectory::getLeafEntry(uint64_t page, bool create) {
+    Node *node = &root;
+    for (uint32_t level = levels - 1; level > 0; level--) {
+        auto &entry = node->entries[getIndex(page, level)];
+        auto next = static_cast<Node *>(entry.load(std::memory_order_acquire));
+        if (next == nullptr) {
+            if (!create) {
+                return nullptr;
+            }
+            next = new Node;
+            entry.store(next, std::memory_order_release);
+        }
+        node = next;
+    }
+    return &node->entries[getIndex(page, 0)];
+}
+
+void SVMPageDirectory::set(const void *ptr, size_t size, GraphicsAllocation *allocation) {
+    uint64_t firstPage = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr)) >> pageBits;
+    uint64_t lastPage = (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr)) + (size ? size - 1 : 0)) >> pageBits;
+    for (uint64_t page = firstPage; page <= lastPage; page++) {
+        getLeafEntry(page, true)->store(allocation, std::memory_order_release);
+    }
+}
+
+void SVMPageDirectory::clear(const void *ptr, size_t size, GraphicsAllocation *allocation) {
+    uint64_t firstPage = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr)) >> pageBits;
+    uint64_t lastPage = (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr)) + (size ? size - 1 : 0)) >> pageBits;
+    for (uint64_t page = firstPage; page <= lastPage; page++) {
+        auto entry = getLeafEntry(page, false);
+        void *expected = allocation;
+        if (entry) {
+            entry->compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
+        }
+    }
+}
+
+GraphicsAllocation *SVMPageDirectory::get(const void *ptr) const {
+    uint64_t page = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr)) >> pageBits;
+    if ((page >> (bitsPerLevel * levels)) != 0) {
+        return nullptr;
+    }
+    const Node *node = &root;
+    for (uint32_t level = levels - 1; level > 0; level--) {
+        node = static_cast<const Node *>(node->entries[getIndex(page, level)].load(std::memory_order_acquire));
+        if (node == nullptr) {
+            return nullptr;
+        }
+    }
+    return static_cast<GraphicsAllocation *>(node->entries[getIndex(page, 0)].load(std::memory_order_acquire));
+}
+
 void SVMAllocsManager::MapBasedAllocationTracker::insert(GraphicsAllocation &ga) {
     allocs.insert(std::make_pair(ga.getUnderlyingBuffer(), &ga));
+    pageDirectory.set(ga.getUnderlyingBuffer(), ga.getUnderlyingBufferSize(), &ga);
 }
 
 void SVMAllocsManager::MapBasedAllocationTracker::remove(GraphicsAllocation &ga) {
     std::map<const void *, GraphicsAllocation *>::iterator iter;
     iter = allocs.find(ga.getUnderlyingBuffer());
     allocs.erase(iter);
+    pageDirectory.clear(ga.getUnderlyingBuffer(), ga.getUnderlyingBufferSize(), &ga);
 }
 
-GraphicsAllocation *SVMAllocsManager::MapBasedAllocationTracker::get(const void *ptr) {
-    std::map<const void *, GraphicsAllocation *>::iterator Iter, End;
-    GraphicsAllocation *GA;
+GraphicsAllocation *SVMAllocsManager::MapBasedAllocationTracker::get(const void *ptr) const {
     if (ptr == nullptr)
         return nullptr;
-    End = allocs.end();
-    Iter = allocs.lower_bound(ptr);
-    if (((Iter != End) && (Iter->first != ptr)) ||
-        (Iter == End)) {
-        if (Iter == allocs.begin()) {
-            Iter = End;
-        } else {
-            Iter--;
-        }
-    }
-    if (Iter != End) {
-        GA = Iter->second;
-        if (ptr < ((char *)GA->getUnderlyingBuffer() + GA->getUnderlyingBufferSize())) {
-            return GA;
-        }
+    // allocations are page aligned, so a page never belongs to two of them; only the tail of the last page needs checking
+    auto GA = pageDirectory.get(ptr);
+    if (GA && ptr >= GA->getUnderlyingBuffer() && ptr < ((char *)GA->getUnderlyingBuffer() + GA->getUnderlyingBufferSize())) {
+        return GA;
     }
     return nullptr;
 }
@@ -79,7 +145,6 @@ void *SVMAllocsManager::createSVMAlloc(size_t size, bool coherent) {
 }
 
 GraphicsAllocation *SVMAllocsManager::getSVMAlloc(const void *ptr) {
-    std::unique_lock<std::mutex> lock(mtx);
     return SVMAllocs.get(ptr);
 }
 
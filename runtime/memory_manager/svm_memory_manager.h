@@ -21,6 +21,7 @@
  */
 
 #pragma once
+#include <atomic>
 #include <cstdint>
 #include <map>
 #include <mutex>
@@ -31,17 +32,51 @@ class GraphicsAllocation;
 class CommandStreamReceiver;
 class MemoryManager;
 
+// Radix tree translating page numbers to allocations, same layout as a 4-level page table.
+// Writers must be serialized, readers need no lock: nodes are published with release semantics
+// and never freed before the directory itself.
+class SVMPageDirectory {
+  public:
+    static const uint32_t bitsPerLevel = 9;
+    static const uint32_t levels = 4;
+    static const uint32_t pageBits = 12;
+
+    SVMPageDirectory() = default;
+    ~SVMPageDirectory();
+    SVMPageDirectory(const SVMPageDirectory &) = delete;
+    SVMPageDirectory &operator=(const SVMPageDirectory &) = delete;
+
+    void set(const void *ptr, size_t size, GraphicsAllocation *allocation);
+    // only pages still pointing to allocation are cleared
+    void clear(const void *ptr, size_t size, GraphicsAllocation *allocation);
+    GraphicsAllocation *get(const void *ptr) const;
+
+  protected:
+    struct Node {
+        Node();
+        std::atomic<void *> entries[1 << bitsPerLevel];
+    };
+    std::atomic<void *> *getLeafEntry(uint64_t page, bool create);
+    static void freeNode(Node *node, uint32_t level);
+    static uint32_t getIndex(uint64_t page, uint32_t level) {
+        return static_cast<uint32_t>(page >> (bitsPerLevel * level)) & ((1u << bitsPerLevel) - 1);
+    }
+
+    Node root;
+};
+
 class SVMAllocsManager {
   public:
     class MapBasedAllocationTracker {
       public:
         void insert(GraphicsAllocation &);
         void remove(GraphicsAllocation &);
-        GraphicsAllocation *get(const void *);
+        GraphicsAllocation *get(const void *) const;
         size_t getNumAllocs() const { return allocs.size(); };
 
       protected:
         std::map<const void *, GraphicsAllocation *> allocs;
+        SVMPageDirectory pageDirectory;
     };
 
     SVMAllocsManager(MemoryManager *memoryManager);
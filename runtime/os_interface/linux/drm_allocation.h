@@ -25,6 +25,7 @@
 
 namespace OCLRT {
 class BufferObject;
+struct DrmSlab;
 
 struct OsHandle {
     BufferObject *bo = nullptr;
@@ -38,6 +39,8 @@ class DrmAllocation : public GraphicsAllocation {
     }
     DrmAllocation(BufferObject *bo, void *ptrIn, uint64_t gpuAddress, size_t sizeIn) : GraphicsAllocation(ptrIn, gpuAddress, 0, sizeIn), bo(bo) {
     }
+    DrmAllocation(BufferObject *bo, void *ptrIn, size_t sizeIn, DrmSlab *slab) : GraphicsAllocation(ptrIn, sizeIn), bo(bo), slab(slab) {
+    }
 
     BufferObject *getBO() const {
         if (fragmentsStorage.fragmentCount) {
@@ -46,7 +49,11 @@ class DrmAllocation : public GraphicsAllocation {
         return this->bo;
     }
 
+    // slab this allocation was carved out of, bo is then the slab object shared with other allocations
+    DrmSlab *peekSlab() const { return slab; }
+
   protected:
     BufferObject *bo;
+    DrmSlab *slab = nullptr;
 };
 }
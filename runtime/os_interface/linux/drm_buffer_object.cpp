@@ -49,8 +49,6 @@ BufferObject::BufferObject(Drm *drm, int handle, bool isAllocated) : drm(drm), r
     this->tiling_mode = I915_TILING_NONE;
     this->stride = 0;
 
-    execObjectsStorage = nullptr;
-
     this->size = 0;
     this->address = nullptr;
     this->offset64 = 0;
@@ -142,24 +140,12 @@ void BufferObject::fillExecObject(drm_i915_gem_exec_object2 &execObject) {
     execObject.rsvd2 = 0;
 }
 
-void BufferObject::processRelocs(int &idx) {
-    for (size_t i = 0; i < this->residency.size(); i++) {
-        residency[i]->fillExecObject(execObjectsStorage[idx]);
-        idx++;
-    }
-}
-
-int BufferObject::exec(uint32_t used, size_t startOffset, unsigned int flags, bool requiresCoherency, bool lowPriority) {
+int BufferObject::submit(drm_i915_gem_exec_object2 *execObjects, uint32_t execObjectsCount, uint32_t used, size_t startOffset, unsigned int flags, bool requiresCoherency, bool lowPriority) {
     drm_i915_gem_execbuffer2 execbuf;
 
-    int idx = 0;
-    processRelocs(idx);
-    this->fillExecObject(execObjectsStorage[idx]);
-    idx++;
-
     memset(&execbuf, 0, sizeof(execbuf));
-    execbuf.buffers_ptr = reinterpret_cast<uintptr_t>(execObjectsStorage);
-    execbuf.buffer_count = idx;
+    execbuf.buffers_ptr = reinterpret_cast<uintptr_t>(execObjects);
+    execbuf.buffer_count = execObjectsCount;
     execbuf.batch_start_offset = static_cast<uint32_t>(startOffset);
     execbuf.batch_len = alignUp(used, 8);
     execbuf.cliprects_ptr = reinterpret_cast<uintptr_t>(nullptr);
@@ -25,8 +25,10 @@
 #include <errno.h>
 #include <stdint.h>
 #include <cstdlib>
+#include "runtime/os_interface/linux/drm_memory_budget.h"
 
 #include <atomic>
+#include <limits>
 #include <set>
 #include <vector>
 
@@ -58,7 +60,8 @@ class BufferObject {
     bool setTiling(uint32_t mode, uint32_t stride);
 
     int pin(BufferObject *boToPin);
-    int exec(uint32_t used, size_t startOffset, unsigned int flags, bool requiresCoherency = false, bool lowPriority = false);
+    // submits this batch buffer with exec objects prepared by the caller
+    int submit(drm_i915_gem_exec_object2 *execObjects, uint32_t execObjectsCount, uint32_t used, size_t startOffset, unsigned int flags, bool requiresCoherency, bool lowPriority);
 
     int wait(int64_t timeoutNs);
     bool close();
@@ -78,12 +81,13 @@ class BufferObject {
     void swapResidencyVector(ResidencyVector *residencyVect) {
         std::swap(this->residency, *residencyVect);
     }
-    void setExecObjectsStorage(drm_i915_gem_exec_object2 *storage) {
-        execObjectsStorage = storage;
-    }
     ResidencyVector *getResidency() { return &residency; }
     StorageAllocatorType peekAllocationType() { return storageAllocatorType; }
     void setAllocationType(StorageAllocatorType allocatorType) { this->storageAllocatorType = allocatorType; }
+    BudgetUsageType peekBudgetUsageType() { return budgetUsageType; }
+    uint32_t peekExecObjectSlot() const { return execObjectSlot; }
+    void setExecObjectSlot(uint32_t slot) { execObjectSlot = slot; }
+    void fillExecObject(drm_i915_gem_exec_object2 &execObject);
 
   protected:
     BufferObject(Drm *drm, int handle, bool isAllocated);
@@ -93,7 +97,6 @@ class BufferObject {
     std::atomic<uint32_t> refCount;
 
     ResidencyVector residency;
-    drm_i915_gem_exec_object2 *execObjectsStorage;
 
     int handle; // i915 gem object handle
     bool isSoftpin;
@@ -103,9 +106,6 @@ class BufferObject {
     uint32_t tiling_mode;
     uint32_t stride;
 
-    void fillExecObject(drm_i915_gem_exec_object2 &execObject);
-    void processRelocs(int &idx);
-
     uint64_t offset64; // last-seen GPU offset
     size_t size;
     void *address; // GPU side virtual address
@@ -113,5 +113,8 @@ class BufferObject {
     bool isAllocated = false;
     uint64_t unmapSize = 0;
     StorageAllocatorType storageAllocatorType = UNKNOWN_ALLOCATOR;
+    BudgetUsageType budgetUsageType = BUDGET_USAGE_UNTRACKED;
+    // position in DrmExecObjectTable of the command stream receiver that last submitted this object
+    uint32_t execObjectSlot = std::numeric_limits<uint32_t>::max();
 };
 }
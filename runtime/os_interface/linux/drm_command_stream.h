@@ -22,6 +22,7 @@
 
 #pragma once
 #include "runtime/command_stream/device_command_stream.h"
+#include "runtime/os_interface/linux/drm_exec_object_table.h"
 #include "runtime/os_interface/linux/drm_gem_close_worker.h"
 #include <vector>
 extern "C" {
@@ -32,6 +33,7 @@ namespace OCLRT {
 class BufferObject;
 class Drm;
 class DrmMemoryManager;
+struct DrmSlab;
 
 template <typename GfxFamily>
 class DrmCommandStreamReceiver : public DeviceCommandStreamReceiver<GfxFamily> {
@@ -66,10 +68,14 @@ class DrmCommandStreamReceiver : public DeviceCommandStreamReceiver<GfxFamily> {
 
   protected:
     void makeResident(BufferObject *bo);
+    void markSlabResident(DrmSlab *slab);
+    void clearResidentSlabs();
     void programVFEState(LinearStream &csr, DispatchFlags &dispatchFlags) override;
 
     std::vector<BufferObject *> residency;
-    std::vector<drm_i915_gem_exec_object2> execObjectsStorage;
+    // slabs whose object is already in residency, allocations sharing it must not add it again
+    std::vector<DrmSlab *> residentSlabs;
+    DrmExecObjectTable execObjectTable;
     Drm *drm;
     gemCloseWorkerMode gemCloseWorkerOperationMode;
     bool mediaVfeStateLowPriorityDirty = true;
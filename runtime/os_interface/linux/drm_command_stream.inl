@@ -24,6 +24,7 @@
 #include "hw_cmds.h"
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/preamble.h"
+#include "runtime/helpers/ptr_math.h"
 #include "runtime/mem_obj/buffer.h"
 #include "runtime/os_interface/linux/drm_buffer_object.h"
 #include "runtime/os_interface/linux/drm_command_stream.h"
@@ -39,10 +40,9 @@ namespace OCLRT {
 template <typename GfxFamily>
 DrmCommandStreamReceiver<GfxFamily>::DrmCommandStreamReceiver(const HardwareInfo &hwInfoIn,
                                                               Drm *drm, gemCloseWorkerMode mode)
-    : BaseClass(hwInfoIn), gemCloseWorkerOperationMode(mode) {
+    : BaseClass(hwInfoIn), execObjectTable((drm ? drm : Drm::get(0))->peekExecBatchFirstSupported()), gemCloseWorkerOperationMode(mode) {
     this->drm = drm ? drm : Drm::get(0);
     residency.reserve(512);
-    execObjectsStorage.reserve(512);
     CommandStreamReceiver::osInterface = std::unique_ptr<OSInterface>(new OSInterface());
     CommandStreamReceiver::osInterface.get()->get()->setDrm(this->drm);
 }
@@ -63,21 +63,37 @@ FlushStamp DrmCommandStreamReceiver<GfxFamily>::flush(BatchBuffer &batchBuffer,
 
     if (bb) {
         flushStamp = bb->peekHandle();
+        if (alloc->peekSlab()) {
+            // command buffer shares its object with other allocations: execute it from its offset
+            // and keep the object out of the residency list, it is added to exec objects as batch buffer
+            alignedStart += ptrDiff(alloc->getUnderlyingBuffer(), bb->peekAddress());
+            markSlabResident(alloc->peekSlab());
+        }
         this->processResidency(allocationsForResidency);
-        // Residency hold all allocation except command buffer, hence + 1
-        auto requiredSize = this->residency.size() + 1;
-        if (requiredSize > this->execObjectsStorage.size()) {
-            this->execObjectsStorage.resize(requiredSize);
+
+        // exec objects persist between submissions, only entries of objects that changed are rewritten
+        execObjectTable.beginSubmission();
+        for (auto bo : this->residency) {
+            execObjectTable.add(bo);
         }
+        uint32_t execObjectsCount = 0;
+        auto execObjects = execObjectTable.finishSubmission(bb, execObjectsCount);
 
         bb->swapResidencyVector(&this->residency);
-        bb->setExecObjectsStorage(this->execObjectsStorage.data());
         this->residency.reserve(512);
+        clearResidentSlabs();
 
-        bb->exec(static_cast<uint32_t>(alignUp(batchBuffer.usedSize - batchBuffer.startOffset, 8)),
-                 alignedStart, engineFlag | I915_EXEC_NO_RELOC,
-                 batchBuffer.requiresCoherency,
-                 batchBuffer.low_priority);
+        unsigned int execFlags = engineFlag | I915_EXEC_NO_RELOC | I915_EXEC_HANDLE_LUT;
+#if defined(I915_EXEC_BATCH_FIRST)
+        if (execObjectTable.peekBatchFirst()) {
+            execFlags |= I915_EXEC_BATCH_FIRST;
+        }
+#endif
+        bb->submit(execObjects, execObjectsCount,
+                   static_cast<uint32_t>(alignUp(batchBuffer.usedSize - batchBuffer.startOffset, 8)),
+                   alignedStart, execFlags,
+                   batchBuffer.requiresCoherency,
+                   batchBuffer.low_priority);
 
         if (this->gemCloseWorkerOperationMode == gemCloseWorkerMode::gemCloseWorkerConsumingCommandBuffers) {
             // Consume all space in CS to force new allocation
@@ -125,6 +141,11 @@ void DrmCommandStreamReceiver<GfxFamily>::processResidency(ResidencyContainer *i
                     drmAlloc->fragmentsStorage.fragmentStorageData[i].residency->resident = true;
                 }
             }
+        } else if (drmAlloc->peekSlab()) {
+            if (!drmAlloc->peekSlab()->resident) {
+                makeResident(drmAlloc->getBO());
+                markSlabResident(drmAlloc->peekSlab());
+            }
         } else {
             BufferObject *bo = drmAlloc->getBO();
             makeResident(bo);
@@ -132,6 +153,20 @@ void DrmCommandStreamReceiver<GfxFamily>::processResidency(ResidencyContainer *i
     }
 }
 
+template <typename GfxFamily>
+void DrmCommandStreamReceiver<GfxFamily>::markSlabResident(DrmSlab *slab) {
+    slab->resident = true;
+    residentSlabs.push_back(slab);
+}
+
+template <typename GfxFamily>
+void DrmCommandStreamReceiver<GfxFamily>::clearResidentSlabs() {
+    for (auto slab : residentSlabs) {
+        slab->resident = false;
+    }
+    residentSlabs.clear();
+}
+
 template <typename GfxFamily>
 void DrmCommandStreamReceiver<GfxFamily>::makeNonResident(GraphicsAllocation &gfxAllocation) {
     // Vector is moved to command buffer inside flush.
@@ -145,6 +180,7 @@ void DrmCommandStreamReceiver<GfxFamily>::makeNonResident(GraphicsAllocation &gf
                 }
             }
             this->residency.clear();
+            clearResidentSlabs();
         }
         if (gfxAllocation.fragmentsStorage.fragmentCount) {
             for (auto fragmentId = 0u; fragmentId < gfxAllocation.fragmentsStorage.fragmentCount; fragmentId++) {
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/linux/drm_exec_object_table.h"
+#include "runtime/os_interface/linux/drm_buffer_object.h"
+
+#include <limits>
+
+namespace OCLRT {
+constexpr uint32_t invalidExecObjectSlot = std::numeric_limits<uint32_t>::max();
+
+DrmExecObjectTable::DrmExecObjectTable(bool batchFirst) : batchFirst(batchFirst) {
+    execObjects.reserve(512);
+    owners.reserve(512);
+    generations.reserve(512);
+}
+
+void DrmExecObjectTable::beginSubmission() {
+    generation++;
+    currentObjectsCount = 0;
+}
+
+void DrmExecObjectTable::add(BufferObject *bo) {
+    auto slot = bo->peekExecObjectSlot();
+    if (slot < owners.size() && owners[slot] == bo && execObjects[entryIndex(slot)].handle == static_cast<uint32_t>(bo->peekHandle())) {
+        if (generations[slot] != generation) {
+            generations[slot] = generation;
+            currentObjectsCount++;
+        }
+        return;
+    }
+
+    slot = static_cast<uint32_t>(owners.size());
+    owners.push_back(bo);
+    generations.push_back(generation);
+    if (execObjects.size() < entryIndex(slot) + 1) {
+        execObjects.resize(entryIndex(slot) + 1);
+    }
+    bo->fillExecObject(execObjects[entryIndex(slot)]);
+    bo->setExecObjectSlot(slot);
+    currentObjectsCount++;
+    filledEntries++;
+}
+
+void DrmExecObjectTable::removeSlot(uint32_t slot) {
+    auto lastSlot = static_cast<uint32_t>(owners.size() - 1);
+    if (slot != lastSlot) {
+        owners[slot] = owners[lastSlot];
+        generations[slot] = generations[lastSlot];
+        execObjects[entryIndex(slot)] = execObjects[entryIndex(lastSlot)];
+        if (generations[slot] == generation) {
+            owners[slot]->setExecObjectSlot(slot);
+        }
+    }
+    owners.pop_back();
+    generations.pop_back();
+}
+
+drm_i915_gem_exec_object2 *DrmExecObjectTable::finishSubmission(BufferObject *batchBuffer, uint32_t &execObjectsCount) {
+    // batch buffer may share its object with resident allocations, it must not be listed twice
+    auto batchSlot = batchBuffer->peekExecObjectSlot();
+    if (batchSlot < owners.size() && owners[batchSlot] == batchBuffer && generations[batchSlot] == generation) {
+        removeSlot(batchSlot);
+        batchBuffer->setExecObjectSlot(invalidExecObjectSlot);
+        currentObjectsCount--;
+    }
+
+    if (currentObjectsCount != owners.size()) {
+        uint32_t slot = 0;
+        while (slot < owners.size()) {
+            if (generations[slot] == generation) {
+                slot++;
+            } else {
+                removeSlot(slot);
+            }
+        }
+    }
+
+    execObjects.resize(owners.size() + 1);
+    auto batchIndex = batchFirst ? 0u : owners.size();
+    batchBuffer->fillExecObject(execObjects[batchIndex]);
+
+    execObjectsCount = static_cast<uint32_t>(execObjects.size());
+    return execObjects.data();
+}
+} // namespace OCLRT
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstdint>
+#include <vector>
+extern "C" {
+#include "drm/i915_drm.h"
+}
+
+namespace OCLRT {
+class BufferObject;
+
+// Exec object list kept by a command stream receiver across submissions. Every buffer object
+// remembers its slot, so an object submitted again is only stamped with the current generation,
+// its entry is filled once when it becomes resident and dropped when a submission no longer uses it.
+class DrmExecObjectTable {
+  public:
+    DrmExecObjectTable(bool batchFirst);
+
+    void beginSubmission();
+    void add(BufferObject *bo);
+    // returns exec objects of the submission with the batch buffer placed first or last
+    drm_i915_gem_exec_object2 *finishSubmission(BufferObject *batchBuffer, uint32_t &execObjectsCount);
+
+    bool peekBatchFirst() const { return batchFirst; }
+    size_t peekObjectsCount() const { return owners.size(); }
+    uint64_t peekFilledEntries() const { return filledEntries; }
+    std::vector<drm_i915_gem_exec_object2> &getExecObjects() { return execObjects; }
+
+  protected:
+    void removeSlot(uint32_t slot);
+    size_t entryIndex(uint32_t slot) const { return batchFirst ? slot + 1 : slot; }
+
+    bool batchFirst;
+    std::vector<drm_i915_gem_exec_object2> execObjects;
+    // owners are compared only, objects of entries not stamped with current generation may be gone
+    std::vector<BufferObject *> owners;
+    std::vector<uint32_t> generations;
+    uint32_t generation = 0;
+    size_t currentObjectsCount = 0;
+    uint64_t filledEntries = 0;
+};
+} // namespace OCLRT
@@ -20,11 +20,14 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include <algorithm>
 #include <atomic>
 #include <iostream>
 #include <queue>
 #include <stdio.h>
+#include <vector>
 #include "runtime/helpers/aligned_memory.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "drm_buffer_object.h"
 #include "drm_command_stream.h"
 #include "drm_gem_close_worker.h"
@@ -32,31 +35,42 @@
 
 namespace OCLRT {
 
-DrmGemCloseWorker::DrmGemCloseWorker(DrmMemoryManager &memoryManager) : active(true), thread(nullptr), workCount(0), memoryManager(memoryManager),
-                                                                        workerDone(false) {
-    thread = new std::thread(&DrmGemCloseWorker::worker, this);
+DrmGemCloseWorker::DrmGemCloseWorker(DrmMemoryManager &memoryManager, uint32_t threadCount) : active(true), workCount(0), processedCount(0), batchCount(0),
+                                                                                              memoryManager(memoryManager), workersDone(0) {
+    threadCount = std::max(threadCount, 1u);
+    for (uint32_t i = 0; i < threadCount; i++) {
+        threads.emplace_back(&DrmGemCloseWorker::worker, this);
+    }
 }
 
 void DrmGemCloseWorker::closeThread() {
-    if (thread) {
-        while (!workerDone.load()) {
+    if (!threads.empty()) {
+        while (workersDone.load() < threads.size()) {
             condition.notify_all();
         }
 
-        thread->join();
-        delete thread;
-        thread = nullptr;
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        threads.clear();
     }
 }
 
 DrmGemCloseWorker::~DrmGemCloseWorker() {
     active = false;
     closeThread();
+
+    auto statistics = getStatistics();
+    printDebugString(DebugManager.flags.PrintDebugMessages.get(), stdout,
+                     "GEM close worker: %llu allocations released in %llu batches, peak queue depth %u\n",
+                     static_cast<unsigned long long>(statistics.processed), static_cast<unsigned long long>(statistics.batches),
+                     statistics.peakQueueDepth);
 }
 
 void DrmGemCloseWorker::push(DrmAllocation *bo) {
     std::unique_lock<std::mutex> lock(closeWorkerMutex);
     workCount++;
+    peakWorkCount = std::max(peakWorkCount, workCount.load());
     queue.push(bo);
     lock.unlock();
     condition.notify_one();
@@ -74,50 +88,65 @@ bool DrmGemCloseWorker::isEmpty() {
     return workCount.load() == 0;
 }
 
+DrmGemCloseWorker::Statistics DrmGemCloseWorker::getStatistics() {
+    std::lock_guard<std::mutex> lock(closeWorkerMutex);
+    return {workCount.load(), peakWorkCount, processedCount.load(), batchCount.load()};
+}
+
 inline void DrmGemCloseWorker::close(DrmAllocation *alloc) {
     auto bo = alloc->getBO();
 
-    bo->wait(-1);
-    memoryManager.unreference(bo);
+    if (alloc->peekSlab()) {
+        memoryManager.releaseSlabAllocation(alloc);
+    } else {
+        memoryManager.unreference(bo);
+        delete alloc;
+    }
+    processedCount++;
     workCount--;
+}
+
+void DrmGemCloseWorker::closeBatch(std::queue<DrmAllocation *> &batch) {
+    // Command buffers complete in submission order only within one HW context and low priority
+    // execs go to a context of their own, so every object is waited on before it is closed.
+    // Waiting newest first leaves the older objects of the same context idle by the time they are checked.
+    std::vector<DrmAllocation *> allocations;
+    allocations.reserve(batch.size());
+    while (!batch.empty()) {
+        allocations.push_back(batch.front());
+        batch.pop();
+    }
+    for (auto allocation = allocations.rbegin(); allocation != allocations.rend(); ++allocation) {
+        (*allocation)->getBO()->wait(-1);
+    }
+    batchCount++;
 
-    delete alloc;
+    for (auto allocation : allocations) {
+        close(allocation);
+    }
 }
 
 void DrmGemCloseWorker::worker() {
-    DrmAllocation *workItem = nullptr;
     std::queue<DrmAllocation *> localQueue;
     std::unique_lock<std::mutex> lock(closeWorkerMutex);
-    lock.unlock();
-
-    while (active) {
-        lock.lock();
-        workItem = nullptr;
 
+    while (true) {
         while (queue.empty() && active) {
             condition.wait(lock);
         }
 
-        if (!queue.empty()) {
-            localQueue.swap(queue);
+        // once closed, keep draining until nothing is left
+        if (queue.empty()) {
+            break;
         }
+        localQueue.swap(queue);
 
         lock.unlock();
-        while (!localQueue.empty()) {
-            workItem = localQueue.front();
-            localQueue.pop();
-            close(workItem);
-        }
-    }
-
-    lock.lock();
-    while (!queue.empty()) {
-        workItem = queue.front();
-        queue.pop();
-        close(workItem);
+        closeBatch(localQueue);
+        lock.lock();
     }
 
     lock.unlock();
-    workerDone.store(true);
+    workersDone++;
 }
 }
@@ -28,6 +28,7 @@
 #include <map>
 #include <set>
 #include <queue>
+#include <vector>
 #include <cstdint>
 
 namespace OCLRT {
@@ -42,7 +43,14 @@ enum gemCloseWorkerMode {
 
 class DrmGemCloseWorker {
   public:
-    DrmGemCloseWorker(DrmMemoryManager &memoryManager);
+    struct Statistics {
+        uint32_t queueDepth;     // pushed allocations not released yet
+        uint32_t peakQueueDepth; // highest queue depth seen on push
+        uint64_t processed;      // released allocations
+        uint64_t batches;        // drained batches, each waits on one buffer object
+    };
+
+    DrmGemCloseWorker(DrmMemoryManager &memoryManager, uint32_t threadCount = 1);
     ~DrmGemCloseWorker();
 
     DrmGemCloseWorker(const DrmGemCloseWorker &) = delete;
@@ -52,22 +60,27 @@ class DrmGemCloseWorker {
     void close(bool blocking);
 
     bool isEmpty();
+    Statistics getStatistics();
 
   private:
     void close(DrmAllocation *workItem);
+    void closeBatch(std::queue<DrmAllocation *> &batch);
     void closeThread();
     void worker();
-    bool active;
+    std::atomic<bool> active;
 
-    std::thread *thread;
+    std::vector<std::thread> threads;
 
     std::queue<DrmAllocation *> queue;
     std::atomic<uint32_t> workCount;
+    uint32_t peakWorkCount = 0;
+    std::atomic<uint64_t> processedCount;
+    std::atomic<uint64_t> batchCount;
 
     DrmMemoryManager &memoryManager;
 
     std::mutex closeWorkerMutex;
     std::condition_variable condition;
-    std::atomic<bool> workerDone;
+    std::atomic<uint32_t> workersDone;
 };
 }
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/linux/drm_memory_budget.h"
+
+namespace OCLRT {
+
+void DrmMemoryBudget::track(BudgetUsageType type, uint64_t size) {
+    usedByType[type] += size;
+    auto newUsed = used.fetch_add(size) + size;
+    auto peak = peakUsed.load();
+    while (newUsed > peak && !peakUsed.compare_exchange_weak(peak, newUsed)) {
+    }
+}
+
+void DrmMemoryBudget::untrack(BudgetUsageType type, uint64_t size) {
+    usedByType[type] -= size;
+    used -= size;
+}
+
+void DrmMemoryBudget::recordTrim(uint64_t releasedBytes) {
+    trims++;
+    trimmedBytes += releasedBytes;
+}
+
+uint64_t DrmMemoryBudget::getBytesOverBudget(uint64_t requiredSize) const {
+    auto required = used.load() + requiredSize;
+    if (budget == 0 || required <= budget) {
+        return 0;
+    }
+    return required - budget;
+}
+
+DrmMemoryBudget::State DrmMemoryBudget::getState() const {
+    State state;
+    state.budget = budget;
+    state.used = used;
+    state.peakUsed = peakUsed;
+    for (uint32_t type = 0; type < BUDGET_USAGE_COUNT; type++) {
+        state.usedByType[type] = usedByType[type];
+    }
+    state.trims = trims;
+    state.trimmedBytes = trimmedBytes;
+    return state;
+}
+} // namespace OCLRT
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+namespace OCLRT {
+
+enum BudgetUsageType {
+    BUDGET_USAGE_SYSTEM,
+    BUDGET_USAGE_HOST_PTR,
+    BUDGET_USAGE_IMAGE,
+    BUDGET_USAGE_32BIT,
+    BUDGET_USAGE_SHARED,
+    BUDGET_USAGE_COUNT,
+    BUDGET_USAGE_UNTRACKED = BUDGET_USAGE_COUNT
+};
+
+// Bytes of buffer objects created by a memory manager, per usage type, checked against an optional budget.
+// Counters are updated lock-free, a queried state is a snapshot that may mix concurrent updates.
+class DrmMemoryBudget {
+  public:
+    struct State {
+        uint64_t budget = 0;
+        uint64_t used = 0;
+        uint64_t peakUsed = 0;
+        uint64_t usedByType[BUDGET_USAGE_COUNT] = {};
+        uint64_t trims = 0;
+        uint64_t trimmedBytes = 0;
+    };
+
+    explicit DrmMemoryBudget(uint64_t budget) : budget(budget) {}
+    DrmMemoryBudget(const DrmMemoryBudget &) = delete;
+    DrmMemoryBudget &operator=(const DrmMemoryBudget &) = delete;
+
+    void track(BudgetUsageType type, uint64_t size);
+    void untrack(BudgetUsageType type, uint64_t size);
+    void recordTrim(uint64_t releasedBytes);
+
+    // 0 when the budget is disabled or requiredSize more bytes still fit in it
+    uint64_t getBytesOverBudget(uint64_t requiredSize) const;
+    bool isExceeded(uint64_t requiredSize) const { return getBytesOverBudget(requiredSize) != 0; }
+
+    uint64_t peekBudget() const { return budget; }
+    uint64_t peekUsed() const { return used; }
+    State getState() const;
+
+  protected:
+    const uint64_t budget;
+    std::atomic<uint64_t> used{0};
+    std::atomic<uint64_t> peakUsed{0};
+    std::atomic<uint64_t> usedByType[BUDGET_USAGE_COUNT] = {};
+    std::atomic<uint64_t> trims{0};
+    std::atomic<uint64_t> trimmedBytes{0};
+};
+} // namespace OCLRT
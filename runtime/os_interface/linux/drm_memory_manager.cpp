@@ -23,6 +23,7 @@
 #include "runtime/device/device.h"
 #include "runtime/helpers/ptr_math.h"
 #include "runtime/helpers/options.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/os_interface/32bit_memory.h"
 #include "runtime/os_interface/linux/drm_allocation.h"
 #include "runtime/os_interface/linux/drm_buffer_object.h"
@@ -41,11 +42,14 @@ extern "C" {
 
 namespace OCLRT {
 
-DrmMemoryManager::DrmMemoryManager(Drm *drm, gemCloseWorkerMode mode, bool forcePinAllowed) : MemoryManager(false), drm(drm), pinBB(nullptr) {
+const size_t DrmMemoryManager::hugePageSize;
+
+DrmMemoryManager::DrmMemoryManager(Drm *drm, gemCloseWorkerMode mode, bool forcePinAllowed) : MemoryManager(false), drm(drm), pinBB(nullptr),
+                                                                                              memoryBudget(static_cast<uint64_t>(std::max(DebugManager.flags.MemoryBudgetMB.get(), 0)) * MemoryConstants::megaByte) {
     MemoryManager::virtualPaddingAvailable = true;
     allocator32Bit = std::unique_ptr<Allocator32bit>(new Allocator32bit);
     if (mode != gemCloseWorkerMode::gemCloseWorkerInactive) {
-        gemCloseWorker.reset(new DrmGemCloseWorker(*this));
+        gemCloseWorker.reset(new DrmGemCloseWorker(*this, static_cast<uint32_t>(std::max(DebugManager.flags.GemCloseWorkerThreads.get(), 1))));
     }
 
     if (forcePinAllowed) {
@@ -60,13 +64,52 @@ DrmMemoryManager::DrmMemoryManager(Drm *drm, gemCloseWorkerMode mode, bool force
             pinBB->isAllocated = true;
         }
     }
+
+    if (DebugManager.flags.UserptrCacheMaxEntries.get() > 0) {
+        auto limitMB = DebugManager.flags.UserptrCacheLimitMB.get();
+        uint64_t maxBytes = limitMB >= 0 ? static_cast<uint64_t>(limitMB) * MemoryConstants::megaByte : DrmUserptrCache::defaultMaxBytes;
+        userptrCache.reset(new DrmUserptrCache(static_cast<size_t>(DebugManager.flags.UserptrCacheMaxEntries.get()), maxBytes));
+    }
+
+    if (DebugManager.flags.HugePageAllocationThresholdMB.get() > 0) {
+        hugePageThreshold = static_cast<size_t>(DebugManager.flags.HugePageAllocationThresholdMB.get() * MemoryConstants::megaByte);
+    }
+
+    if (DebugManager.flags.SlabAllocationMaxSizeKB.get() > 0) {
+        auto maxAllocationSize = std::min(static_cast<size_t>(DebugManager.flags.SlabAllocationMaxSizeKB.get() * MemoryConstants::kiloByte), DrmSlabAllocator::defaultSlabSize);
+        slabAllocator.reset(new DrmSlabAllocator(DrmSlabAllocator::defaultSlabSize, maxAllocationSize));
+    }
 }
 
 DrmMemoryManager::~DrmMemoryManager() {
+    auto budgetState = memoryBudget.getState();
+    printDebugString(DebugManager.flags.PrintDebugMessages.get(), stdout,
+                     "Memory budget: %llu bytes used (%llu peak) of %llu, %llu trims released %llu bytes\n",
+                     static_cast<unsigned long long>(budgetState.used), static_cast<unsigned long long>(budgetState.peakUsed),
+                     static_cast<unsigned long long>(budgetState.budget), static_cast<unsigned long long>(budgetState.trims),
+                     static_cast<unsigned long long>(budgetState.trimmedBytes));
+
     applyCommonCleanup();
     if (gemCloseWorker) {
         gemCloseWorker->close(false);
     }
+    if (userptrCache) {
+        std::vector<BufferObject *> evicted;
+        userptrCache->evictAll(evicted);
+        releaseUserptrCacheEvictions(evicted);
+    }
+    if (slabAllocator) {
+        for (auto allocation : pendingSlabAllocations) {
+            allocation->getBO()->wait(-1);
+            releaseSlabAllocation(allocation);
+        }
+        pendingSlabAllocations.clear();
+        std::vector<BufferObject *> released;
+        slabAllocator->releaseAll(released);
+        for (auto bo : released) {
+            unreference(bo);
+        }
+    }
     if (pinBB) {
         unreference(pinBB);
         pinBB = nullptr;
@@ -111,6 +154,8 @@ uint32_t DrmMemoryManager::unreference(OCLRT::BufferObject *bo, bool synchronous
         auto unmapSize = bo->peekUnmapSize();
         auto address = bo->isAllocated || unmapSize > 0 ? bo->address : nullptr;
         auto allocatorType = bo->peekAllocationType();
+        auto size = bo->peekSize();
+        auto budgetUsageType = bo->peekBudgetUsageType();
 
         if (bo->isReused) {
             eraseSharedBufferObject(bo);
@@ -119,10 +164,19 @@ uint32_t DrmMemoryManager::unreference(OCLRT::BufferObject *bo, bool synchronous
         bo->close();
 
         delete bo;
+        if (budgetUsageType != BUDGET_USAGE_UNTRACKED) {
+            memoryBudget.untrack(budgetUsageType, size);
+        }
+        if (address && userptrCache) {
+            // cached userptr objects of host pointers within memory being released must not outlive it
+            std::vector<BufferObject *> evicted;
+            userptrCache->invalidate(address, unmapSize ? static_cast<size_t>(unmapSize) : size, evicted);
+            releaseUserptrCacheEvictions(evicted);
+        }
         if (address) {
             if (unmapSize) {
                 if (allocatorType == MMAP_ALLOCATOR) {
-                    munmapFunction(address, unmapSize);
+                    releaseGpuRange(address, static_cast<size_t>(unmapSize));
                 } else {
                     allocator32Bit->free(address, unmapSize);
                 }
@@ -173,6 +227,22 @@ DrmAllocation *DrmMemoryManager::allocateGraphicsMemory(size_t size, size_t alig
     // It's needed to prevent overlapping pages with user pointers
     size_t cSize = std::max(alignUp(size, minAlignment), minAlignment);
 
+    trimToBudget(cSize);
+
+    if (slabAllocator && !forcePin && !uncacheable && slabAllocator->isSuitable(cSize, cAlignment)) {
+        auto allocation = allocateFromSlab(cSize);
+        if (allocation) {
+            return allocation;
+        }
+    }
+
+    if (hugePageThreshold != 0 && cSize >= hugePageThreshold && cAlignment <= hugePageSize) {
+        auto allocation = allocateWithHugePages(cSize, forcePin);
+        if (allocation) {
+            return allocation;
+        }
+    }
+
     auto res = alignedMallocWrapper(cSize, cAlignment);
 
     if (!res)
@@ -186,6 +256,7 @@ DrmAllocation *DrmMemoryManager::allocateGraphicsMemory(size_t size, size_t alig
     }
 
     bo->isAllocated = true;
+    trackBufferObject(bo, BUDGET_USAGE_SYSTEM);
     if (pinBB != nullptr && forcePin && size >= this->pinThreshold) {
         pinBB->pin(bo);
     }
@@ -193,7 +264,102 @@ DrmAllocation *DrmMemoryManager::allocateGraphicsMemory(size_t size, size_t alig
     return new DrmAllocation(bo, res, cSize);
 }
 
+DrmAllocation *DrmMemoryManager::allocateWithHugePages(size_t size, bool forcePin) {
+    // over-allocate by one huge page and cut the mapping down to a 2MB-aligned range of whole huge pages
+    auto mappingSize = alignUp(size, hugePageSize);
+    auto reservedSize = mappingSize + hugePageSize;
+    auto reserved = mmapFunction(nullptr, reservedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (reserved == MAP_FAILED)
+        return nullptr;
+
+    auto res = alignUp(reserved, hugePageSize);
+    auto head = ptrDiff(res, reserved);
+    auto tail = reservedSize - head - mappingSize;
+    if (head) {
+        munmapFunction(reserved, head);
+    }
+    if (tail) {
+        munmapFunction(ptrOffset(res, mappingSize), tail);
+    }
+    // without transparent huge page support the mapping is simply backed by 4KB pages
+    madviseFunction(res, mappingSize, MADV_HUGEPAGE);
+
+    BufferObject *bo = allocUserptr(reinterpret_cast<uintptr_t>(res), size, 0, true);
+    if (!bo) {
+        munmapFunction(res, mappingSize);
+        return nullptr;
+    }
+
+    bo->isAllocated = true;
+    bo->setUnmapSize(mappingSize);
+    bo->setAllocationType(MMAP_ALLOCATOR);
+    trackBufferObject(bo, BUDGET_USAGE_SYSTEM);
+    if (pinBB != nullptr && forcePin && size >= this->pinThreshold) {
+        pinBB->pin(bo);
+    }
+
+    return new DrmAllocation(bo, res, size);
+}
+
+DrmAllocation *DrmMemoryManager::allocateFromSlab(size_t size) {
+    releaseCompletedSlabAllocations();
+
+    DrmSlab *slab = nullptr;
+    auto ptr = slabAllocator->allocate(size, slab);
+
+    if (!ptr) {
+        auto slabSize = slabAllocator->getSlabSize();
+        auto res = alignedMallocWrapper(slabSize, MemoryConstants::pageSize);
+        if (!res)
+            return nullptr;
+
+        BufferObject *bo = allocUserptr(reinterpret_cast<uintptr_t>(res), slabSize, 0, true);
+        if (!bo) {
+            alignedFreeWrapper(res);
+            return nullptr;
+        }
+        bo->isAllocated = true;
+        trackBufferObject(bo, BUDGET_USAGE_SYSTEM);
+        ptr = slabAllocator->allocateFromNewSlab(bo, size, slab);
+    }
+
+    // every allocation holds its own reference to the slab object and drops it when released
+    slab->bo->reference();
+    return new DrmAllocation(slab->bo, ptr, size, slab);
+}
+
+void DrmMemoryManager::releaseSlabAllocation(DrmAllocation *allocation) {
+    auto bo = allocation->getBO();
+    auto released = slabAllocator->free(allocation->peekSlab(), allocation->getUnderlyingBuffer(), allocation->getUnderlyingBufferSize());
+    delete allocation;
+
+    unreference(bo);
+    if (released) {
+        unreference(released);
+    }
+}
+
+void DrmMemoryManager::releaseCompletedSlabAllocations() {
+    std::lock_guard<decltype(mtx)> lock(mtx);
+    for (auto allocation = pendingSlabAllocations.begin(); allocation != pendingSlabAllocations.end();) {
+        if (isSlabAllocationCompleted((*allocation)->taskCount)) {
+            releaseSlabAllocation(*allocation);
+            allocation = pendingSlabAllocations.erase(allocation);
+        } else {
+            ++allocation;
+        }
+    }
+}
+
+bool DrmMemoryManager::isSlabAllocationCompleted(uint32_t taskCount) const {
+    if (taskCount == ObjectNotUsed || device == nullptr) {
+        return true;
+    }
+    return *device->getTagAddress() >= taskCount;
+}
+
 DrmAllocation *DrmMemoryManager::allocateGraphicsMemory(size_t size, const void *ptr, bool forcePin) {
+    trimToBudget(size);
     auto res = (DrmAllocation *)MemoryManager::allocateGraphicsMemory(size, const_cast<void *>(ptr));
 
     if (res != nullptr && pinBB != nullptr && forcePin && size >= this->pinThreshold) {
@@ -216,8 +382,12 @@ GraphicsAllocation *DrmMemoryManager::allocateGraphicsMemoryForImage(ImageInfo &
         return alloc;
     }
 
-    auto gpuRange = mmapFunction(nullptr, imgInfo.size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
-    DEBUG_BREAK_IF(gpuRange == MAP_FAILED);
+    trimToBudget(imgInfo.size);
+
+    auto gpuRange = reserveGpuRange(imgInfo.size);
+    if (!gpuRange) {
+        return nullptr;
+    }
 
     drm_i915_gem_create create = {0, 0, 0};
     create.size = imgInfo.size;
@@ -228,6 +398,7 @@ GraphicsAllocation *DrmMemoryManager::allocateGraphicsMemoryForImage(ImageInfo &
 
     auto bo = new (std::nothrow) BufferObject(this->drm, create.handle, true);
     if (!bo) {
+        releaseGpuRange(gpuRange, imgInfo.size);
         return nullptr;
     }
     bo->size = imgInfo.size;
@@ -239,6 +410,7 @@ GraphicsAllocation *DrmMemoryManager::allocateGraphicsMemoryForImage(ImageInfo &
     ((void)(ret2));
 
     bo->setUnmapSize(imgInfo.size);
+    trackBufferObject(bo, BUDGET_USAGE_IMAGE);
 
     auto allocation = new DrmAllocation(bo, gpuRange, imgInfo.size);
     bo->setAllocationType(MMAP_ALLOCATOR);
@@ -247,6 +419,7 @@ GraphicsAllocation *DrmMemoryManager::allocateGraphicsMemoryForImage(ImageInfo &
 }
 
 DrmAllocation *DrmMemoryManager::allocate32BitGraphicsMemory(size_t size, void *ptr) {
+    trimToBudget(size);
     if (ptr) {
         uintptr_t inputPtr = (uintptr_t)ptr;
         auto allocationSize = alignSizeWholePage((void *)ptr, size);
@@ -266,6 +439,7 @@ DrmAllocation *DrmMemoryManager::allocate32BitGraphicsMemory(size_t size, void *
 
         bo->isAllocated = false;
         bo->setUnmapSize(realAllocationSize);
+        trackBufferObject(bo, BUDGET_USAGE_32BIT);
         bo->address = gpuVirtualAddress;
         uintptr_t offset = (uintptr_t)bo->address;
         bo->softPin((uint64_t)offset);
@@ -298,6 +472,7 @@ DrmAllocation *DrmMemoryManager::allocate32BitGraphicsMemory(size_t size, void *
 
     bo->isAllocated = true;
     bo->setUnmapSize(allocationSize);
+    trackBufferObject(bo, BUDGET_USAGE_32BIT);
 
     auto drmAllocation = new DrmAllocation(bo, res, alignedAllocationSize);
     drmAllocation->is32BitAllocation = true;
@@ -328,14 +503,21 @@ BufferObject *DrmMemoryManager::createSharedBufferObject(int boHandle, size_t si
         gpuRange = this->allocator32Bit->allocate(size);
         storageType = BIT32_ALLOCATOR;
     } else {
-        gpuRange = mmapFunction(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        gpuRange = reserveGpuRange(size);
         storageType = MMAP_ALLOCATOR;
     }
 
-    DEBUG_BREAK_IF(gpuRange == MAP_FAILED);
+    if (!gpuRange) {
+        return nullptr;
+    }
 
     auto bo = new (std::nothrow) BufferObject(this->drm, boHandle, true);
     if (!bo) {
+        if (storageType == MMAP_ALLOCATOR) {
+            releaseGpuRange(gpuRange, size);
+        } else {
+            allocator32Bit->free(gpuRange, size);
+        }
         return nullptr;
     }
 
@@ -344,6 +526,7 @@ BufferObject *DrmMemoryManager::createSharedBufferObject(int boHandle, size_t si
     bo->softPin(reinterpret_cast<uint64_t>(gpuRange));
     bo->setUnmapSize(size);
     bo->setAllocationType(storageType);
+    trackBufferObject(bo, BUDGET_USAGE_SHARED);
     return bo;
 }
 
@@ -386,7 +569,10 @@ GraphicsAllocation *DrmMemoryManager::createGraphicsAllocationFromSharedHandle(o
 }
 
 GraphicsAllocation *DrmMemoryManager::createPaddedAllocation(GraphicsAllocation *inputGraphicsAllocation, size_t sizeWithPadding) {
-    void *gpuRange = mmapFunction(nullptr, sizeWithPadding, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    void *gpuRange = reserveGpuRange(sizeWithPadding);
+    if (!gpuRange) {
+        return nullptr;
+    }
 
     auto srcPtr = inputGraphicsAllocation->getUnderlyingBuffer();
     auto srcSize = inputGraphicsAllocation->getUnderlyingBufferSize();
@@ -396,6 +582,7 @@ GraphicsAllocation *DrmMemoryManager::createPaddedAllocation(GraphicsAllocation
 
     BufferObject *bo = allocUserptr(alignedPtr, alignedSrcSize, 0, true);
     if (!bo) {
+        releaseGpuRange(gpuRange, sizeWithPadding);
         return nullptr;
     }
     bo->setAddress(gpuRange);
@@ -421,6 +608,17 @@ void DrmMemoryManager::freeGraphicsMemoryImpl(GraphicsAllocation *gfxAllocation)
 
     BufferObject *search = input->getBO();
 
+    if (input->peekSlab()) {
+        // waiting on the slab object would block on every sibling allocation, so only this allocation's own submission is tracked
+        if (!isSlabAllocationCompleted(input->taskCount)) {
+            std::lock_guard<decltype(mtx)> lock(mtx);
+            pendingSlabAllocations.push_back(input);
+            return;
+        }
+        releaseSlabAllocation(input);
+        return;
+    }
+
     if (gfxAllocation->peekSharedHandle() != Sharing::nonSharedResource) {
         closeFunction(gfxAllocation->peekSharedHandle());
     }
@@ -454,10 +652,20 @@ bool DrmMemoryManager::populateOsHandles(OsHandleStorage &handleStorage) {
             handleStorage.fragmentStorageData[i].osHandleStorage = new OsHandle();
             handleStorage.fragmentStorageData[i].residency = new ResidencyData();
 
-            handleStorage.fragmentStorageData[i].osHandleStorage->bo = allocUserptr((uintptr_t)handleStorage.fragmentStorageData[i].cpuPtr,
-                                                                                    handleStorage.fragmentStorageData[i].fragmentSize,
-                                                                                    0,
-                                                                                    true);
+            BufferObject *bo = nullptr;
+            if (userptrCache) {
+                bo = userptrCache->take(handleStorage.fragmentStorageData[i].cpuPtr, handleStorage.fragmentStorageData[i].fragmentSize);
+            }
+            if (!bo) {
+                bo = allocUserptr((uintptr_t)handleStorage.fragmentStorageData[i].cpuPtr,
+                                  handleStorage.fragmentStorageData[i].fragmentSize,
+                                  0,
+                                  true);
+                if (bo) {
+                    trackBufferObject(bo, BUDGET_USAGE_HOST_PTR);
+                }
+            }
+            handleStorage.fragmentStorageData[i].osHandleStorage->bo = bo;
             if (!handleStorage.fragmentStorageData[i].osHandleStorage->bo) {
                 handleStorage.fragmentStorageData[i].freeTheFragment = true;
                 return false;
@@ -472,10 +680,17 @@ void DrmMemoryManager::cleanOsHandles(OsHandleStorage &handleStorage) {
         if (handleStorage.fragmentStorageData[i].freeTheFragment) {
             if (handleStorage.fragmentStorageData[i].osHandleStorage->bo) {
                 BufferObject *search = handleStorage.fragmentStorageData[i].osHandleStorage->bo;
-                search->wait(-1);
-                auto refCount = unreference(search, true);
-                DEBUG_BREAK_IF(refCount != 1u);
-                ((void)(refCount));
+                if (userptrCache) {
+                    // keep the userptr object for the next transfer from the same host pointer
+                    std::vector<BufferObject *> evicted;
+                    userptrCache->store(search, evicted);
+                    releaseUserptrCacheEvictions(evicted);
+                } else {
+                    search->wait(-1);
+                    auto refCount = unreference(search, true);
+                    DEBUG_BREAK_IF(refCount != 1u);
+                    ((void)(refCount));
+                }
             }
             delete handleStorage.fragmentStorageData[i].osHandleStorage;
             delete handleStorage.fragmentStorageData[i].residency;
@@ -483,6 +698,61 @@ void DrmMemoryManager::cleanOsHandles(OsHandleStorage &handleStorage) {
     }
 }
 
+void DrmMemoryManager::releaseUserptrCacheEvictions(std::vector<BufferObject *> &evicted) {
+    for (auto bo : evicted) {
+        bo->wait(-1);
+        auto refCount = unreference(bo, true);
+        DEBUG_BREAK_IF(refCount != 1u);
+        ((void)(refCount));
+    }
+}
+
+void *DrmMemoryManager::reserveGpuRange(size_t size) {
+    // the range is never touched by the CPU, it only keeps the address out of reach of other mappings
+    auto gpuRange = mmapFunction(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (gpuRange == MAP_FAILED) {
+        return nullptr;
+    }
+    return gpuRange;
+}
+
+void DrmMemoryManager::releaseGpuRange(void *gpuRange, size_t size) {
+    munmapFunction(gpuRange, size);
+}
+
+void DrmMemoryManager::trackBufferObject(BufferObject *bo, BudgetUsageType type) {
+    bo->budgetUsageType = type;
+    memoryBudget.track(type, bo->peekSize());
+}
+
+void DrmMemoryManager::trimToBudget(size_t requiredSize) {
+    if (!memoryBudget.isExceeded(requiredSize)) {
+        return;
+    }
+    auto usedBefore = memoryBudget.peekUsed();
+
+    // idle objects go first: cached userptr objects and empty slabs back no allocation at all
+    if (userptrCache) {
+        std::vector<BufferObject *> evicted;
+        userptrCache->evictLeastRecentlyStored(memoryBudget.getBytesOverBudget(requiredSize), evicted);
+        releaseUserptrCacheEvictions(evicted);
+    }
+    if (slabAllocator && memoryBudget.isExceeded(requiredSize)) {
+        releaseCompletedSlabAllocations();
+        std::vector<BufferObject *> released;
+        slabAllocator->releaseEmptySlabs(released);
+        for (auto bo : released) {
+            unreference(bo);
+        }
+    }
+    if (memoryBudget.isExceeded(requiredSize)) {
+        releaseIdleAllocations(static_cast<size_t>(memoryBudget.getBytesOverBudget(requiredSize)));
+    }
+
+    auto usedAfter = memoryBudget.peekUsed();
+    memoryBudget.recordTrim(usedBefore > usedAfter ? usedBefore - usedAfter : 0);
+}
+
 BufferObject *DrmMemoryManager::getPinBB() const {
     return pinBB;
 }
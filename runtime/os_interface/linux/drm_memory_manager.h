@@ -24,7 +24,10 @@
 #include "drm_gem_close_worker.h"
 #include "runtime/memory_manager/memory_manager.h"
 #include "runtime/os_interface/linux/drm_allocation.h"
+#include "runtime/os_interface/linux/drm_memory_budget.h"
 #include "runtime/os_interface/linux/drm_neo.h"
+#include "runtime/os_interface/linux/drm_slab_allocator.h"
+#include "runtime/os_interface/linux/drm_userptr_cache.h"
 #include <map>
 #include <sys/mman.h>
 
@@ -60,6 +63,8 @@ class DrmMemoryManager : public MemoryManager {
     void unlockResource(GraphicsAllocation *graphicsAllocation) override{};
 
     uint64_t getSystemSharedMemory() override;
+    bool isMemoryBudgetExhausted() const override { return memoryBudget.isExceeded(0); }
+    DrmMemoryBudget::State getMemoryBudgetState() const { return memoryBudget.getState(); }
     uint64_t getMaxApplicationAddress() override;
 
     bool populateOsHandles(OsHandleStorage &handleStorage) override;
@@ -71,6 +76,13 @@ class DrmMemoryManager : public MemoryManager {
     // CloseWorker delegate
     void push(DrmAllocation *alloc);
 
+    DrmUserptrCache *peekUserptrCache() const { return userptrCache.get(); }
+    DrmSlabAllocator *peekSlabAllocator() const { return slabAllocator.get(); }
+
+    // Returns the range of an idle slab allocation to its slab and deletes it
+    void releaseSlabAllocation(DrmAllocation *allocation);
+    size_t peekNumPendingSlabAllocations() const { return pendingSlabAllocations.size(); }
+
     DrmAllocation *createGraphicsAllocation(OsHandleStorage &handleStorage, size_t hostPtrSize, const void *hostPtr) override;
 
   protected:
@@ -79,16 +91,36 @@ class DrmMemoryManager : public MemoryManager {
     void eraseSharedBufferObject(BufferObject *bo);
     void pushSharedBufferObject(BufferObject *bo);
     BufferObject *allocUserptr(uintptr_t address, size_t size, uint64_t flags, bool softpin);
+    void releaseUserptrCacheEvictions(std::vector<BufferObject *> &evicted);
+    DrmAllocation *allocateFromSlab(size_t size);
+    // releases freed slab allocations whose last submission has completed
+    void releaseCompletedSlabAllocations();
+    bool isSlabAllocationCompleted(uint32_t taskCount) const;
+    DrmAllocation *allocateWithHugePages(size_t size, bool forcePin);
+    void trackBufferObject(BufferObject *bo, BudgetUsageType type);
+    // reserves process address space that a softpinned object without a CPU mapping is placed at, nullptr on failure
+    void *reserveGpuRange(size_t size);
+    void releaseGpuRange(void *gpuRange, size_t size);
+    // releases idle objects and allocations while requiredSize more bytes would exceed the budget
+    void trimToBudget(size_t requiredSize);
 
     Drm *drm;
     BufferObject *pinBB;
     size_t pinThreshold = 8 * 1024 * 1024;
+    static const size_t hugePageSize = 2 * 1024 * 1024;
+    // allocations from this size up are backed by transparent huge pages, 0 when disabled
+    size_t hugePageThreshold = 0;
     std::unique_ptr<DrmGemCloseWorker> gemCloseWorker;
     decltype(&lseek) lseekFunction = lseek;
     decltype(&mmap) mmapFunction = mmap;
     decltype(&munmap) munmapFunction = munmap;
     decltype(&close) closeFunction = close;
+    decltype(&madvise) madviseFunction = madvise;
     std::vector<BufferObject *> sharingBufferObjects;
+    std::unique_ptr<DrmUserptrCache> userptrCache;
+    std::unique_ptr<DrmSlabAllocator> slabAllocator;
+    std::vector<DrmAllocation *> pendingSlabAllocations;
+    DrmMemoryBudget memoryBudget;
     std::recursive_mutex mtx;
 };
 } // namespace OCLRT
@@ -144,6 +144,22 @@ void Drm::obtainCoherencyDisablePatchActive() {
     }
 }
 
+void Drm::obtainExecBatchFirstSupported() {
+#if defined(I915_PARAM_HAS_EXEC_BATCH_FIRST)
+    drm_i915_getparam_t GPUParams;
+    int value = 0;
+
+    GPUParams.param = I915_PARAM_HAS_EXEC_BATCH_FIRST;
+    GPUParams.value = &value;
+
+    auto retVal = ioctl(DRM_IOCTL_I915_GETPARAM, &GPUParams);
+
+    if (retVal == 0) {
+        execBatchFirstSupported = value != 0;
+    }
+#endif
+}
+
 std::string Drm::getSysFsPciPath(int deviceID) {
     std::string nullPath;
     std::string sysFsPciDirectory = Os::sysFsPciPath;
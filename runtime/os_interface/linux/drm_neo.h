@@ -64,6 +64,8 @@ class Drm {
     bool setLowPriority();
     bool peekCoherencyDisablePatchActive() { return coherencyDisablePatchActive; }
     virtual void obtainCoherencyDisablePatchActive();
+    bool peekExecBatchFirstSupported() const { return execBatchFirstSupported; }
+    void obtainExecBatchFirstSupported();
     int getFileDescriptor() const { return fd; }
     bool contextCreate();
     void contextDestroy();
@@ -77,6 +79,7 @@ class Drm {
     int revisionId;
     GTTYPE eGtType;
     bool coherencyDisablePatchActive = false;
+    bool execBatchFirstSupported = false;
     Drm(int fd) : lowPriorityContextId(0), fd(fd), deviceId(0), revisionId(0), eGtType(GTTYPE_UNDEFINED) {}
     virtual ~Drm();
 
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/linux/drm_slab_allocator.h"
+#include "runtime/os_interface/linux/drm_buffer_object.h"
+
+#include <algorithm>
+
+namespace OCLRT {
+
+const size_t DrmSlabAllocator::defaultSlabSize;
+
+void *DrmSlabAllocator::allocate(size_t &size, DrmSlab *&slab) {
+    std::lock_guard<std::mutex> lock(mtx);
+    for (auto &candidate : slabs) {
+        auto ptr = allocateFromSlab(*candidate, size);
+        if (ptr) {
+            slab = candidate.get();
+            return ptr;
+        }
+    }
+    return nullptr;
+}
+
+void *DrmSlabAllocator::allocateFromNewSlab(BufferObject *bo, size_t &size, DrmSlab *&slab) {
+    std::lock_guard<std::mutex> lock(mtx);
+    slabs.emplace_back(new DrmSlab(bo, bo->peekAddress(), bo->peekSize()));
+    slab = slabs.back().get();
+    return allocateFromSlab(*slab, size);
+}
+
+BufferObject *DrmSlabAllocator::free(DrmSlab *slab, void *ptr, size_t size) {
+    std::lock_guard<std::mutex> lock(mtx);
+    slab->heap.free(ptr, size);
+    slab->usedSize -= size;
+    slab->allocationCount--;
+    if (slab->allocationCount != 0) {
+        return nullptr;
+    }
+
+    auto emptySlabs = std::count_if(slabs.begin(), slabs.end(), [](const std::unique_ptr<DrmSlab> &s) { return s->allocationCount == 0; });
+    if (emptySlabs < 2) {
+        return nullptr;
+    }
+
+    auto entry = std::find_if(slabs.begin(), slabs.end(), [slab](const std::unique_ptr<DrmSlab> &s) { return s.get() == slab; });
+    auto bo = slab->bo;
+    slabs.erase(entry);
+    return bo;
+}
+
+void DrmSlabAllocator::releaseEmptySlabs(std::vector<BufferObject *> &released) {
+    std::lock_guard<std::mutex> lock(mtx);
+    for (auto slab = slabs.begin(); slab != slabs.end();) {
+        if ((*slab)->allocationCount == 0) {
+            released.push_back((*slab)->bo);
+            slab = slabs.erase(slab);
+        } else {
+            ++slab;
+        }
+    }
+}
+
+void DrmSlabAllocator::releaseAll(std::vector<BufferObject *> &released) {
+    std::lock_guard<std::mutex> lock(mtx);
+    for (auto &slab : slabs) {
+        released.push_back(slab->bo);
+    }
+    slabs.clear();
+}
+
+void *DrmSlabAllocator::allocateFromSlab(DrmSlab &slab, size_t &size) {
+    if (slab.heap.getLeftSize() < size) {
+        return nullptr;
+    }
+    auto ptr = slab.heap.allocate(size);
+    if (ptr) {
+        slab.usedSize += size;
+        slab.allocationCount++;
+    }
+    return ptr;
+}
+} // namespace OCLRT
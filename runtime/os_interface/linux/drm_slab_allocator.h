@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/utilities/heap_allocator.h"
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace OCLRT {
+class BufferObject;
+
+struct DrmSlab {
+    DrmSlab(BufferObject *bo, void *address, size_t size) : bo(bo), heap(address, size) {}
+
+    BufferObject *bo;
+    HeapAllocator heap;
+    size_t usedSize = 0;
+    size_t allocationCount = 0;
+    // set while the parent object is already in the exec list being built, so sibling allocations add it once
+    bool resident = false;
+};
+
+// Carves small allocations out of large userptr buffer objects (slabs) shared by many graphics allocations.
+// The allocator only does the bookkeeping: the memory manager creates slab objects and releases the ones
+// handed back once their last allocation is freed. One empty slab is kept for reuse.
+class DrmSlabAllocator {
+  public:
+    static const size_t defaultSlabSize = 2 * 1024 * 1024;
+
+    DrmSlabAllocator(size_t slabSize, size_t maxAllocationSize) : slabSize(slabSize), maxAllocationSize(maxAllocationSize) {}
+    DrmSlabAllocator(const DrmSlabAllocator &) = delete;
+    DrmSlabAllocator &operator=(const DrmSlabAllocator &) = delete;
+
+    bool isSuitable(size_t size, size_t alignment) const {
+        return size <= maxAllocationSize && alignment <= MemoryConstants::pageSize;
+    }
+
+    void *allocate(size_t &size, DrmSlab *&slab);
+    void *allocateFromNewSlab(BufferObject *bo, size_t &size, DrmSlab *&slab);
+    BufferObject *free(DrmSlab *slab, void *ptr, size_t size);
+    void releaseEmptySlabs(std::vector<BufferObject *> &released);
+    void releaseAll(std::vector<BufferObject *> &released);
+
+    size_t getSlabSize() const { return slabSize; }
+    size_t peekNumSlabs() const { return slabs.size(); }
+
+  protected:
+    void *allocateFromSlab(DrmSlab &slab, size_t &size);
+
+    size_t slabSize;
+    size_t maxAllocationSize;
+    std::vector<std::unique_ptr<DrmSlab>> slabs;
+    std::mutex mtx;
+};
+} // namespace OCLRT
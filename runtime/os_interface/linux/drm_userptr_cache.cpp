@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/linux/drm_userptr_cache.h"
+#include "runtime/os_interface/linux/drm_buffer_object.h"
+
+#include <algorithm>
+
+namespace OCLRT {
+
+const uint64_t DrmUserptrCache::defaultMaxBytes;
+
+BufferObject *DrmUserptrCache::take(const void *address, size_t size) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto entry = entries.find(Key(reinterpret_cast<uintptr_t>(address), size));
+    if (entry == entries.end()) {
+        misses++;
+        return nullptr;
+    }
+    hits++;
+    auto bo = *entry->second;
+    lru.erase(entry->second);
+    entries.erase(entry);
+    bytes -= size;
+    return bo;
+}
+
+void DrmUserptrCache::store(BufferObject *bo, std::vector<BufferObject *> &evicted) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto size = bo->peekSize();
+    Key key(reinterpret_cast<uintptr_t>(bo->peekAddress()), size);
+    if (maxEntries == 0 || (maxBytes != 0 && size > maxBytes) || entries.find(key) != entries.end()) {
+        evicted.push_back(bo);
+        return;
+    }
+
+    lru.push_front(bo);
+    entries.insert(std::make_pair(key, lru.begin()));
+    bytes += size;
+    maxEntrySize = std::max(maxEntrySize, size);
+
+    while (entries.size() > maxEntries || (maxBytes != 0 && bytes > maxBytes)) {
+        auto oldest = lru.back();
+        evict(entries.find(Key(reinterpret_cast<uintptr_t>(oldest->peekAddress()), oldest->peekSize())), evicted);
+    }
+}
+
+void DrmUserptrCache::invalidate(const void *address, size_t size, std::vector<BufferObject *> &evicted) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto start = reinterpret_cast<uintptr_t>(address);
+    auto end = start + size;
+    // no cached range is longer than maxEntrySize, so earlier keys cannot reach the invalidated range
+    auto entry = entries.lower_bound(Key(start > maxEntrySize ? start - maxEntrySize : 0, 0));
+    while (entry != entries.end() && entry->first.first < end) {
+        auto current = entry++;
+        if (current->first.first + current->first.second > start) {
+            evict(current, evicted);
+        }
+    }
+}
+
+void DrmUserptrCache::evictAll(std::vector<BufferObject *> &evicted) {
+    std::lock_guard<std::mutex> lock(mtx);
+    while (!entries.empty()) {
+        evict(entries.begin(), evicted);
+    }
+}
+
+void DrmUserptrCache::evictLeastRecentlyStored(uint64_t bytesToRelease, std::vector<BufferObject *> &evicted) {
+    std::lock_guard<std::mutex> lock(mtx);
+    uint64_t released = 0;
+    while (released < bytesToRelease && !lru.empty()) {
+        auto oldest = lru.back();
+        released += oldest->peekSize();
+        evict(entries.find(Key(reinterpret_cast<uintptr_t>(oldest->peekAddress()), oldest->peekSize())), evicted);
+    }
+}
+
+void DrmUserptrCache::evict(std::map<Key, LruList::iterator>::iterator entry, std::vector<BufferObject *> &evicted) {
+    evicted.push_back(*entry->second);
+    bytes -= entry->first.second;
+    lru.erase(entry->second);
+    entries.erase(entry);
+}
+} // namespace OCLRT
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace OCLRT {
+class BufferObject;
+
+// Bounded LRU cache of userptr buffer objects of released host pointer fragments, keyed by (address, size).
+// Userptr objects are created without I915_USERPTR_UNSYNCHRONIZED, so the kernel keeps them coherent with the
+// process address space: pages are dropped on munmap and reacquired on next use, and a cached object stays
+// valid for whatever gets mapped at its address. Objects evicted from the cache are handed back to the caller.
+class DrmUserptrCache {
+  public:
+    static const uint64_t defaultMaxBytes = 64 * 1024 * 1024;
+
+    DrmUserptrCache(size_t maxEntries, uint64_t maxBytes) : maxEntries(maxEntries), maxBytes(maxBytes) {}
+    DrmUserptrCache(const DrmUserptrCache &) = delete;
+    DrmUserptrCache &operator=(const DrmUserptrCache &) = delete;
+
+    BufferObject *take(const void *address, size_t size);
+    void store(BufferObject *bo, std::vector<BufferObject *> &evicted);
+    void invalidate(const void *address, size_t size, std::vector<BufferObject *> &evicted);
+    void evictAll(std::vector<BufferObject *> &evicted);
+    void evictLeastRecentlyStored(uint64_t bytesToRelease, std::vector<BufferObject *> &evicted);
+
+    size_t peekNumEntries() const { return entries.size(); }
+    uint64_t peekBytes() const { return bytes; }
+    uint64_t peekHits() const { return hits; }
+    uint64_t peekMisses() const { return misses; }
+
+  protected:
+    using Key = std::pair<uintptr_t, size_t>;
+    using LruList = std::list<BufferObject *>;
+
+    void evict(std::map<Key, LruList::iterator>::iterator entry, std::vector<BufferObject *> &evicted);
+
+    size_t maxEntries;
+    uint64_t maxBytes;
+    uint64_t bytes = 0;
+    size_t maxEntrySize = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+
+    // most recently stored at front
+    LruList lru;
+    std::map<Key, LruList::iterator> entries;
+    std::mutex mtx;
+};
+} // namespace OCLRT
@@ -130,6 +130,7 @@ int HwInfoConfig::configureHwInfo(const HardwareInfo *inHwInfo, HardwareInfo *ou
     pSysInfo->SubSliceCount = static_cast<uint32_t>(subSliceCount);
 
     drm->obtainCoherencyDisablePatchActive();
+    drm->obtainExecBatchFirstSupported();
     pSkuTable->ftrSVM = drm->is48BitAddressRangeSupported();
 
     int maxGpuFreq = 0;
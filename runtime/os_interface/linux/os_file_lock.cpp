@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/linux/os_file_lock.h"
+#include <cerrno>
+#include <fcntl.h>
+#include <new>
+#include <sys/file.h>
+#include <unistd.h>
+
+namespace OCLRT {
+OsFileLock *OsFileLock::lock(const std::string &fileName) {
+    auto ptr = new (std::nothrow) Linux::OsFileLock(fileName);
+    if (ptr == nullptr)
+        return nullptr;
+
+    if (!ptr->isLocked()) {
+        delete ptr;
+        return nullptr;
+    }
+    return ptr;
+}
+namespace Linux {
+
+OsFileLock::OsFileLock(const std::string &fileName) {
+    fd = ::open(fileName.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+    if (fd < 0) {
+        return;
+    }
+
+    int ret;
+    do {
+        ret = flock(fd, LOCK_EX);
+    } while (ret != 0 && errno == EINTR);
+    locked = (ret == 0);
+}
+
+OsFileLock::~OsFileLock() {
+    if (fd >= 0) {
+        // closing the descriptor releases the lock
+        ::close(fd);
+        fd = -1;
+    }
+    locked = false;
+}
+} // namespace Linux
+} // namespace OCLRT
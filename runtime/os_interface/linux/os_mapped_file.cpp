@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/linux/os_mapped_file.h"
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace OCLRT {
+OsMappedFile *OsMappedFile::open(const std::string &fileName) {
+    auto ptr = new (std::nothrow) Linux::OsMappedFile(fileName);
+    if (ptr == nullptr)
+        return nullptr;
+
+    if (!ptr->isMapped()) {
+        delete ptr;
+        return nullptr;
+    }
+    return ptr;
+}
+namespace Linux {
+
+OsMappedFile::OsMappedFile(const std::string &fileName) {
+    int fd = ::open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return;
+    }
+
+    struct stat fileStat = {};
+    if ((fstat(fd, &fileStat) == 0) && (fileStat.st_size > 0)) {
+        auto mapped = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED) {
+            this->data = mapped;
+            this->size = static_cast<size_t>(fileStat.st_size);
+        }
+    }
+
+    // mapping stays valid after the descriptor is closed
+    ::close(fd);
+}
+
+OsMappedFile::~OsMappedFile() {
+    if (this->data != nullptr) {
+        munmap(this->data, this->size);
+        this->data = nullptr;
+        this->size = 0;
+    }
+}
+} // namespace Linux
+} // namespace OCLRT
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace OCLRT {
+
+// Private, copy-on-write mapping of a whole file. Multiple processes mapping the same file
+// share its page cache pages, so no heap copy of the content is needed. Pages written
+// through the mapping (e.g. kernel headers patched for instrumentation) get private copies,
+// the file itself is never modified.
+class OsMappedFile {
+  protected:
+    OsMappedFile() = default;
+
+  public:
+    virtual ~OsMappedFile() = default;
+
+    static OsMappedFile *open(const std::string &fileName);
+
+    virtual const void *getData() const = 0;
+    virtual size_t getSize() const = 0;
+    virtual bool isMapped() const = 0;
+};
+} // namespace OCLRT
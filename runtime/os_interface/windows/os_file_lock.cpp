@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/windows/os_file_lock.h"
+#include <new>
+
+namespace OCLRT {
+OsFileLock *OsFileLock::lock(const std::string &fileName) {
+    auto ptr = new (std::nothrow) Windows::OsFileLock(fileName);
+    if (ptr == nullptr)
+        return nullptr;
+
+    if (!ptr->isLocked()) {
+        delete ptr;
+        return nullptr;
+    }
+    return ptr;
+}
+namespace Windows {
+
+OsFileLock::OsFileLock(const std::string &fileName) {
+    file = ::CreateFileA(fileName.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                         nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+
+    OVERLAPPED overlapped = {};
+    locked = (::LockFileEx(file, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &overlapped) != FALSE);
+}
+
+OsFileLock::~OsFileLock() {
+    if (file != INVALID_HANDLE_VALUE) {
+        if (locked) {
+            OVERLAPPED overlapped = {};
+            ::UnlockFileEx(file, 0, MAXDWORD, MAXDWORD, &overlapped);
+        }
+        ::CloseHandle(file);
+        file = INVALID_HANDLE_VALUE;
+    }
+    locked = false;
+}
+} // namespace Windows
+} // namespace OCLRT
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/windows/os_mapped_file.h"
+#include <new>
+
+namespace OCLRT {
+OsMappedFile *OsMappedFile::open(const std::string &fileName) {
+    auto ptr = new (std::nothrow) Windows::OsMappedFile(fileName);
+    if (ptr == nullptr)
+        return nullptr;
+
+    if (!ptr->isMapped()) {
+        delete ptr;
+        return nullptr;
+    }
+    return ptr;
+}
+namespace Windows {
+
+OsMappedFile::OsMappedFile(const std::string &fileName) {
+    HANDLE file = ::CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                                nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+
+    LARGE_INTEGER fileSize = {};
+    if (::GetFileSizeEx(file, &fileSize) && (fileSize.QuadPart > 0)) {
+        HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+        if (mapping != nullptr) {
+            this->data = ::MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+            if (this->data != nullptr) {
+                this->size = static_cast<size_t>(fileSize.QuadPart);
+            }
+            // view keeps the mapping object alive
+            ::CloseHandle(mapping);
+        }
+    }
+    ::CloseHandle(file);
+}
+
+OsMappedFile::~OsMappedFile() {
+    if (this->data != nullptr) {
+        ::UnmapViewOfFile(this->data);
+        this->data = nullptr;
+        this->size = 0;
+    }
+}
+} // namespace Windows
+} // namespace OCLRT
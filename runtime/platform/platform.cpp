@@ -31,6 +31,7 @@
 #include "runtime/helpers/string.h"
 #include "runtime/os_interface/device_factory.h"
 #include "runtime/event/async_events_handler.h"
+#include "runtime/program/async_build_handler.h"
 #include "runtime/sharings/sharing_factory.h"
 #include "runtime/platform/extensions.h"
 #include "CL/cl_ext.h"
@@ -156,6 +157,10 @@ bool Platform::initialize(size_t numDevices,
 
     this->fillGlobalDispatchTable();
 
+    if (asyncBuildHandler == nullptr) {
+        createAsyncBuildHandler(new AsyncBuildHandler());
+    }
+
     state = StateInited;
     return true;
 }
@@ -172,6 +177,9 @@ bool Platform::isInitialized() {
 
 void Platform::shutdown() {
     asyncEventsHandler->closeThread();
+    if (asyncBuildHandler) {
+        asyncBuildHandler->closeThreads();
+    }
     TakeOwnershipWrapper<Platform> platformOwnership(*this);
 
     if (state == StateNone) {
@@ -237,4 +245,12 @@ void Platform::createAsyncEventsHandler(AsyncEventsHandler *handler) {
     asyncEventsHandler.reset(handler);
 }
 
+AsyncBuildHandler *Platform::getAsyncBuildHandler() {
+    return asyncBuildHandler.get();
+}
+
+void Platform::createAsyncBuildHandler(AsyncBuildHandler *handler) {
+    asyncBuildHandler.reset(handler);
+}
+
 } // namespace OCLRT
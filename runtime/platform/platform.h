@@ -34,6 +34,7 @@ namespace OCLRT {
 class CompilerInterface;
 class Device;
 class AsyncEventsHandler;
+class AsyncBuildHandler;
 struct HardwareInfo;
 
 template <>
@@ -67,6 +68,8 @@ class Platform : public BaseObject<_cl_platform_id> {
     const PlatformInfo &getPlatformInfo() const;
     AsyncEventsHandler *getAsyncEventsHandler();
     void createAsyncEventsHandler(AsyncEventsHandler *handler);
+    AsyncBuildHandler *getAsyncBuildHandler();
+    void createAsyncBuildHandler(AsyncBuildHandler *handler);
 
   protected:
     enum {
@@ -81,6 +84,7 @@ class Platform : public BaseObject<_cl_platform_id> {
     DeviceVector devices;
     std::string compilerExtensions;
     std::unique_ptr<AsyncEventsHandler> asyncEventsHandler;
+    std::unique_ptr<AsyncBuildHandler> asyncBuildHandler;
 };
 
 Platform *platform();
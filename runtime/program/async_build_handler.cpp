@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/program/async_build_handler.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+#include <algorithm>
+
+namespace OCLRT {
+
+AsyncBuildHandler::AsyncBuildHandler() : AsyncBuildHandler(getDefaultThreadsCount()) {
+}
+
+AsyncBuildHandler::AsyncBuildHandler(uint32_t maxThreadsCount) : maxThreadsCount(maxThreadsCount) {
+}
+
+AsyncBuildHandler::~AsyncBuildHandler() {
+    closeThreads();
+}
+
+uint32_t AsyncBuildHandler::getDefaultThreadsCount() {
+    if (DebugManager.flags.AsyncBuildThreadsCount.get() != -1) {
+        return static_cast<uint32_t>(std::max(0, DebugManager.flags.AsyncBuildThreadsCount.get()));
+    }
+    auto hwThreads = std::thread::hardware_concurrency();
+    return std::max(1u, std::min(hwThreads, 4u));
+}
+
+void AsyncBuildHandler::enqueueBuild(BuildTask task) {
+    std::unique_lock<std::mutex> lock(buildMtx);
+    if ((allowAsyncProcess == false) || (maxThreadsCount == 0)) {
+        lock.unlock();
+        task();
+        return;
+    }
+
+    buildQueue.push_back(std::move(task));
+    pendingBuilds++;
+    // create another thread only when all existing ones are busy
+    if ((threads.size() < maxThreadsCount) && (pendingBuilds > threads.size())) {
+        openThread();
+    }
+    buildCond.notify_one();
+}
+
+void AsyncBuildHandler::openThread() {
+    threads.emplace_back([this] { processBuilds(); });
+}
+
+void AsyncBuildHandler::processBuilds() {
+    std::unique_lock<std::mutex> lock(buildMtx);
+    while (true) {
+        buildCond.wait(lock, [this] { return !buildQueue.empty() || !allowAsyncProcess; });
+        if (buildQueue.empty()) {
+            break;
+        }
+
+        auto task = std::move(buildQueue.front());
+        buildQueue.pop_front();
+        lock.unlock();
+
+        task();
+
+        lock.lock();
+        pendingBuilds--;
+        if (pendingBuilds == 0) {
+            buildsDoneCond.notify_all();
+        }
+    }
+}
+
+void AsyncBuildHandler::waitForBuilds() {
+    std::unique_lock<std::mutex> lock(buildMtx);
+    buildsDoneCond.wait(lock, [this] { return pendingBuilds == 0; });
+}
+
+void AsyncBuildHandler::closeThreads() {
+    std::vector<std::thread> threadsToJoin;
+    {
+        std::unique_lock<std::mutex> lock(buildMtx);
+        // queued builds are still completed, so every registered callback gets called
+        buildsDoneCond.wait(lock, [this] { return pendingBuilds == 0; });
+        allowAsyncProcess = false;
+        threadsToJoin.swap(threads);
+        buildCond.notify_all();
+    }
+
+    for (auto &thread : threadsToJoin) {
+        thread.join();
+    }
+
+    std::lock_guard<std::mutex> lock(buildMtx);
+    allowAsyncProcess = true;
+}
+
+size_t AsyncBuildHandler::getThreadsCount() const {
+    std::lock_guard<std::mutex> lock(buildMtx);
+    return threads.size();
+}
+} // namespace OCLRT
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OCLRT {
+
+// Pool of compile threads used by clBuildProgram when a notification callback is supplied.
+// Threads are created on first use; closeThreads waits for all queued builds to finish.
+class AsyncBuildHandler {
+  public:
+    using BuildTask = std::function<void()>;
+
+    AsyncBuildHandler();
+    AsyncBuildHandler(uint32_t maxThreadsCount);
+    virtual ~AsyncBuildHandler();
+
+    AsyncBuildHandler(const AsyncBuildHandler &) = delete;
+    AsyncBuildHandler &operator=(const AsyncBuildHandler &) = delete;
+
+    bool isAsyncBuildEnabled() const {
+        return maxThreadsCount > 0;
+    }
+
+    MOCKABLE_VIRTUAL void enqueueBuild(BuildTask task);
+    void waitForBuilds();
+    void closeThreads();
+
+    size_t getThreadsCount() const;
+
+  protected:
+    static uint32_t getDefaultThreadsCount();
+    void openThread();
+    void processBuilds();
+
+    uint32_t maxThreadsCount;
+    uint32_t pendingBuilds = 0;
+    bool allowAsyncProcess = true;
+    std::deque<BuildTask> buildQueue;
+    std::vector<std::thread> threads;
+    mutable std::mutex buildMtx;
+    std::condition_variable buildCond;
+    std::condition_variable buildsDoneCond;
+};
+} // namespace OCLRT
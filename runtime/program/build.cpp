@@ -24,6 +24,7 @@
 #include "runtime/compiler_interface/compiler_interface.h"
 #include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/platform/platform.h"
+#include "runtime/program/async_build_handler.h"
 #include "runtime/helpers/validators.h"
 #include "program.h"
 #include <cstring>
@@ -37,37 +38,104 @@ cl_int Program::build(
     void(CL_CALLBACK *funcNotify)(cl_program program, void *userData),
     void *userData,
     bool enableCaching) {
-    cl_int retVal = CL_SUCCESS;
+    cl_int retVal = validateBuildArgs(numDevices, deviceList, funcNotify, userData);
 
-    do {
-        if (((deviceList == nullptr) && (numDevices != 0)) ||
-            ((deviceList != nullptr) && (numDevices == 0))) {
-            retVal = CL_INVALID_VALUE;
-            break;
-        }
+    // invalid arguments and a build already in progress return without touching the build status
+    if (retVal != CL_SUCCESS) {
+        return retVal;
+    }
 
-        if ((funcNotify == nullptr) &&
-            (userData != nullptr)) {
-            retVal = CL_INVALID_VALUE;
-            break;
-        }
+    if (tryStartBuild() == false) {
+        return CL_INVALID_OPERATION;
+    }
 
-        // if a device_list is specified, make sure it points to our device
-        // NOTE: a null device_list is ok - it means "all devices"
-        if (deviceList && validateObject(*deviceList) != CL_SUCCESS) {
-            retVal = CL_INVALID_DEVICE;
-            break;
-        }
+    retVal = buildImpl(buildOptions, enableCaching);
 
-        // check to see if a previous build request is in progress
-        if (buildStatus == CL_BUILD_IN_PROGRESS) {
-            retVal = CL_INVALID_OPERATION;
-            break;
+    finishBuild(retVal, funcNotify, userData);
+
+    return retVal;
+}
+
+cl_int Program::buildAsync(
+    cl_uint numDevices,
+    const cl_device_id *deviceList,
+    const char *buildOptions,
+    void(CL_CALLBACK *funcNotify)(cl_program program, void *userData),
+    void *userData,
+    bool enableCaching,
+    AsyncBuildHandler &asyncBuildHandler) {
+    DEBUG_BREAK_IF(funcNotify == nullptr);
+    cl_int retVal = validateBuildArgs(numDevices, deviceList, funcNotify, userData);
+
+    // invalid arguments and a build already in progress return without touching the build status
+    if (retVal != CL_SUCCESS) {
+        return retVal;
+    }
+
+    if (tryStartBuild() == false) {
+        return CL_INVALID_OPERATION;
+    }
+
+    // options buffer is owned by the application and may be released after returning
+    std::string asyncBuildOptions = (buildOptions) ? buildOptions : "";
+
+    // keep program alive until notification is done, even if application releases it meanwhile
+    this->incRefInternal();
+    asyncBuildHandler.enqueueBuild([this, asyncBuildOptions, funcNotify, userData, enableCaching]() {
+        auto buildRetVal = this->buildImpl(asyncBuildOptions.c_str(), enableCaching);
+        this->finishBuild(buildRetVal, funcNotify, userData);
+        this->decRefInternal();
+    });
+
+    return CL_SUCCESS;
+}
+
+cl_int Program::validateBuildArgs(
+    cl_uint numDevices,
+    const cl_device_id *deviceList,
+    void(CL_CALLBACK *funcNotify)(cl_program program, void *userData),
+    void *userData) const {
+    if (((deviceList == nullptr) && (numDevices != 0)) ||
+        ((deviceList != nullptr) && (numDevices == 0))) {
+        return CL_INVALID_VALUE;
+    }
+
+    if ((funcNotify == nullptr) &&
+        (userData != nullptr)) {
+        return CL_INVALID_VALUE;
+    }
+
+    // if a device_list is specified, make sure it points to our device
+    // NOTE: a null device_list is ok - it means "all devices"
+    if (deviceList && validateObject(*deviceList) != CL_SUCCESS) {
+        return CL_INVALID_DEVICE;
+    }
+
+    // check to see if a previous build request is in progress
+    if (buildStatus == CL_BUILD_IN_PROGRESS) {
+        return CL_INVALID_OPERATION;
+    }
+
+    return CL_SUCCESS;
+}
+
+bool Program::tryStartBuild() {
+    auto currentStatus = buildStatus.load();
+    do {
+        if (currentStatus == CL_BUILD_IN_PROGRESS) {
+            return false;
         }
+    } while (buildStatus.compare_exchange_weak(currentStatus, CL_BUILD_IN_PROGRESS) == false);
+    return true;
+}
 
-        if (isCreatedFromBinary == false) {
-            buildStatus = CL_BUILD_IN_PROGRESS;
+cl_int Program::buildImpl(
+    const char *buildOptions,
+    bool enableCaching) {
+    cl_int retVal = CL_SUCCESS;
 
+    do {
+        if (isCreatedFromBinary == false) {
             options = (buildOptions) ? buildOptions : "";
             std::string reraStr = "-cl-intel-gtpin-rera";
             size_t pos = options.find(reraStr);
@@ -78,6 +146,8 @@ cl_int Program::build(
                 internalOptions.append(reraStr);
                 internalOptions.append(" ");
             }
+            // handled by the runtime only, the compiler does not know it
+            embedKernelInfo = extractOption(options, clOptNameEmbedKernelInfo);
 
             CompilerInterface *pCompilerInterface = getCompilerInterface();
             if (!pCompilerInterface) {
@@ -119,6 +189,13 @@ cl_int Program::build(
         separateBlockKernels();
     } while (false);
 
+    return retVal;
+}
+
+void Program::finishBuild(
+    cl_int retVal,
+    void(CL_CALLBACK *funcNotify)(cl_program program, void *userData),
+    void *userData) {
     if (retVal != CL_SUCCESS) {
         buildStatus = CL_BUILD_ERROR;
         programBinaryType = CL_PROGRAM_BINARY_TYPE_NONE;
@@ -130,8 +207,6 @@ cl_int Program::build(
     if (funcNotify != nullptr) {
         (*funcNotify)(this, userData);
     }
-
-    return retVal;
 }
 
 cl_int Program::build(const cl_device_id device, const char *buildOptions, bool enableCaching,
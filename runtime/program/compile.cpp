@@ -46,45 +46,38 @@ cl_int Program::compile(
     size_t compileDataSize;
     char *pCompileData = nullptr;
 
-    do {
-        if (((deviceList == nullptr) && (numDevices != 0)) ||
-            ((deviceList != nullptr) && (numDevices == 0))) {
-            retVal = CL_INVALID_VALUE;
-            break;
-        }
+    if (((deviceList == nullptr) && (numDevices != 0)) ||
+        ((deviceList != nullptr) && (numDevices == 0))) {
+        return CL_INVALID_VALUE;
+    }
 
-        if (numInputHeaders == 0) {
-            if ((headerIncludeNames != nullptr) || (inputHeaders != nullptr)) {
-                retVal = CL_INVALID_VALUE;
-                break;
-            }
-        } else {
-            if ((headerIncludeNames == nullptr) || (inputHeaders == nullptr)) {
-                retVal = CL_INVALID_VALUE;
-                break;
-            }
+    if (numInputHeaders == 0) {
+        if ((headerIncludeNames != nullptr) || (inputHeaders != nullptr)) {
+            return CL_INVALID_VALUE;
         }
-
-        if ((funcNotify == nullptr) &&
-            (userData != nullptr)) {
-            retVal = CL_INVALID_VALUE;
-            break;
+    } else {
+        if ((headerIncludeNames == nullptr) || (inputHeaders == nullptr)) {
+            return CL_INVALID_VALUE;
         }
+    }
 
-        // if a device_list is specified, make sure it points to our device
-        // NOTE: a null device_list is ok - it means "all devices"
-        if ((deviceList != nullptr) && validateObject(*deviceList) != CL_SUCCESS) {
-            retVal = CL_INVALID_DEVICE;
-            break;
-        }
+    if ((funcNotify == nullptr) &&
+        (userData != nullptr)) {
+        return CL_INVALID_VALUE;
+    }
 
-        if (buildStatus == CL_BUILD_IN_PROGRESS) {
-            retVal = CL_INVALID_OPERATION;
-            break;
-        }
+    // if a device_list is specified, make sure it points to our device
+    // NOTE: a null device_list is ok - it means "all devices"
+    if ((deviceList != nullptr) && validateObject(*deviceList) != CL_SUCCESS) {
+        return CL_INVALID_DEVICE;
+    }
 
-        buildStatus = CL_BUILD_IN_PROGRESS;
+    // the checks above and a build already in progress return without touching the build status
+    if (tryStartBuild() == false) {
+        return CL_INVALID_OPERATION;
+    }
 
+    do {
         options = (buildOptions != nullptr) ? buildOptions : "";
         std::string reraStr = "-cl-intel-gtpin-rera";
         size_t pos = options.find(reraStr);
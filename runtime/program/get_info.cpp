@@ -38,6 +38,7 @@ cl_int Program::getInfo(cl_program_info paramName, size_t paramValueSize,
     cl_device_id device_id = pDevice;
     cl_uint refCount = 0;
     size_t numKernels;
+    size_t noBinarySize = 0;
     cl_context clContext = context;
 
     switch (paramName) {
@@ -47,9 +48,20 @@ cl_int Program::getInfo(cl_program_info paramName, size_t paramValueSize,
         break;
 
     case CL_PROGRAM_BINARIES:
+        retSize = sizeof(void **);
+        if (isBuildInProgress()) {
+            // the binary of a build in progress is not available yet and its size is reported as 0,
+            // so there is nothing to copy
+            if ((paramValue != nullptr) && (paramValueSize < retSize)) {
+                retVal = CL_INVALID_VALUE;
+            }
+            if (paramValueSizeRet) {
+                *paramValueSizeRet = retSize;
+            }
+            return retVal;
+        }
         resolveProgramBinary();
         pSrc = elfBinary;
-        retSize = sizeof(void **);
         srcSize = elfBinarySize;
         if (paramValue != nullptr) {
             if (paramValueSize < retSize) {
@@ -62,29 +74,34 @@ cl_int Program::getInfo(cl_program_info paramName, size_t paramValueSize,
         break;
 
     case CL_PROGRAM_BINARY_SIZES:
-        resolveProgramBinary();
-        pSrc = &elfBinarySize;
+        // the binary of a build in progress is not available yet
+        if (isBuildInProgress() == false) {
+            resolveProgramBinary();
+            pSrc = &elfBinarySize;
+        } else {
+            pSrc = &noBinarySize;
+        }
         retSize = srcSize = sizeof(size_t *);
         break;
 
     case CL_PROGRAM_KERNEL_NAMES:
+        if (buildStatus != CL_BUILD_SUCCESS) {
+            retVal = CL_INVALID_PROGRAM_EXECUTABLE;
+            break;
+        }
         kernelNamesString = getKernelNamesString();
         pSrc = kernelNamesString.c_str();
         retSize = srcSize = kernelNamesString.length() + 1;
+        break;
 
+    case CL_PROGRAM_NUM_KERNELS:
         if (buildStatus != CL_BUILD_SUCCESS) {
             retVal = CL_INVALID_PROGRAM_EXECUTABLE;
+            break;
         }
-        break;
-
-    case CL_PROGRAM_NUM_KERNELS:
         numKernels = kernelInfoArray.size();
         pSrc = &numKernels;
         retSize = srcSize = sizeof(numKernels);
-
-        if (buildStatus != CL_BUILD_SUCCESS) {
-            retVal = CL_INVALID_PROGRAM_EXECUTABLE;
-        }
         break;
 
     case CL_PROGRAM_NUM_DEVICES:
@@ -172,11 +189,12 @@ cl_int Program::getBuildInfo(cl_device_id device, cl_program_build_info paramNam
     }
 
     auto pDev = castToObject<Device>(device);
+    cl_build_status currentBuildStatus = buildStatus;
 
     switch (paramName) {
     case CL_PROGRAM_BUILD_STATUS:
         srcSize = retSize = sizeof(cl_build_status);
-        pSrc = &buildStatus;
+        pSrc = &currentBuildStatus;
         break;
 
     case CL_PROGRAM_BUILD_OPTIONS:
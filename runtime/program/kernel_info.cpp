@@ -207,6 +207,8 @@ void WorkSizeInfo::checkRatio(const size_t workItems[3]) {
     }
 }
 
+std::atomic<uint64_t> KernelInfo::kernelIsaKeyCounter(0);
+
 KernelInfo *KernelInfo::create() {
     return new KernelInfo();
 }
@@ -456,6 +458,17 @@ cl_int KernelInfo::resolveKernelInfo() {
     return retVal;
 }
 
+bool KernelInfo::hasKnownArgQualifiers(const SPatchKernelArgumentInfo *pkernelArgInfo) {
+    auto pAddressQualifier = ptrOffset(reinterpret_cast<const char *>(pkernelArgInfo), sizeof(SPatchKernelArgumentInfo));
+    auto pAccessQualifier = ptrOffset(pAddressQualifier, pkernelArgInfo->AddressQualifierSize);
+
+    std::string addressQualifierStr(pAddressQualifier, strnlen(pAddressQualifier, pkernelArgInfo->AddressQualifierSize));
+    std::string accessQualifierStr(pAccessQualifier, strnlen(pAccessQualifier, pkernelArgInfo->AccessQualifierSize));
+
+    return (addressQualifierMap.find(addressQualifierStr) != addressQualifierMap.end()) &&
+           (accessQualifierMap.find(accessQualifierStr) != accessQualifierMap.end());
+}
+
 void KernelInfo::storeKernelArgPatchInfo(uint32_t argNum, uint32_t dataSize, uint32_t dataOffset, uint32_t sourceOffset, uint32_t offsetSSH) {
     resizeKernelArgInfoAndRegisterParameter(argNum);
 
@@ -29,6 +29,7 @@
 #include "runtime/helpers/hw_info.h"
 #include "runtime/helpers/dispatch_info.h"
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cmath>
 #include <vector>
@@ -60,6 +61,9 @@ struct WorkloadInfo {
     uint32_t simdSizeOffset;
     uint32_t parentEventOffset;
     uint32_t prefferedWkgMultipleOffset;
+    uint32_t privateMemoryStatelessSizeOffset;
+    uint32_t localMemoryStatelessWindowSizeOffset;
+    uint32_t localMemoryStatelessWindowStartAddressOffset;
 
     static const uint32_t undefinedOffset;
     static const uint32_t invalidParentEvent;
@@ -88,6 +92,9 @@ struct WorkloadInfo {
         simdSizeOffset = undefinedOffset;
         parentEventOffset = undefinedOffset;
         prefferedWkgMultipleOffset = undefinedOffset;
+        privateMemoryStatelessSizeOffset = undefinedOffset;
+        localMemoryStatelessWindowSizeOffset = undefinedOffset;
+        localMemoryStatelessWindowStartAddressOffset = undefinedOffset;
     }
 };
 
@@ -129,6 +136,7 @@ struct KernelInfo {
         reqdWorkGroupSize[0] = WorkloadInfo::undefinedOffset;
         reqdWorkGroupSize[1] = WorkloadInfo::undefinedOffset;
         reqdWorkGroupSize[2] = WorkloadInfo::undefinedOffset;
+        regenerateKernelIsaKey();
     }
 
     KernelInfo(const KernelInfo &) = delete;
@@ -153,6 +161,7 @@ struct KernelInfo {
     void storePatchToken(const SPatchString *pStringArg);
     void storePatchToken(const SPatchKernelAttributesInfo *pKernelAttributesInfo);
     cl_int resolveKernelInfo();
+    static bool hasKnownArgQualifiers(const SPatchKernelArgumentInfo *pkernelArgInfo);
     void resizeKernelArgInfoAndRegisterParameter(uint32_t argCount) {
         if (kernelArgInfo.size() <= argCount) {
             kernelArgInfo.resize(argCount + 1);
@@ -187,6 +196,10 @@ struct KernelInfo {
 
         return 8;
     }
+    // to be called whenever the kernel heap changes, so that ISA copies cached under the old key are not reused
+    void regenerateKernelIsaKey() {
+        kernelIsaKey = ++kernelIsaKeyCounter;
+    }
     bool hasDeviceEnqueue() const {
         return patchInfo.executionEnvironment ? !!patchInfo.executionEnvironment->HasDeviceEnqueue : false;
     }
@@ -228,6 +241,7 @@ struct KernelInfo {
     bool requiresSshForBuffers = false;
     bool isValid = false;
     bool isVmeWorkload = false;
+    bool isPatchListDecoded = true;
     char *crossThreadData = nullptr;
     size_t reqdWorkGroupSize[3];
     size_t requiredSubGroupSize = 0;
@@ -236,5 +250,10 @@ struct KernelInfo {
     uint32_t argumentsToPatchNum = 0;
     uint32_t systemKernelOffset = 0;
     uint64_t kernelId = 0;
+    // unique for the whole process lifetime, so that a cached ISA can't be mistaken for a later kernel's
+    uint64_t kernelIsaKey = 0;
+
+  protected:
+    static std::atomic<uint64_t> kernelIsaKeyCounter;
 };
 } // namespace OCLRT
@@ -0,0 +1,520 @@
+/*
+ * Copyright (c) 2017, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/hash.h"
+#include "runtime/helpers/ptr_math.h"
+#include "runtime/helpers/string.h"
+#include "runtime/program/kernel_info_image.h"
+#include "runtime/program/program.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace OCLRT {
+
+static uint32_t WorkloadInfo::*const workloadInfoOffsets[] = {
+    &WorkloadInfo::maxWorkGroupSizeOffset,
+    &WorkloadInfo::workDimOffset,
+    &WorkloadInfo::slmStaticSize,
+    &WorkloadInfo::simdSizeOffset,
+    &WorkloadInfo::parentEventOffset,
+    &WorkloadInfo::prefferedWkgMultipleOffset,
+    &WorkloadInfo::privateMemoryStatelessSizeOffset,
+    &WorkloadInfo::localMemoryStatelessWindowSizeOffset,
+    &WorkloadInfo::localMemoryStatelessWindowStartAddressOffset};
+
+static uint32_t(WorkloadInfo::*const workloadInfoOffsetArrays[])[3] = {
+    &WorkloadInfo::globalWorkOffsetOffsets,
+    &WorkloadInfo::globalWorkSizeOffsets,
+    &WorkloadInfo::localWorkSizeOffsets,
+    &WorkloadInfo::localWorkSizeOffsets2,
+    &WorkloadInfo::enqueuedLocalWorkSizeOffsets,
+    &WorkloadInfo::numWorkGroupsOffset};
+
+static uint32_t KernelArgInfo::*const kernelArgInfoOffsets[] = {
+    &KernelArgInfo::offsetHeap,
+    &KernelArgInfo::slmAlignment,
+    &KernelArgInfo::samplerArgumentType,
+    &KernelArgInfo::offsetImgWidth,
+    &KernelArgInfo::offsetImgHeight,
+    &KernelArgInfo::offsetImgDepth,
+    &KernelArgInfo::offsetChannelDataType,
+    &KernelArgInfo::offsetChannelOrder,
+    &KernelArgInfo::offsetArraySize,
+    &KernelArgInfo::offsetNumSamples,
+    &KernelArgInfo::offsetSamplerSnapWa,
+    &KernelArgInfo::offsetSamplerAddressingMode,
+    &KernelArgInfo::offsetSamplerNormalizedCoords,
+    &KernelArgInfo::offsetVmeMbBlockType,
+    &KernelArgInfo::offsetVmeSubpixelMode,
+    &KernelArgInfo::offsetVmeSadAdjustMode,
+    &KernelArgInfo::offsetVmeSearchPathType,
+    &KernelArgInfo::offsetObjectId,
+    &KernelArgInfo::offsetBufferOffset};
+
+static bool KernelArgInfo::*const kernelArgInfoFlags[] = {
+    &KernelArgInfo::isImage,
+    &KernelArgInfo::isMediaImage,
+    &KernelArgInfo::isMediaBlockImage,
+    &KernelArgInfo::isSampler,
+    &KernelArgInfo::isAccelerator,
+    &KernelArgInfo::isDeviceQueue,
+    &KernelArgInfo::isBuffer,
+    &KernelArgInfo::needPatch};
+
+static std::string KernelArgInfo::*const kernelArgInfoStrings[] = {
+    &KernelArgInfo::name,
+    &KernelArgInfo::typeStr,
+    &KernelArgInfo::accessQualifierStr,
+    &KernelArgInfo::addressQualifierStr,
+    &KernelArgInfo::typeQualifierStr};
+
+template <typename TokenT>
+static void writeToken(KernelInfoImageWriter &writer, const KernelInfo &kernelInfo, const TokenT *pToken) {
+    uint32_t offset = KernelInfoImageHeader::invalidOffset;
+    if (pToken != nullptr) {
+        offset = static_cast<uint32_t>(ptrDiff(pToken, kernelInfo.heapInfo.pBlob));
+    }
+    writer.write(offset);
+}
+
+template <typename TokenT>
+static bool readToken(KernelInfoImageReader &reader, const KernelInfo &kernelInfo, const TokenT *&pToken) {
+    uint32_t offset = 0;
+    if (!reader.read(offset)) {
+        return false;
+    }
+    if (offset == KernelInfoImageHeader::invalidOffset) {
+        pToken = nullptr;
+        return true;
+    }
+    if ((offset > kernelInfo.heapInfo.blobSize) || (kernelInfo.heapInfo.blobSize - offset < sizeof(TokenT))) {
+        return false;
+    }
+    pToken = reinterpret_cast<const TokenT *>(ptrOffset(kernelInfo.heapInfo.pBlob, offset));
+    return true;
+}
+
+template <typename TokenT>
+static void writeTokens(KernelInfoImageWriter &writer, const KernelInfo &kernelInfo, const std::vector<const TokenT *> &tokens) {
+    writer.write(static_cast<uint32_t>(tokens.size()));
+    for (auto pToken : tokens) {
+        writeToken(writer, kernelInfo, pToken);
+    }
+}
+
+template <typename TokenT>
+static bool readTokens(KernelInfoImageReader &reader, const KernelInfo &kernelInfo, std::vector<const TokenT *> &tokens) {
+    uint32_t count = 0;
+    if (!reader.readCount(count)) {
+        return false;
+    }
+    tokens.resize(count);
+    for (auto &pToken : tokens) {
+        if (!readToken(reader, kernelInfo, pToken) || (pToken == nullptr)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void writeKernelArgInfo(KernelInfoImageWriter &writer, const KernelArgInfo &argInfo) {
+    for (auto member : kernelArgInfoStrings) {
+        writer.writeString(argInfo.*member);
+    }
+    for (auto member : kernelArgInfoOffsets) {
+        writer.write(argInfo.*member);
+    }
+    for (auto member : kernelArgInfoFlags) {
+        writer.write(static_cast<uint8_t>(argInfo.*member));
+    }
+    writer.write(static_cast<uint32_t>(argInfo.accessQualifier));
+    writer.write(static_cast<uint32_t>(argInfo.addressQualifier));
+    writer.write(static_cast<uint64_t>(argInfo.typeQualifier));
+
+    writer.write(static_cast<uint32_t>(argInfo.kernelArgPatchInfoVector.size()));
+    for (auto &patchInfo : argInfo.kernelArgPatchInfoVector) {
+        writer.write(patchInfo.crossthreadOffset);
+        writer.write(patchInfo.size);
+        writer.write(patchInfo.sourceOffset);
+    }
+}
+
+static bool readKernelArgInfo(KernelInfoImageReader &reader, KernelArgInfo &argInfo) {
+    for (auto member : kernelArgInfoStrings) {
+        if (!reader.readString(argInfo.*member)) {
+            return false;
+        }
+    }
+    for (auto member : kernelArgInfoOffsets) {
+        if (!reader.read(argInfo.*member)) {
+            return false;
+        }
+    }
+    for (auto member : kernelArgInfoFlags) {
+        uint8_t flag = 0;
+        if (!reader.read(flag)) {
+            return false;
+        }
+        argInfo.*member = (flag != 0);
+    }
+
+    uint32_t accessQualifier = 0;
+    uint32_t addressQualifier = 0;
+    uint64_t typeQualifier = 0;
+    if (!reader.read(accessQualifier) || !reader.read(addressQualifier) || !reader.read(typeQualifier)) {
+        return false;
+    }
+    argInfo.accessQualifier = static_cast<cl_kernel_arg_access_qualifier>(accessQualifier);
+    argInfo.addressQualifier = static_cast<cl_kernel_arg_address_qualifier>(addressQualifier);
+    argInfo.typeQualifier = static_cast<cl_kernel_arg_type_qualifier>(typeQualifier);
+
+    uint32_t patchInfoCount = 0;
+    if (!reader.readCount(patchInfoCount)) {
+        return false;
+    }
+    argInfo.kernelArgPatchInfoVector.resize(patchInfoCount);
+    for (auto &patchInfo : argInfo.kernelArgPatchInfoVector) {
+        if (!reader.read(patchInfo.crossthreadOffset) || !reader.read(patchInfo.size) || !reader.read(patchInfo.sourceOffset)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void writeKernelInfo(KernelInfoImageWriter &writer, const KernelInfo &kernelInfo) {
+    writer.write(static_cast<uint8_t>(kernelInfo.isValid));
+    writer.write(static_cast<uint8_t>(kernelInfo.usesSsh));
+    writer.write(static_cast<uint8_t>(kernelInfo.requiresSshForBuffers));
+    writer.write(static_cast<uint8_t>(kernelInfo.isVmeWorkload));
+    writer.write(kernelInfo.systemKernelOffset);
+    writer.write(kernelInfo.argumentsToPatchNum);
+    writer.write(static_cast<uint64_t>(kernelInfo.requiredSubGroupSize));
+    for (auto size : kernelInfo.reqdWorkGroupSize) {
+        writer.write(static_cast<uint64_t>(size));
+    }
+    writer.writeString(kernelInfo.attributes);
+
+    for (auto member : workloadInfoOffsets) {
+        writer.write(kernelInfo.workloadInfo.*member);
+    }
+    for (auto member : workloadInfoOffsetArrays) {
+        for (auto offset : kernelInfo.workloadInfo.*member) {
+            writer.write(offset);
+        }
+    }
+
+    const auto &patchInfo = kernelInfo.patchInfo;
+    writeToken(writer, kernelInfo, patchInfo.interfaceDescriptorDataLoad);
+    writeToken(writer, kernelInfo, patchInfo.localsurface);
+    writeToken(writer, kernelInfo, patchInfo.mediavfestate);
+    writeToken(writer, kernelInfo, patchInfo.interfaceDescriptorData);
+    writeToken(writer, kernelInfo, patchInfo.samplerStateArray);
+    writeToken(writer, kernelInfo, patchInfo.bindingTableState);
+    writeToken(writer, kernelInfo, patchInfo.dataParameterStream);
+    writeToken(writer, kernelInfo, patchInfo.threadPayload);
+    writeToken(writer, kernelInfo, patchInfo.executionEnvironment);
+    writeToken(writer, kernelInfo, patchInfo.pKernelAttributesInfo);
+    writeToken(writer, kernelInfo, patchInfo.pAllocateStatelessPrivateSurface);
+    writeToken(writer, kernelInfo, patchInfo.pAllocateStatelessConstantMemorySurfaceWithInitialization);
+    writeToken(writer, kernelInfo, patchInfo.pAllocateStatelessGlobalMemorySurfaceWithInitialization);
+    writeToken(writer, kernelInfo, patchInfo.pAllocateStatelessPrintfSurface);
+    writeToken(writer, kernelInfo, patchInfo.pAllocateStatelessEventPoolSurface);
+    writeToken(writer, kernelInfo, patchInfo.pAllocateStatelessDefaultDeviceQueueSurface);
+    writeTokens(writer, kernelInfo, patchInfo.dataParameterBuffers);
+    writeTokens(writer, kernelInfo, patchInfo.statelessGlobalMemObjKernelArgs);
+    writeTokens(writer, kernelInfo, patchInfo.imageMemObjKernelArgs);
+    writeTokens(writer, kernelInfo, patchInfo.globalMemObjKernelArgs);
+    writeTokens(writer, kernelInfo, patchInfo.kernelArgumentInfo);
+
+    writer.write(static_cast<uint32_t>(patchInfo.stringDataMap.size()));
+    for (auto &stringData : patchInfo.stringDataMap) {
+        writer.write(stringData.first);
+        writer.writeBytes(stringData.second.pStringData, stringData.second.SizeInBytes);
+    }
+
+    writer.write(static_cast<uint32_t>(kernelInfo.childrenKernelsIdOffset.size()));
+    for (auto &childIdOffset : kernelInfo.childrenKernelsIdOffset) {
+        writer.write(childIdOffset.first);
+        writer.write(childIdOffset.second);
+    }
+
+    writer.write(static_cast<uint32_t>(kernelInfo.kernelArgInfo.size()));
+    for (auto &argInfo : kernelInfo.kernelArgInfo) {
+        writeKernelArgInfo(writer, argInfo);
+    }
+}
+
+static bool readKernelInfo(KernelInfoImageReader &reader, KernelInfo &kernelInfo) {
+    uint8_t flags[4] = {};
+    for (auto &flag : flags) {
+        if (!reader.read(flag)) {
+            return false;
+        }
+    }
+    kernelInfo.isValid = (flags[0] != 0);
+    kernelInfo.usesSsh = (flags[1] != 0);
+    kernelInfo.requiresSshForBuffers = (flags[2] != 0);
+    kernelInfo.isVmeWorkload = (flags[3] != 0);
+
+    uint64_t requiredSubGroupSize = 0;
+    if (!reader.read(kernelInfo.systemKernelOffset) || !reader.read(kernelInfo.argumentsToPatchNum) || !reader.read(requiredSubGroupSize)) {
+        return false;
+    }
+    kernelInfo.requiredSubGroupSize = static_cast<size_t>(requiredSubGroupSize);
+    for (auto &size : kernelInfo.reqdWorkGroupSize) {
+        uint64_t value = 0;
+        if (!reader.read(value)) {
+            return false;
+        }
+        size = static_cast<size_t>(value);
+    }
+    if (!reader.readString(kernelInfo.attributes)) {
+        return false;
+    }
+
+    for (auto member : workloadInfoOffsets) {
+        if (!reader.read(kernelInfo.workloadInfo.*member)) {
+            return false;
+        }
+    }
+    for (auto member : workloadInfoOffsetArrays) {
+        for (auto &offset : kernelInfo.workloadInfo.*member) {
+            if (!reader.read(offset)) {
+                return false;
+            }
+        }
+    }
+
+    auto &patchInfo = kernelInfo.patchInfo;
+    bool tokensRead = readToken(reader, kernelInfo, patchInfo.interfaceDescriptorDataLoad) &&
+                      readToken(reader, kernelInfo, patchInfo.localsurface) &&
+                      readToken(reader, kernelInfo, patchInfo.mediavfestate) &&
+                      readToken(reader, kernelInfo, patchInfo.interfaceDescriptorData) &&
+                      readToken(reader, kernelInfo, patchInfo.samplerStateArray) &&
+                      readToken(reader, kernelInfo, patchInfo.bindingTableState) &&
+                      readToken(reader, kernelInfo, patchInfo.dataParameterStream) &&
+                      readToken(reader, kernelInfo, patchInfo.threadPayload) &&
+                      readToken(reader, kernelInfo, patchInfo.executionEnvironment) &&
+                      readToken(reader, kernelInfo, patchInfo.pKernelAttributesInfo) &&
+                      readToken(reader, kernelInfo, patchInfo.pAllocateStatelessPrivateSurface) &&
+                      readToken(reader, kernelInfo, patchInfo.pAllocateStatelessConstantMemorySurfaceWithInitialization) &&
+                      readToken(reader, kernelInfo, patchInfo.pAllocateStatelessGlobalMemorySurfaceWithInitialization) &&
+                      readToken(reader, kernelInfo, patchInfo.pAllocateStatelessPrintfSurface) &&
+                      readToken(reader, kernelInfo, patchInfo.pAllocateStatelessEventPoolSurface) &&
+                      readToken(reader, kernelInfo, patchInfo.pAllocateStatelessDefaultDeviceQueueSurface) &&
+                      readTokens(reader, kernelInfo, patchInfo.dataParameterBuffers) &&
+                      readTokens(reader, kernelInfo, patchInfo.statelessGlobalMemObjKernelArgs) &&
+                      readTokens(reader, kernelInfo, patchInfo.imageMemObjKernelArgs) &&
+                      readTokens(reader, kernelInfo, patchInfo.globalMemObjKernelArgs) &&
+                      readTokens(reader, kernelInfo, patchInfo.kernelArgumentInfo);
+    if (!tokensRead) {
+        return false;
+    }
+
+    uint32_t stringsCount = 0;
+    if (!reader.readCount(stringsCount)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < stringsCount; i++) {
+        uint32_t stringIndex = 0;
+        const char *pStringData = nullptr;
+        uint32_t stringSize = 0;
+        if (!reader.read(stringIndex) || !reader.readBytes(pStringData, stringSize)) {
+            return false;
+        }
+        PrintfStringInfo printfStringInfo;
+        printfStringInfo.SizeInBytes = stringSize;
+        printfStringInfo.pStringData = new char[stringSize];
+        memcpy_s(printfStringInfo.pStringData, stringSize, pStringData, stringSize);
+        if (!patchInfo.stringDataMap.insert(std::pair<uint32_t, PrintfStringInfo>(stringIndex, printfStringInfo)).second) {
+            delete[] printfStringInfo.pStringData;
+            return false;
+        }
+    }
+
+    uint32_t childrenCount = 0;
+    if (!reader.readCount(childrenCount)) {
+        return false;
+    }
+    kernelInfo.childrenKernelsIdOffset.resize(childrenCount);
+    for (auto &childIdOffset : kernelInfo.childrenKernelsIdOffset) {
+        if (!reader.read(childIdOffset.first) || !reader.read(childIdOffset.second)) {
+            return false;
+        }
+    }
+
+    uint32_t argsCount = 0;
+    if (!reader.readCount(argsCount)) {
+        return false;
+    }
+    kernelInfo.kernelArgInfo.resize(argsCount);
+    for (auto &argInfo : kernelInfo.kernelArgInfo) {
+        if (!readKernelArgInfo(reader, argInfo)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool computeGenBinaryKey(const char *genBinary, size_t genBinarySize, Hash128Value &key) {
+    if (genBinarySize < sizeof(SProgramBinaryHeader)) {
+        return false;
+    }
+    auto pGenBinaryHeader = reinterpret_cast<const SProgramBinaryHeader *>(genBinary);
+
+    Hash128 hash;
+    hash.update(genBinary, sizeof(SProgramBinaryHeader));
+
+    uint64_t offset = sizeof(SProgramBinaryHeader) + static_cast<uint64_t>(pGenBinaryHeader->PatchListSize);
+    for (uint32_t i = 0; i < pGenBinaryHeader->NumberOfKernels; i++) {
+        if ((offset > genBinarySize) || (genBinarySize - offset < sizeof(SKernelBinaryHeaderCommon))) {
+            return false;
+        }
+        auto pKernelHeader = reinterpret_cast<const SKernelBinaryHeaderCommon *>(genBinary + offset);
+        if (genBinarySize - offset - sizeof(SKernelBinaryHeaderCommon) < pKernelHeader->KernelNameSize) {
+            return false;
+        }
+        hash.update(genBinary + offset, sizeof(SKernelBinaryHeaderCommon) + pKernelHeader->KernelNameSize);
+
+        offset += sizeof(SKernelBinaryHeaderCommon);
+        offset += static_cast<uint64_t>(pKernelHeader->KernelNameSize) + pKernelHeader->KernelHeapSize +
+                  pKernelHeader->GeneralStateHeapSize + pKernelHeader->DynamicStateHeapSize +
+                  pKernelHeader->SurfaceStateHeapSize + pKernelHeader->PatchListSize;
+    }
+
+    key = hash.finish();
+    return true;
+}
+
+bool Program::serializeKernelInfoImage(std::vector<char> &image) {
+    if ((genBinary == nullptr) || (genBinarySize < sizeof(SProgramBinaryHeader))) {
+        return false;
+    }
+    auto pGenBinaryHeader = reinterpret_cast<const SProgramBinaryHeader *>(genBinary);
+
+    std::vector<const KernelInfo *> kernelInfos;
+    for (auto kernelInfo : kernelInfoArray) {
+        decodeKernelPatchList(*kernelInfo);
+        kernelInfos.push_back(kernelInfo);
+    }
+    for (size_t i = 0; i < blockKernelManager->getCount(); i++) {
+        kernelInfos.push_back(blockKernelManager->getBlockKernelInfo(i));
+    }
+    if (kernelInfos.size() != pGenBinaryHeader->NumberOfKernels) {
+        return false;
+    }
+    for (auto kernelInfo : kernelInfos) {
+        if ((kernelInfo->heapInfo.pBlob < genBinary) || (ptrDiff(kernelInfo->heapInfo.pBlob, genBinary) >= genBinarySize)) {
+            return false;
+        }
+    }
+    std::sort(kernelInfos.begin(), kernelInfos.end(),
+              [](const KernelInfo *lhs, const KernelInfo *rhs) { return lhs->heapInfo.pBlob < rhs->heapInfo.pBlob; });
+
+    Hash128Value genBinaryKey = {};
+    if (!computeGenBinaryKey(genBinary, genBinarySize, genBinaryKey)) {
+        return false;
+    }
+
+    KernelInfoImageWriter writer;
+    KernelInfoImageHeader header = {};
+    header.headerMagic = KernelInfoImageHeader::magic;
+    header.headerVersion = KernelInfoImageHeader::version;
+    header.genBinaryKeyHi = genBinaryKey.hi;
+    header.genBinaryKeyLo = genBinaryKey.lo;
+    header.genBinarySize = genBinarySize;
+    header.numKernels = static_cast<uint32_t>(kernelInfos.size());
+
+    writer.write(header.headerMagic);
+    writer.write(header.headerVersion);
+    writer.write(header.genBinaryKeyHi);
+    writer.write(header.genBinaryKeyLo);
+    writer.write(header.genBinarySize);
+    writer.write(header.numKernels);
+    writer.write(header.reserved);
+
+    for (auto kernelInfo : kernelInfos) {
+        writer.write(static_cast<uint32_t>(ptrDiff(kernelInfo->heapInfo.pBlob, genBinary)));
+        writeKernelInfo(writer, *kernelInfo);
+    }
+
+    image.swap(writer.getData());
+    return true;
+}
+
+bool Program::restoreKernelInfoImage() {
+    KernelInfoImageReader reader(kernelInfoImage.data(), kernelInfoImage.size());
+    KernelInfoImageHeader header = {};
+
+    bool headerRead = reader.read(header.headerMagic) &&
+                      reader.read(header.headerVersion) &&
+                      reader.read(header.genBinaryKeyHi) &&
+                      reader.read(header.genBinaryKeyLo) &&
+                      reader.read(header.genBinarySize) &&
+                      reader.read(header.numKernels) &&
+                      reader.read(header.reserved);
+    if (!headerRead ||
+        (header.headerMagic != KernelInfoImageHeader::magic) ||
+        (header.headerVersion != KernelInfoImageHeader::version) ||
+        (header.genBinarySize != genBinarySize) ||
+        (header.numKernels != kernelInfoArray.size())) {
+        return false;
+    }
+
+    Hash128Value genBinaryKey = {};
+    if (!computeGenBinaryKey(genBinary, genBinarySize, genBinaryKey) ||
+        (genBinaryKey.hi != header.genBinaryKeyHi) || (genBinaryKey.lo != header.genBinaryKeyLo)) {
+        return false;
+    }
+
+    std::vector<std::unique_ptr<KernelInfo>> restoredKernelInfos;
+    for (auto indexedKernelInfo : kernelInfoArray) {
+        uint32_t kernelOffset = 0;
+        if (!reader.read(kernelOffset) || (kernelOffset != ptrDiff(indexedKernelInfo->heapInfo.pBlob, genBinary))) {
+            return false;
+        }
+
+        std::unique_ptr<KernelInfo> kernelInfo(KernelInfo::create());
+        kernelInfo->name = indexedKernelInfo->name;
+        kernelInfo->heapInfo = indexedKernelInfo->heapInfo;
+        kernelInfo->gpuPointerSize = indexedKernelInfo->gpuPointerSize;
+        if (!readKernelInfo(reader, *kernelInfo)) {
+            return false;
+        }
+        restoredKernelInfos.push_back(std::move(kernelInfo));
+    }
+
+    for (size_t i = 0; i < kernelInfoArray.size(); i++) {
+        delete kernelInfoArray[i];
+        auto kernelInfo = restoredKernelInfos[i].release();
+        kernelInfoArray[i] = kernelInfo;
+
+        if (kernelInfo->workloadInfo.localMemoryStatelessWindowStartAddressOffset != WorkloadInfo::undefinedOffset) {
+            pDevice->prepareSLMWindow();
+        }
+        initializeCrossThreadData(*kernelInfo);
+        registerBlockKernelParent(*kernelInfo);
+    }
+    return true;
+}
+} // namespace OCLRT
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2017, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace OCLRT {
+
+// Pre-decoded KernelInfo of all kernels in a device binary, stored in a separate ELF section.
+// Patch tokens are referenced by their offset from the start of the kernel blob, so the image
+// is only valid together with the device binary it was created from. The binary is identified
+// by a key over the program header and the header and name of every kernel; kernel heaps and
+// patch lists are covered by the compiler checksum stored in each kernel header.
+struct KernelInfoImageHeader {
+    static const uint32_t magic = 0x4D49494B; // "KIIM"
+    static const uint32_t version = 2;
+    static const uint32_t invalidOffset = 0xFFFFFFFF;
+
+    uint32_t headerMagic;
+    uint32_t headerVersion;
+    uint64_t genBinaryKeyHi;
+    uint64_t genBinaryKeyLo;
+    uint64_t genBinarySize;
+    uint32_t numKernels;
+    uint32_t reserved;
+};
+
+class KernelInfoImageWriter {
+  public:
+    template <typename T>
+    void write(const T &value) {
+        static_assert(std::is_arithmetic<T>::value, "only arithmetic types can be serialized");
+        auto pValue = reinterpret_cast<const char *>(&value);
+        data.insert(data.end(), pValue, pValue + sizeof(T));
+    }
+
+    void writeString(const std::string &value) {
+        writeBytes(value.c_str(), value.size());
+    }
+
+    void writeBytes(const char *pBytes, size_t size) {
+        write(static_cast<uint32_t>(size));
+        data.insert(data.end(), pBytes, pBytes + size);
+    }
+
+    std::vector<char> &getData() {
+        return data;
+    }
+
+  protected:
+    std::vector<char> data;
+};
+
+class KernelInfoImageReader {
+  public:
+    KernelInfoImageReader(const char *data, size_t size) : data(data), size(size) {}
+
+    template <typename T>
+    bool read(T &value) {
+        static_assert(std::is_arithmetic<T>::value, "only arithmetic types can be deserialized");
+        if (size - position < sizeof(T)) {
+            return false;
+        }
+        memcpy(&value, data + position, sizeof(T));
+        position += sizeof(T);
+        return true;
+    }
+
+    bool readString(std::string &value) {
+        const char *pBytes = nullptr;
+        uint32_t bytesCount = 0;
+        if (!readBytes(pBytes, bytesCount)) {
+            return false;
+        }
+        value.assign(pBytes, bytesCount);
+        return true;
+    }
+
+    bool readBytes(const char *&pBytes, uint32_t &bytesCount) {
+        if (!read(bytesCount) || (size - position < bytesCount)) {
+            return false;
+        }
+        pBytes = data + position;
+        position += bytesCount;
+        return true;
+    }
+
+    // element counts are bounded by the remaining data to reject corrupted images early
+    bool readCount(uint32_t &count) {
+        return read(count) && (count <= size - position);
+    }
+
+    size_t getPosition() const {
+        return position;
+    }
+
+  protected:
+    const char *data;
+    size_t size;
+    size_t position = 0;
+};
+} // namespace OCLRT
@@ -47,40 +47,36 @@ cl_int Program::link(
     bool isCreateLibrary;
     CLElfLib::SSectionNode sectionNode;
 
-    do {
-        if (((deviceList == nullptr) && (numDevices != 0)) ||
-            ((deviceList != nullptr) && (numDevices == 0))) {
-            retVal = CL_INVALID_VALUE;
-            break;
-        }
+    if (((deviceList == nullptr) && (numDevices != 0)) ||
+        ((deviceList != nullptr) && (numDevices == 0))) {
+        return CL_INVALID_VALUE;
+    }
 
-        if ((numInputPrograms == 0) || (inputPrograms == nullptr)) {
-            retVal = CL_INVALID_VALUE;
-            break;
-        }
+    if ((numInputPrograms == 0) || (inputPrograms == nullptr)) {
+        return CL_INVALID_VALUE;
+    }
 
-        if ((funcNotify == nullptr) &&
-            (userData != nullptr)) {
-            retVal = CL_INVALID_VALUE;
-            break;
-        }
+    if ((funcNotify == nullptr) &&
+        (userData != nullptr)) {
+        return CL_INVALID_VALUE;
+    }
 
-        if ((deviceList != nullptr) && validateObject(*deviceList) != CL_SUCCESS) {
-            retVal = CL_INVALID_DEVICE;
-            break;
-        }
+    if ((deviceList != nullptr) && validateObject(*deviceList) != CL_SUCCESS) {
+        return CL_INVALID_DEVICE;
+    }
 
-        if (buildStatus == CL_BUILD_IN_PROGRESS) {
-            retVal = CL_INVALID_OPERATION;
-            break;
-        }
+    // the checks above and a build already in progress return without touching the build status
+    if (tryStartBuild() == false) {
+        return CL_INVALID_OPERATION;
+    }
 
+    do {
         options = (buildOptions != nullptr) ? buildOptions : "";
+        // handled by the runtime only, the compiler does not know it
+        embedKernelInfo = extractOption(options, clOptNameEmbedKernelInfo);
 
         isCreateLibrary = (strstr(options.c_str(), "-create-library") != nullptr);
 
-        buildStatus = CL_BUILD_IN_PROGRESS;
-
         pElfWriter = CLElfLib::CElfWriter::create(CLElfLib::EH_TYPE_OPENCL_OBJECTS, CLElfLib::EH_MACHINE_NONE, 0);
 
         StackVec<const Program *, 16> inputProgramsInternal;
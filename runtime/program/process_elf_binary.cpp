@@ -38,6 +38,7 @@ cl_int Program::processElfBinary(
     size_t sectionDataSize = 0;
 
     binaryVersion = iOpenCL::CURRENT_ICBE_VERSION;
+    kernelInfoImage.clear();
 
     if (CLElfLib::CElfReader::isValidElf64(pBinary, binarySize) == false) {
         retVal = CL_INVALID_BINARY;
@@ -114,6 +115,13 @@ cl_int Program::processElfBinary(
                 }
                 break;
 
+            case CLElfLib::SH_TYPE_OPENCL_KERNEL_INFO:
+                pElfReader->getSectionData(i, pSectionData, sectionDataSize);
+                if (pSectionData && sectionDataSize) {
+                    kernelInfoImage.assign(pSectionData, pSectionData + sectionDataSize);
+                }
+                break;
+
             case CLElfLib::SH_TYPE_OPENCL_OPTIONS:
                 pElfReader->getSectionData(i, pSectionData, sectionDataSize);
                 if (pSectionData && sectionDataSize) {
@@ -230,6 +238,18 @@ cl_int Program::resolveProgramBinary() {
                     elfRetVal = pElfWriter->addSection(&sectionNode);
                 }
 
+                // Add pre-decoded kernel info, so that loading the binary can skip patch token decoding,
+                // only on request through the build option as older runtimes reject binaries with unknown section types
+                std::vector<char> kernelInfoImage;
+                if (elfRetVal && embedKernelInfo &&
+                    (headerType == CLElfLib::EH_TYPE_OPENCL_EXECUTABLE) && serializeKernelInfoImage(kernelInfoImage)) {
+                    sectionNode.Name = "Intel(R) OpenCL Kernel Info";
+                    sectionNode.Type = CLElfLib::SH_TYPE_OPENCL_KERNEL_INFO;
+                    sectionNode.pData = kernelInfoImage.data();
+                    sectionNode.DataSize = (uint32_t)kernelInfoImage.size();
+                    elfRetVal = pElfWriter->addSection(&sectionNode);
+                }
+
                 // Add the device debug data if it exists
                 if (elfRetVal && (debugData != nullptr)) {
                     sectionNode.Name = "Intel(R) OpenCL Device Debug";
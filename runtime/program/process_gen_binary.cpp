@@ -46,8 +46,13 @@ const KernelInfo *Program::getKernelInfo(
 
     auto it = std::find_if(kernelInfoArray.begin(), kernelInfoArray.end(),
                            [=](const KernelInfo *kInfo) { return (0 == strcmp(kInfo->name.c_str(), kernelName)); });
+    if (it == kernelInfoArray.end()) {
+        return nullptr;
+    }
 
-    return (it != kernelInfoArray.end()) ? *it : nullptr;
+    // the patch list is decoded on first use, a failure is reported through KernelInfo::isValid
+    decodeKernelPatchList(**it);
+    return *it;
 }
 
 size_t Program::getNumKernels() const {
@@ -56,6 +61,7 @@ size_t Program::getNumKernels() const {
 
 const KernelInfo *Program::getKernelInfo(size_t ordinal) const {
     DEBUG_BREAK_IF(ordinal >= kernelInfoArray.size());
+    decodeKernelPatchList(*kernelInfoArray[ordinal]);
     return kernelInfoArray[ordinal];
 }
 
@@ -74,7 +80,8 @@ std::string Program::getKernelNamesString() const {
 
 size_t Program::processKernel(
     const void *pKernelBlob,
-    cl_int &retVal) {
+    cl_int &retVal,
+    bool decodePatchList) {
     size_t sizeProcessed = 0;
 
     do {
@@ -108,16 +115,7 @@ size_t Program::processKernel(
 
         pKernelInfo->heapInfo.pPatchList = pCurKernelPtr;
 
-        retVal = parsePatchList(*pKernelInfo);
-        if (retVal != CL_SUCCESS) {
-            delete pKernelInfo;
-
-            sizeProcessed = ptrDiff(pCurKernelPtr, pKernelBlob);
-            break;
-        }
-
         auto pKernelHeader = pKernelInfo->heapInfo.pKernelHeader;
-        auto pKernel = ptrOffset(pKernelBlob, sizeof(SKernelBinaryHeaderCommon));
 
         if (genBinary)
             pKernelInfo->gpuPointerSize = reinterpret_cast<const SProgramBinaryHeader *>(genBinary)->GPUPointerSizeInBytes;
@@ -131,37 +129,145 @@ size_t Program::processKernel(
             pKernelHeader->SurfaceStateHeapSize;
 
         pKernelInfo->heapInfo.blobSize = kernelSize + sizeof(SKernelBinaryHeaderCommon);
+        pKernelInfo->isPatchListDecoded = false;
 
-        uint32_t kernelCheckSum = pKernelInfo->heapInfo.pKernelHeader->CheckSum;
-
-        uint64_t hashValue = Hash::hash(reinterpret_cast<const char *>(pKernel), kernelSize);
+        if (decodePatchList) {
+            retVal = decodeKernelPatchList(*pKernelInfo);
+            if (retVal != CL_SUCCESS) {
+                delete pKernelInfo;
 
-        uint32_t calcCheckSum = hashValue & 0xFFFFFFFF;
-        pKernelInfo->isValid = (calcCheckSum == kernelCheckSum);
+                sizeProcessed = ptrDiff(pCurKernelPtr, pKernelBlob);
+                break;
+            }
+            registerBlockKernelParent(*pKernelInfo);
+        }
 
         retVal = CL_SUCCESS;
         sizeProcessed = sizeof(SKernelBinaryHeaderCommon) + kernelSize;
         kernelInfoArray.push_back(pKernelInfo);
-        if (pKernelInfo->hasDeviceEnqueue()) {
-            parentKernelInfoArray.push_back(pKernelInfo);
-        }
-        if (pKernelInfo->requiresSubgroupIndependentForwardProgress()) {
-            subgroupKernelInfoArray.push_back(pKernelInfo);
-        }
     } while (false);
 
     return sizeProcessed;
 }
 
-cl_int Program::parsePatchList(KernelInfo &kernelInfo) {
+cl_int Program::validateKernelPatchList(const KernelInfo &kernelInfo, bool &requiresDecoding) {
+    auto pPatchList = kernelInfo.heapInfo.pPatchList;
+    auto patchListSize = kernelInfo.heapInfo.pKernelHeader->PatchListSize;
+    auto pCurPatchListPtr = pPatchList;
+
+    while (ptrDiff(pCurPatchListPtr, pPatchList) < patchListSize) {
+        auto remainingSize = patchListSize - ptrDiff(pCurPatchListPtr, pPatchList);
+        auto pPatch = reinterpret_cast<const SPatchItemHeader *>(pCurPatchListPtr);
+        if ((remainingSize < sizeof(SPatchItemHeader)) || (pPatch->Size < sizeof(SPatchItemHeader)) || (pPatch->Size > remainingSize)) {
+            return CL_INVALID_KERNEL;
+        }
+
+        switch (pPatch->Token) {
+        case PATCH_TOKEN_SAMPLER_STATE_ARRAY:
+        case PATCH_TOKEN_BINDING_TABLE_STATE:
+        case PATCH_TOKEN_ALLOCATE_LOCAL_SURFACE:
+        case PATCH_TOKEN_MEDIA_VFE_STATE:
+        case PATCH_TOKEN_MEDIA_INTERFACE_DESCRIPTOR_LOAD:
+        case PATCH_TOKEN_INTERFACE_DESCRIPTOR_DATA:
+        case PATCH_TOKEN_THREAD_PAYLOAD:
+        case PATCH_TOKEN_DATA_PARAMETER_STREAM:
+        case PATCH_TOKEN_KERNEL_ATTRIBUTES_INFO:
+        case PATCH_TOKEN_SAMPLER_KERNEL_ARGUMENT:
+        case PATCH_TOKEN_IMAGE_MEMORY_OBJECT_KERNEL_ARGUMENT:
+        case PATCH_TOKEN_GLOBAL_MEMORY_OBJECT_KERNEL_ARGUMENT:
+        case PATCH_TOKEN_STATELESS_GLOBAL_MEMORY_OBJECT_KERNEL_ARGUMENT:
+        case PATCH_TOKEN_STATELESS_CONSTANT_MEMORY_OBJECT_KERNEL_ARGUMENT:
+        case PATCH_TOKEN_STATELESS_DEVICE_QUEUE_KERNEL_ARGUMENT:
+        case PATCH_TOKEN_ALLOCATE_STATELESS_PRIVATE_MEMORY:
+        case PATCH_TOKEN_ALLOCATE_STATELESS_CONSTANT_MEMORY_SURFACE_WITH_INITIALIZATION:
+        case PATCH_TOKEN_ALLOCATE_STATELESS_GLOBAL_MEMORY_SURFACE_WITH_INITIALIZATION:
+        case PATCH_TOKEN_ALLOCATE_STATELESS_PRINTF_SURFACE:
+        case PATCH_TOKEN_ALLOCATE_STATELESS_EVENT_POOL_SURFACE:
+        case PATCH_TOKEN_ALLOCATE_STATELESS_DEFAULT_DEVICE_QUEUE_SURFACE:
+        case PATCH_TOKEN_STRING:
+        case PATCH_TOKEN_INLINE_VME_SAMPLER_INFO:
+        case PATCH_TOKEN_GTPIN_FREE_GRF_INFO:
+        case PATCH_TOKEN_STATE_SIP:
+            break;
+
+        case PATCH_TOKEN_DATA_PARAMETER_BUFFER:
+            // the SLM window is a device resource, it has to be in place before any kernel of the program is created
+            if (reinterpret_cast<const SPatchDataParameterBuffer *>(pPatch)->Type == DATA_PARAMETER_LOCAL_MEMORY_STATELESS_WINDOW_START_ADDRESS) {
+                pDevice->prepareSLMWindow();
+            }
+            break;
+
+        case PATCH_TOKEN_EXECUTION_ENVIRONMENT: {
+            auto pExecutionEnvironment = reinterpret_cast<const SPatchExecutionEnvironment *>(pPatch);
+            if (pExecutionEnvironment->HasDeviceEnqueue || pExecutionEnvironment->SubgroupIndependentForwardProgressRequired) {
+                requiresDecoding = true;
+            }
+        } break;
+
+        case PATCH_TOKEN_KERNEL_ARGUMENT_INFO: {
+            auto pKernelArgInfo = reinterpret_cast<const SPatchKernelArgumentInfo *>(pPatch);
+            if ((pPatch->Size < sizeof(SPatchKernelArgumentInfo)) ||
+                (pPatch->Size - sizeof(SPatchKernelArgumentInfo) < static_cast<uint64_t>(pKernelArgInfo->AddressQualifierSize) + pKernelArgInfo->AccessQualifierSize) ||
+                !KernelInfo::hasKnownArgQualifiers(pKernelArgInfo)) {
+                return CL_INVALID_BINARY;
+            }
+        } break;
+
+        default:
+            if (false == isSafeToSkipUnhandledToken(pPatch->Token)) {
+                return CL_INVALID_KERNEL;
+            }
+            break;
+        }
+
+        pCurPatchListPtr = ptrOffset(pCurPatchListPtr, pPatch->Size);
+    }
+
+    return CL_SUCCESS;
+}
+
+cl_int Program::decodeKernelPatchList(KernelInfo &kernelInfo) const {
+    std::lock_guard<std::mutex> lock(kernelDecodeMutex);
+
+    if (kernelInfo.isPatchListDecoded) {
+        return CL_SUCCESS;
+    }
+    kernelInfo.isPatchListDecoded = true;
+
+    auto retVal = parsePatchList(kernelInfo);
+    if (retVal != CL_SUCCESS) {
+        kernelInfo.isValid = false;
+        return retVal;
+    }
+
+    auto pKernel = ptrOffset(kernelInfo.heapInfo.pBlob, sizeof(SKernelBinaryHeaderCommon));
+    auto kernelSize = kernelInfo.heapInfo.blobSize - sizeof(SKernelBinaryHeaderCommon);
+
+    uint32_t kernelCheckSum = kernelInfo.heapInfo.pKernelHeader->CheckSum;
+
+    uint64_t hashValue = Hash::hash(reinterpret_cast<const char *>(pKernel), kernelSize);
+
+    uint32_t calcCheckSum = hashValue & 0xFFFFFFFF;
+    kernelInfo.isValid = (calcCheckSum == kernelCheckSum);
+
+    return CL_SUCCESS;
+}
+
+void Program::registerBlockKernelParent(KernelInfo &kernelInfo) {
+    if (kernelInfo.hasDeviceEnqueue()) {
+        parentKernelInfoArray.push_back(&kernelInfo);
+    }
+    if (kernelInfo.requiresSubgroupIndependentForwardProgress()) {
+        subgroupKernelInfoArray.push_back(&kernelInfo);
+    }
+}
+
+cl_int Program::parsePatchList(KernelInfo &kernelInfo) const {
     cl_int retVal = CL_SUCCESS;
 
     auto pPatchList = kernelInfo.heapInfo.pPatchList;
     auto patchListSize = kernelInfo.heapInfo.pKernelHeader->PatchListSize;
     auto pCurPatchListPtr = pPatchList;
-    uint32_t PrivateMemoryStatelessSizeOffset = 0xFFffFFff;
-    uint32_t LocalMemoryStatelessWindowSizeOffset = 0xFFffFFff;
-    uint32_t LocalMemoryStatelessWindowStartAddressOffset = 0xFFffFFff;
 
     //Speed up containers by giving some pre-allocated storage
     kernelInfo.kernelArgInfo.reserve(10);
@@ -372,15 +478,15 @@ cl_int Program::parsePatchList(KernelInfo &kernelInfo) {
 
             case DATA_PARAMETER_PRIVATE_MEMORY_STATELESS_SIZE:
                 DBG_LOG(LogPatchTokens, "\n  .Type", "PRIVATE_MEMORY_STATELESS_SIZE");
-                PrivateMemoryStatelessSizeOffset = pDataParameterBuffer->Offset;
+                kernelInfo.workloadInfo.privateMemoryStatelessSizeOffset = pDataParameterBuffer->Offset;
                 break;
             case DATA_PARAMETER_LOCAL_MEMORY_STATELESS_WINDOW_SIZE:
                 DBG_LOG(LogPatchTokens, "\n  .Type", "LOCAL_MEMORY_STATELESS_WINDOW_SIZE");
-                LocalMemoryStatelessWindowSizeOffset = pDataParameterBuffer->Offset;
+                kernelInfo.workloadInfo.localMemoryStatelessWindowSizeOffset = pDataParameterBuffer->Offset;
                 break;
             case DATA_PARAMETER_LOCAL_MEMORY_STATELESS_WINDOW_START_ADDRESS:
                 DBG_LOG(LogPatchTokens, "\n  .Type", "LOCAL_MEMORY_STATELESS_WINDOW_START_ADDRESS");
-                LocalMemoryStatelessWindowStartAddressOffset = pDataParameterBuffer->Offset;
+                kernelInfo.workloadInfo.localMemoryStatelessWindowStartAddressOffset = pDataParameterBuffer->Offset;
                 pDevice->prepareSLMWindow();
                 break;
             case DATA_PARAMETER_PREFERRED_WORKGROUP_MULTIPLE:
@@ -774,29 +880,33 @@ cl_int Program::parsePatchList(KernelInfo &kernelInfo) {
         retVal = kernelInfo.resolveKernelInfo();
     }
 
+    initializeCrossThreadData(kernelInfo);
+
+    return retVal;
+}
+
+void Program::initializeCrossThreadData(KernelInfo &kernelInfo) const {
     if (kernelInfo.patchInfo.dataParameterStream && kernelInfo.patchInfo.dataParameterStream->DataParameterStreamSize) {
         uint32_t crossThreadDataSize = kernelInfo.patchInfo.dataParameterStream->DataParameterStreamSize;
         kernelInfo.crossThreadData = new char[crossThreadDataSize];
         memset(kernelInfo.crossThreadData, 0x00, crossThreadDataSize);
 
-        if (LocalMemoryStatelessWindowStartAddressOffset != 0xFFffFFff) {
-            *(uintptr_t *)&(kernelInfo.crossThreadData[LocalMemoryStatelessWindowStartAddressOffset]) = reinterpret_cast<uintptr_t>(this->pDevice->getSLMWindowStartAddress());
+        if (kernelInfo.workloadInfo.localMemoryStatelessWindowStartAddressOffset != WorkloadInfo::undefinedOffset) {
+            *(uintptr_t *)&(kernelInfo.crossThreadData[kernelInfo.workloadInfo.localMemoryStatelessWindowStartAddressOffset]) = reinterpret_cast<uintptr_t>(this->pDevice->getSLMWindowStartAddress());
         }
 
-        if (LocalMemoryStatelessWindowSizeOffset != 0xFFffFFff) {
-            *(uint32_t *)&(kernelInfo.crossThreadData[LocalMemoryStatelessWindowSizeOffset]) = (uint32_t)this->pDevice->getDeviceInfo().localMemSize;
+        if (kernelInfo.workloadInfo.localMemoryStatelessWindowSizeOffset != WorkloadInfo::undefinedOffset) {
+            *(uint32_t *)&(kernelInfo.crossThreadData[kernelInfo.workloadInfo.localMemoryStatelessWindowSizeOffset]) = (uint32_t)this->pDevice->getDeviceInfo().localMemSize;
         }
 
-        if (kernelInfo.patchInfo.pAllocateStatelessPrivateSurface && (PrivateMemoryStatelessSizeOffset != 0xFFffFFff)) {
-            *(uint32_t *)&(kernelInfo.crossThreadData[PrivateMemoryStatelessSizeOffset]) = kernelInfo.patchInfo.pAllocateStatelessPrivateSurface->PerThreadPrivateMemorySize * this->getDevice(0).getDeviceInfo().computeUnitsUsedForScratch * kernelInfo.getMaxSimdSize();
+        if (kernelInfo.patchInfo.pAllocateStatelessPrivateSurface && (kernelInfo.workloadInfo.privateMemoryStatelessSizeOffset != WorkloadInfo::undefinedOffset)) {
+            *(uint32_t *)&(kernelInfo.crossThreadData[kernelInfo.workloadInfo.privateMemoryStatelessSizeOffset]) = kernelInfo.patchInfo.pAllocateStatelessPrivateSurface->PerThreadPrivateMemorySize * this->getDevice(0).getDeviceInfo().computeUnitsUsedForScratch * kernelInfo.getMaxSimdSize();
         }
 
         if (kernelInfo.workloadInfo.maxWorkGroupSizeOffset != WorkloadInfo::undefinedOffset) {
             *(uint32_t *)&(kernelInfo.crossThreadData[kernelInfo.workloadInfo.maxWorkGroupSizeOffset]) = (uint32_t)this->getDevice(0).getDeviceInfo().maxWorkGroupSize;
         }
     }
-
-    return retVal;
 }
 
 cl_int Program::parseProgramScopePatchList() {
@@ -954,9 +1064,22 @@ cl_int Program::processGenBinary() {
         auto numKernels = pGenBinaryHeader->NumberOfKernels;
         for (uint32_t i = 0; i < numKernels && retVal == CL_SUCCESS; i++) {
 
-            size_t bytesProcessed = processKernel(pCurBinaryPtr, retVal);
+            size_t bytesProcessed = processKernel(pCurBinaryPtr, retVal, false);
             pCurBinaryPtr = ptrOffset(pCurBinaryPtr, bytesProcessed);
         }
+
+        // a valid kernel info image already holds the decoded patch lists, otherwise they are only
+        // walked here so that a malformed binary fails the build and decoded on first getKernelInfo;
+        // parent and subgroup kernels are decoded right away since their block kernels are separated at build time
+        bool kernelInfosRestored = (retVal == CL_SUCCESS) && !kernelInfoImage.empty() && restoreKernelInfoImage();
+        bool requiresDecoding = false;
+        for (size_t i = 0; i < kernelInfoArray.size() && retVal == CL_SUCCESS && !kernelInfosRestored; i++) {
+            retVal = validateKernelPatchList(*kernelInfoArray[i], requiresDecoding);
+        }
+        for (size_t i = 0; i < kernelInfoArray.size() && retVal == CL_SUCCESS && !kernelInfosRestored && requiresDecoding; i++) {
+            retVal = decodeKernelPatchList(*kernelInfoArray[i]);
+            registerBlockKernelParent(*kernelInfoArray[i]);
+        }
     } while (false);
 
     return retVal;
@@ -24,6 +24,7 @@
 #include "elf/writer.h"
 #include "runtime/context/context.h"
 #include "runtime/helpers/debug_helpers.h"
+#include "runtime/helpers/ptr_math.h"
 #include "runtime/helpers/string.h"
 #include "runtime/memory_manager/memory_manager.h"
 #include "runtime/compiler_interface/compiler_interface.h"
@@ -34,6 +35,9 @@ namespace OCLRT {
 
 const std::string Program::clOptNameClVer("-cl-std=CL");
 const std::string Program::clOptNameUniformWgs{"-cl-uniform-work-group-size"};
+// makes CL_PROGRAM_BINARIES carry the pre-decoded kernel info of the program, see kernel_info_image.h;
+// runtimes without support for the kernel info section reject such binaries
+const std::string Program::clOptNameEmbedKernelInfo{"-cl-intel-embed-kernel-info"};
 
 Program::Program() : Program(nullptr) {
     numDevices = 0;
@@ -98,8 +102,7 @@ Program::~Program() {
     if (context && !isBuiltIn) {
         context->decRefInternal();
     }
-    delete[] genBinary;
-    genBinary = nullptr;
+    releaseGenBinary();
 
     delete[] llvmBinary;
     llvmBinary = nullptr;
@@ -264,9 +267,31 @@ cl_int Program::getSource(char *&pBinary, unsigned int &dataSize) const {
 void Program::storeGenBinary(
     const void *pSrc,
     const size_t srcSize) {
+    releaseGenBinary();
     storeBinary(genBinary, genBinarySize, pSrc, srcSize);
 }
 
+void Program::storeGenBinary(
+    std::unique_ptr<OsMappedFile> mappedFile,
+    size_t offset,
+    size_t size) {
+    DEBUG_BREAK_IF(!(mappedFile && size > 0 && offset + size <= mappedFile->getSize()));
+
+    releaseGenBinary();
+    genBinary = const_cast<char *>(ptrOffset(reinterpret_cast<const char *>(mappedFile->getData()), offset));
+    genBinarySize = size;
+    genBinaryMapping = std::move(mappedFile);
+}
+
+void Program::releaseGenBinary() {
+    if (genBinaryMapping == nullptr) {
+        delete[] genBinary;
+    }
+    genBinaryMapping.reset();
+    genBinary = nullptr;
+    genBinarySize = 0;
+}
+
 void Program::storeLlvmBinary(
     const void *pSrc,
     const size_t srcSize) {
@@ -432,4 +457,13 @@ void Program::updateNonUniformFlag(const Program **inputPrograms, size_t numInpu
     }
     this->allowNonUniform = allowNonUniform;
 }
+
+bool Program::extractOption(std::string &options, const std::string &optionName) {
+    auto pos = options.find(optionName);
+    if (pos == std::string::npos) {
+        return false;
+    }
+    options.erase(pos, optionName.length());
+    return true;
+}
 } // namespace OCLRT
@@ -29,15 +29,20 @@
 #include "runtime/helpers/base_object.h"
 #include "runtime/helpers/stdio.h"
 #include "runtime/helpers/string_helpers.h"
+#include "runtime/os_interface/os_mapped_file.h"
 #include "igfxfmid.h"
 #include "patch_list.h"
+#include <atomic>
 #include <vector>
 #include <string>
 #include <map>
+#include <memory>
+#include <mutex>
 
 #define OCLRT_ALIGN(a, b) ((((a) % (b)) != 0) ? ((a) - ((a) % (b)) + (b)) : (a))
 
 namespace OCLRT {
+class AsyncBuildHandler;
 class Context;
 class CompilerInterface;
 template <>
@@ -126,6 +131,11 @@ class Program : public BaseObject<_cl_program> {
                  void(CL_CALLBACK *funcNotify)(cl_program program, void *userData),
                  void *userData, bool enableCaching);
 
+    // validates arguments synchronously, then builds on one of the handler's threads and calls funcNotify when done
+    cl_int buildAsync(cl_uint numDevices, const cl_device_id *deviceList, const char *buildOptions,
+                      void(CL_CALLBACK *funcNotify)(cl_program program, void *userData),
+                      void *userData, bool enableCaching, AsyncBuildHandler &asyncBuildHandler);
+
     cl_int build(const cl_device_id device, const char *buildOptions, bool enableCaching,
                  std::unordered_map<std::string, BuiltinDispatchInfoBuilder *> &builtinsMap);
 
@@ -143,6 +153,11 @@ class Program : public BaseObject<_cl_program> {
                 void(CL_CALLBACK *funcNotify)(cl_program program, void *userData),
                 void *userData);
 
+    // kernel info is rebuilt while a build is in progress and must not be accessed then
+    bool isBuildInProgress() const {
+        return buildStatus == CL_BUILD_IN_PROGRESS;
+    }
+
     size_t getNumKernels() const;
     const KernelInfo *getKernelInfo(const char *kernelName) const;
     const KernelInfo *getKernelInfo(size_t ordinal) const;
@@ -178,6 +193,13 @@ class Program : public BaseObject<_cl_program> {
 
     void storeGenBinary(const void *pSrc, const size_t srcSize);
 
+    // references gen binary directly in copy-on-write mapped file instead of copying it
+    void storeGenBinary(std::unique_ptr<OsMappedFile> mappedFile, size_t offset, size_t size);
+
+    bool isGenBinaryMapped() const {
+        return genBinaryMapping != nullptr;
+    }
+
     char *getGenBinary(size_t &genBinarySize) const {
         genBinarySize = this->genBinarySize;
         return this->genBinary;
@@ -185,8 +207,18 @@ class Program : public BaseObject<_cl_program> {
 
     void storeLlvmBinary(const void *pSrc, const size_t srcSize);
 
+    char *getLlvmBinary(size_t &llvmBinarySize) const {
+        llvmBinarySize = this->llvmBinarySize;
+        return this->llvmBinary;
+    }
+
     void storeDebugData(const void *pSrc, const size_t srcSize);
 
+    char *getDebugData(size_t &debugDataSize) const {
+        debugDataSize = this->debugDataSize;
+        return this->debugData;
+    }
+
     void updateBuildLog(const Device *pDevice, const char *pErrorString, const size_t errorStringSize);
 
     const char *getBuildLog(const Device *pDevice) const;
@@ -244,6 +276,14 @@ class Program : public BaseObject<_cl_program> {
 
     bool optionsAreNew(const char *options) const;
 
+    cl_int validateBuildArgs(cl_uint numDevices, const cl_device_id *deviceList,
+                             void(CL_CALLBACK *funcNotify)(cl_program program, void *userData),
+                             void *userData) const;
+    // atomically moves to CL_BUILD_IN_PROGRESS, fails when another build, compile or link is in progress
+    bool tryStartBuild();
+    cl_int buildImpl(const char *buildOptions, bool enableCaching);
+    void finishBuild(cl_int retVal, void(CL_CALLBACK *funcNotify)(cl_program program, void *userData), void *userData);
+
     cl_int processElfHeader(const CLElfLib::SElf64Header *pElfHeader,
                             cl_program_binary_type &binaryType, uint32_t &numSections);
 
@@ -255,12 +295,26 @@ class Program : public BaseObject<_cl_program> {
 
     MOCKABLE_VIRTUAL cl_int rebuildProgramFromLLVM();
 
-    cl_int parsePatchList(KernelInfo &pKernelInfo);
+    cl_int validateKernelPatchList(const KernelInfo &kernelInfo, bool &requiresDecoding);
+
+    cl_int parsePatchList(KernelInfo &pKernelInfo) const;
+
+    cl_int decodeKernelPatchList(KernelInfo &kernelInfo) const;
+
+    void registerBlockKernelParent(KernelInfo &kernelInfo);
+
+    void initializeCrossThreadData(KernelInfo &kernelInfo) const;
 
-    size_t processKernel(const void *pKernelBlob, cl_int &retVal);
+    bool serializeKernelInfoImage(std::vector<char> &image);
+
+    bool restoreKernelInfoImage();
+
+    size_t processKernel(const void *pKernelBlob, cl_int &retVal, bool decodePatchList = true);
 
     void storeBinary(char *&pDst, size_t &dstSize, const void *pSrc, const size_t srcSize);
 
+    void releaseGenBinary();
+
     bool validateGenBinaryDevice(GFXCORE_FAMILY device) const;
     bool validateGenBinaryHeader(const iOpenCL::SProgramBinaryHeader *pGenBinaryHeader) const;
 
@@ -273,16 +327,22 @@ class Program : public BaseObject<_cl_program> {
     void updateNonUniformFlag();
     void updateNonUniformFlag(const Program **inputProgram, size_t numInputPrograms);
 
+    static bool extractOption(std::string &options, const std::string &optionName);
+
     static const std::string clOptNameClVer;
     static const std::string clOptNameUniformWgs;
+    static const std::string clOptNameEmbedKernelInfo;
     // clang-format off
     cl_program_binary_type    programBinaryType;
     bool                      isSpirV = false;
+    bool                      embedKernelInfo = false;
     char*                     elfBinary;
     size_t                    elfBinarySize;
 
     char*                     genBinary;
     size_t                    genBinarySize;
+    std::unique_ptr<OsMappedFile> genBinaryMapping;
+    std::vector<char>         kernelInfoImage;
 
     char*                     llvmBinary;
     size_t                    llvmBinarySize;
@@ -293,6 +353,7 @@ class Program : public BaseObject<_cl_program> {
     std::vector<KernelInfo*>  kernelInfoArray;
     std::vector<KernelInfo*>  parentKernelInfoArray;
     std::vector<KernelInfo*>  subgroupKernelInfoArray;
+    mutable std::mutex        kernelDecodeMutex;
     BlockKernelManager *      blockKernelManager;
 
     const void*               programScopePatchList;
@@ -303,7 +364,7 @@ class Program : public BaseObject<_cl_program> {
 
     size_t                    globalVarTotalSize;
 
-    cl_build_status           buildStatus;
+    std::atomic<cl_build_status> buildStatus;
     bool                      isCreatedFromBinary;
     bool                      isProgramBinaryResolved;
 
@@ -27,8 +27,10 @@
 #include <cstdint>
 #include <algorithm>
 
-#include <vector>
-#include <unordered_map>
+#include <map>
+#include <mutex>
+#include <set>
+#include <utility>
 
 namespace OCLRT {
 
@@ -40,20 +42,104 @@ struct HeapChunk {
 
 bool operator<(const HeapChunk &hc1, const HeapChunk &hc2);
 
+// Freed chunks indexed both by address (neighbour lookup for coalescing)
+// and by size (best-fit lookup), all operations are O(log n).
+class HeapFreeChunks {
+  public:
+    struct CompareBySize {
+        // among chunks of equal size the one with the highest address is preferred
+        bool operator()(const std::pair<size_t, uint64_t> &lhs, const std::pair<size_t, uint64_t> &rhs) const {
+            return (lhs.first != rhs.first) ? (lhs.first < rhs.first) : (lhs.second > rhs.second);
+        }
+    };
+    using ChunksByAddress = std::map<uint64_t, size_t>;
+    using ChunksBySize = std::set<std::pair<size_t, uint64_t>, CompareBySize>;
+
+    void insert(void *ptr, size_t size) {
+        insert(reinterpret_cast<uintptr_t>(ptr), size);
+    }
+
+    void insert(uint64_t ptr, size_t size) {
+        chunksByAddress[ptr] = size;
+        chunksBySize.emplace(size, ptr);
+        totalSize += size;
+    }
+
+    void erase(uint64_t ptr) {
+        auto it = chunksByAddress.find(ptr);
+        DEBUG_BREAK_IF(it == chunksByAddress.end());
+        chunksBySize.erase(std::make_pair(it->second, ptr));
+        totalSize -= it->second;
+        chunksByAddress.erase(it);
+    }
+
+    void resize(uint64_t ptr, size_t newSize) {
+        auto size = peekSize(ptr);
+        chunksBySize.erase(std::make_pair(size, ptr));
+        chunksBySize.emplace(newSize, ptr);
+        chunksByAddress[ptr] = newSize;
+        totalSize = totalSize - size + newSize;
+    }
+
+    // returns size of the chunk starting at ptr or 0 if there is none
+    size_t peekSize(void *ptr) const {
+        return peekSize(reinterpret_cast<uintptr_t>(ptr));
+    }
+
+    size_t peekSize(uint64_t ptr) const {
+        auto it = chunksByAddress.find(ptr);
+        return (it != chunksByAddress.end()) ? it->second : 0u;
+    }
+
+    bool peekEndingAt(uint64_t end, uint64_t &ptr) const {
+        auto it = chunksByAddress.lower_bound(end);
+        if (it == chunksByAddress.begin()) {
+            return false;
+        }
+        --it;
+        ptr = it->first;
+        return (it->first + it->second == end);
+    }
+
+    // smallest chunk not smaller than size
+    bool peekBestFit(size_t size, uint64_t &ptr, size_t &chunkSize) const {
+        auto it = chunksBySize.lower_bound(std::make_pair(size, UINT64_MAX));
+        if (it == chunksBySize.end()) {
+            return false;
+        }
+        chunkSize = it->first;
+        ptr = it->second;
+        return true;
+    }
+
+    size_t getLargestChunkSize() const {
+        return chunksBySize.empty() ? 0u : chunksBySize.rbegin()->first;
+    }
+
+    uint64_t getTotalSize() const { return totalSize; }
+    size_t size() const { return chunksByAddress.size(); }
+    bool empty() const { return chunksByAddress.empty(); }
+
+  protected:
+    ChunksByAddress chunksByAddress;
+    ChunksBySize chunksBySize;
+    uint64_t totalSize = 0;
+};
+
 class HeapAllocator {
   public:
     HeapAllocator(void *address, uint64_t size) : address(address), size(size), availableSize(size), sizeThreshold(defaultSizeThreshold) {
         pLeftBound = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(address));
         pRightBound = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(address) + (size_t)size);
-        freedChunksBig.reserve(10);
-        freedChunksSmall.reserve(50);
     }
 
     HeapAllocator(void *address, uint64_t size, size_t threshold) : address(address), size(size), availableSize(size), sizeThreshold(threshold) {
         pLeftBound = reinterpret_cast<uint64_t>(address);
         pRightBound = reinterpret_cast<uint64_t>(address) + size;
-        freedChunksBig.reserve(10);
-        freedChunksSmall.reserve(50);
+    }
+
+    HeapAllocator(void *address, uint64_t size, size_t threshold, size_t alignment) : HeapAllocator(address, size, threshold) {
+        allocationAlignment = alignment;
     }
 
     ~HeapAllocator() {
@@ -70,42 +156,31 @@ class HeapAllocator {
             return nullptr;
         }
 
-        std::vector<HeapChunk> &freedChunks = (sizeToAllocate > sizeThreshold) ? freedChunksBig : freedChunksSmall;
+        HeapFreeChunks &freedChunks = (sizeToAllocate > sizeThreshold) ? freedChunksBig : freedChunksSmall;
         size_t sizeOfFreedChunk = 0;
-        uint32_t defragmentCount = 0;
-
-        while (ptrReturn == nullptr) {
-
-            ptrReturn = getFromFreedChunks(sizeToAllocate, freedChunks, sizeOfFreedChunk);
-
-            if (ptrReturn == nullptr) {
-                if (sizeToAllocate > sizeThreshold) {
-                    if (pLeftBound + sizeToAllocate <= pRightBound) {
-                        ptrReturn = reinterpret_cast<void *>(pLeftBound);
-                        pLeftBound += sizeToAllocate;
-                    }
-                } else {
-                    if (pRightBound - sizeToAllocate >= pLeftBound) {
-                        pRightBound -= sizeToAllocate;
-                        ptrReturn = reinterpret_cast<void *>(pRightBound);
-                    }
-                }
-            }
 
-            if (ptrReturn != nullptr) {
-                if (sizeOfFreedChunk > 0) {
-                    availableSize -= sizeOfFreedChunk;
-                    sizeToAllocate = sizeOfFreedChunk;
-                } else {
-                    availableSize -= sizeToAllocate;
+        ptrReturn = getFromFreedChunks(sizeToAllocate, freedChunks, sizeOfFreedChunk);
+
+        if (ptrReturn == nullptr) {
+            if (sizeToAllocate > sizeThreshold) {
+                if (pLeftBound + sizeToAllocate <= pRightBound) {
+                    ptrReturn = reinterpret_cast<void *>(pLeftBound);
+                    pLeftBound += sizeToAllocate;
+                }
+            } else {
+                if (pRightBound - sizeToAllocate >= pLeftBound) {
+                    pRightBound -= sizeToAllocate;
+                    ptrReturn = reinterpret_cast<void *>(pRightBound);
                 }
             }
+        }
 
-            if (ptrReturn == nullptr) {
-                if (defragmentCount == 1)
-                    break;
-                defragment();
-                defragmentCount++;
+        if (ptrReturn != nullptr) {
+            if (sizeOfFreedChunk > 0) {
+                availableSize -= sizeOfFreedChunk;
+                sizeToAllocate = sizeOfFreedChunk;
+            } else {
+                availableSize -= sizeToAllocate;
             }
         }
 
@@ -150,6 +225,29 @@ class HeapAllocator {
         return 1.0 * (size - availableSize) / (size * 1.0);
     }
 
+    uint64_t getLargestFreeBlockSize() {
+        std::lock_guard<std::mutex> lock(mtx);
+        uint64_t largest = pRightBound - pLeftBound;
+        largest = std::max(largest, static_cast<uint64_t>(freedChunksSmall.getLargestChunkSize()));
+        largest = std::max(largest, static_cast<uint64_t>(freedChunksBig.getLargestChunkSize()));
+        return largest;
+    }
+
+    // 0.0 when all free space is one block, approaching 1.0 as it gets scattered into small chunks
+    double getFragmentation() {
+        auto largest = getLargestFreeBlockSize();
+        std::lock_guard<std::mutex> lock(mtx);
+        if (availableSize == 0) {
+            return 0.0;
+        }
+        return 1.0 - static_cast<double>(largest) / static_cast<double>(availableSize);
+    }
+
+    size_t getFreedChunksCount() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return freedChunksSmall.size() + freedChunksBig.size();
+    }
+
   protected:
     void *address;
     uint64_t size;
@@ -159,134 +257,76 @@ class HeapAllocator {
     const size_t sizeThreshold;
     size_t allocationAlignment = MemoryConstants::pageSize;
 
-    std::vector<HeapChunk> freedChunksSmall;
-    std::vector<HeapChunk> freedChunksBig;
+    HeapFreeChunks freedChunksSmall;
+    HeapFreeChunks freedChunksBig;
     std::mutex mtx;
 
-    void *getFromFreedChunks(size_t size, std::vector<HeapChunk> &freedChunks, size_t &sizeOfFreedChunk) {
-        size_t elements = freedChunks.size();
-        size_t bestFitIndex = -1;
+    void *getFromFreedChunks(size_t size, HeapFreeChunks &freedChunks, size_t &sizeOfFreedChunk) {
+        uint64_t bestFitPtr = 0;
         size_t bestFitSize = 0;
         sizeOfFreedChunk = 0;
 
-        for (size_t i = 0; i < elements; i++) {
-            if (freedChunks[i].size == size) {
-                void *ptr = freedChunks[i].ptr;
-                freedChunks.erase(freedChunks.begin() + i);
-                return ptr;
-            }
+        if (!freedChunks.peekBestFit(size, bestFitPtr, bestFitSize)) {
+            return nullptr;
+        }
 
-            if (freedChunks[i].size > size) {
-                if (freedChunks[i].size < bestFitSize || bestFitSize == 0) {
-                    bestFitIndex = i;
-                    bestFitSize = freedChunks[i].size;
-                }
-            }
+        if (bestFitSize == size) {
+            freedChunks.erase(bestFitPtr);
+            return reinterpret_cast<void *>(bestFitPtr);
         }
 
-        if (bestFitSize != 0) {
-            if (bestFitSize < (size << 1)) {
-                void *ptr = freedChunks[bestFitIndex].ptr;
-                sizeOfFreedChunk = freedChunks[bestFitIndex].size;
-                freedChunks.erase(freedChunks.begin() + bestFitIndex);
-                return ptr;
-            } else {
-                size_t sizeDelta = freedChunks[bestFitIndex].size - size;
+        if (bestFitSize < (size << 1)) {
+            sizeOfFreedChunk = bestFitSize;
+            freedChunks.erase(bestFitPtr);
+            return reinterpret_cast<void *>(bestFitPtr);
+        }
 
-                DEBUG_BREAK_IF(!((size <= sizeThreshold) || ((size > sizeThreshold) && (sizeDelta > sizeThreshold))));
+        size_t sizeDelta = bestFitSize - size;
 
-                void *ptr = reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(freedChunks[bestFitIndex].ptr) + sizeDelta);
-                freedChunks[bestFitIndex].size = sizeDelta;
-                return ptr;
-            }
-        }
-        return nullptr;
+        DEBUG_BREAK_IF(!((size <= sizeThreshold) || ((size > sizeThreshold) && (sizeDelta > sizeThreshold))));
+
+        freedChunks.resize(bestFitPtr, sizeDelta);
+        return reinterpret_cast<void *>(bestFitPtr + sizeDelta);
     }
 
-    void storeInFreedChunks(void *ptr, size_t size, std::vector<HeapChunk> &freedChunks) {
-        size_t elements = freedChunks.size();
-        uintptr_t pLeft = reinterpret_cast<uintptr_t>(ptr);
-        uintptr_t pRight = reinterpret_cast<uintptr_t>(ptr) + size;
-        bool freedChunkStored = false;
-
-        for (size_t i = 0; i < elements; i++) {
-            if (freedChunks[i].ptr == reinterpret_cast<void *>(pRight)) {
-                freedChunks[i].ptr = reinterpret_cast<void *>(pLeft);
-                freedChunks[i].size += size;
-                freedChunkStored = true;
-            } else if ((reinterpret_cast<uintptr_t>(freedChunks[i].ptr) + freedChunks[i].size) == pLeft) {
-                freedChunks[i].size += size;
-                freedChunkStored = true;
-            }
+    void storeInFreedChunks(void *ptr, size_t size, HeapFreeChunks &freedChunks) {
+        uint64_t pLeft = reinterpret_cast<uintptr_t>(ptr);
+        uint64_t pRight = pLeft + size;
 
-            if (freedChunkStored == true) {
-                break;
-            }
+        // coalesce with both neighbours, so freed chunks never need sorting
+        auto rightNeighbourSize = freedChunks.peekSize(pRight);
+        if (rightNeighbourSize != 0) {
+            freedChunks.erase(pRight);
+            size += rightNeighbourSize;
         }
 
-        if (freedChunkStored == false) {
-            freedChunks.emplace_back(ptr, size);
+        uint64_t leftNeighbour = 0;
+        if (freedChunks.peekEndingAt(pLeft, leftNeighbour)) {
+            freedChunks.resize(leftNeighbour, freedChunks.peekSize(leftNeighbour) + size);
+        } else {
+            freedChunks.insert(pLeft, size);
         }
     }
 
     void mergeLastFreedSmall() {
-
-        size_t maxSizeOfSmallChunks = freedChunksSmall.size();
-
-        if (maxSizeOfSmallChunks > 0) {
-            uintptr_t ptr = reinterpret_cast<uintptr_t>(freedChunksSmall[maxSizeOfSmallChunks - 1].ptr);
-            size_t chunkSize = freedChunksSmall[maxSizeOfSmallChunks - 1].size;
-            if (ptr == pRightBound) {
-                pRightBound = ptr + chunkSize;
-                freedChunksSmall.pop_back();
-            }
+        auto chunkSize = freedChunksSmall.peekSize(pRightBound);
+        if (chunkSize != 0) {
+            freedChunksSmall.erase(pRightBound);
+            pRightBound += chunkSize;
         }
     }
 
     void mergeLastFreedBig() {
-        size_t maxSizeOfBigChunks = freedChunksBig.size();
-
-        if (maxSizeOfBigChunks > 0) {
-            uintptr_t ptr = reinterpret_cast<uintptr_t>(freedChunksBig[maxSizeOfBigChunks - 1].ptr);
-            size_t chunkSize = freedChunksBig[maxSizeOfBigChunks - 1].size;
-
-            if (ptr == (pLeftBound - chunkSize)) {
-                pLeftBound = (pLeftBound - chunkSize);
-                freedChunksBig.pop_back();
-            }
+        uint64_t chunkPtr = 0;
+        if (freedChunksBig.peekEndingAt(pLeftBound, chunkPtr)) {
+            freedChunksBig.erase(chunkPtr);
+            pLeftBound = chunkPtr;
         }
     }
 
     void defragment() {
-
-        if (freedChunksSmall.size() > 1) {
-            std::sort(freedChunksSmall.rbegin(), freedChunksSmall.rend());
-            size_t maxSize = freedChunksSmall.size();
-            for (size_t i = maxSize - 1; i > 0; --i) {
-                uintptr_t ptr = reinterpret_cast<uintptr_t>(freedChunksSmall[i].ptr);
-                size_t chunkSize = freedChunksSmall[i].size;
-
-                if (reinterpret_cast<uintptr_t>(freedChunksSmall[i - 1].ptr) == ptr + chunkSize) {
-                    freedChunksSmall[i - 1].ptr = reinterpret_cast<void *>(ptr);
-                    freedChunksSmall[i - 1].size += chunkSize;
-                    freedChunksSmall.erase(freedChunksSmall.begin() + i);
-                }
-            }
-        }
+        // freed chunks are coalesced on free, only ones touching the free range are left to merge
         mergeLastFreedSmall();
-        if (freedChunksBig.size() > 1) {
-            std::sort(freedChunksBig.begin(), freedChunksBig.end());
-
-            size_t maxSize = freedChunksBig.size();
-            for (size_t i = maxSize - 1; i > 0; --i) {
-                uintptr_t ptr = reinterpret_cast<uintptr_t>(freedChunksBig[i].ptr);
-                size_t chunkSize = freedChunksBig[i].size;
-                if ((reinterpret_cast<uintptr_t>(freedChunksBig[i - 1].ptr) + freedChunksBig[i - 1].size) == ptr) {
-                    freedChunksBig[i - 1].size += chunkSize;
-                    freedChunksBig.erase(freedChunksBig.begin() + i);
-                }
-            }
-        }
         mergeLastFreedBig();
         DBG_LOG(PrintDebugMessages, __FUNCTION__, "Allocator usage == ", this->getUsage());
     }
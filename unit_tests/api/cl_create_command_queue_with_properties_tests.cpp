@@ -359,4 +359,31 @@ INSTANTIATE_TEST_CASE_P(AllValidPriorities,
                         clCreateCommandQueueWithPropertiesApiPriority,
                         ::testing::ValuesIn(priorityParams));
 
+std::pair<uint32_t, QueueThrottle> throttleParams[3]{
+    std::make_pair(CL_QUEUE_THROTTLE_LOW_KHR, QueueThrottle::LOW),
+    std::make_pair(CL_QUEUE_THROTTLE_MED_KHR, QueueThrottle::MEDIUM),
+    std::make_pair(CL_QUEUE_THROTTLE_HIGH_KHR, QueueThrottle::HIGH)};
+
+class clCreateCommandQueueWithPropertiesApiThrottle : public clCreateCommandQueueWithPropertiesApi,
+                                                      public ::testing::WithParamInterface<std::pair<uint32_t, QueueThrottle>> {
+};
+
+TEST_P(clCreateCommandQueueWithPropertiesApiThrottle, givenCreateQueueWithThrottlePropertiesThenSetCorrectThrottleInternally) {
+    cl_int retVal = CL_SUCCESS;
+    cl_queue_properties properties[] = {CL_QUEUE_THROTTLE_KHR, GetParam().first, 0};
+    auto cmdqd = clCreateCommandQueueWithProperties(pContext, devices[0], properties, &retVal);
+    EXPECT_NE(nullptr, cmdqd);
+    EXPECT_EQ(retVal, CL_SUCCESS);
+
+    auto commandQueue = castToObject<CommandQueue>(cmdqd);
+    EXPECT_EQ(commandQueue->getThrottle(), GetParam().second);
+
+    retVal = clReleaseCommandQueue(cmdqd);
+    EXPECT_EQ(retVal, CL_SUCCESS);
+}
+
+INSTANTIATE_TEST_CASE_P(AllValidThrottles,
+                        clCreateCommandQueueWithPropertiesApiThrottle,
+                        ::testing::ValuesIn(throttleParams));
+
 } // namespace ULT
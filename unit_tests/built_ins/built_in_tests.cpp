@@ -35,9 +35,11 @@
 #include "unit_tests/fixtures/context_fixture.h"
 #include "unit_tests/fixtures/image_fixture.h"
 #include "unit_tests/fixtures/run_kernel_fixture.h"
+#include <algorithm>
 #include <string>
 #include "runtime/helpers/string.h"
 #include "unit_tests/mocks/mock_buffer.h"
+#include "unit_tests/mocks/mock_builtins.h"
 #include "unit_tests/mocks/mock_compilers.h"
 #include "unit_tests/mocks/mock_kernel.h"
 #include "runtime/helpers/dispatch_info_builder.h"
@@ -1499,3 +1501,78 @@ TEST_F(BuiltInTests, getSipKernelReturnsProgramCreatedOutOfIsaAcquiredFromCompil
     EXPECT_EQ(SipKernelType::Csr, mockCompilerInterface.requestedSipKernel);
     p->release();
 }
+
+class MockCorruptedBinaryStorage : public Storage {
+  public:
+    MockCorruptedBinaryStorage() : Storage("") {}
+
+    std::vector<std::string> requestedResources;
+
+  protected:
+    BuiltinResourceT loadImpl(const std::string &fullResourceName) override {
+        requestedResources.push_back(fullResourceName);
+        BuiltinResourceT ret;
+        if (fullResourceName.find(BuiltinCode::getExtension(BuiltinCode::ECodeType::Binary)) != std::string::npos) {
+            ret.assign(64, '\xFF');
+        }
+        return ret;
+    }
+};
+
+class MockBuiltinsWithCorruptedBinaries : public MockBuiltins {
+  public:
+    class MockBuiltinsLib : public BuiltinsLib {
+      public:
+        MockBuiltinsLib(MockCorruptedBinaryStorage *storage) {
+            allStorages.insert(allStorages.begin(), std::unique_ptr<Storage>(storage));
+        }
+    };
+
+    MockBuiltinsWithCorruptedBinaries() {
+        storage = new MockCorruptedBinaryStorage;
+        builtinsLib.reset(new MockBuiltinsLib(storage));
+        setCacheingEnableState(false);
+    }
+
+    bool sourceRequested() const {
+        auto sourceExtension = BuiltinCode::getExtension(BuiltinCode::ECodeType::Source);
+        return std::any_of(storage->requestedResources.begin(), storage->requestedResources.end(),
+                           [=](const std::string &name) { return name.find(sourceExtension) != std::string::npos; });
+    }
+
+    MockCorruptedBinaryStorage *storage = nullptr;
+};
+
+TEST_F(BuiltInTests, givenCorruptedBuiltinBinaryWhenBuilderIsCreatedThenKernelsAreBuiltFromSource) {
+    MockBuiltinsWithCorruptedBinaries mockBuiltins;
+
+    auto &builder = mockBuiltins.getBuiltinDispatchInfoBuilder(EBuiltInOps::CopyBufferToBuffer, *pContext, *pDevice);
+
+    EXPECT_TRUE(mockBuiltins.sourceRequested());
+
+    MockBuffer src;
+    MockBuffer dst;
+    MultiDispatchInfo multiDispatchInfo;
+    BuiltinDispatchInfoBuilder::BuiltinOpParams builtinOpsParams;
+    builtinOpsParams.srcMemObj = &src;
+    builtinOpsParams.dstMemObj = &dst;
+    builtinOpsParams.srcPtr = src.getCpuAddress();
+    builtinOpsParams.dstPtr = dst.getCpuAddress();
+    builtinOpsParams.size = {dst.getSize(), 0, 0};
+    EXPECT_TRUE(builder.buildDispatchInfos(multiDispatchInfo, builtinOpsParams));
+    EXPECT_NE(0u, multiDispatchInfo.size());
+}
+
+TEST_F(BuiltInTests, givenCorruptedBuiltinBinaryAndFailingSourceBuildWhenBuilderIsCreatedThenItFailsInsteadOfGrabbingKernels) {
+    MockBuiltinsWithCorruptedBinaries mockBuiltins;
+
+    MockCompilerDebugVars igcDebugVars;
+    igcDebugVars.fileName = gEnvironment->igcGetMockFile();
+    igcDebugVars.forceBuildFailure = true;
+    gEnvironment->igcPushDebugVars(igcDebugVars);
+
+    EXPECT_THROW(mockBuiltins.getBuiltinDispatchInfoBuilder(EBuiltInOps::CopyBufferToBuffer, *pContext, *pDevice), std::exception);
+    EXPECT_TRUE(mockBuiltins.sourceRequested());
+
+    gEnvironment->igcPopDebugVars();
+}
@@ -125,6 +125,26 @@ TEST(CommandQueue, taskLevelInitializesTo0) {
     EXPECT_EQ(0u, cmdQ.taskCount);
 }
 
+TEST(CommandQueue, givenBatchedFlushDebugFlagsWhenQueueIsCreatedThenBatchedFlushThresholdsAreTakenFromThem) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.BatchedFlushCommandBuffersThreshold.set(8);
+    DebugManager.flags.BatchedFlushSizeThresholdKB.set(64);
+    DebugManager.flags.BatchedFlushAgeThresholdUs.set(500);
+
+    CommandQueue cmdQ(nullptr, nullptr, 0);
+    auto &thresholds = cmdQ.getBatchedFlushThresholds();
+    EXPECT_EQ(8u, thresholds.commandBuffers);
+    EXPECT_EQ(64u * KB, thresholds.bytes);
+    EXPECT_EQ(500, thresholds.ageUs);
+
+    BatchedFlushThresholds queueThresholds;
+    queueThresholds.commandBuffers = 2;
+    cmdQ.setBatchedFlushThresholds(queueThresholds);
+    EXPECT_EQ(2u, cmdQ.getBatchedFlushThresholds().commandBuffers);
+    EXPECT_EQ(0u, cmdQ.getBatchedFlushThresholds().bytes);
+    EXPECT_EQ(0, cmdQ.getBatchedFlushThresholds().ageUs);
+}
+
 struct GetTagTest : public DeviceFixture,
                     public CommandQueueFixture,
                     public CommandStreamFixture,
@@ -661,6 +681,7 @@ struct KmdNotifyTests : public ::testing::Test {
     class MyCommandQueue : public CommandQueue {
       public:
         MyCommandQueue(Context *ctx, Device *device) : CommandQueue(ctx, device, 0) {}
+        void setThrottle(QueueThrottle newThrottle) { throttle = newThrottle; }
     };
 
     template <typename Family>
@@ -711,6 +732,7 @@ HWTEST_F(KmdNotifyTests, givenNotReadyTaskCountWhenWaitUntilCompletionCalledThen
 
     //we have unrecoverable for this case, this will throw.
     EXPECT_THROW(cmdQ->waitUntilComplete(taskCountToWait, flushStampToWait), std::exception);
+    EXPECT_EQ(1u, csr->getWaitStatistics().kmdWaits);
 }
 
 HWTEST_F(KmdNotifyTests, givenReadyTaskCountWhenWaitUntilCompletionCalledThenTryCpuPollingAndDontCallKmdWait) {
@@ -724,6 +746,63 @@ HWTEST_F(KmdNotifyTests, givenReadyTaskCountWhenWaitUntilCompletionCalledThenTry
     cmdQ->waitUntilComplete(taskCountToWait, flushStampToWait);
 }
 
+HWTEST_F(KmdNotifyTests, givenLowThrottleQueueWhenWaitUntilCompletionCalledThenKmdWaitIsUsedWithoutDelay) {
+    resetObjects(0, 0);
+    auto csr = new ::testing::NiceMock<MyCsr<FamilyType>>(device->getHardwareInfo());
+    device->resetCommandStreamReceiver(csr);
+    cmdQ->setThrottle(QueueThrottle::LOW);
+
+    EXPECT_CALL(*csr, waitForCompletionWithTimeout(true, 0, taskCountToWait)).Times(1).WillOnce(::testing::Return(true));
+
+    cmdQ->waitUntilComplete(taskCountToWait, flushStampToWait);
+}
+
+HWTEST_F(KmdNotifyTests, givenHighThrottleQueueWhenWaitUntilCompletionCalledThenTryCpuPollingWithoutTimeout) {
+    auto csr = new ::testing::NiceMock<MyCsr<FamilyType>>(device->getHardwareInfo());
+    device->resetCommandStreamReceiver(csr);
+    cmdQ->setThrottle(QueueThrottle::HIGH);
+
+    EXPECT_CALL(*csr, waitForCompletionWithTimeout(false, 1, taskCountToWait)).Times(1).WillOnce(::testing::Return(true));
+    EXPECT_CALL(*csr, waitForFlushStamp(::testing::_)).Times(0);
+
+    cmdQ->waitUntilComplete(taskCountToWait, flushStampToWait);
+}
+
+HWTEST_F(KmdNotifyTests, givenReadyTaskCountWhenPollForCompletionCalledThenWaitIsNotCounted) {
+    auto &csr = device->getCommandStreamReceiver();
+    EXPECT_TRUE(csr.waitForCompletionWithTimeout(true, 1, taskCountToWait));
+
+    auto statistics = csr.getWaitStatistics();
+    EXPECT_EQ(0u, statistics.waits);
+    EXPECT_EQ(0u, statistics.spinTimeUs + statistics.yieldTimeUs);
+}
+
+HWTEST_F(KmdNotifyTests, givenNotReadyTaskCountAndZeroTimeoutWhenPollForCompletionCalledThenTagIsCheckedWithoutPolling) {
+    auto &csr = device->getCommandStreamReceiver();
+    *device->getTagAddress() = taskCountToWait - 1;
+
+    EXPECT_FALSE(csr.waitForCompletionWithTimeout(true, 0, taskCountToWait));
+
+    auto statistics = csr.getWaitStatistics();
+    EXPECT_EQ(0u, statistics.waits);
+    EXPECT_EQ(0u, statistics.spinTimeUs + statistics.yieldTimeUs);
+}
+
+HWTEST_F(KmdNotifyTests, givenNotReadyTaskCountWhenPollForCompletionTimesOutThenTimeIsAccountedToSpinAndYieldPhases) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.WaitSpinIterations.set(64);
+    auto &csr = device->getCommandStreamReceiver();
+    *device->getTagAddress() = taskCountToWait - 1;
+
+    EXPECT_FALSE(csr.waitForCompletionWithTimeout(true, 1, taskCountToWait));
+
+    auto statistics = csr.getWaitStatistics();
+    EXPECT_EQ(1u, statistics.waits);
+    EXPECT_LE(1000u, statistics.spinTimeUs + statistics.yieldTimeUs);
+    EXPECT_LT(0u, statistics.yieldTimeUs);
+    EXPECT_EQ(0u, statistics.kmdWaits);
+}
+
 HWTEST_F(KmdNotifyTests, givenNotReadyTaskCountWhenPollForCompletionCalledThenTimeout) {
     CommandQueue commandQ(&context, device, 0);
     *device->getTagAddress() = taskCountToWait - 1;
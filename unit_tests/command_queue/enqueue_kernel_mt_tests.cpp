@@ -25,6 +25,9 @@
 #include "unit_tests/command_queue/enqueue_fixture.h"
 #include "unit_tests/mocks/mock_submissions_aggregator.h"
 
+#include <chrono>
+#include <string>
+
 typedef HelloWorldFixture<HelloWorldFixtureFactory> EnqueueKernelFixture;
 typedef Test<EnqueueKernelFixture> EnqueueKernelTest;
 
@@ -83,3 +86,51 @@ HWTEST_F(EnqueueKernelTest, givenCsrInBatchingModeWhenFinishIsCalledThenBatchesS
 
     EXPECT_EQ(mockedSubmissionsAggregator->peekInspectionId() - 1, (uint32_t)mockCsr->flushCalledCount);
 }
+
+HWTEST_F(EnqueueKernelTest, givenQueuePerThreadWhenKernelsAreEnqueuedConcurrentlyThenAllTasksAreSubmittedAndThroughputIsRecorded) {
+    auto &commandStreamReceiver = pDevice->getCommandStreamReceiver();
+    size_t gws[3] = {1, 0, 0};
+    auto enqueueCount = 100;
+
+    for (auto threadCount : {1, 2, 4, 8}) {
+        std::vector<CommandQueue *> queues;
+        std::vector<std::unique_ptr<MockKernelWithInternals>> kernels;
+        for (auto thread = 0; thread < threadCount; thread++) {
+            queues.push_back(createCommandQueue(pDevice, 0));
+            kernels.emplace_back(new MockKernelWithInternals(*pDevice));
+        }
+
+        std::atomic<bool> startEnqueueProcess(false);
+        auto function = [&](int thread) {
+            while (!startEnqueueProcess)
+                ;
+            for (int enqueue = 0; enqueue < enqueueCount; enqueue++) {
+                queues[thread]->enqueueKernel(kernels[thread]->mockKernel, 1, nullptr, gws, nullptr, 0, nullptr, nullptr);
+            }
+        };
+
+        auto taskCountBefore = commandStreamReceiver.peekTaskCount();
+
+        std::vector<std::thread> threads;
+        for (auto thread = 0; thread < threadCount; thread++) {
+            threads.push_back(std::thread(function, thread));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        startEnqueueProcess = true;
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        long long elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        EXPECT_EQ(taskCountBefore + static_cast<uint32_t>(enqueueCount * threadCount), commandStreamReceiver.peekTaskCount());
+
+        auto enqueuesPerSecond = static_cast<int>(enqueueCount * threadCount * 1000000ll / std::max(elapsed, 1ll));
+        RecordProperty("EnqueuesPerSecondWith" + std::to_string(threadCount) + "Threads", enqueuesPerSecond);
+
+        for (auto &queue : queues) {
+            queue->finish(false);
+            queue->release();
+        }
+    }
+}
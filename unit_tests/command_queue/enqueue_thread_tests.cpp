@@ -22,6 +22,7 @@
 
 #include "runtime/command_queue/command_queue_hw.h"
 #include "runtime/command_stream/command_stream_receiver_hw.h"
+#include "runtime/event/user_event.h"
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/kernel/kernel.h"
 #include "runtime/mem_obj/buffer.h"
@@ -32,6 +33,7 @@
 #include "unit_tests/fixtures/device_fixture.h"
 #include "unit_tests/fixtures/memory_management_fixture.h"
 #include "unit_tests/mocks/mock_context.h"
+#include "unit_tests/mocks/mock_kernel.h"
 #include "test.h"
 
 using namespace OCLRT;
@@ -124,9 +126,12 @@ struct EnqueueThreadingFixture : public DeviceFixture,
                 auto &kernel = *dispatchInfo.getKernel();
                 EXPECT_TRUE(kernel.hasOwnership());
             }
+            EXPECT_TRUE(this->hasOwnership());
+            deviceOwnedWhileRecording = this->getDevice().hasOwnership();
         }
 
         Kernel *kernel;
+        bool deviceOwnedWhileRecording = false;
     };
 
     CommandQueue *pCmdQ;
@@ -532,4 +537,33 @@ HWTEST_F(EnqueueThreading, flushWaitList_ReleaseOwnershipWhenQueueIsBlocked) {
 
     delete pMyDevice;
 }
+
+HWTEST_F(EnqueueThreading, givenUnblockedQueueWhenKernelIsEnqueuedThenCommandsAreRecordedWithoutDeviceOwnership) {
+    createCQ<FamilyType>();
+    auto myCmdQ = static_cast<MyCommandQueue<FamilyType> *>(pCmdQ);
+
+    MockKernelWithInternals mockKernel(*pDevice);
+    size_t gws[3] = {1, 0, 0};
+    pCmdQ->enqueueKernel(mockKernel.mockKernel, 1, nullptr, gws, nullptr, 0, nullptr, nullptr);
+
+    EXPECT_FALSE(myCmdQ->deviceOwnedWhileRecording);
+    EXPECT_FALSE(mockKernel.mockKernel->hasOwnership());
+    EXPECT_FALSE(pCmdQ->hasOwnership());
+}
+
+HWTEST_F(EnqueueThreading, givenBlockedQueueWhenKernelIsEnqueuedThenCommandsAreRecordedWithDeviceOwnership) {
+    createCQ<FamilyType>();
+    auto myCmdQ = static_cast<MyCommandQueue<FamilyType> *>(pCmdQ);
+
+    MockKernelWithInternals mockKernel(*pDevice);
+    size_t gws[3] = {1, 0, 0};
+    UserEvent userEvent(context);
+    cl_event blockingEvent = &userEvent;
+    pCmdQ->enqueueKernel(mockKernel.mockKernel, 1, nullptr, gws, nullptr, 1, &blockingEvent, nullptr);
+
+    EXPECT_TRUE(myCmdQ->deviceOwnedWhileRecording);
+
+    userEvent.setStatus(CL_COMPLETE);
+    pCmdQ->isQueueBlocked();
+}
 } // namespace ULT
@@ -53,6 +53,8 @@
 #include "runtime/utilities/linux/debug_env_reader.h"
 #include "runtime/gmm_helper/gmm_helper.h"
 #include "runtime/command_queue/dispatch_walker.h"
+#include <chrono>
+#include <thread>
 
 using namespace OCLRT;
 
@@ -1991,6 +1993,115 @@ HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrInBatchingModeAndTwoRecord
     EXPECT_EQ(secondBatchBufferAddress, batchBufferStart->getBatchBufferStartAddressGraphicsaddress472());
 }
 
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrInBatchingModeWhenCommandBuffersThresholdIsReachedThenRecordedCommandBuffersAreSubmitted) {
+    CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
+    auto &commandStream = commandQueue.getCS(4096u);
+
+    auto mockCsr = new MockCsrHw2<FamilyType>(*platformDevices[0]);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+
+    mockCsr->overrideDispatchPolicy(CommandStreamReceiver::DispatchMode::BatchedDispatch);
+
+    DispatchFlags dispatchFlags;
+    dispatchFlags.guardCommandBufferWithPipeControl = true;
+    dispatchFlags.batchedFlushThresholds.commandBuffers = 2;
+
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevel, dispatchFlags);
+
+    EXPECT_EQ(0, mockCsr->flushCalledCount);
+
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevel, dispatchFlags);
+
+    EXPECT_EQ(1, mockCsr->flushCalledCount);
+    EXPECT_TRUE(mockCsr->peekSubmissionAggregator()->peekCmdBufferList().peekIsEmpty());
+    EXPECT_EQ(2u, mockCsr->peekLatestFlushedTaskCount());
+
+    auto statistics = mockCsr->getBatchingStatistics();
+    EXPECT_EQ(1u, statistics.commandBufferLimitFlushes);
+    EXPECT_EQ(0u, statistics.explicitFlushes);
+    EXPECT_EQ(0u, statistics.implicitFlushes);
+
+    //tracking starts over after submission
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevel, dispatchFlags);
+    EXPECT_EQ(1, mockCsr->flushCalledCount);
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrInBatchingModeWhenBytesThresholdIsReachedThenRecordedCommandBuffersAreSubmitted) {
+    CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
+    auto &commandStream = commandQueue.getCS(4096u);
+
+    auto mockCsr = new MockCsrHw2<FamilyType>(*platformDevices[0]);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+
+    mockCsr->overrideDispatchPolicy(CommandStreamReceiver::DispatchMode::BatchedDispatch);
+
+    DispatchFlags dispatchFlags;
+    dispatchFlags.guardCommandBufferWithPipeControl = true;
+    dispatchFlags.batchedFlushThresholds.bytes = 1;
+
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevel, dispatchFlags);
+
+    EXPECT_EQ(1, mockCsr->flushCalledCount);
+    EXPECT_TRUE(mockCsr->peekSubmissionAggregator()->peekCmdBufferList().peekIsEmpty());
+    EXPECT_EQ(1u, mockCsr->getBatchingStatistics().byteLimitFlushes);
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrInBatchingModeWhenAgeThresholdPassesThenRecordedCommandBuffersAreSubmittedInBackground) {
+    CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
+    auto &commandStream = commandQueue.getCS(4096u);
+
+    auto mockCsr = new MockCsrHw2<FamilyType>(*platformDevices[0]);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+
+    mockCsr->overrideDispatchPolicy(CommandStreamReceiver::DispatchMode::BatchedDispatch);
+
+    DispatchFlags dispatchFlags;
+    dispatchFlags.guardCommandBufferWithPipeControl = true;
+    dispatchFlags.batchedFlushThresholds.ageUs = 1000;
+
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevel, dispatchFlags);
+
+    auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (mockCsr->peekLatestFlushedTaskCount() == 0 && std::chrono::steady_clock::now() < timeout) {
+        std::this_thread::yield();
+    }
+    mockCsr->closeBatchedSubmissionFlusher();
+
+    EXPECT_EQ(1u, mockCsr->peekLatestFlushedTaskCount());
+    EXPECT_EQ(1, mockCsr->flushCalledCount);
+    EXPECT_TRUE(mockCsr->peekSubmissionAggregator()->peekCmdBufferList().peekIsEmpty());
+    EXPECT_EQ(1u, mockCsr->getBatchingStatistics().ageLimitFlushes);
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrInBatchingModeWhenRecordedCommandBuffersAreFlushedThenFlushReasonIsCounted) {
+    CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
+    auto &commandStream = commandQueue.getCS(4096u);
+
+    auto mockCsr = new MockCsrHw2<FamilyType>(*platformDevices[0]);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+
+    mockCsr->overrideDispatchPolicy(CommandStreamReceiver::DispatchMode::BatchedDispatch);
+
+    DispatchFlags dispatchFlags;
+    dispatchFlags.guardCommandBufferWithPipeControl = true;
+
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevel, dispatchFlags);
+    mockCsr->flushBatchedSubmissions();
+
+    //nothing to submit, nothing to count
+    mockCsr->flushBatchedSubmissions();
+
+    dispatchFlags.blocking = true;
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevel, dispatchFlags);
+
+    auto statistics = mockCsr->getBatchingStatistics();
+    EXPECT_EQ(1u, statistics.explicitFlushes);
+    EXPECT_EQ(1u, statistics.implicitFlushes);
+    EXPECT_EQ(0u, statistics.commandBufferLimitFlushes);
+    EXPECT_EQ(0u, statistics.byteLimitFlushes);
+    EXPECT_EQ(0u, statistics.ageLimitFlushes);
+}
+
 HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrInBatchingModeAndThreeRecordedCommandBuffersWhenFlushTaskIsCalledThenBatchBuffersAreCombined) {
 
     typedef typename FamilyType::MI_BATCH_BUFFER_END MI_BATCH_BUFFER_END;
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/compiler_interface/binary_cache_index.h"
+#include "runtime/helpers/file_io.h"
+#include "runtime/os_interface/os_inc.h"
+#include "test.h"
+
+#include <cstdio>
+#include <string>
+
+using namespace OCLRT;
+
+namespace {
+const char *testCacheDirectory = ".";
+
+struct BinaryCacheIndexTest : public ::testing::Test {
+    void SetUp() override {
+        std::remove(getPath(BinaryCacheIndex::indexFileName).c_str());
+    }
+
+    void TearDown() override {
+        for (auto &fileName : createdFiles) {
+            std::remove(getPath(fileName).c_str());
+        }
+        std::remove(getPath(BinaryCacheIndex::indexFileName).c_str());
+        std::remove(getPath(BinaryCacheIndex::lockFileName).c_str());
+    }
+
+    std::string getPath(const std::string &fileName) {
+        return std::string(testCacheDirectory) + Os::fileSeparator + fileName;
+    }
+
+    void createFile(const std::string &fileName, size_t size) {
+        std::string data(size, 'x');
+        ASSERT_TRUE(BinaryCacheIndex::publishFile(getPath(fileName), data.c_str(), data.size()));
+        createdFiles.push_back(fileName);
+    }
+
+    std::vector<std::string> createdFiles;
+};
+} // namespace
+
+TEST(BinaryCacheIndexSerialization, givenEntriesWhenSerializedAndDeserializedThenEntriesArePreserved) {
+    std::unordered_map<std::string, BinaryCacheIndex::Entry> entries;
+    entries["a.cl_cache"] = {16u, 3u};
+    entries["bb.cl_src_cache"] = {4096u, 7u};
+
+    auto data = BinaryCacheIndex::serialize(entries);
+
+    std::unordered_map<std::string, BinaryCacheIndex::Entry> restored;
+    ASSERT_TRUE(BinaryCacheIndex::deserialize(data.data(), data.size(), restored));
+    ASSERT_EQ(2u, restored.size());
+    EXPECT_EQ(16u, restored["a.cl_cache"].size);
+    EXPECT_EQ(3u, restored["a.cl_cache"].lastAccess);
+    EXPECT_EQ(4096u, restored["bb.cl_src_cache"].size);
+    EXPECT_EQ(7u, restored["bb.cl_src_cache"].lastAccess);
+}
+
+TEST(BinaryCacheIndexSerialization, givenTruncatedOrCorruptedDataWhenDeserializedThenFails) {
+    std::unordered_map<std::string, BinaryCacheIndex::Entry> entries;
+    entries["a.cl_cache"] = {16u, 3u};
+    auto data = BinaryCacheIndex::serialize(entries);
+
+    std::unordered_map<std::string, BinaryCacheIndex::Entry> restored;
+    EXPECT_FALSE(BinaryCacheIndex::deserialize(data.data(), data.size() - 1, restored));
+    EXPECT_FALSE(BinaryCacheIndex::deserialize(data.data(), 2, restored));
+
+    data[0] ^= 0xFF;
+    EXPECT_FALSE(BinaryCacheIndex::deserialize(data.data(), data.size(), restored));
+}
+
+TEST_F(BinaryCacheIndexTest, givenPublishedFileThenWholeContentIsVisible) {
+    createFile("publish_test.cl_cache", 100);
+
+    void *pData = nullptr;
+    auto size = loadDataFromFile(getPath("publish_test.cl_cache").c_str(), pData);
+    EXPECT_EQ(100u, size);
+    deleteDataReadFromFile(pData);
+}
+
+TEST_F(BinaryCacheIndexTest, givenSizeLimitExceededWhenInsertingThenLeastRecentlyUsedFilesAreEvicted) {
+    BinaryCacheIndex index(testCacheDirectory, 250);
+
+    createFile("first.cl_cache", 100);
+    EXPECT_TRUE(index.insert("first.cl_cache", 100).empty());
+    createFile("second.cl_cache", 100);
+    EXPECT_TRUE(index.insert("second.cl_cache", 100).empty());
+    EXPECT_EQ(200u, index.getTotalSize());
+
+    createFile("third.cl_cache", 100);
+    auto evicted = index.insert("third.cl_cache", 100);
+    ASSERT_EQ(1u, evicted.size());
+    EXPECT_EQ("first.cl_cache", evicted[0]);
+    EXPECT_FALSE(fileExists(getPath("first.cl_cache")));
+    EXPECT_TRUE(fileExists(getPath("second.cl_cache")));
+    EXPECT_TRUE(fileExists(getPath("third.cl_cache")));
+    EXPECT_EQ(200u, index.getTotalSize());
+}
+
+TEST_F(BinaryCacheIndexTest, givenTouchedEntryWhenEvictingThenItIsKept) {
+    BinaryCacheIndex index(testCacheDirectory, 250);
+
+    createFile("first.cl_cache", 100);
+    index.insert("first.cl_cache", 100);
+    createFile("second.cl_cache", 100);
+    index.insert("second.cl_cache", 100);
+
+    index.touch("first.cl_cache");
+
+    createFile("third.cl_cache", 100);
+    auto evicted = index.insert("third.cl_cache", 100);
+    ASSERT_EQ(1u, evicted.size());
+    EXPECT_EQ("second.cl_cache", evicted[0]);
+    EXPECT_TRUE(index.contains("first.cl_cache"));
+    EXPECT_FALSE(index.contains("second.cl_cache"));
+}
+
+TEST_F(BinaryCacheIndexTest, givenZeroSizeLimitWhenInsertingThenNothingIsEvicted) {
+    BinaryCacheIndex index(testCacheDirectory, 0);
+
+    for (auto name : {"first.cl_cache", "second.cl_cache", "third.cl_cache"}) {
+        createFile(name, 100);
+        EXPECT_TRUE(index.insert(name, 100).empty());
+    }
+    EXPECT_EQ(3u, index.getEntriesCount());
+}
+
+TEST_F(BinaryCacheIndexTest, givenIndexPersistedByOtherInstanceWhenInsertingThenEntriesAreMerged) {
+    BinaryCacheIndex otherProcessIndex(testCacheDirectory, 0);
+    createFile("other.cl_cache", 100);
+    otherProcessIndex.insert("other.cl_cache", 100);
+    otherProcessIndex.flush();
+
+    BinaryCacheIndex index(testCacheDirectory, 0);
+    EXPECT_TRUE(index.contains("other.cl_cache"));
+
+    createFile("own.cl_cache", 50);
+    index.insert("own.cl_cache", 50);
+    EXPECT_EQ(150u, index.getTotalSize());
+}
+
+TEST_F(BinaryCacheIndexTest, givenSaveBatchSizeWhenInsertingThenIndexIsSavedOncePerBatch) {
+    BinaryCacheIndex index(testCacheDirectory, 0, 3);
+
+    createFile("first.cl_cache", 100);
+    index.insert("first.cl_cache", 100);
+    createFile("second.cl_cache", 100);
+    index.insert("second.cl_cache", 100);
+    EXPECT_FALSE(fileExists(getPath(BinaryCacheIndex::indexFileName)));
+
+    createFile("third.cl_cache", 100);
+    index.insert("third.cl_cache", 100);
+    EXPECT_TRUE(fileExists(getPath(BinaryCacheIndex::indexFileName)));
+}
+
+TEST_F(BinaryCacheIndexTest, givenPendingInsertsWhenIndexIsDestroyedThenTheyAreSaved) {
+    {
+        BinaryCacheIndex index(testCacheDirectory, 0);
+        createFile("pending.cl_cache", 100);
+        index.insert("pending.cl_cache", 100);
+        EXPECT_FALSE(fileExists(getPath(BinaryCacheIndex::indexFileName)));
+    }
+
+    BinaryCacheIndex index(testCacheDirectory, 0);
+    EXPECT_TRUE(index.contains("pending.cl_cache"));
+}
+
+TEST_F(BinaryCacheIndexTest, givenInstancesSavingInterleavedWhenReloadingThenNoEntryIsLost) {
+    BinaryCacheIndex firstProcessIndex(testCacheDirectory, 0);
+    BinaryCacheIndex secondProcessIndex(testCacheDirectory, 0);
+
+    createFile("first.cl_cache", 100);
+    firstProcessIndex.insert("first.cl_cache", 100);
+    createFile("second.cl_cache", 100);
+    secondProcessIndex.insert("second.cl_cache", 100);
+
+    firstProcessIndex.flush();
+    secondProcessIndex.flush();
+
+    BinaryCacheIndex index(testCacheDirectory, 0);
+    EXPECT_TRUE(index.contains("first.cl_cache"));
+    EXPECT_TRUE(index.contains("second.cl_cache"));
+    EXPECT_EQ(200u, index.getTotalSize());
+}
+
+TEST_F(BinaryCacheIndexTest, givenFilesPublishedByOtherInstanceWhenBudgetIsExceededThenTheyAreEvictedToo) {
+    BinaryCacheIndex otherProcessIndex(testCacheDirectory, 250);
+    createFile("other.cl_cache", 100);
+    otherProcessIndex.insert("other.cl_cache", 100);
+    otherProcessIndex.flush();
+
+    BinaryCacheIndex index(testCacheDirectory, 250);
+    createFile("first.cl_cache", 100);
+    EXPECT_TRUE(index.insert("first.cl_cache", 100).empty());
+    createFile("second.cl_cache", 100);
+    auto evicted = index.insert("second.cl_cache", 100);
+
+    ASSERT_EQ(1u, evicted.size());
+    EXPECT_EQ("other.cl_cache", evicted[0]);
+    EXPECT_FALSE(fileExists(getPath("other.cl_cache")));
+    EXPECT_EQ(200u, index.getTotalSize());
+}
+
+TEST_F(BinaryCacheIndexTest, givenCacheFilesMissingFromIndexWhenIndexIsCreatedThenTheyAreImportedAndEvictedFirst) {
+    createFile("0123456789abcdef.cl_cache", 100);
+    createFile("unrelated.bin", 100);
+
+    BinaryCacheIndex index(testCacheDirectory, 250);
+    EXPECT_TRUE(index.contains("0123456789abcdef.cl_cache"));
+    EXPECT_FALSE(index.contains("unrelated.bin"));
+    EXPECT_EQ(100u, index.getTotalSize());
+
+    createFile("first.cl_cache", 100);
+    EXPECT_TRUE(index.insert("first.cl_cache", 100).empty());
+    createFile("second.cl_cache", 100);
+    auto evicted = index.insert("second.cl_cache", 100);
+
+    ASSERT_EQ(1u, evicted.size());
+    EXPECT_EQ("0123456789abcdef.cl_cache", evicted[0]);
+    EXPECT_FALSE(fileExists(getPath("0123456789abcdef.cl_cache")));
+}
+
+TEST_F(BinaryCacheIndexTest, givenUnindexedFilesOverBudgetWhenIndexIsCreatedThenTheyArePruned) {
+    createFile("first.cl_cache", 100);
+    createFile("second.cl_src_cache", 100);
+
+    BinaryCacheIndex index(testCacheDirectory, 150);
+    EXPECT_EQ(1u, index.getEntriesCount());
+    EXPECT_EQ(100u, index.getTotalSize());
+    EXPECT_TRUE(fileExists(getPath(BinaryCacheIndex::indexFileName)));
+}
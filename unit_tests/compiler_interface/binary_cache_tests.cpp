@@ -27,6 +27,7 @@
 #include <runtime/helpers/string.h>
 #include <runtime/helpers/aligned_memory.h>
 #include <unit_tests/global_environment.h>
+#include <unit_tests/helpers/debug_manager_state_restore.h>
 #include <unit_tests/fixtures/device_fixture.h>
 #include <unit_tests/fixtures/memory_management_fixture.h>
 #include <unit_tests/mocks/mock_context.h>
@@ -97,9 +98,22 @@ class BinaryCacheMock : public BinaryCache {
         return loadResult;
     }
 
+    bool cacheSourceBinary(const std::string sourceFileHash, const Program &program) override {
+        cacheSourceInvoked++;
+        return cacheResult;
+    }
+
+    bool loadCachedSourceBinary(const std::string sourceFileHash, Program &program) override {
+        loadSourceInvoked++;
+        return loadSourceResult;
+    }
+
     bool cacheResult = false;
     uint32_t cacheInvoked = 0u;
     bool loadResult = false;
+    uint32_t cacheSourceInvoked = 0u;
+    uint32_t loadSourceInvoked = 0u;
+    bool loadSourceResult = false;
 };
 
 class CompilerInterfaceCachedFixture : public MemoryManagementFixture,
@@ -301,6 +315,7 @@ TEST_F(BinaryCacheHashTests, testUnique) {
                                 for (auto &in : hashes) {
                                     EXPECT_STRNE(in.c_str(), hash.c_str()) << "failed: " << i1 << ":" << i2 << ":" << i3 << ":" << i4;
                                 }
+                                EXPECT_EQ(32u, hash.size());
                                 hashes.push_back(hash);
 
                                 string hash2 = cache->getCachedFileName(hwInfo, ArrayRef<const char>(args.pInput, args.InputSize),
@@ -331,6 +346,23 @@ TEST_F(BinaryCacheTests, loadNotFound) {
     EXPECT_FALSE(ret);
 }
 
+class BinaryCacheWithIndexPeek : public BinaryCache {
+  public:
+    using BinaryCache::index;
+};
+
+TEST(BinaryCacheIndexCreation, givenBinaryCacheWhenNothingIsStoredOrLoadedThenIndexIsNotCreated) {
+    BinaryCacheWithIndexPeek cache;
+    EXPECT_EQ(nullptr, cache.index.get());
+
+    MockProgram program;
+    EXPECT_FALSE(cache.loadCachedBinary("----do-not-exists----", program));
+    EXPECT_EQ(nullptr, cache.index.get());
+
+    EXPECT_NE(nullptr, cache.getIndex());
+    EXPECT_EQ(cache.index.get(), cache.getIndex());
+}
+
 TEST_F(BinaryCacheTests, cacheThenLoad) {
     MockProgram program;
     static const char *hash = "SOME_HASH";
@@ -345,6 +377,130 @@ TEST_F(BinaryCacheTests, cacheThenLoad) {
     EXPECT_TRUE(ret);
 }
 
+TEST_F(BinaryCacheTests, loadSourceNotFound) {
+    MockProgram program;
+    bool ret = cache->loadCachedSourceBinary("----do-not-exists----", program);
+    EXPECT_FALSE(ret);
+}
+
+TEST_F(BinaryCacheTests, doNotCacheSourceWithoutLlvmBinary) {
+    MockProgram program;
+    char genBinary[16] = {};
+    program.storeGenBinary(genBinary, sizeof(genBinary));
+
+    bool ret = cache->cacheSourceBinary("SOME_SOURCE_HASH", program);
+    EXPECT_FALSE(ret);
+}
+
+TEST_F(BinaryCacheTests, cacheSourceThenLoadRestoresGenAndLlvmBinaries) {
+    static const char *hash = "SOME_SOURCE_HASH";
+    char genBinary[32];
+    char llvmBinary[16];
+    for (size_t i = 0; i < sizeof(genBinary); i++)
+        genBinary[i] = static_cast<char>(i);
+    for (size_t i = 0; i < sizeof(llvmBinary); i++)
+        llvmBinary[i] = static_cast<char>(0xF0 + i);
+
+    MockProgram srcProgram;
+    srcProgram.storeGenBinary(genBinary, sizeof(genBinary));
+    srcProgram.storeLlvmBinary(llvmBinary, sizeof(llvmBinary));
+
+    bool ret = cache->cacheSourceBinary(hash, srcProgram);
+    EXPECT_TRUE(ret);
+
+    MockProgram dstProgram;
+    ret = cache->loadCachedSourceBinary(hash, dstProgram);
+    EXPECT_TRUE(ret);
+
+    size_t size = 0;
+    auto pGen = dstProgram.getGenBinary(size);
+    ASSERT_EQ(sizeof(genBinary), size);
+    EXPECT_EQ(0, memcmp(genBinary, pGen, size));
+
+    auto pLlvm = dstProgram.getLlvmBinary(size);
+    ASSERT_EQ(sizeof(llvmBinary), size);
+    EXPECT_EQ(0, memcmp(llvmBinary, pLlvm, size));
+}
+
+TEST_F(BinaryCacheTests, givenIrCacheEntryWhenLoadedAsSourceEntryThenFails) {
+    MockProgram program;
+    static const char *hash = "SOME_SOURCE_HASH_IR_ONLY";
+    char data[32] = {};
+
+    bool ret = cache->cacheBinary(hash, data, sizeof(data));
+    EXPECT_TRUE(ret);
+
+    ret = cache->loadCachedSourceBinary(hash, program);
+    EXPECT_FALSE(ret);
+}
+
+TEST_F(BinaryCacheTests, givenMappedBinaryCacheEnabledWhenLoadingThenGenBinaryReferencesMappedFile) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableMappedBinaryCache.set(true);
+
+    static const char *hash = "SOME_MAPPED_HASH";
+    char data[32];
+    for (size_t i = 0; i < sizeof(data); i++)
+        data[i] = static_cast<char>(i);
+
+    bool ret = cache->cacheBinary(hash, data, sizeof(data));
+    EXPECT_TRUE(ret);
+
+    MockProgram program;
+    ret = cache->loadCachedBinary(hash, program);
+    EXPECT_TRUE(ret);
+    EXPECT_TRUE(program.isGenBinaryMapped());
+
+    size_t size = 0;
+    auto pGen = program.getGenBinary(size);
+    ASSERT_EQ(sizeof(data), size);
+    EXPECT_EQ(0, memcmp(data, pGen, size));
+
+    program.storeGenBinary(data, sizeof(data));
+    EXPECT_FALSE(program.isGenBinaryMapped());
+}
+
+TEST_F(BinaryCacheTests, givenMappedBinaryCacheEnabledWhenLoadingSourceEntryThenGenBinaryReferencesMappedFile) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableMappedBinaryCache.set(true);
+
+    static const char *hash = "SOME_MAPPED_SOURCE_HASH";
+    char genBinary[32];
+    char llvmBinary[16];
+    for (size_t i = 0; i < sizeof(genBinary); i++)
+        genBinary[i] = static_cast<char>(i);
+    for (size_t i = 0; i < sizeof(llvmBinary); i++)
+        llvmBinary[i] = static_cast<char>(0xF0 + i);
+
+    MockProgram srcProgram;
+    srcProgram.storeGenBinary(genBinary, sizeof(genBinary));
+    srcProgram.storeLlvmBinary(llvmBinary, sizeof(llvmBinary));
+    EXPECT_TRUE(cache->cacheSourceBinary(hash, srcProgram));
+
+    MockProgram dstProgram;
+    EXPECT_TRUE(cache->loadCachedSourceBinary(hash, dstProgram));
+    EXPECT_TRUE(dstProgram.isGenBinaryMapped());
+
+    size_t size = 0;
+    auto pGen = dstProgram.getGenBinary(size);
+    ASSERT_EQ(sizeof(genBinary), size);
+    EXPECT_EQ(0, memcmp(genBinary, pGen, size));
+
+    auto pLlvm = dstProgram.getLlvmBinary(size);
+    ASSERT_EQ(sizeof(llvmBinary), size);
+    EXPECT_EQ(0, memcmp(llvmBinary, pLlvm, size));
+}
+
+TEST_F(BinaryCacheTests, givenMappedBinaryCacheEnabledWhenEntryNotFoundThenLoadFails) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableMappedBinaryCache.set(true);
+
+    MockProgram program;
+    EXPECT_FALSE(cache->loadCachedBinary("----do-not-exists----", program));
+    EXPECT_FALSE(cache->loadCachedSourceBinary("----do-not-exists----", program));
+    EXPECT_FALSE(program.isGenBinaryMapped());
+}
+
 TEST_F(CompilerInterfaceCachedTests, canInjectCache) {
     std::unique_ptr<BinaryCache> cache(new BinaryCache());
     auto res1 = pCompilerInterface->replaceBinaryCache(cache.get());
@@ -444,3 +600,194 @@ TEST_F(CompilerInterfaceCachedTests, builtThenCached) {
     gEnvironment->fclPopDebugVars();
     gEnvironment->igcPopDebugVars();
 }
+
+TEST_F(CompilerInterfaceCachedTests, givenSourceCacheHitWhenBuildingThenFrontendIsSkipped) {
+    MockContext context(pDevice, true);
+    MockProgram program(&context);
+    BinaryCacheMock cache;
+    TranslationArgs inputArgs;
+
+    inputArgs.pInput = new char[128];
+    strcpy_s(inputArgs.pInput, 128, "__kernel k() {}");
+    inputArgs.InputSize = static_cast<uint32_t>(strlen(inputArgs.pInput));
+
+    MockCompilerDebugVars fclDebugVars;
+    fclDebugVars.fileName = gEnvironment->fclGetMockFile();
+    fclDebugVars.forceBuildFailure = true;
+    gEnvironment->fclPushDebugVars(fclDebugVars);
+
+    MockCompilerDebugVars igcDebugVars;
+    igcDebugVars.fileName = gEnvironment->igcGetMockFile();
+    igcDebugVars.forceBuildFailure = true;
+    gEnvironment->igcPushDebugVars(igcDebugVars);
+
+    auto res1 = pCompilerInterface->replaceBinaryCache(&cache);
+    cache.loadSourceResult = true;
+    auto retVal = pCompilerInterface->build(program, inputArgs, true);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(1u, cache.loadSourceInvoked);
+    EXPECT_EQ(0u, cache.cacheInvoked);
+    EXPECT_EQ(0u, cache.cacheSourceInvoked);
+
+    pCompilerInterface->replaceBinaryCache(res1);
+    delete[] inputArgs.pInput;
+
+    gEnvironment->fclPopDebugVars();
+    gEnvironment->igcPopDebugVars();
+}
+
+TEST_F(CompilerInterfaceCachedTests, givenSourceCacheMissWhenBuildingThenBothCacheTiersArePopulated) {
+    MockContext context(pDevice, true);
+    MockProgram program(&context);
+    BinaryCacheMock cache;
+    TranslationArgs inputArgs;
+
+    inputArgs.pInput = new char[128];
+    strcpy_s(inputArgs.pInput, 128, "__kernel k() {}");
+    inputArgs.InputSize = static_cast<uint32_t>(strlen(inputArgs.pInput));
+
+    MockCompilerDebugVars fclDebugVars;
+    fclDebugVars.fileName = gEnvironment->fclGetMockFile();
+    gEnvironment->fclPushDebugVars(fclDebugVars);
+
+    MockCompilerDebugVars igcDebugVars;
+    igcDebugVars.fileName = gEnvironment->igcGetMockFile();
+    gEnvironment->igcPushDebugVars(igcDebugVars);
+
+    auto res1 = pCompilerInterface->replaceBinaryCache(&cache);
+    auto retVal = pCompilerInterface->build(program, inputArgs, true);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(1u, cache.loadSourceInvoked);
+    EXPECT_EQ(1u, cache.cacheInvoked);
+    EXPECT_EQ(1u, cache.cacheSourceInvoked);
+
+    pCompilerInterface->replaceBinaryCache(res1);
+    delete[] inputArgs.pInput;
+
+    gEnvironment->fclPopDebugVars();
+    gEnvironment->igcPopDebugVars();
+}
+
+TEST_F(CompilerInterfaceCachedTests, givenCachingDisabledWhenBuildingThenSourceCacheIsNotConsulted) {
+    MockContext context(pDevice, true);
+    MockProgram program(&context);
+    BinaryCacheMock cache;
+    TranslationArgs inputArgs;
+
+    inputArgs.pInput = new char[128];
+    strcpy_s(inputArgs.pInput, 128, "__kernel k() {}");
+    inputArgs.InputSize = static_cast<uint32_t>(strlen(inputArgs.pInput));
+
+    MockCompilerDebugVars fclDebugVars;
+    fclDebugVars.fileName = gEnvironment->fclGetMockFile();
+    gEnvironment->fclPushDebugVars(fclDebugVars);
+
+    MockCompilerDebugVars igcDebugVars;
+    igcDebugVars.fileName = gEnvironment->igcGetMockFile();
+    gEnvironment->igcPushDebugVars(igcDebugVars);
+
+    auto res1 = pCompilerInterface->replaceBinaryCache(&cache);
+    auto retVal = pCompilerInterface->build(program, inputArgs, false);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(0u, cache.loadSourceInvoked);
+    EXPECT_EQ(0u, cache.cacheSourceInvoked);
+
+    pCompilerInterface->replaceBinaryCache(res1);
+    delete[] inputArgs.pInput;
+
+    gEnvironment->fclPopDebugVars();
+    gEnvironment->igcPopDebugVars();
+}
+
+TEST(BinaryCacheSourceTier, givenSourceWithoutIncludesWhenCheckingIfSourceIsCacheableThenTrueIsReturned) {
+    const char source[] = "#define X 1\n__kernel void k() {}";
+    const char options[] = "-cl-std=CL2.0 -DINCLUDED=1";
+    EXPECT_TRUE(BinaryCache::isSourceCacheable(ArrayRef<const char>(source, strlen(source)), ArrayRef<const char>(options, strlen(options))));
+    EXPECT_TRUE(BinaryCache::isSourceCacheable(ArrayRef<const char>(source, strlen(source)), ArrayRef<const char>()));
+}
+
+TEST(BinaryCacheSourceTier, givenSourceWithIncludeDirectiveWhenCheckingIfSourceIsCacheableThenFalseIsReturned) {
+    const char *sources[] = {"#include \"header.h\"\n__kernel void k() {}",
+                             "__kernel void k() {}\n#  include <header.h>",
+                             "#\tinclude \"header.h\""};
+    for (auto source : sources) {
+        EXPECT_FALSE(BinaryCache::isSourceCacheable(ArrayRef<const char>(source, strlen(source)), ArrayRef<const char>())) << source;
+    }
+}
+
+TEST(BinaryCacheSourceTier, givenIncludePathOptionWhenCheckingIfSourceIsCacheableThenFalseIsReturned) {
+    const char source[] = "__kernel void k() {}";
+    const char *optionsList[] = {"-I/some/dir", "-cl-std=CL2.0 -I some/dir"};
+    for (auto options : optionsList) {
+        EXPECT_FALSE(BinaryCache::isSourceCacheable(ArrayRef<const char>(source, strlen(source)), ArrayRef<const char>(options, strlen(options)))) << options;
+    }
+}
+
+TEST_F(CompilerInterfaceCachedTests, givenSourceIncludingHeaderWhenBuildingThenSourceCacheIsBypassedSoChangedHeaderIsRecompiled) {
+    MockContext context(pDevice, true);
+    MockProgram program(&context);
+    BinaryCacheMock cache;
+    TranslationArgs inputArgs;
+
+    inputArgs.pInput = new char[128];
+    strcpy_s(inputArgs.pInput, 128, "#include \"kernel_header.h\"\n__kernel k() {}");
+    inputArgs.InputSize = static_cast<uint32_t>(strlen(inputArgs.pInput));
+
+    MockCompilerDebugVars fclDebugVars;
+    fclDebugVars.fileName = gEnvironment->fclGetMockFile();
+    gEnvironment->fclPushDebugVars(fclDebugVars);
+
+    MockCompilerDebugVars igcDebugVars;
+    igcDebugVars.fileName = gEnvironment->igcGetMockFile();
+    gEnvironment->igcPushDebugVars(igcDebugVars);
+
+    auto res1 = pCompilerInterface->replaceBinaryCache(&cache);
+    // an entry stored before the header changed must not be served
+    cache.loadSourceResult = true;
+    auto retVal = pCompilerInterface->build(program, inputArgs, true);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(0u, cache.loadSourceInvoked);
+    EXPECT_EQ(0u, cache.cacheSourceInvoked);
+    EXPECT_EQ(1u, cache.cacheInvoked);
+
+    pCompilerInterface->replaceBinaryCache(res1);
+    delete[] inputArgs.pInput;
+
+    gEnvironment->fclPopDebugVars();
+    gEnvironment->igcPopDebugVars();
+}
+
+TEST_F(CompilerInterfaceCachedTests, givenIncludePathInOptionsWhenBuildingThenSourceCacheIsBypassed) {
+    MockContext context(pDevice, true);
+    MockProgram program(&context);
+    BinaryCacheMock cache;
+    TranslationArgs inputArgs;
+    const char options[] = "-I /some/include/dir";
+
+    inputArgs.pInput = new char[128];
+    strcpy_s(inputArgs.pInput, 128, "__kernel k() {}");
+    inputArgs.InputSize = static_cast<uint32_t>(strlen(inputArgs.pInput));
+    inputArgs.pOptions = options;
+    inputArgs.OptionsSize = static_cast<uint32_t>(strlen(options));
+
+    MockCompilerDebugVars fclDebugVars;
+    fclDebugVars.fileName = gEnvironment->fclGetMockFile();
+    gEnvironment->fclPushDebugVars(fclDebugVars);
+
+    MockCompilerDebugVars igcDebugVars;
+    igcDebugVars.fileName = gEnvironment->igcGetMockFile();
+    gEnvironment->igcPushDebugVars(igcDebugVars);
+
+    auto res1 = pCompilerInterface->replaceBinaryCache(&cache);
+    cache.loadSourceResult = true;
+    auto retVal = pCompilerInterface->build(program, inputArgs, true);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(0u, cache.loadSourceInvoked);
+    EXPECT_EQ(0u, cache.cacheSourceInvoked);
+
+    pCompilerInterface->replaceBinaryCache(res1);
+    delete[] inputArgs.pInput;
+
+    gEnvironment->fclPopDebugVars();
+    gEnvironment->igcPopDebugVars();
+}
@@ -53,3 +53,18 @@ TEST(FileIO, existsSizeZero) {
     EXPECT_TRUE(fileExists(fileName.c_str()));
     EXPECT_FALSE(fileExistsHasSize(fileName.c_str()));
 }
+
+TEST(FileIO, getFileSize) {
+    std::string fileName("fileIO.bin");
+    std::remove(fileName.c_str());
+    EXPECT_EQ(0u, getFileSize(fileName));
+
+    FILE *fp = nullptr;
+    fopen_s(&fp, fileName.c_str(), "wb");
+    ASSERT_NE(nullptr, fp);
+    fprintf(fp, "TEST");
+    fclose(fp);
+
+    EXPECT_EQ(4u, getFileSize(fileName));
+    std::remove(fileName.c_str());
+}
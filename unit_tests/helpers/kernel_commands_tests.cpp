@@ -103,6 +103,73 @@ HWTEST_F(KernelCommandsTest, copyKernelBinaryResourceUsage) {
     EXPECT_EQ(kernel->getKernelHeapSize(), usedIndirectHeapAfter - usedIndirectHeapBefore);
 }
 
+HWTEST_F(KernelCommandsTest, givenKernelBinaryAlreadyInHeapWhenObtainedAgainThenItIsNotCopied) {
+    CommandQueueHw<FamilyType> cmdQ(pContext, pDevice, 0);
+
+    std::unique_ptr<Image> srcImage(Image2dHelper<>::create(pContext));
+    ASSERT_NE(nullptr, srcImage.get());
+    std::unique_ptr<Image> dstImage(Image2dHelper<>::create(pContext));
+    ASSERT_NE(nullptr, dstImage.get());
+
+    MultiDispatchInfo multiDispatchInfo;
+    auto &builder = BuiltIns::getInstance().getBuiltinDispatchInfoBuilder(EBuiltInOps::CopyImageToImage3d,
+                                                                          cmdQ.getContext(), cmdQ.getDevice());
+    ASSERT_NE(nullptr, &builder);
+
+    BuiltinDispatchInfoBuilder::BuiltinOpParams dc;
+    dc.srcMemObj = srcImage.get();
+    dc.dstMemObj = dstImage.get();
+    dc.srcOffset = {0, 0, 0};
+    dc.dstOffset = {0, 0, 0};
+    dc.size = {1, 1, 1};
+    builder.buildDispatchInfos(multiDispatchInfo, dc);
+    EXPECT_NE(0u, multiDispatchInfo.size());
+
+    auto kernel = multiDispatchInfo.begin()->getKernel();
+    ASSERT_NE(nullptr, kernel);
+
+    auto &indirectHeap = cmdQ.getIndirectHeap(IndirectHeap::INSTRUCTION, 2 * kernel->getKernelHeapSize());
+    auto usedIndirectHeapBefore = indirectHeap.getUsed();
+
+    auto kernelStartOffset = KernelCommandsHelper<FamilyType>::obtainKernelBinary(indirectHeap, kernel->getKernelInfo());
+    auto usedIndirectHeapAfterFirstCopy = indirectHeap.getUsed();
+    EXPECT_LT(usedIndirectHeapBefore, usedIndirectHeapAfterFirstCopy);
+    EXPECT_EQ(0, memcmp(ptrOffset(indirectHeap.getBase(), kernelStartOffset), kernel->getKernelHeap(), kernel->getKernelHeapSize()));
+
+    EXPECT_EQ(kernelStartOffset, KernelCommandsHelper<FamilyType>::obtainKernelBinary(indirectHeap, kernel->getKernelInfo()));
+    EXPECT_EQ(usedIndirectHeapAfterFirstCopy, indirectHeap.getUsed());
+
+    cmdQ.releaseIndirectHeap(IndirectHeap::INSTRUCTION);
+    auto &newIndirectHeap = cmdQ.getIndirectHeap(IndirectHeap::INSTRUCTION, 2 * kernel->getKernelHeapSize());
+    auto usedNewIndirectHeapBefore = newIndirectHeap.getUsed();
+    KernelCommandsHelper<FamilyType>::obtainKernelBinary(newIndirectHeap, kernel->getKernelInfo());
+    EXPECT_LT(usedNewIndirectHeapBefore, newIndirectHeap.getUsed());
+}
+
+HWTEST_F(KernelCommandsTest, givenKernelBinaryAlreadyInHeapWhenKernelHeapIsSubstitutedThenNewBinaryIsCopied) {
+    CommandQueueHw<FamilyType> cmdQ(pContext, pDevice, 0);
+    MockKernelWithInternals mockKernelWithInternals(*pDevice, pContext);
+    auto kernel = mockKernelWithInternals.mockKernel;
+    memset(mockKernelWithInternals.kernelIsa, 0x11, sizeof(mockKernelWithInternals.kernelIsa));
+    mockKernelWithInternals.kernelHeader.KernelHeapSize = sizeof(mockKernelWithInternals.kernelIsa);
+
+    uint32_t newKernelIsa[32];
+    memset(newKernelIsa, 0x22, sizeof(newKernelIsa));
+
+    auto &indirectHeap = cmdQ.getIndirectHeap(IndirectHeap::INSTRUCTION, sizeof(mockKernelWithInternals.kernelIsa) + sizeof(newKernelIsa));
+    auto kernelStartOffset = KernelCommandsHelper<FamilyType>::obtainKernelBinary(indirectHeap, kernel->getKernelInfo());
+    auto usedIndirectHeapAfterFirstCopy = indirectHeap.getUsed();
+
+    auto kernelIsaKey = kernel->getKernelInfo().kernelIsaKey;
+    kernel->substituteKernelHeap(newKernelIsa, sizeof(newKernelIsa));
+    EXPECT_NE(kernelIsaKey, kernel->getKernelInfo().kernelIsaKey);
+
+    auto newKernelStartOffset = KernelCommandsHelper<FamilyType>::obtainKernelBinary(indirectHeap, kernel->getKernelInfo());
+    EXPECT_NE(kernelStartOffset, newKernelStartOffset);
+    EXPECT_LT(usedIndirectHeapAfterFirstCopy, indirectHeap.getUsed());
+    EXPECT_EQ(0, memcmp(ptrOffset(indirectHeap.getBase(), newKernelStartOffset), newKernelIsa, sizeof(newKernelIsa)));
+}
+
 HWTEST_F(KernelCommandsTest, programInterfaceDescriptorDataResourceUsage) {
     CommandQueueHw<FamilyType> cmdQ(pContext, pDevice, 0);
 
@@ -24,7 +24,10 @@
 #include "runtime/helpers/string_helpers.h"
 #include "gtest/gtest.h"
 
+#include <algorithm>
+
 using OCLRT::Hash;
+using OCLRT::Hash128;
 
 TEST(CreateCombinedStrings, singleString) {
     std::string dstString;
@@ -250,3 +253,69 @@ TEST(CreateHash, unalignedLengths) {
         EXPECT_EQ(hash1, Hash::hash(pBuffer, length));
     }
 }
+
+TEST(CreateHash128, HashBuffers) {
+    char pBuffer[128];
+    memset(pBuffer, 0x23, sizeof(pBuffer));
+
+    auto hash1 = Hash128::hash(pBuffer, sizeof(pBuffer));
+    auto hash2 = Hash128::hash(pBuffer, sizeof(pBuffer));
+    EXPECT_EQ(hash1, hash2);
+    EXPECT_NE(hash1.hi, hash1.lo);
+
+    auto hash3 = Hash128::hash(pBuffer, sizeof(pBuffer) - 1);
+    EXPECT_NE(hash2, hash3);
+    EXPECT_NE(hash2.hi, hash3.hi);
+    EXPECT_NE(hash2.lo, hash3.lo);
+}
+
+TEST(CreateHash128, givenDataSplitIntoChunksWhenUpdatingThenResultMatchesSingleUpdate) {
+    char pBuffer[200];
+    for (size_t i = 0; i < sizeof(pBuffer); i++) {
+        pBuffer[i] = static_cast<char>(i * 7 + 3);
+    }
+
+    auto expected = Hash128::hash(pBuffer, sizeof(pBuffer));
+    for (size_t chunk = 1; chunk < 70; chunk++) {
+        Hash128 hash;
+        for (size_t offset = 0; offset < sizeof(pBuffer); offset += chunk) {
+            hash.update(pBuffer + offset, std::min(chunk, sizeof(pBuffer) - offset));
+        }
+        EXPECT_EQ(expected, hash.finish()) << chunk;
+    }
+}
+
+TEST(CreateHash128, givenUnalignedDataWhenHashingThenResultDoesNotDependOnAlignment) {
+    char pBuffer[128 + 8];
+    for (size_t i = 0; i < sizeof(pBuffer); i++) {
+        pBuffer[i] = static_cast<char>(i);
+    }
+    char pShifted[128 + 8];
+
+    for (size_t misalignment = 1; misalignment < 8; misalignment++) {
+        memcpy(pShifted + misalignment, pBuffer, 128);
+        EXPECT_EQ(Hash128::hash(pBuffer, 128), Hash128::hash(pShifted + misalignment, 128));
+    }
+}
+
+TEST(CreateHash128, unalignedLengths) {
+    char pBuffer[80];
+    memset(pBuffer, 0x55, sizeof(pBuffer));
+
+    for (auto length = 1u; length < sizeof(pBuffer); length++) {
+        auto hash1 = Hash128::hash(pBuffer, length);
+        pBuffer[length]++;
+        EXPECT_EQ(hash1, Hash128::hash(pBuffer, length));
+        EXPECT_NE(hash1, Hash128::hash(pBuffer, length + 1));
+    }
+}
+
+TEST(CreateHash128, givenResetWhenHashingAgainThenSameResultIsReturned) {
+    const char data[] = "__kernel void test() {}";
+    Hash128 hash;
+    hash.update(data, sizeof(data));
+    auto hash1 = hash.finish();
+    hash.reset();
+    hash.update(data, sizeof(data));
+    EXPECT_EQ(hash1, hash.finish());
+}
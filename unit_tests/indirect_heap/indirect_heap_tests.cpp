@@ -102,3 +102,21 @@ TEST_F(IndirectHeapTest, getBase) {
     auto base = indirectHeap.getBase();
     EXPECT_EQ(base, buffer);
 }
+
+TEST_F(IndirectHeapTest, givenStoredKernelIsaOffsetWhenQueriedThenOffsetIsReturned) {
+    size_t offset = 0;
+    EXPECT_FALSE(indirectHeap.getKernelIsaOffset(1u, offset));
+
+    indirectHeap.storeKernelIsaOffset(1u, 64u);
+    EXPECT_TRUE(indirectHeap.getKernelIsaOffset(1u, offset));
+    EXPECT_EQ(64u, offset);
+    EXPECT_FALSE(indirectHeap.getKernelIsaOffset(2u, offset));
+}
+
+TEST_F(IndirectHeapTest, givenStoredKernelIsaOffsetWhenBufferIsReplacedThenOffsetIsForgotten) {
+    indirectHeap.storeKernelIsaOffset(1u, 64u);
+    indirectHeap.replaceBuffer(buffer, sizeof(buffer));
+
+    size_t offset = 0;
+    EXPECT_FALSE(indirectHeap.getKernelIsaOffset(1u, offset));
+}
@@ -21,10 +21,12 @@
  */
 
 #include "runtime/command_stream/command_stream_receiver_hw.h"
+#include "runtime/helpers/file_io.h"
 #include "runtime/helpers/options.h"
 #include "runtime/kernel/kernel.h"
 #include "runtime/memory_manager/os_agnostic_memory_manager.h"
 #include "runtime/os_interface/debug_settings_manager.h"
+#include "runtime/os_interface/os_mapped_file.h"
 #include "unit_tests/fixtures/device_fixture.h"
 #include "unit_tests/fixtures/execution_model_fixture.h"
 #include "unit_tests/fixtures/memory_management_fixture.h"
@@ -101,6 +103,43 @@ TEST_P(KernelTest, getKernelHeap) {
     EXPECT_EQ(pKernel->getKernelInfo().heapInfo.pKernelHeader->KernelHeapSize, pKernel->getKernelHeapSize());
 }
 
+TEST_P(KernelTest, givenProgramWithMappedGenBinaryWhenKernelHeapIsSubstitutedThenHeaderIsUpdatedAndFileIsNotModified) {
+    size_t genBinarySize = 0;
+    auto pGenBinary = pProgram->getGenBinary(genBinarySize);
+    ASSERT_NE(nullptr, pGenBinary);
+    std::vector<char> genBinary(pGenBinary, pGenBinary + genBinarySize);
+
+    const char *fileName = "kernel_tests_mapped_gen_binary.bin";
+    ASSERT_EQ(genBinarySize, writeDataToFile(fileName, genBinary.data(), genBinarySize));
+
+    {
+        std::unique_ptr<OsMappedFile> mappedFile(OsMappedFile::open(fileName));
+        ASSERT_NE(nullptr, mappedFile);
+
+        MockProgram program(pContext);
+        program.storeGenBinary(std::move(mappedFile), 0, genBinarySize);
+        ASSERT_TRUE(program.isGenBinaryMapped());
+        ASSERT_EQ(CL_SUCCESS, program.processGenBinary());
+
+        auto pKernelInfo = static_cast<Program &>(program).getKernelInfo(KernelName);
+        ASSERT_NE(nullptr, pKernelInfo);
+        std::unique_ptr<Kernel> kernel(Kernel::create(&program, *pKernelInfo, &retVal));
+        ASSERT_NE(nullptr, kernel);
+
+        std::vector<char> newKernelHeap(kernel->getKernelHeapSize() + 64, 0);
+        kernel->substituteKernelHeap(newKernelHeap.data(), newKernelHeap.size());
+        EXPECT_EQ(newKernelHeap.data(), kernel->getKernelHeap());
+        EXPECT_EQ(newKernelHeap.size(), kernel->getKernelHeapSize());
+    }
+
+    void *pFileData = nullptr;
+    auto fileSize = loadDataFromFile(fileName, pFileData);
+    ASSERT_EQ(genBinarySize, fileSize);
+    EXPECT_EQ(0, memcmp(genBinary.data(), pFileData, genBinarySize));
+    deleteDataReadFromFile(pFileData);
+    std::remove(fileName);
+}
+
 TEST_P(KernelTest, Create_Simple) {
     // included in the setup of fixture
 }
@@ -442,7 +481,7 @@ class CommandStreamReceiverMock : public CommandStreamReceiver {
     void addPipeControl(LinearStream &commandStream, bool dcFlush) override {
     }
 
-    void waitForTaskCountWithKmdNotifyFallback(uint32_t taskCountToWait, FlushStamp flushStampToWait) override {
+    void waitForTaskCountWithKmdNotifyFallback(uint32_t taskCountToWait, FlushStamp flushStampToWait, QueueThrottle throttle) override {
     }
 
     CompletionStamp flushTask(
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/ptr_math.h"
+#include "runtime/mem_obj/buffer.h"
+#include "runtime/mem_obj/buffer_pool_allocator.h"
+#include "runtime/mem_obj/image.h"
+#include "runtime/memory_manager/graphics_allocation.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/mocks/mock_context.h"
+#include "gtest/gtest.h"
+#include "test.h"
+
+#include <cstring>
+#include <memory>
+
+using namespace OCLRT;
+
+class BufferPoolTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        DebugManager.flags.SmallBufferPoolMaxSizeKB.set(4);
+        context.reset(new MockContext());
+        allocator = context->getBufferPoolAllocator();
+        ASSERT_NE(nullptr, allocator);
+    }
+
+    void TearDown() override {
+        context.reset();
+    }
+
+    Buffer *createBuffer(cl_mem_flags flags, size_t size, void *hostPtr = nullptr) {
+        auto buffer = Buffer::create(context.get(), flags, size, hostPtr, retVal);
+        EXPECT_EQ(CL_SUCCESS, retVal);
+        return buffer;
+    }
+
+    DebugManagerStateRestore restorer;
+    std::unique_ptr<MockContext> context;
+    BufferPoolAllocator *allocator = nullptr;
+    cl_int retVal = CL_SUCCESS;
+};
+
+TEST(BufferPoolDisabledTest, givenDefaultSettingsWhenContextIsCreatedThenBufferPoolIsNotUsed) {
+    MockContext context;
+    EXPECT_EQ(nullptr, context.getBufferPoolAllocator());
+}
+
+TEST_F(BufferPoolTest, givenSmallBuffersWhenCreatedThenTheyShareParentAllocationAtDistinctAlignedOffsets) {
+    std::unique_ptr<Buffer> buffer1(createBuffer(CL_MEM_READ_WRITE, 100));
+    std::unique_ptr<Buffer> buffer2(createBuffer(CL_MEM_READ_ONLY, 4 * KB));
+    ASSERT_NE(nullptr, buffer1);
+    ASSERT_NE(nullptr, buffer2);
+
+    EXPECT_TRUE(buffer1->isPooledBuffer());
+    EXPECT_TRUE(buffer2->isPooledBuffer());
+    EXPECT_FALSE(buffer1->isSubBuffer());
+    EXPECT_EQ(1u, allocator->peekNumPools());
+    EXPECT_EQ(buffer1->getGraphicsAllocation(), buffer2->getGraphicsAllocation());
+    EXPECT_NE(buffer1->getAllocationOffset(), buffer2->getAllocationOffset());
+
+    auto slotAlignment = context->getDevice(0)->getDeviceInfo().memBaseAddressAlign / 8;
+    for (auto &buffer : {buffer1.get(), buffer2.get()}) {
+        EXPECT_EQ(0u, buffer->getAllocationOffset() % slotAlignment);
+        EXPECT_EQ(ptrOffset(buffer->getGraphicsAllocation()->getUnderlyingBuffer(), buffer->getAllocationOffset()), buffer->getCpuAddress());
+        EXPECT_TRUE(buffer->isMemObjZeroCopy());
+    }
+    EXPECT_EQ(100u, buffer1->getSize());
+    EXPECT_EQ(4 * KB, buffer2->getSize());
+}
+
+TEST_F(BufferPoolTest, givenBufferWithHostPtrOrAboveMaxSizeWhenCreatedThenItIsNotPooled) {
+    auto hostPtr = alignedMalloc(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    std::unique_ptr<Buffer> useHostPtrBuffer(createBuffer(CL_MEM_USE_HOST_PTR, MemoryConstants::pageSize, hostPtr));
+    std::unique_ptr<Buffer> largeBuffer(createBuffer(CL_MEM_READ_WRITE, 4 * KB + 1));
+
+    EXPECT_FALSE(useHostPtrBuffer->isPooledBuffer());
+    EXPECT_FALSE(largeBuffer->isPooledBuffer());
+    EXPECT_EQ(0u, allocator->peekNumPools());
+
+    useHostPtrBuffer.reset();
+    alignedFree(hostPtr);
+}
+
+TEST_F(BufferPoolTest, givenCopyHostPtrFlagWhenPooledBufferIsCreatedThenDataIsCopiedToItsSlot) {
+    char hostData[64];
+    memset(hostData, 0x5a, sizeof(hostData));
+
+    std::unique_ptr<Buffer> buffer(createBuffer(CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, sizeof(hostData), hostData));
+    ASSERT_NE(nullptr, buffer);
+    EXPECT_TRUE(buffer->isPooledBuffer());
+    EXPECT_EQ(0, memcmp(hostData, buffer->getCpuAddress(), sizeof(hostData)));
+}
+
+TEST_F(BufferPoolTest, givenReleasedBufferWhenParentAllocationIsBusyThenSlotIsReusedOnlyAfterCompletion) {
+    auto tagAddress = context->getDevice(0)->getTagAddress();
+    auto buffer = createBuffer(CL_MEM_READ_WRITE, 256);
+    auto releasedOffset = buffer->getAllocationOffset();
+    auto parentAllocation = buffer->getGraphicsAllocation();
+
+    auto initialTag = *tagAddress;
+    parentAllocation->taskCount = initialTag + 1;
+    delete buffer;
+    EXPECT_EQ(1u, allocator->peekNumPendingSlots());
+
+    std::unique_ptr<Buffer> buffer2(createBuffer(CL_MEM_READ_WRITE, 256));
+    EXPECT_NE(releasedOffset, buffer2->getAllocationOffset());
+    EXPECT_EQ(1u, allocator->peekNumPendingSlots());
+
+    *tagAddress = initialTag + 1;
+    std::unique_ptr<Buffer> buffer3(createBuffer(CL_MEM_READ_WRITE, 256));
+    EXPECT_EQ(0u, allocator->peekNumPendingSlots());
+    EXPECT_EQ(releasedOffset, buffer3->getAllocationOffset());
+
+    parentAllocation->taskCount = ObjectNotUsed;
+    *tagAddress = initialTag;
+}
+
+TEST_F(BufferPoolTest, givenPooledBufferWhenSetArgStatelessIsCalledThenSlotAddressIsPatched) {
+    std::unique_ptr<Buffer> buffer(createBuffer(CL_MEM_READ_WRITE, 64));
+    ASSERT_NE(0u, buffer->getAllocationOffset());
+
+    uint64_t patchedAddress = 0;
+    buffer->setArgStateless(&patchedAddress, sizeof(patchedAddress));
+    EXPECT_EQ(buffer->getGraphicsAllocation()->getGpuAddress() + buffer->getAllocationOffset(), patchedAddress);
+}
+
+HWTEST_F(BufferPoolTest, givenPooledBufferWhenSetArgStatefulIsCalledThenSurfaceCoversOnlyItsSlot) {
+    using RENDER_SURFACE_STATE = typename FamilyType::RENDER_SURFACE_STATE;
+    std::unique_ptr<Buffer> buffer(createBuffer(CL_MEM_READ_WRITE, 200));
+    ASSERT_NE(0u, buffer->getAllocationOffset());
+
+    RENDER_SURFACE_STATE surfaceState = {};
+    buffer->setArgStateful(&surfaceState);
+
+    EXPECT_EQ(buffer->getGraphicsAllocation()->getGpuAddress() + buffer->getAllocationOffset(), surfaceState.getSurfaceBaseAddress());
+    auto surfaceSize = (surfaceState.getWidth() - 1) + ((surfaceState.getHeight() - 1) << 7) + ((surfaceState.getDepth() - 1) << 21) + 1;
+    EXPECT_EQ(200u, surfaceSize);
+
+    cl_buffer_region region = {64, 64};
+    auto subBuffer = buffer->createSubBuffer(CL_MEM_READ_WRITE, &region, retVal);
+    ASSERT_NE(nullptr, subBuffer);
+
+    subBuffer->setArgStateful(&surfaceState);
+    EXPECT_EQ(buffer->getGraphicsAllocation()->getGpuAddress() + buffer->getAllocationOffset() + region.origin, surfaceState.getSurfaceBaseAddress());
+    subBuffer->release();
+}
+
+HWTEST_F(BufferPoolTest, givenPooledBufferWhenImageIsCreatedFromItThenImageCoversOnlyItsSlot) {
+    using RENDER_SURFACE_STATE = typename FamilyType::RENDER_SURFACE_STATE;
+    std::unique_ptr<Buffer> firstBuffer(createBuffer(CL_MEM_READ_WRITE, 100));
+    std::unique_ptr<Buffer> buffer(createBuffer(CL_MEM_READ_WRITE, 4 * KB));
+    ASSERT_NE(nullptr, buffer);
+    ASSERT_TRUE(buffer->isPooledBuffer());
+    ASSERT_NE(0u, buffer->getAllocationOffset());
+
+    cl_image_format imageFormat = {CL_RGBA, CL_UNORM_INT8};
+    cl_image_desc imageDesc = {};
+    imageDesc.image_width = 16;
+    imageDesc.image_height = 16;
+    imageDesc.mem_object = buffer.get();
+
+    cl_mem_flags flags = CL_MEM_READ_ONLY;
+    auto surfaceFormat = Image::getSurfaceFormatFromTable(flags, &imageFormat);
+    ASSERT_NE(nullptr, surfaceFormat);
+
+    imageDesc.image_type = CL_MEM_OBJECT_IMAGE1D_BUFFER;
+    imageDesc.image_height = 0;
+    EXPECT_EQ(CL_SUCCESS, Image::validate(context.get(), flags, surfaceFormat, &imageDesc, nullptr));
+
+    imageDesc.image_type = CL_MEM_OBJECT_IMAGE2D;
+    imageDesc.image_height = 16;
+    EXPECT_EQ(CL_SUCCESS, Image::validate(context.get(), flags, surfaceFormat, &imageDesc, nullptr));
+
+    std::unique_ptr<Image> image(Image::create(context.get(), flags, surfaceFormat, &imageDesc, nullptr, retVal));
+    ASSERT_EQ(CL_SUCCESS, retVal);
+    ASSERT_NE(nullptr, image);
+    EXPECT_EQ(buffer->getCpuAddress(), image->getCpuAddress());
+    EXPECT_EQ(buffer->getSize(), image->getSize());
+
+    RENDER_SURFACE_STATE surfaceState = {};
+    image->setImageArg(&surfaceState, false);
+    EXPECT_EQ(buffer->getGraphicsAllocation()->getGpuAddress() + buffer->getAllocationOffset(), surfaceState.getSurfaceBaseAddress());
+
+    std::unique_ptr<Image> redescribedImage(image->redescribe());
+    ASSERT_NE(nullptr, redescribedImage);
+    EXPECT_EQ(image->getCpuAddress(), redescribedImage->getCpuAddress());
+    redescribedImage->setImageArg(&surfaceState, false);
+    EXPECT_EQ(buffer->getGraphicsAllocation()->getGpuAddress() + buffer->getAllocationOffset(), surfaceState.getSurfaceBaseAddress());
+}
@@ -24,6 +24,9 @@
 #include "runtime/memory_manager/host_ptr_manager.h"
 #include "runtime/helpers/ptr_math.h"
 
+#include <thread>
+#include <vector>
+
 using namespace OCLRT;
 
 TEST(HostPtrManager, AlignedPointerAndAlignedSizeAskedForAllocationCountReturnsOne) {
@@ -785,3 +788,74 @@ TEST(HostPtrManager, GivenHostPtrManagerFilledWithFragmentsWhenAskedForOverlapin
     EXPECT_EQ(OverlapStatus::FRAGMENT_WITHIN_STORED_FRAGMENT, overlapStatus);
     EXPECT_NE(nullptr, fragment3);
 }
+
+TEST(HostPtrManager, GivenRangesWhenShardsMaskIsComputedThenEveryTouchedGranuleIsCovered) {
+    auto granuleSize = static_cast<size_t>(1) << HostPtrManager::shardGranularityShift;
+    auto ptr = reinterpret_cast<void *>(granuleSize * 5);
+
+    EXPECT_EQ(5u, HostPtrManager::getShardIndex(ptr));
+    EXPECT_EQ(1u << 5, HostPtrManager::getShardsMask(ptr, 0));
+    EXPECT_EQ(1u << 5, HostPtrManager::getShardsMask(ptr, granuleSize));
+    EXPECT_EQ((1u << 5) | (1u << 6), HostPtrManager::getShardsMask(ptr, granuleSize + 1));
+    EXPECT_EQ((1u << 4) | (1u << 5), HostPtrManager::getShardsMask(ptrOffset(ptr, static_cast<size_t>(0) - MemoryConstants::pageSize), 2 * MemoryConstants::pageSize));
+    EXPECT_EQ(~0u, HostPtrManager::getShardsMask(ptr, HostPtrManager::shardCount * granuleSize));
+}
+
+TEST(HostPtrManager, GivenFragmentSpanningShardsWhenQueriedFromEachShardThenTheSameFragmentIsReturned) {
+    auto granuleSize = static_cast<size_t>(1) << HostPtrManager::shardGranularityShift;
+    auto ptr = reinterpret_cast<void *>(granuleSize * 3 - MemoryConstants::pageSize);
+    auto size = granuleSize + 2 * MemoryConstants::pageSize;
+
+    FragmentStorage fragment;
+    fragment.fragmentCpuPointer = ptr;
+    fragment.fragmentSize = size;
+    HostPtrManager hostPtrManager;
+    hostPtrManager.storeFragment(fragment);
+    EXPECT_EQ(1u, hostPtrManager.getFragmentCount());
+
+    auto storedFragment = hostPtrManager.getFragment(ptr);
+    ASSERT_NE(nullptr, storedFragment);
+    EXPECT_EQ(storedFragment, hostPtrManager.getFragment(ptrOffset(ptr, granuleSize)));
+    EXPECT_EQ(storedFragment, hostPtrManager.getFragment(ptrOffset(ptr, size - 1)));
+    EXPECT_EQ(nullptr, hostPtrManager.getFragment(ptrOffset(ptr, size)));
+
+    OverlapStatus overlapStatus;
+    auto overlapping = hostPtrManager.getFragmentAndCheckForOverlaps(ptrOffset(ptr, granuleSize), MemoryConstants::pageSize, overlapStatus);
+    EXPECT_EQ(OverlapStatus::FRAGMENT_WITHIN_STORED_FRAGMENT, overlapStatus);
+    EXPECT_EQ(storedFragment, overlapping);
+
+    overlapping = hostPtrManager.getFragmentAndCheckForOverlaps(ptrOffset(ptr, size - MemoryConstants::pageSize), 2 * MemoryConstants::pageSize, overlapStatus);
+    EXPECT_EQ(OverlapStatus::FRAGMENT_OVERLAPING_AND_BIGGER_THEN_STORED_FRAGMENT, overlapStatus);
+    EXPECT_EQ(nullptr, overlapping);
+
+    EXPECT_TRUE(hostPtrManager.releaseHostPtr(ptrOffset(ptr, granuleSize)));
+    EXPECT_EQ(0u, hostPtrManager.getFragmentCount());
+    EXPECT_EQ(nullptr, hostPtrManager.getFragment(ptrOffset(ptr, size - 1)));
+}
+
+TEST(HostPtrManager, GivenManyThreadsWithDistinctHostPtrsWhenFragmentsAreStoredAndReleasedConcurrentlyThenCountIsConsistent) {
+    const size_t threadsCount = 8;
+    const size_t iterations = 1000;
+    HostPtrManager hostPtrManager;
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadsCount; t++) {
+        threads.push_back(std::thread([&hostPtrManager, t, iterations]() {
+            auto base = reinterpret_cast<void *>((t + 1) << HostPtrManager::shardGranularityShift);
+            for (size_t i = 0; i < iterations; i++) {
+                auto requirements = HostPtrManager::getAllocationRequirements(ptrOffset(base, 0x10), 3 * MemoryConstants::pageSize);
+                HostPtrRangeLock rangeLock(hostPtrManager, requirements);
+                auto handleStorage = hostPtrManager.populateAlreadyAllocatedFragments(requirements, nullptr);
+                for (uint32_t j = 0; j < handleStorage.fragmentCount; j++) {
+                    hostPtrManager.storeFragment(handleStorage.fragmentStorageData[j]);
+                }
+                hostPtrManager.releaseHandleStorage(handleStorage);
+            }
+        }));
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(0u, hostPtrManager.getFragmentCount());
+}
@@ -1050,6 +1050,64 @@ TEST(OsAgnosticMemoryManager, GivenEnabled64kbPagesWhenAllocationIsCreatedThenAl
     memoryManager.freeGraphicsMemory(galloc);
 }
 
+class RacingFragmentsMemoryManager : public OsAgnosticMemoryManager {
+  public:
+    bool checkFragmentsForOverlapping(AllocationRequirements *requirements, CheckedFragments *checkedFragments) override {
+        checkFragmentsCalled++;
+        if (overlappingChecksLeft > 0) {
+            overlappingChecksLeft--;
+            return false;
+        }
+        return OsAgnosticMemoryManager::checkFragmentsForOverlapping(requirements, checkedFragments);
+    }
+    uint32_t overlappingChecksLeft = 0;
+    uint32_t checkFragmentsCalled = 0;
+};
+
+TEST(OsAgnosticMemoryManager, givenOverlapReportedAfterCleanupWhenHostPtrIsAllocatedThenOverlapCheckIsRetriedInsteadOfAborting) {
+    RacingFragmentsMemoryManager memoryManager;
+    memoryManager.overlappingChecksLeft = 2;
+    void *cpuPtr = reinterpret_cast<void *>(0x100004);
+
+    auto graphicsAllocation = memoryManager.allocateGraphicsMemory(MemoryConstants::pageSize, cpuPtr);
+    ASSERT_NE(nullptr, graphicsAllocation);
+    EXPECT_EQ(3u, memoryManager.checkFragmentsCalled);
+    EXPECT_EQ(2u, memoryManager.hostPtrManager.getFragmentCount());
+
+    memoryManager.freeGraphicsMemory(graphicsAllocation);
+}
+
+class PopulateCountingMemoryManager : public OsAgnosticMemoryManager {
+  public:
+    bool populateOsHandles(OsHandleStorage &handleStorage) override {
+        populateOsHandlesCalled++;
+        return OsAgnosticMemoryManager::populateOsHandles(handleStorage);
+    }
+    uint32_t populateOsHandlesCalled = 0;
+};
+
+TEST(OsAgnosticMemoryManager, givenHostPtrWithStoredFragmentsWhenAllocatedAgainThenOsHandlesAreNotPopulated) {
+    PopulateCountingMemoryManager memoryManager;
+    void *cpuPtr = reinterpret_cast<void *>(0x100004);
+
+    auto graphicsAllocation = memoryManager.allocateGraphicsMemory(MemoryConstants::pageSize, cpuPtr);
+    ASSERT_NE(nullptr, graphicsAllocation);
+    EXPECT_EQ(1u, memoryManager.populateOsHandlesCalled);
+
+    auto secondGraphicsAllocation = memoryManager.allocateGraphicsMemory(MemoryConstants::pageSize, cpuPtr);
+    ASSERT_NE(nullptr, secondGraphicsAllocation);
+    EXPECT_EQ(1u, memoryManager.populateOsHandlesCalled);
+    EXPECT_EQ(2u, memoryManager.hostPtrManager.getFragmentCount());
+    for (uint32_t i = 0; i < graphicsAllocation->fragmentsStorage.fragmentCount; i++) {
+        EXPECT_EQ(graphicsAllocation->fragmentsStorage.fragmentStorageData[i].osHandleStorage,
+                  secondGraphicsAllocation->fragmentsStorage.fragmentStorageData[i].osHandleStorage);
+    }
+
+    memoryManager.freeGraphicsMemory(secondGraphicsAllocation);
+    memoryManager.freeGraphicsMemory(graphicsAllocation);
+    EXPECT_EQ(0u, memoryManager.hostPtrManager.getFragmentCount());
+}
+
 TEST(OsAgnosticMemoryManager, checkAllocationsForOverlappingWithNullCsrInMemoryManager) {
     OsAgnosticMemoryManager memoryManager;
 
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/memory_manager/reusable_allocations_pool.h"
+#include "runtime/memory_manager/memory_constants.h"
+#include "gtest/gtest.h"
+
+using namespace OCLRT;
+
+namespace {
+GraphicsAllocation *createAllocation(size_t size, uint32_t taskCount = 0) {
+    auto allocation = new GraphicsAllocation(nullptr, size);
+    allocation->taskCount = taskCount;
+    return allocation;
+}
+
+void deleteChain(GraphicsAllocation *allocations) {
+    if (allocations != nullptr) {
+        allocations->deleteThisAndAllNext();
+    }
+}
+
+size_t countChain(GraphicsAllocation *allocations) {
+    return allocations ? allocations->countThisAndAllConnected() : 0u;
+}
+} // namespace
+
+TEST(ReusableAllocationsPool, givenSizeWhenBucketIndexIsQueriedThenPowerOfTwoPageClassIsReturned) {
+    EXPECT_EQ(0u, ReusableAllocationsPool::getBucketIndex(0));
+    EXPECT_EQ(0u, ReusableAllocationsPool::getBucketIndex(1));
+    EXPECT_EQ(0u, ReusableAllocationsPool::getBucketIndex(MemoryConstants::pageSize));
+    EXPECT_EQ(1u, ReusableAllocationsPool::getBucketIndex(MemoryConstants::pageSize + 1));
+    EXPECT_EQ(1u, ReusableAllocationsPool::getBucketIndex(3 * MemoryConstants::pageSize));
+    EXPECT_EQ(2u, ReusableAllocationsPool::getBucketIndex(4 * MemoryConstants::pageSize));
+    EXPECT_EQ(4u, ReusableAllocationsPool::getBucketIndex(64 * MemoryConstants::kiloByte));
+    EXPECT_EQ(ReusableAllocationsPool::bucketsCount - 1, ReusableAllocationsPool::getBucketIndex(static_cast<size_t>(-1)));
+}
+
+TEST(ReusableAllocationsPool, givenAllocationsOfDifferentSizesWhenAllocationIsDetachedThenBestFitIsReturned) {
+    ReusableAllocationsPool pool;
+    auto big = createAllocation(64 * MemoryConstants::megaByte);
+    auto fit = createAllocation(96 * MemoryConstants::kiloByte);
+    auto tight = createAllocation(64 * MemoryConstants::kiloByte);
+    auto small = createAllocation(MemoryConstants::pageSize);
+    pool.pushTailOne(*big);
+    pool.pushTailOne(*fit);
+    pool.pushTailOne(*tight);
+    pool.pushTailOne(*small);
+
+    auto allocation = pool.detachAllocation(64 * MemoryConstants::kiloByte);
+    EXPECT_EQ(tight, allocation.get());
+    EXPECT_EQ(nullptr, allocation->next);
+    EXPECT_EQ(nullptr, allocation->prev);
+
+    allocation = pool.detachAllocation(64 * MemoryConstants::kiloByte);
+    EXPECT_EQ(fit, allocation.get());
+
+    allocation = pool.detachAllocation(64 * MemoryConstants::kiloByte);
+    EXPECT_EQ(big, allocation.get());
+
+    EXPECT_EQ(nullptr, pool.detachAllocation(64 * MemoryConstants::kiloByte));
+    EXPECT_TRUE(pool.peekContains(*small));
+    EXPECT_EQ(MemoryConstants::pageSize, pool.peekBytes());
+
+    EXPECT_EQ(3u, pool.getStatistics().hits);
+    EXPECT_EQ(1u, pool.getStatistics().misses);
+}
+
+TEST(ReusableAllocationsPool, givenAllocationStillUsedByGpuWhenAllocationIsDetachedThenItIsSkipped) {
+    ReusableAllocationsPool pool;
+    volatile uint32_t tag = 5;
+    auto busy = createAllocation(MemoryConstants::pageSize, 5);
+    auto completed = createAllocation(2 * MemoryConstants::pageSize, 4);
+    pool.pushTailOne(*busy);
+    pool.pushTailOne(*completed);
+
+    auto allocation = pool.detachAllocation(1, &tag);
+    EXPECT_EQ(completed, allocation.get());
+    EXPECT_EQ(nullptr, pool.detachAllocation(1, &tag));
+
+    tag = 6;
+    allocation = pool.detachAllocation(1, &tag);
+    EXPECT_EQ(busy, allocation.get());
+    EXPECT_TRUE(pool.peekIsEmpty());
+}
+
+TEST(ReusableAllocationsPool, givenWaitTaskCountWhenCompletedAllocationsAreDetachedThenOnlyFinishedOnesAreReturned) {
+    ReusableAllocationsPool pool;
+    auto first = createAllocation(MemoryConstants::pageSize, 1);
+    auto second = createAllocation(MemoryConstants::megaByte, 10);
+    auto third = createAllocation(MemoryConstants::pageSize, 2);
+    pool.pushTailOne(*first);
+    pool.pushTailOne(*second);
+    pool.pushTailOne(*third);
+
+    auto detached = pool.detachCompletedAllocations(2);
+    EXPECT_EQ(2u, countChain(detached));
+    EXPECT_EQ(second, pool.peekHead());
+    EXPECT_EQ(second, pool.peekTail());
+    EXPECT_EQ(MemoryConstants::megaByte, pool.peekBytes());
+    deleteChain(detached);
+}
+
+TEST(ReusableAllocationsPool, givenPoolAboveByteCapWhenTrimmedThenOldestAllocationsAreDetached) {
+    ReusableAllocationsPool pool;
+    pool.setMaxBytes(3 * MemoryConstants::pageSize);
+    pool.setMaxIdleTime(std::chrono::milliseconds(0));
+
+    auto oldest = createAllocation(2 * MemoryConstants::pageSize);
+    auto middle = createAllocation(MemoryConstants::pageSize);
+    auto newest = createAllocation(MemoryConstants::pageSize);
+    pool.pushTailOne(*oldest);
+    pool.pushTailOne(*middle);
+    pool.pushTailOne(*newest);
+    auto now = std::chrono::steady_clock::now();
+    oldest->reuseTimestamp = now - std::chrono::seconds(3);
+    middle->reuseTimestamp = now - std::chrono::seconds(2);
+    newest->reuseTimestamp = now - std::chrono::seconds(1);
+
+    auto detached = pool.detachAllocationsToTrim(nullptr, now);
+    ASSERT_EQ(1u, countChain(detached));
+    EXPECT_EQ(oldest, detached);
+    EXPECT_EQ(2 * MemoryConstants::pageSize, pool.peekBytes());
+    EXPECT_EQ(1u, pool.getStatistics().trimmedAllocations);
+    EXPECT_EQ(2 * MemoryConstants::pageSize, pool.getStatistics().trimmedBytes);
+    deleteChain(detached);
+}
+
+TEST(ReusableAllocationsPool, givenIdleAllocationsWhenTrimmedThenOnlyExpiredAndCompletedOnesAreDetached) {
+    ReusableAllocationsPool pool;
+    pool.setMaxBytes(0);
+    pool.setMaxIdleTime(std::chrono::milliseconds(100));
+    volatile uint32_t tag = 3;
+
+    auto idle = createAllocation(MemoryConstants::pageSize, 1);
+    auto busy = createAllocation(MemoryConstants::pageSize, 3);
+    pool.pushTailOne(*idle);
+    pool.pushTailOne(*busy);
+    auto storeTime = std::chrono::steady_clock::now();
+    idle->reuseTimestamp = storeTime;
+    busy->reuseTimestamp = storeTime;
+
+    auto detached = pool.detachAllocationsToTrim(&tag, storeTime + std::chrono::milliseconds(100));
+    EXPECT_EQ(nullptr, detached);
+
+    detached = pool.detachAllocationsToTrim(&tag, storeTime + std::chrono::seconds(1));
+    ASSERT_EQ(1u, countChain(detached));
+    EXPECT_EQ(idle, detached);
+    EXPECT_TRUE(pool.peekContains(*busy));
+    deleteChain(detached);
+}
+
+TEST(ReusableAllocationsPool, givenBytesToReleaseWhenLeastRecentlyStoredAreDetachedThenOldestCompletedAllocationsAreReturned) {
+    ReusableAllocationsPool pool;
+    volatile uint32_t tag = 3;
+
+    auto busy = createAllocation(MemoryConstants::pageSize, 3);
+    auto oldest = createAllocation(4 * MemoryConstants::pageSize, 1);
+    auto middle = createAllocation(MemoryConstants::pageSize, 1);
+    auto newest = createAllocation(2 * MemoryConstants::pageSize, 1);
+    for (auto allocation : {busy, oldest, middle, newest}) {
+        pool.pushTailOne(*allocation);
+    }
+    auto now = std::chrono::steady_clock::now();
+    busy->reuseTimestamp = now - std::chrono::seconds(4);
+    oldest->reuseTimestamp = now - std::chrono::seconds(3);
+    middle->reuseTimestamp = now - std::chrono::seconds(2);
+    newest->reuseTimestamp = now - std::chrono::seconds(1);
+
+    auto detached = pool.detachLeastRecentlyStored(&tag, 4 * MemoryConstants::pageSize + 1);
+    ASSERT_EQ(2u, countChain(detached));
+    EXPECT_EQ(oldest, detached);
+    EXPECT_EQ(middle, detached->next);
+    EXPECT_TRUE(pool.peekContains(*busy));
+    EXPECT_TRUE(pool.peekContains(*newest));
+    EXPECT_EQ(3 * MemoryConstants::pageSize, pool.peekBytes());
+    EXPECT_EQ(2u, pool.getStatistics().trimmedAllocations);
+    deleteChain(detached);
+
+    detached = pool.detachLeastRecentlyStored(&tag, 0);
+    EXPECT_EQ(nullptr, detached);
+}
@@ -23,6 +23,7 @@
 #include "gtest/gtest.h"
 #include "test.h"
 #include "runtime/event/event.h"
+#include "runtime/helpers/ptr_math.h"
 #include "runtime/memory_manager/svm_memory_manager.h"
 #include "runtime/utilities/tag_allocator.h"
 #include "unit_tests/helpers/memory_management.h"
@@ -145,3 +146,72 @@ TEST_F(SVMMemoryAllocatorTest, WhenCouldNotAllocateInMemoryManagerThenReturnsNul
         EXPECT_EQ(0U, svmM.GetSVMAllocs().getNumAllocs());
     }
 }
+
+TEST_F(SVMMemoryAllocatorTest, GivenMultiPageSVMAllocWhenInteriorPointersAreLookedUpThenAllocationIsReturnedOnlyWithinItsSize) {
+    OsAgnosticMemoryManager umm;
+    {
+        SVMAllocsManager svmM(&umm);
+        size_t size = 5 * MemoryConstants::pageSize + 100;
+        char *ptr = (char *)svmM.createSVMAlloc(size);
+        ASSERT_NE(nullptr, ptr);
+        GraphicsAllocation *GA = svmM.getSVMAlloc(ptr);
+        ASSERT_NE(nullptr, GA);
+
+        EXPECT_EQ(GA, svmM.getSVMAlloc(ptr + MemoryConstants::pageSize));
+        EXPECT_EQ(GA, svmM.getSVMAlloc(ptr + 3 * MemoryConstants::pageSize + 17));
+        EXPECT_EQ(GA, svmM.getSVMAlloc(ptr + size - 1));
+        EXPECT_EQ(nullptr, svmM.getSVMAlloc(ptr + size));
+
+        svmM.freeSVMAlloc(ptr + 2 * MemoryConstants::pageSize);
+        EXPECT_EQ(nullptr, svmM.getSVMAlloc(ptr + size - 1));
+        EXPECT_EQ(0u, svmM.getNumAllocs());
+    }
+}
+
+TEST(SVMPageDirectoryTest, GivenAllocationsSetInDirectoryWhenClearedThenOnlyPagesOfClearedAllocationAreReset) {
+    SVMPageDirectory pageDirectory;
+    auto first = reinterpret_cast<GraphicsAllocation *>(0x1000);
+    auto second = reinterpret_cast<GraphicsAllocation *>(0x2000);
+    auto ptr = reinterpret_cast<void *>(0x7f0000000000);
+
+    EXPECT_EQ(nullptr, pageDirectory.get(ptr));
+
+    pageDirectory.set(ptr, 2 * MemoryConstants::pageSize, first);
+    pageDirectory.set(ptrOffset(ptr, 2 * MemoryConstants::pageSize), MemoryConstants::pageSize, second);
+    EXPECT_EQ(first, pageDirectory.get(ptrOffset(ptr, MemoryConstants::pageSize + 5)));
+    EXPECT_EQ(second, pageDirectory.get(ptrOffset(ptr, 2 * MemoryConstants::pageSize)));
+
+    pageDirectory.clear(ptr, 3 * MemoryConstants::pageSize, first);
+    EXPECT_EQ(nullptr, pageDirectory.get(ptr));
+    EXPECT_EQ(nullptr, pageDirectory.get(ptrOffset(ptr, MemoryConstants::pageSize)));
+    EXPECT_EQ(second, pageDirectory.get(ptrOffset(ptr, 2 * MemoryConstants::pageSize)));
+}
+
+TEST_F(SVMMemoryAllocatorTest, GivenSVMAllocsCreatedAndFreedConcurrentlyWhenLookedUpFromOtherThreadThenLiveAllocationIsAlwaysFound) {
+    OsAgnosticMemoryManager umm;
+    {
+        SVMAllocsManager svmM(&umm);
+        char *ptr = (char *)svmM.createSVMAlloc(4 * MemoryConstants::pageSize);
+        ASSERT_NE(nullptr, ptr);
+        auto GA = svmM.getSVMAlloc(ptr);
+
+        std::atomic<bool> done(false);
+        auto lookups = std::async(std::launch::async, [&]() {
+            size_t misses = 0;
+            while (!done) {
+                misses += (svmM.getSVMAlloc(ptr + MemoryConstants::pageSize + 1) != GA);
+            }
+            return misses;
+        });
+
+        for (int i = 0; i < 100; i++) {
+            auto other = svmM.createSVMAlloc(MemoryConstants::pageSize);
+            EXPECT_EQ(svmM.getSVMAlloc(other)->getUnderlyingBuffer(), other);
+            svmM.freeSVMAlloc(other);
+        }
+        done = true;
+
+        EXPECT_EQ(0u, lookups.get());
+        svmM.freeSVMAlloc(ptr);
+    }
+}
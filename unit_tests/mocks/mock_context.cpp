@@ -25,6 +25,7 @@
 #include "runtime/memory_manager/os_agnostic_memory_manager.h"
 #include "runtime/memory_manager/svm_memory_manager.h"
 #include "runtime/command_queue/command_queue.h"
+#include "runtime/mem_obj/buffer_pool_allocator.h"
 #include "runtime/compiler_interface/compiler_interface.h"
 #include "runtime/built_ins/built_ins.h"
 #include "unit_tests/mocks/mock_context.h"
@@ -37,6 +38,7 @@ MockContext::MockContext(Device *device, bool noSpecialQueue) {
     memoryManager = device->getMemoryManager();
     devices.push_back(device);
     svmAllocsManager = new SVMAllocsManager(memoryManager);
+    initBufferPoolAllocator();
     cl_int retVal;
     if (!specialQueue && !noSpecialQueue) {
         auto commandQueue = CommandQueue::create(this, device, nullptr, retVal);
@@ -59,6 +61,7 @@ MockContext::MockContext(
 }
 
 MockContext::~MockContext() {
+    bufferPoolAllocator.reset();
     if (specialQueue) {
         delete specialQueue;
         specialQueue = nullptr;
@@ -76,6 +79,7 @@ MockContext::MockContext() {
     devices.push_back(device.get());
     memoryManager = device->getMemoryManager();
     svmAllocsManager = new SVMAllocsManager(memoryManager);
+    initBufferPoolAllocator();
     cl_int retVal;
     if (!specialQueue) {
         auto commandQueue = CommandQueue::create(this, device.get(), nullptr, retVal);
@@ -219,7 +219,7 @@ class MockCommandStreamReceiver : public CommandStreamReceiver {
     void flushBatchedSubmissions() override {
     }
 
-    void waitForTaskCountWithKmdNotifyFallback(uint32_t taskCountToWait, FlushStamp flushStampToWait) override {
+    void waitForTaskCountWithKmdNotifyFallback(uint32_t taskCountToWait, FlushStamp flushStampToWait, QueueThrottle throttle) override {
     }
 
     void addPipeControl(LinearStream &commandStream, bool dcFlush) override {
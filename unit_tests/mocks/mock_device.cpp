@@ -71,6 +71,7 @@ void MockDevice::injectMemoryManager(MockMemoryManager *memoryManager) {
 
 void MockDevice::resetCommandStreamReceiver(CommandStreamReceiver *newCsr) {
     if (commandStreamReceiver) {
+        commandStreamReceiver->closeBatchedSubmissionFlusher();
         delete commandStreamReceiver;
     }
     commandStreamReceiver = newCsr;
@@ -68,6 +68,9 @@ class MockProgram : public Program {
     void separateBlockKernels() {
         Program::separateBlockKernels();
     }
+    bool tryStartBuild() {
+        return Program::tryStartBuild();
+    }
     std::vector<KernelInfo *> &getKernelInfoArray() {
         return kernelInfoArray;
     }
@@ -92,6 +95,11 @@ class MockProgram : public Program {
     void ClearLog() { buildLog.clear(); }
     void SetGlobalVariableTotalSize(size_t globalVarSize) { globalVarTotalSize = globalVarSize; }
     void SetDevice(Device *pDev) { pDevice = pDev; }
+    void setProgramBinaryType(cl_program_binary_type binaryType) { programBinaryType = binaryType; }
+
+    bool serializeKernelInfoImage(std::vector<char> &image) { return Program::serializeKernelInfoImage(image); }
+    void setKernelInfoImage(const std::vector<char> &image) { kernelInfoImage = image; }
+    void setEmbedKernelInfo(bool embed) { embedKernelInfo = embed; }
 
     char *GetLLVMBinary() { return llvmBinary; }
     size_t GetLLVMBinarySize() { return llvmBinarySize; }
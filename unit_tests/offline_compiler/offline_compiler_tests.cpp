@@ -23,6 +23,7 @@
 #include "config.h"
 #include "environment.h"
 #include "mock/mock_offline_compiler.h"
+#include "offline_compiler/batch_compiler.h"
 #include "offline_compiler_tests.h"
 #include "runtime/helpers/hw_info.h"
 #include "runtime/helpers/file_io.h"
@@ -505,4 +506,194 @@ TEST(OfflineCompilerTest, generateElfBinary) {
     EXPECT_NE(0u, mockOfflineCompiler->getElfBinarySize());
 }
 
+TEST(OfflineCompilerTest, reinitializeReusesCompilerForNextInput) {
+    auto mockOfflineCompiler = std::unique_ptr<MockOfflineCompiler>(new MockOfflineCompiler());
+    ASSERT_NE(nullptr, mockOfflineCompiler);
+
+    const char *argv[] = {
+        "cloc",
+        "-file",
+        "test_files/copybuffer.cl",
+        "-device",
+        gEnvironment->devicePrefix.c_str()};
+
+    auto retVal = mockOfflineCompiler->initialize(ARRAY_COUNT(argv), argv);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    retVal = mockOfflineCompiler->buildSourceCode();
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_NE(nullptr, mockOfflineCompiler->getGenBinary());
+
+    const char *nextArgv[] = {
+        "cloc",
+        "-file",
+        "test_files/copybuffer.cl",
+        "-device",
+        gEnvironment->devicePrefix.c_str(),
+        "-llvm_text"};
+
+    retVal = mockOfflineCompiler->reinitialize(ARRAY_COUNT(nextArgv), nextArgv);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(nullptr, mockOfflineCompiler->getGenBinary());
+    EXPECT_EQ(0u, mockOfflineCompiler->getGenBinarySize());
+
+    retVal = mockOfflineCompiler->buildSourceCode();
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_NE(nullptr, mockOfflineCompiler->getGenBinary());
+}
+
+TEST(OfflineCompilerTest, reinitializeWithMissingFileFails) {
+    auto mockOfflineCompiler = std::unique_ptr<MockOfflineCompiler>(new MockOfflineCompiler());
+    ASSERT_NE(nullptr, mockOfflineCompiler);
+
+    const char *argv[] = {
+        "cloc",
+        "-file",
+        "test_files/copybuffer.cl",
+        "-device",
+        gEnvironment->devicePrefix.c_str()};
+
+    auto retVal = mockOfflineCompiler->initialize(ARRAY_COUNT(argv), argv);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    const char *nextArgv[] = {
+        "cloc",
+        "-file",
+        "test_files/ImANaughtyFile.cl",
+        "-device",
+        gEnvironment->devicePrefix.c_str()};
+
+    testing::internal::CaptureStdout();
+    retVal = mockOfflineCompiler->reinitialize(ARRAY_COUNT(nextArgv), nextArgv);
+    std::string output = testing::internal::GetCapturedStdout();
+    EXPECT_EQ(INVALID_FILE, retVal);
+}
+
+TEST(BatchCompilerTest, splitManifestLine) {
+    auto args = splitManifestLine("-file test_files/copybuffer.cl  -options \"-cl-std=CL2.0 -g\"\t-q\r");
+    ASSERT_EQ(5u, args.size());
+    EXPECT_EQ("-file", args[0]);
+    EXPECT_EQ("test_files/copybuffer.cl", args[1]);
+    EXPECT_EQ("-options", args[2]);
+    EXPECT_EQ("-cl-std=CL2.0 -g", args[3]);
+    EXPECT_EQ("-q", args[4]);
+
+    EXPECT_TRUE(splitManifestLine("   ").empty());
+    ASSERT_EQ(2u, splitManifestLine("-options \"\"").size());
+}
+
+TEST(BatchCompilerTest, isBatchCommandLine) {
+    const char *batchArgv[] = {"cloc", "-q", "-batch", "manifest.txt"};
+    const char *singleArgv[] = {"cloc", "-file", "test_files/copybuffer.cl"};
+
+    EXPECT_TRUE(BatchCompiler::isBatchCommandLine(ARRAY_COUNT(batchArgv), batchArgv));
+    EXPECT_FALSE(BatchCompiler::isBatchCommandLine(ARRAY_COUNT(singleArgv), singleArgv));
+}
+
+TEST(BatchCompilerTest, missingManifestFails) {
+    const char *argv[] = {"cloc", "-batch", "test_files/ImANaughtyManifest.txt"};
+    int retVal = CL_SUCCESS;
+
+    testing::internal::CaptureStdout();
+    auto pBatchCompiler = BatchCompiler::create(ARRAY_COUNT(argv), argv, retVal);
+    std::string output = testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(nullptr, pBatchCompiler);
+    EXPECT_EQ(INVALID_FILE, retVal);
+}
+
+TEST(BatchCompilerTest, invalidThreadCountFails) {
+    const char *argv[] = {"cloc", "-batch", "manifest.txt", "-threads", "0"};
+    int retVal = CL_SUCCESS;
+
+    testing::internal::CaptureStdout();
+    auto pBatchCompiler = BatchCompiler::create(ARRAY_COUNT(argv), argv, retVal);
+    std::string output = testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(nullptr, pBatchCompiler);
+    EXPECT_EQ(INVALID_COMMAND_LINE, retVal);
+}
+
+TEST(BatchCompilerTest, buildKeepsPerEntryResults) {
+    std::string manifest = "# batch manifest\n"
+                           "\n"
+                           "-file test_files/copybuffer.cl -device " +
+                           gEnvironment->devicePrefix + "\n"
+                           "-file test_files/ImANaughtyFile.cl -device " +
+                           gEnvironment->devicePrefix + "\n"
+                           "  -file test_files/copybuffer.cl -llvm_text -out_dir offline_compiler_batch_test -device " +
+                           gEnvironment->devicePrefix + "\n";
+    writeDataToFile("batch_manifest.txt", manifest.c_str(), manifest.size());
+
+    const char *argv[] = {"cloc", "-batch", "batch_manifest.txt", "-threads", "1", "-q"};
+    int retVal = CL_SUCCESS;
+
+    auto pBatchCompiler = std::unique_ptr<BatchCompiler>(BatchCompiler::create(ARRAY_COUNT(argv), argv, retVal));
+    ASSERT_NE(nullptr, pBatchCompiler);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(1u, pBatchCompiler->getNumThreads());
+    EXPECT_TRUE(pBatchCompiler->isQuiet());
+
+    auto &entries = pBatchCompiler->getEntries();
+    ASSERT_EQ(3u, entries.size());
+    EXPECT_EQ(gEnvironment->devicePrefix, entries[0].deviceName);
+    EXPECT_EQ("test_files/ImANaughtyFile.cl", entries[1].inputFile);
+
+    testing::internal::CaptureStdout();
+    retVal = pBatchCompiler->build();
+    std::string output = testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(INVALID_FILE, retVal);
+    EXPECT_EQ(CL_SUCCESS, entries[0].retVal);
+    EXPECT_EQ(INVALID_FILE, entries[1].retVal);
+    EXPECT_EQ(CL_SUCCESS, entries[2].retVal);
+    EXPECT_EQ(true, compilerOutputExists("copybuffer", "bc"));
+    EXPECT_EQ(true, compilerOutputExists("copybuffer", "bin"));
+    EXPECT_EQ(true, fileExists("offline_compiler_batch_test/copybuffer_" + gEnvironment->devicePrefix + ".ll"));
+
+    EXPECT_NE(std::string::npos, entries[1].messages.find("Error: Input file test_files/ImANaughtyFile.cl missing."));
+    EXPECT_EQ(std::string::npos, output.find("ImANaughtyFile.cl"));
+}
+
+TEST(BatchCompilerTest, defaultThreadCountIsLimitedToNumberOfDevices) {
+    std::string manifest = "-file test_files/copybuffer.cl -device " +
+                           gEnvironment->devicePrefix + "\n"
+                           "-file test_files/copybuffer.cl -llvm_text -out_dir offline_compiler_batch_test -device " +
+                           gEnvironment->devicePrefix + "\n";
+    writeDataToFile("batch_manifest_single_device.txt", manifest.c_str(), manifest.size());
+
+    const char *argv[] = {"cloc", "-batch", "batch_manifest_single_device.txt", "-q"};
+    int retVal = CL_SUCCESS;
+
+    auto pBatchCompiler = std::unique_ptr<BatchCompiler>(BatchCompiler::create(ARRAY_COUNT(argv), argv, retVal));
+    ASSERT_NE(nullptr, pBatchCompiler);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(1u, pBatchCompiler->getNumThreads());
+}
+
+TEST(BatchCompilerTest, entriesWritingSameOutputsAreRejected) {
+    std::string manifest = "-file test_files/copybuffer.cl -device " +
+                           gEnvironment->devicePrefix + "\n"
+                           "-file test_files/copybuffer.cl -llvm_text -device " +
+                           gEnvironment->devicePrefix + "\n";
+    writeDataToFile("batch_manifest_same_outputs.txt", manifest.c_str(), manifest.size());
+
+    const char *argv[] = {"cloc", "-batch", "batch_manifest_same_outputs.txt"};
+    int retVal = CL_SUCCESS;
+
+    testing::internal::CaptureStdout();
+    auto pBatchCompiler = BatchCompiler::create(ARRAY_COUNT(argv), argv, retVal);
+    std::string output = testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(nullptr, pBatchCompiler);
+    EXPECT_EQ(INVALID_COMMAND_LINE, retVal);
+    EXPECT_NE(std::string::npos, output.find("copybuffer_" + gEnvironment->devicePrefix));
+}
+
+TEST(BatchCompilerTest, getOutputFileBase) {
+    EXPECT_EQ("copybuffer_skl", getOutputFileBase("", "test_files/copybuffer.cl", "skl", ""));
+    EXPECT_EQ("out/copybuffer_skl", getOutputFileBase("out", "copybuffer.cl", "skl", ""));
+    EXPECT_EQ("out/copybuffer_skl.-g", getOutputFileBase("out", "dir.d\\copybuffer", "skl", "-g"));
+    EXPECT_NE(getOutputFileBase("", "a/copybuffer.cl", "skl", ""), getOutputFileBase("", "a/copybuffer.cl", "kbl", ""));
+}
+
 } // namespace OCLRT
@@ -78,6 +78,7 @@ class DrmMockCustom : public Drm {
         IoctlResExt(int32_t no, int32_t res) : no(no), res(res) {}
     };
     void overideCoherencyPatchActive(bool newCoherencyPatchActiveValue) { coherencyDisablePatchActive = newCoherencyPatchActiveValue; }
+    void overrideExecBatchFirstSupported(bool newExecBatchFirstSupported) { execBatchFirstSupported = newExecBatchFirstSupported; }
 
     std::atomic<int> ioctl_cnt;
     std::atomic<int> ioctl_res;
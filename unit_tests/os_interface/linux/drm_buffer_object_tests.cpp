@@ -49,7 +49,7 @@ class DrmBufferObjectFixture : public MemoryManagementFixture {
   public:
     DrmMockCustom *mock;
     TestedBufferObject *bo;
-    drm_i915_gem_exec_object2 execObjectsStorage[256];
+    drm_i915_gem_exec_object2 execObject = {};
 
     void SetUp() override {
         MemoryManagementFixture::SetUp();
@@ -57,7 +57,7 @@ class DrmBufferObjectFixture : public MemoryManagementFixture {
         ASSERT_NE(nullptr, this->mock);
         bo = new TestedBufferObject(this->mock);
         ASSERT_NE(nullptr, bo);
-        bo->setExecObjectsStorage(execObjectsStorage);
+        bo->fillExecObject(execObject);
     }
 
     void TearDown() override {
@@ -74,44 +74,44 @@ class DrmBufferObjectFixture : public MemoryManagementFixture {
 
 typedef Test<DrmBufferObjectFixture> DrmBufferObjectTest;
 
-TEST_F(DrmBufferObjectTest, exec) {
+TEST_F(DrmBufferObjectTest, submit) {
     mock->ioctl_expected = 1;
     mock->ioctl_res = 0;
 
-    auto ret = bo->exec(0, 0, 0);
+    auto ret = bo->submit(&execObject, 1, 0, 0, 0, false, false);
     EXPECT_EQ(mock->ioctl_res, ret);
     EXPECT_EQ(0u, mock->execBuffer.flags);
 }
 
-TEST_F(DrmBufferObjectTest, givenDrmWithCoherencyPatchActiveWhenExecIsCalledThenFlagsContainNonCoherentFlag) {
+TEST_F(DrmBufferObjectTest, givenDrmWithCoherencyPatchActiveWhenSubmitIsCalledThenFlagsContainNonCoherentFlag) {
     mock->ioctl_expected = 1;
     mock->ioctl_res = 0;
     mock->overideCoherencyPatchActive(true);
 
-    auto ret = bo->exec(0, 0, 0);
+    auto ret = bo->submit(&execObject, 1, 0, 0, 0, false, false);
     EXPECT_EQ(mock->ioctl_res, ret);
     uint64_t expectedFlag = I915_PRIVATE_EXEC_FORCE_NON_COHERENT;
     uint64_t currentFlag = mock->execBuffer.flags;
     EXPECT_EQ(expectedFlag, currentFlag);
 }
 
-TEST_F(DrmBufferObjectTest, givenDrmWithCoherencyPatchActiveWhenExecIsCalledWithCoherencyRequestThenFlagsDontContainNonCoherentFlag) {
+TEST_F(DrmBufferObjectTest, givenDrmWithCoherencyPatchActiveWhenSubmitIsCalledWithCoherencyRequestThenFlagsDontContainNonCoherentFlag) {
     mock->ioctl_expected = 1;
     mock->ioctl_res = 0;
     mock->overideCoherencyPatchActive(true);
 
-    auto ret = bo->exec(0, 0, 0, true);
+    auto ret = bo->submit(&execObject, 1, 0, 0, 0, true, false);
     EXPECT_EQ(mock->ioctl_res, ret);
     uint64_t expectedFlag = 0;
     uint64_t currentFlag = mock->execBuffer.flags;
     EXPECT_EQ(expectedFlag, currentFlag);
 }
 
-TEST_F(DrmBufferObjectTest, exec_ioctlFailed) {
+TEST_F(DrmBufferObjectTest, submit_ioctlFailed) {
     testing::internal::CaptureStderr();
     mock->ioctl_expected = 1;
     mock->ioctl_res = -1;
-    EXPECT_THROW(bo->exec(0, 0, 0), std::exception);
+    EXPECT_THROW(bo->submit(&execObject, 1, 0, 0, 0, false, false), std::exception);
     testing::internal::GetCapturedStderr();
 }
 
@@ -764,7 +764,10 @@ class DrmCommandStreamEnhancedFixture : public MemoryManagementFixture
             this->submissionAggregator.reset(newSubmissionsAggregator);
         }
         std::vector<drm_i915_gem_exec_object2> &getExecStorage() {
-            return this->execObjectsStorage;
+            return this->execObjectTable.getExecObjects();
+        }
+        DrmExecObjectTable &getExecObjectTable() {
+            return this->execObjectTable;
         }
     };
     TestedDrmCommandStreamReceiver<DEFAULT_TEST_FAMILY_NAME> *tCsr = nullptr;
@@ -922,12 +925,73 @@ TEST_F(DrmCommandStreamBatchingTests, givenCSRWhenFlushIsCalledThenProperFlagsAr
     csr->flush(batchBuffer, EngineType::ENGINE_RCS, nullptr);
 
     EXPECT_EQ(3, this->mock->ioctl_cnt);
-    uint64_t flags = I915_EXEC_RENDER | I915_EXEC_NO_RELOC;
+    uint64_t flags = I915_EXEC_RENDER | I915_EXEC_NO_RELOC | I915_EXEC_HANDLE_LUT;
+    EXPECT_EQ(flags, this->mock->execBuffer.flags);
+
+    mm->freeGraphicsMemory(dummyAllocation);
+    mm->freeGraphicsMemory(commandBuffer);
+}
+
+TEST_F(DrmCommandStreamBatchingTests, givenSameResidencyInConsecutiveFlushesWhenFlushIsCalledThenExecObjectsAreNotFilledAgain) {
+    tCsr->overrideGemCloseWorkerOperationMode(gemCloseWorkerMode::gemCloseWorkerInactive);
+    auto commandBuffer = mm->allocateGraphicsMemory(1024, 4096);
+    auto dummyAllocation = mm->allocateGraphicsMemory(1024, 4096);
+    LinearStream cs(commandBuffer);
+
+    csr->addBatchBufferEnd(cs, nullptr);
+    csr->alignToCacheLine(cs);
+
+    ResidencyContainer allocationsForResidency;
+    allocationsForResidency.push_back(dummyAllocation);
+
+    BatchBuffer batchBuffer{cs.getGraphicsAllocation(), 0, false, false, cs.getUsed(), &cs};
+    csr->flush(batchBuffer, EngineType::ENGINE_RCS, &allocationsForResidency);
+    EXPECT_EQ(2u, this->mock->execBuffer.buffer_count);
+    EXPECT_EQ(1u, tCsr->getExecObjectTable().peekFilledEntries());
+
+    csr->flush(batchBuffer, EngineType::ENGINE_RCS, &allocationsForResidency);
+    EXPECT_EQ(2u, this->mock->execBuffer.buffer_count);
+    EXPECT_EQ(1u, tCsr->getExecObjectTable().peekFilledEntries());
+
+    auto execObjects = reinterpret_cast<drm_i915_gem_exec_object2 *>(this->mock->execBuffer.buffers_ptr);
+    EXPECT_EQ(static_cast<uint32_t>(dummyAllocation->getBO()->peekHandle()), execObjects[0].handle);
+    EXPECT_EQ(static_cast<uint32_t>(commandBuffer->getBO()->peekHandle()), execObjects[1].handle);
+
+    mm->freeGraphicsMemory(dummyAllocation);
+    mm->freeGraphicsMemory(commandBuffer);
+}
+
+#if defined(I915_EXEC_BATCH_FIRST)
+TEST_F(DrmCommandStreamBatchingTests, givenKernelSupportingBatchFirstWhenFlushIsCalledThenBatchBufferIsFirstExecObject) {
+    mock->overrideExecBatchFirstSupported(true);
+    TestedDrmCommandStreamReceiver<DEFAULT_TEST_FAMILY_NAME> testedCsr(mock, gemCloseWorkerMode::gemCloseWorkerInactive);
+
+    auto commandBuffer = mm->allocateGraphicsMemory(1024, 4096);
+    auto dummyAllocation = mm->allocateGraphicsMemory(1024, 4096);
+    LinearStream cs(commandBuffer);
+
+    testedCsr.addBatchBufferEnd(cs, nullptr);
+    testedCsr.alignToCacheLine(cs);
+
+    ResidencyContainer allocationsForResidency;
+    allocationsForResidency.push_back(dummyAllocation);
+
+    BatchBuffer batchBuffer{cs.getGraphicsAllocation(), 0, false, false, cs.getUsed(), &cs};
+    testedCsr.flush(batchBuffer, EngineType::ENGINE_RCS, &allocationsForResidency);
+
+    uint64_t flags = I915_EXEC_RENDER | I915_EXEC_NO_RELOC | I915_EXEC_HANDLE_LUT | I915_EXEC_BATCH_FIRST;
     EXPECT_EQ(flags, this->mock->execBuffer.flags);
+    EXPECT_EQ(2u, this->mock->execBuffer.buffer_count);
+
+    auto execObjects = reinterpret_cast<drm_i915_gem_exec_object2 *>(this->mock->execBuffer.buffers_ptr);
+    EXPECT_EQ(static_cast<uint32_t>(commandBuffer->getBO()->peekHandle()), execObjects[0].handle);
+    EXPECT_EQ(static_cast<uint32_t>(dummyAllocation->getBO()->peekHandle()), execObjects[1].handle);
 
     mm->freeGraphicsMemory(dummyAllocation);
     mm->freeGraphicsMemory(commandBuffer);
+    mock->overrideExecBatchFirstSupported(false);
 }
+#endif
 
 TEST_F(DrmCommandStreamBatchingTests, givenCsrWhenDispatchPolicyIsSetToBatchingThenCommandBufferIsNotSubmitted) {
     tCsr->overrideDispatchPolicy(CommandStreamReceiver::DispatchMode::BatchedDispatch);
@@ -1338,6 +1402,32 @@ TEST_F(DrmCommandStreamLeaksTest, GivenAllocationsContainingDifferentCountOfFrag
     EXPECT_EQ(0u, hostPtrManager.getFragmentCount());
 }
 
+TEST_F(DrmCommandStreamLeaksTest, GivenAllocationsSharingSlabWhenTheyAreMadeResidentThenSlabObjectIsAddedOnce) {
+    auto buffer = this->createBO(4 * MemoryConstants::pageSize);
+    DrmSlab slab(buffer, buffer->peekAddress(), buffer->peekSize());
+    auto allocation1 = new DrmAllocation(buffer, nullptr, MemoryConstants::pageSize, &slab);
+    auto allocation2 = new DrmAllocation(buffer, nullptr, MemoryConstants::pageSize, &slab);
+
+    csr->makeResident(*allocation1);
+    csr->makeResident(*allocation2);
+    csr->processResidency(nullptr);
+
+    EXPECT_EQ(1u, tCsr->getResidencyVector()->size());
+    EXPECT_TRUE(isResident(buffer));
+    EXPECT_TRUE(slab.resident);
+    EXPECT_EQ(2u, buffer->getRefCount());
+
+    csr->makeNonResident(*allocation1);
+    csr->makeNonResident(*allocation2);
+    EXPECT_FALSE(isResident(buffer));
+    EXPECT_FALSE(slab.resident);
+    EXPECT_EQ(1u, buffer->getRefCount());
+
+    delete allocation1;
+    delete allocation2;
+    mm->unreference(buffer);
+}
+
 TEST_F(DrmCommandStreamLeaksTest, makeResidentSizeZero) {
     std::unique_ptr<BufferObject> buffer(this->createBO(0));
     auto allocation = DrmAllocation(buffer.get(), nullptr, buffer->peekSize());
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/linux/drm_buffer_object.h"
+#include "runtime/os_interface/linux/drm_exec_object_table.h"
+#include "unit_tests/os_interface/linux/device_command_stream_fixture.h"
+#include "test.h"
+
+#include <memory>
+
+using namespace OCLRT;
+
+class ExecObjectTableBufferObject : public BufferObject {
+  public:
+    ExecObjectTableBufferObject(Drm *drm, int handle) : BufferObject(drm, handle, true) {
+    }
+};
+
+class DrmExecObjectTableTest : public ::testing::Test {
+  public:
+    void SetUp() override {
+        mock.reset(new DrmMockCustom);
+        for (int i = 0; i < 4; i++) {
+            bos[i].reset(new ExecObjectTableBufferObject(mock.get(), i + 1));
+        }
+        batchBuffer.reset(new ExecObjectTableBufferObject(mock.get(), 100));
+    }
+
+    void submit(DrmExecObjectTable &table, std::initializer_list<int> resident) {
+        table.beginSubmission();
+        for (auto id : resident) {
+            table.add(bos[id].get());
+        }
+        execObjects = table.finishSubmission(batchBuffer.get(), execObjectsCount);
+    }
+
+    bool isSubmitted(BufferObject *bo) {
+        uint32_t found = 0;
+        for (uint32_t i = 0; i < execObjectsCount; i++) {
+            found += execObjects[i].handle == static_cast<uint32_t>(bo->peekHandle()) ? 1 : 0;
+        }
+        return found == 1;
+    }
+
+    std::unique_ptr<DrmMockCustom> mock;
+    std::unique_ptr<ExecObjectTableBufferObject> bos[4];
+    std::unique_ptr<ExecObjectTableBufferObject> batchBuffer;
+    drm_i915_gem_exec_object2 *execObjects = nullptr;
+    uint32_t execObjectsCount = 0;
+};
+
+TEST_F(DrmExecObjectTableTest, givenSameObjectsInConsecutiveSubmissionsWhenSubmittedThenEntriesAreFilledOnce) {
+    DrmExecObjectTable table(false);
+
+    submit(table, {0, 1, 2});
+    EXPECT_EQ(4u, execObjectsCount);
+    EXPECT_EQ(3u, table.peekFilledEntries());
+
+    submit(table, {2, 0, 1});
+    EXPECT_EQ(4u, execObjectsCount);
+    EXPECT_EQ(3u, table.peekFilledEntries());
+
+    EXPECT_TRUE(isSubmitted(bos[0].get()));
+    EXPECT_TRUE(isSubmitted(bos[1].get()));
+    EXPECT_TRUE(isSubmitted(bos[2].get()));
+    EXPECT_EQ(static_cast<uint32_t>(batchBuffer->peekHandle()), execObjects[execObjectsCount - 1].handle);
+}
+
+TEST_F(DrmExecObjectTableTest, givenObjectNotResidentAnymoreWhenSubmittedThenOnlyItsEntryIsRemoved) {
+    DrmExecObjectTable table(false);
+
+    submit(table, {0, 1, 2});
+    submit(table, {0, 2, 3});
+
+    EXPECT_EQ(4u, execObjectsCount);
+    EXPECT_EQ(3u, table.peekObjectsCount());
+    EXPECT_EQ(4u, table.peekFilledEntries());
+    EXPECT_TRUE(isSubmitted(bos[0].get()));
+    EXPECT_FALSE(isSubmitted(bos[1].get()));
+    EXPECT_TRUE(isSubmitted(bos[2].get()));
+    EXPECT_TRUE(isSubmitted(bos[3].get()));
+
+    //object coming back gets a new entry
+    submit(table, {1});
+    EXPECT_EQ(2u, execObjectsCount);
+    EXPECT_EQ(5u, table.peekFilledEntries());
+    EXPECT_TRUE(isSubmitted(bos[1].get()));
+}
+
+TEST_F(DrmExecObjectTableTest, givenObjectAddedTwiceWhenSubmittedThenItIsListedOnce) {
+    DrmExecObjectTable table(false);
+
+    submit(table, {0, 0, 1});
+
+    EXPECT_EQ(3u, execObjectsCount);
+    EXPECT_TRUE(isSubmitted(bos[0].get()));
+}
+
+TEST_F(DrmExecObjectTableTest, givenBatchBufferAmongResidentObjectsWhenSubmittedThenItIsListedOnceAsBatch) {
+    DrmExecObjectTable table(false);
+
+    table.beginSubmission();
+    table.add(bos[0].get());
+    table.add(batchBuffer.get());
+    table.add(bos[1].get());
+    execObjects = table.finishSubmission(batchBuffer.get(), execObjectsCount);
+
+    EXPECT_EQ(3u, execObjectsCount);
+    EXPECT_TRUE(isSubmitted(batchBuffer.get()));
+    EXPECT_EQ(static_cast<uint32_t>(batchBuffer->peekHandle()), execObjects[execObjectsCount - 1].handle);
+    EXPECT_TRUE(isSubmitted(bos[0].get()));
+    EXPECT_TRUE(isSubmitted(bos[1].get()));
+}
+
+TEST_F(DrmExecObjectTableTest, givenBatchFirstTableWhenSubmittedThenBatchBufferIsFirstObject) {
+    DrmExecObjectTable table(true);
+
+    submit(table, {0, 1});
+    EXPECT_EQ(3u, execObjectsCount);
+    EXPECT_EQ(static_cast<uint32_t>(batchBuffer->peekHandle()), execObjects[0].handle);
+
+    submit(table, {1, 2});
+    EXPECT_EQ(3u, execObjectsCount);
+    EXPECT_EQ(static_cast<uint32_t>(batchBuffer->peekHandle()), execObjects[0].handle);
+    EXPECT_FALSE(isSubmitted(bos[0].get()));
+    EXPECT_TRUE(isSubmitted(bos[1].get()));
+    EXPECT_TRUE(isSubmitted(bos[2].get()));
+}
@@ -48,6 +48,8 @@ class DrmMockForWorker : public Drm {
     std::mutex mutex;
     std::atomic<int> gem_close_cnt;
     std::atomic<int> gem_close_expected;
+    std::atomic<int> gem_wait_cnt{0};
+    std::atomic<bool> ioctl_pending{false};
     std::atomic<std::thread::id> ioctl_caller_thread_id;
     DrmMockForWorker() : Drm(33) {
     }
@@ -55,10 +57,13 @@ class DrmMockForWorker : public Drm {
         if (_IOC_TYPE(request) == DRM_IOCTL_BASE) {
             //when drm ioctl is called, try acquire mutex
             //main thread can hold mutex, to prevent ioctl handling
+            ioctl_pending = true;
             std::lock_guard<std::mutex> lock(mutex);
         }
         if (request == DRM_IOCTL_GEM_CLOSE)
             gem_close_cnt++;
+        if (request == DRM_IOCTL_I915_GEM_WAIT)
+            gem_wait_cnt++;
 
         ioctl_caller_thread_id = std::this_thread::get_id();
 
@@ -179,3 +184,47 @@ TEST_F(DrmGemCloseWorkerTests, givenAllocationWhenAskedForUnreferenceWithForceFl
 
     delete worker;
 }
+
+TEST_F(DrmGemCloseWorkerTests, givenAllocationsPushedWhileWorkerWaitsWhenWaitCompletesThenTheyAreReleasedInOneBatchAfterEachIsWaitedOn) {
+    this->drmMock->gem_close_expected = 3;
+
+    auto worker = new DrmGemCloseWorker(*mm);
+
+    std::unique_lock<std::mutex> ioctlLock(drmMock->mutex);
+    worker->push(new DrmAllocationWrapper(new BufferObjectWrapper(this->drmMock, 1)));
+
+    //wait until worker is blocked on the wait for the first allocation
+    while (!drmMock->ioctl_pending && (deadCnt-- > 0))
+        pthread_yield();
+
+    worker->push(new DrmAllocationWrapper(new BufferObjectWrapper(this->drmMock, 2)));
+    worker->push(new DrmAllocationWrapper(new BufferObjectWrapper(this->drmMock, 3)));
+    EXPECT_EQ(3u, worker->getStatistics().peakQueueDepth);
+    ioctlLock.unlock();
+
+    worker->close(true);
+
+    auto statistics = worker->getStatistics();
+    EXPECT_EQ(0u, statistics.queueDepth);
+    EXPECT_EQ(3u, statistics.processed);
+    EXPECT_EQ(2u, statistics.batches);
+    EXPECT_EQ(3, drmMock->gem_wait_cnt.load());
+
+    delete worker;
+}
+
+TEST_F(DrmGemCloseWorkerTests, givenMultipleWorkerThreadsWhenAllocationsArePushedThenAllAreReleased) {
+    const int allocationCount = 16;
+    this->drmMock->gem_close_expected = allocationCount;
+
+    auto worker = new DrmGemCloseWorker(*mm, 3);
+    for (int i = 0; i < allocationCount; i++) {
+        worker->push(new DrmAllocationWrapper(new BufferObjectWrapper(this->drmMock, i + 1)));
+    }
+    worker->close(true);
+
+    EXPECT_TRUE(worker->isEmpty());
+    EXPECT_EQ(static_cast<uint64_t>(allocationCount), worker->getStatistics().processed);
+
+    delete worker;
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/linux/drm_memory_budget.h"
+#include "test.h"
+
+using namespace OCLRT;
+
+TEST(DrmMemoryBudgetTest, GivenTrackedObjectsWhenStateIsQueriedThenUsageIsReportedPerType) {
+    DrmMemoryBudget budget(0);
+    budget.track(BUDGET_USAGE_SYSTEM, 0x3000);
+    budget.track(BUDGET_USAGE_IMAGE, 0x10000);
+    budget.track(BUDGET_USAGE_HOST_PTR, 0x1000);
+    budget.untrack(BUDGET_USAGE_IMAGE, 0x10000);
+
+    auto state = budget.getState();
+    EXPECT_EQ(0u, state.budget);
+    EXPECT_EQ(0x4000u, state.used);
+    EXPECT_EQ(0x14000u, state.peakUsed);
+    EXPECT_EQ(0x3000u, state.usedByType[BUDGET_USAGE_SYSTEM]);
+    EXPECT_EQ(0x1000u, state.usedByType[BUDGET_USAGE_HOST_PTR]);
+    EXPECT_EQ(0u, state.usedByType[BUDGET_USAGE_IMAGE]);
+    EXPECT_EQ(0u, state.usedByType[BUDGET_USAGE_32BIT]);
+    EXPECT_EQ(0u, state.usedByType[BUDGET_USAGE_SHARED]);
+}
+
+TEST(DrmMemoryBudgetTest, GivenBudgetWhenUsageApproachesItThenBytesOverBudgetAreReported) {
+    DrmMemoryBudget disabled(0);
+    disabled.track(BUDGET_USAGE_SYSTEM, 0x100000);
+    EXPECT_FALSE(disabled.isExceeded(0x100000));
+
+    DrmMemoryBudget budget(0x10000);
+    budget.track(BUDGET_USAGE_SYSTEM, 0xc000);
+    EXPECT_FALSE(budget.isExceeded(0));
+    EXPECT_FALSE(budget.isExceeded(0x4000));
+    EXPECT_EQ(0x1000u, budget.getBytesOverBudget(0x5000));
+
+    budget.recordTrim(0x2000);
+    budget.recordTrim(0);
+    auto state = budget.getState();
+    EXPECT_EQ(0x10000u, state.budget);
+    EXPECT_EQ(2u, state.trims);
+    EXPECT_EQ(0x2000u, state.trimmedBytes);
+}
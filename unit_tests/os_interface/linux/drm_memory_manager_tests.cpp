@@ -72,6 +72,21 @@ int munmapMock(void *addr, size_t length) noexcept {
     return 0;
 }
 
+static int madviseMockCallCount = 0;
+static int madviseMockAdvice = 0;
+
+int madviseMock(void *addr, size_t length, int advice) noexcept {
+    madviseMockCallCount++;
+    madviseMockAdvice = advice;
+    return 0;
+}
+
+void *mmapFailingMock(void *addr, size_t length, int prot, int flags,
+                      int fd, long offset) noexcept {
+    mmapMockCallCount++;
+    return MAP_FAILED;
+}
+
 int closeMock(int) {
     return 0;
 }
@@ -83,20 +98,24 @@ class TestedDrmMemoryManager : public DrmMemoryManager {
         this->mmapFunction = &mmapMock;
         this->munmapFunction = &munmapMock;
         this->closeFunction = &closeMock;
+        this->madviseFunction = &madviseMock;
         lseekReturn = 4096;
         lseekCalledCount = 0;
         mmapMockCallCount = 0;
         munmapMockCallCount = 0;
+        madviseMockCallCount = 0;
     };
     TestedDrmMemoryManager(Drm *drm, bool allowForcePin) : DrmMemoryManager(drm, gemCloseWorkerMode::gemCloseWorkerConsumingCommandBuffers, allowForcePin) {
         this->lseekFunction = &lseekMock;
         this->mmapFunction = &mmapMock;
         this->munmapFunction = &munmapMock;
         this->closeFunction = &closeMock;
+        this->madviseFunction = &madviseMock;
         lseekReturn = 4096;
         lseekCalledCount = 0;
         mmapMockCallCount = 0;
         munmapMockCallCount = 0;
+        madviseMockCallCount = 0;
     }
 
     void unreference(BufferObject *bo) {
@@ -107,6 +126,7 @@ class TestedDrmMemoryManager : public DrmMemoryManager {
         return DrmMemoryManager::allocUserptr(address, size, flags, softpin);
     }
     DrmGemCloseWorker *getgemCloseWorker() { return this->gemCloseWorker.get(); }
+    using DrmMemoryManager::mmapFunction;
 };
 
 class DrmMemoryManagerFixture : public MemoryManagementFixture {
@@ -578,6 +598,259 @@ TEST_F(DrmMemoryManagerTest, GivenMisalignedHostPtrAndMultiplePagesSizeWhenAsked
     EXPECT_EQ(0u, hostPtrManager.getFragmentCount());
 }
 
+TEST_F(DrmMemoryManagerTest, GivenUserptrCacheEnabledWhenSameHostPtrIsAllocatedAgainThenCachedBufferObjectsAreReused) {
+    DebugManagerStateRestore dbgRestorer;
+    DebugManager.flags.UserptrCacheMaxEntries.set(8);
+    // 3 fragments: userptr on first allocation, wait + close when the cache is destroyed
+    mock->ioctl_expected = 9;
+    auto mm = new (std::nothrow) TestedDrmMemoryManager(this->mock);
+    ASSERT_NE(nullptr, mm);
+    mm->getgemCloseWorker()->close(true);
+    auto cache = mm->peekUserptrCache();
+    ASSERT_NE(nullptr, cache);
+
+    auto ptr = (void *)0x1001;
+    auto size = MemoryConstants::pageSize * 10;
+    auto graphicsAllocation = mm->allocateGraphicsMemory(size, ptr);
+    ASSERT_NE(nullptr, graphicsAllocation);
+    BufferObject *bos[max_fragments_count];
+    for (int i = 0; i < max_fragments_count; i++) {
+        bos[i] = graphicsAllocation->fragmentsStorage.fragmentStorageData[i].osHandleStorage->bo;
+    }
+    mm->freeGraphicsMemory(graphicsAllocation);
+    EXPECT_EQ(0u, mm->hostPtrManager.getFragmentCount());
+    EXPECT_EQ(3u, cache->peekNumEntries());
+    EXPECT_EQ(3, mock->ioctl_cnt);
+
+    graphicsAllocation = mm->allocateGraphicsMemory(size, ptr);
+    ASSERT_NE(nullptr, graphicsAllocation);
+    for (int i = 0; i < max_fragments_count; i++) {
+        EXPECT_EQ(bos[i], graphicsAllocation->fragmentsStorage.fragmentStorageData[i].osHandleStorage->bo);
+    }
+    EXPECT_EQ(3u, cache->peekHits());
+    EXPECT_EQ(0u, cache->peekNumEntries());
+    mm->freeGraphicsMemory(graphicsAllocation);
+    EXPECT_EQ(3, mock->ioctl_cnt);
+
+    delete mm;
+}
+
+TEST_F(DrmMemoryManagerTest, GivenUserptrCacheEnabledWhenDriverMemoryBackingCachedHostPtrIsFreedThenCachedBufferObjectIsReleased) {
+    DebugManagerStateRestore dbgRestorer;
+    DebugManager.flags.UserptrCacheMaxEntries.set(8);
+    // backing allocation: userptr, wait, close; host ptr fragment: userptr, then wait + close on invalidation
+    mock->ioctl_expected = 6;
+    auto mm = new (std::nothrow) TestedDrmMemoryManager(this->mock);
+    ASSERT_NE(nullptr, mm);
+    mm->getgemCloseWorker()->close(true);
+    auto cache = mm->peekUserptrCache();
+    ASSERT_NE(nullptr, cache);
+
+    auto backingAllocation = mm->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, backingAllocation);
+    auto hostPtrAllocation = mm->allocateGraphicsMemory(MemoryConstants::pageSize, backingAllocation->getUnderlyingBuffer());
+    ASSERT_NE(nullptr, hostPtrAllocation);
+    mm->freeGraphicsMemory(hostPtrAllocation);
+    EXPECT_EQ(1u, cache->peekNumEntries());
+
+    mm->freeGraphicsMemory(backingAllocation);
+    EXPECT_EQ(0u, cache->peekNumEntries());
+
+    delete mm;
+}
+
+TEST_F(DrmMemoryManagerTest, GivenSlabAllocatorEnabledWhenSmallAllocationsAreCreatedThenTheyShareOneBufferObject) {
+    DebugManagerStateRestore dbgRestorer;
+    DebugManager.flags.SlabAllocationMaxSizeKB.set(64);
+    // slab: userptr on first allocation, close on destruction, unused allocations are released without a wait
+    // large allocation: userptr, wait, close
+    mock->ioctl_expected = 5;
+    auto mm = new (std::nothrow) TestedDrmMemoryManager(this->mock);
+    ASSERT_NE(nullptr, mm);
+    mm->getgemCloseWorker()->close(true);
+    ASSERT_NE(nullptr, mm->peekSlabAllocator());
+
+    auto allocation1 = mm->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation1);
+    auto allocation2 = mm->allocateGraphicsMemory(1024, MemoryConstants::preferredAlignment);
+    ASSERT_NE(nullptr, allocation2);
+    EXPECT_EQ(1, mock->ioctl_cnt);
+
+    ASSERT_NE(nullptr, allocation1->peekSlab());
+    EXPECT_EQ(allocation1->peekSlab(), allocation2->peekSlab());
+    EXPECT_EQ(allocation1->getBO(), allocation2->getBO());
+    EXPECT_EQ(3u, allocation1->getBO()->getRefCount());
+    EXPECT_NE(allocation1->getUnderlyingBuffer(), allocation2->getUnderlyingBuffer());
+    EXPECT_EQ(MemoryConstants::pageSize, allocation2->getUnderlyingBufferSize());
+    EXPECT_EQ(reinterpret_cast<uint64_t>(allocation2->getUnderlyingBuffer()), allocation2->getGpuAddress());
+
+    auto largeAllocation = mm->allocateGraphicsMemory(128 * MemoryConstants::kiloByte, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, largeAllocation);
+    EXPECT_EQ(nullptr, largeAllocation->peekSlab());
+    EXPECT_NE(allocation1->getBO(), largeAllocation->getBO());
+
+    auto slabBo = allocation1->getBO();
+    mm->freeGraphicsMemory(allocation1);
+    mm->freeGraphicsMemory(allocation2);
+    mm->freeGraphicsMemory(largeAllocation);
+    EXPECT_EQ(1u, slabBo->getRefCount());
+    EXPECT_EQ(1u, mm->peekSlabAllocator()->peekNumSlabs());
+
+    delete mm;
+}
+
+TEST_F(DrmMemoryManagerTest, GivenSlabAllocationUsedBySubmissionWhenFreedThenRangeIsReleasedOnlyAfterItsTaskCountCompletes) {
+    DebugManagerStateRestore dbgRestorer;
+    DebugManager.flags.SlabAllocationMaxSizeKB.set(64);
+    // slab: userptr on first allocation, close on destruction
+    mock->ioctl_expected = 2;
+    auto pDevice = Device::create<OCLRT::MockDevice>(nullptr);
+    ASSERT_NE(nullptr, pDevice);
+    auto mm = new (std::nothrow) TestedDrmMemoryManager(this->mock);
+    ASSERT_NE(nullptr, mm);
+    mm->getgemCloseWorker()->close(true);
+    mm->device = pDevice;
+    *pDevice->getTagAddress() = 1;
+
+    auto busyAllocation = mm->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, busyAllocation);
+    auto siblingAllocation = mm->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, siblingAllocation);
+    auto slabBo = busyAllocation->getBO();
+    auto busyRange = busyAllocation->getUnderlyingBuffer();
+    busyAllocation->taskCount = 2;
+
+    mm->freeGraphicsMemory(busyAllocation);
+    EXPECT_EQ(1u, mm->peekNumPendingSlabAllocations());
+    EXPECT_EQ(3u, slabBo->getRefCount());
+
+    auto allocation = mm->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation);
+    EXPECT_NE(busyRange, allocation->getUnderlyingBuffer());
+    EXPECT_EQ(1u, mm->peekNumPendingSlabAllocations());
+    mm->freeGraphicsMemory(allocation);
+
+    *pDevice->getTagAddress() = 2;
+    allocation = mm->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation);
+    EXPECT_EQ(0u, mm->peekNumPendingSlabAllocations());
+    EXPECT_EQ(3u, slabBo->getRefCount());
+
+    mm->freeGraphicsMemory(allocation);
+    mm->freeGraphicsMemory(siblingAllocation);
+    EXPECT_EQ(1u, slabBo->getRefCount());
+
+    mm->device = nullptr;
+    delete mm;
+    delete pDevice;
+}
+
+TEST_F(DrmMemoryManagerTest, GivenAllocationsWhenMemoryBudgetStateIsQueriedThenBufferObjectsAreAccountedPerType) {
+    // system allocation and host ptr fragment: userptr, wait, close each
+    mock->ioctl_expected = 6;
+
+    auto allocation = memoryManager->allocateGraphicsMemory(3 * MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation);
+    auto hostPtrAllocation = memoryManager->allocateGraphicsMemory(MemoryConstants::pageSize, reinterpret_cast<void *>(0x1000));
+    ASSERT_NE(nullptr, hostPtrAllocation);
+
+    auto state = memoryManager->getMemoryBudgetState();
+    EXPECT_EQ(0u, state.budget);
+    EXPECT_EQ(4 * MemoryConstants::pageSize, state.used);
+    EXPECT_EQ(3 * MemoryConstants::pageSize, state.usedByType[BUDGET_USAGE_SYSTEM]);
+    EXPECT_EQ(MemoryConstants::pageSize, state.usedByType[BUDGET_USAGE_HOST_PTR]);
+    EXPECT_FALSE(memoryManager->isMemoryBudgetExhausted());
+
+    memoryManager->freeGraphicsMemory(allocation);
+    memoryManager->freeGraphicsMemory(hostPtrAllocation);
+
+    state = memoryManager->getMemoryBudgetState();
+    EXPECT_EQ(0u, state.used);
+    EXPECT_EQ(4 * MemoryConstants::pageSize, state.peakUsed);
+    EXPECT_EQ(0u, state.trims);
+}
+
+TEST_F(DrmMemoryManagerTest, GivenMemoryBudgetWhenAllocationWouldExceedItThenIdleReusableAllocationsAreReleased) {
+    DebugManagerStateRestore dbgRestorer;
+    DebugManager.flags.MemoryBudgetMB.set(1);
+    // reusable allocation: userptr, then wait + close when trimmed; new allocation: userptr, wait, close
+    mock->ioctl_expected = 6;
+    auto mm = new (std::nothrow) TestedDrmMemoryManager(this->mock);
+    ASSERT_NE(nullptr, mm);
+    mm->getgemCloseWorker()->close(true);
+
+    auto reusableAllocation = mm->allocateGraphicsMemory(static_cast<size_t>(MemoryConstants::megaByte), MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, reusableAllocation);
+    mm->storeAllocation(std::unique_ptr<GraphicsAllocation>(reusableAllocation), REUSABLE_ALLOCATION);
+    EXPECT_FALSE(mm->isMemoryBudgetExhausted());
+
+    auto allocation = mm->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation);
+    EXPECT_TRUE(mm->allocationsForReuse.peekIsEmpty());
+
+    auto state = mm->getMemoryBudgetState();
+    EXPECT_EQ(MemoryConstants::megaByte, state.budget);
+    EXPECT_EQ(MemoryConstants::pageSize, state.used);
+    EXPECT_EQ(1u, state.trims);
+    EXPECT_EQ(MemoryConstants::megaByte, state.trimmedBytes);
+
+    mm->freeGraphicsMemory(allocation);
+    delete mm;
+}
+
+TEST_F(DrmMemoryManagerTest, GivenHugePageThresholdWhenLargeAllocationIsCreatedThenItIsBackedByHugePageAlignedMapping) {
+    DebugManagerStateRestore dbgRestorer;
+    DebugManager.flags.HugePageAllocationThresholdMB.set(2);
+    // large allocation: userptr, wait, close
+    mock->ioctl_expected = 3;
+    auto mm = new (std::nothrow) TestedDrmMemoryManager(this->mock);
+    ASSERT_NE(nullptr, mm);
+    mm->getgemCloseWorker()->close(true);
+
+    auto size = 3 * MemoryConstants::megaByte;
+    auto allocation = mm->allocateGraphicsMemory(static_cast<size_t>(size), MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(allocation->getUnderlyingBuffer()) & (2 * MemoryConstants::megaByte - 1));
+    EXPECT_EQ(size, allocation->getUnderlyingBufferSize());
+    EXPECT_EQ(1, mmapMockCallCount);
+    // mock mapping at 0x1000: the unaligned head and the tail beyond whole huge pages are unmapped
+    EXPECT_EQ(2, munmapMockCallCount);
+    EXPECT_EQ(1, madviseMockCallCount);
+    EXPECT_EQ(MADV_HUGEPAGE, madviseMockAdvice);
+    EXPECT_EQ(4 * MemoryConstants::megaByte, allocation->getBO()->peekUnmapSize());
+
+    mm->freeGraphicsMemory(allocation);
+    EXPECT_EQ(3, munmapMockCallCount);
+    delete mm;
+}
+
+TEST_F(DrmMemoryManagerTest, GivenHugePageThresholdWhenMappingFailsOrAllocationIsSmallThenAlignedMallocIsUsed) {
+    DebugManagerStateRestore dbgRestorer;
+    DebugManager.flags.HugePageAllocationThresholdMB.set(2);
+    // two allocations: userptr, wait, close each
+    mock->ioctl_expected = 6;
+    auto mm = new (std::nothrow) TestedDrmMemoryManager(this->mock);
+    ASSERT_NE(nullptr, mm);
+    mm->getgemCloseWorker()->close(true);
+
+    auto smallAllocation = mm->allocateGraphicsMemory(MemoryConstants::megaByte, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, smallAllocation);
+    EXPECT_EQ(0, mmapMockCallCount);
+    EXPECT_EQ(0u, smallAllocation->getBO()->peekUnmapSize());
+
+    mm->mmapFunction = &mmapFailingMock;
+    auto largeAllocation = mm->allocateGraphicsMemory(2 * MemoryConstants::megaByte, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, largeAllocation);
+    EXPECT_EQ(1, mmapMockCallCount);
+    EXPECT_EQ(0, madviseMockCallCount);
+    EXPECT_EQ(0u, largeAllocation->getBO()->peekUnmapSize());
+
+    mm->freeGraphicsMemory(smallAllocation);
+    mm->freeGraphicsMemory(largeAllocation);
+    EXPECT_EQ(0, munmapMockCallCount);
+    delete mm;
+}
+
 TEST_F(DrmMemoryManagerTest, testProfilingAllocatorCleanup) {
     mock->ioctl_expected = -1; //don't care
     MemoryManager *memMngr = memoryManager;
@@ -998,6 +1271,26 @@ TEST_F(DrmMemoryManagerTest, GivenMemoryManagerWhenAllocateGraphicsMemoryForImag
     EXPECT_EQ(1, munmapMockCallCount);
 }
 
+TEST_F(DrmMemoryManagerTest, givenFailingGpuRangeReservationWhenTiledImageIsAllocatedThenNullptrIsReturnedAndNoBufferObjectIsCreated) {
+    mock->ioctl_expected = 0;
+    cl_image_desc imgDesc = {};
+    imgDesc.image_type = CL_MEM_OBJECT_IMAGE2D; // tiled
+    imgDesc.image_width = 512;
+    imgDesc.image_height = 512;
+    auto imgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+    imgInfo.imgDesc = &imgDesc;
+    imgInfo.size = 4096u;
+    imgInfo.rowPitch = 512u;
+
+    memoryManager->mmapFunction = &mmapFailingMock;
+    auto queryGmm = MockGmm::queryImgParams(imgInfo);
+    auto imageGraphicsAllocation = memoryManager->allocateGraphicsMemoryForImage(imgInfo, queryGmm.get());
+
+    EXPECT_EQ(nullptr, imageGraphicsAllocation);
+    EXPECT_EQ(1, mmapMockCallCount);
+    EXPECT_EQ(0, munmapMockCallCount);
+}
+
 TEST_F(DrmMemoryManagerTest, givenDrmMemoryManagerWhenTiledImageIsBeingCreatedThenallocateGraphicsMemoryForImageIsUsed) {
     //GEM CREATE + SET_TILING + WAIT + CLOSE
     mock->ioctl_expected = 4;
@@ -1342,6 +1635,53 @@ TEST_F(DrmMemoryManagerTest, givenNon32BitAddressingWhenBufferFromSharedHandleIs
     EXPECT_EQ(1, munmapMockCallCount);
 }
 
+TEST_F(DrmMemoryManagerTest, givenFailingGpuRangeReservationWhenBufferFromSharedHandleIsCreatedThenNullptrIsReturned) {
+    memoryManager->setForce32BitAllocations(false);
+    osHandle handle = 1u;
+    //DRM_IOCTL_PRIME_FD_TO_HANDLE
+    mock->ioctl_expected = 1;
+    this->mock->outputHandle = 2u;
+    memoryManager->mmapFunction = &mmapFailingMock;
+    auto graphicsAllocation = memoryManager->createGraphicsAllocationFromSharedHandle(handle, false);
+    EXPECT_EQ(nullptr, graphicsAllocation);
+    EXPECT_EQ(1, mmapMockCallCount);
+    EXPECT_EQ(0, munmapMockCallCount);
+}
+
+TEST_F(DrmMemoryManagerTest, givenPaddedAllocationWhenCreatedThenBufferObjectIsSoftpinnedAtReservedRangeAndRangeIsReleasedOnFree) {
+    //USERPTR x 2 + WAIT x 2 + CLOSE x 2
+    mock->ioctl_expected = 6;
+    auto inputAllocation = memoryManager->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, inputAllocation);
+
+    auto paddedAllocation = static_cast<DrmAllocation *>(memoryManager->createPaddedAllocation(inputAllocation, 2 * MemoryConstants::pageSize));
+    ASSERT_NE(nullptr, paddedAllocation);
+    EXPECT_EQ(1, mmapMockCallCount);
+    EXPECT_EQ(0x1000u, paddedAllocation->getGpuAddress());
+    EXPECT_EQ(reinterpret_cast<void *>(0x1000), paddedAllocation->getBO()->peekAddress());
+    EXPECT_EQ(2 * MemoryConstants::pageSize, paddedAllocation->getBO()->peekUnmapSize());
+    EXPECT_EQ(MMAP_ALLOCATOR, paddedAllocation->getBO()->peekAllocationType());
+
+    memoryManager->freeGraphicsMemory(paddedAllocation);
+    EXPECT_EQ(1, munmapMockCallCount);
+    memoryManager->freeGraphicsMemory(inputAllocation);
+}
+
+TEST_F(DrmMemoryManagerTest, givenFailingGpuRangeReservationWhenPaddedAllocationIsCreatedThenNullptrIsReturnedAndNoUserptrIsCreated) {
+    //USERPTR + WAIT + CLOSE
+    mock->ioctl_expected = 3;
+    auto inputAllocation = memoryManager->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, inputAllocation);
+
+    memoryManager->mmapFunction = &mmapFailingMock;
+    auto paddedAllocation = memoryManager->createPaddedAllocation(inputAllocation, 2 * MemoryConstants::pageSize);
+    EXPECT_EQ(nullptr, paddedAllocation);
+    EXPECT_EQ(1, mmapMockCallCount);
+    EXPECT_EQ(0, munmapMockCallCount);
+
+    memoryManager->freeGraphicsMemory(inputAllocation);
+}
+
 TEST_F(DrmMemoryManagerTest, givenDrmMemoryManagerWhenCreateAllocationFromNtHandleIsCalledThenReturnNullptr) {
     auto graphicsAllocation = memoryManager->createGraphicsAllocationFromNTHandle((void *)1);
     EXPECT_EQ(nullptr, graphicsAllocation);
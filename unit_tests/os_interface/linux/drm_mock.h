@@ -140,6 +140,12 @@ class Drm2 : public Drm {
                 *((int *)(gp->value)) = this->StoredExecSoftPin;
                 return this->StoredRetVal;
             }
+#if defined(I915_PARAM_HAS_EXEC_BATCH_FIRST)
+            if (gp->param == I915_PARAM_HAS_EXEC_BATCH_FIRST) {
+                *((int *)(gp->value)) = this->StoredExecBatchFirst;
+                return this->StoredRetVal;
+            }
+#endif
         }
 #if defined(I915_PARAM_HAS_PREEMPTION)
         if ((request == DRM_IOCTL_I915_GEM_CONTEXT_CREATE) && (arg != nullptr)) {
@@ -265,6 +271,7 @@ class Drm2 : public Drm {
     int StoredRetValForPooledEU = 0;
     int StoredRetValForMinEUinPool = 0;
     int StoredDisableCoherencyPatchActive = 1;
+    int StoredExecBatchFirst = 1;
     int StoredPPGTT = 3;
     int StoredPreemptionSupport = 1;
     int StoredMockPreemptionSupport = 0;
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/linux/drm_buffer_object.h"
+#include "runtime/os_interface/linux/drm_slab_allocator.h"
+#include "test.h"
+
+#include <memory>
+
+using namespace OCLRT;
+
+class SlabBufferObject : public BufferObject {
+  public:
+    SlabBufferObject(uintptr_t address, size_t size) : BufferObject(nullptr, 1, true) {
+        this->address = reinterpret_cast<void *>(address);
+        this->size = size;
+    }
+};
+
+class DrmSlabAllocatorTest : public ::testing::Test {
+  public:
+    BufferObject *createSlabBo(uintptr_t address) {
+        bos.emplace_back(new SlabBufferObject(address, slabSize));
+        return bos.back().get();
+    }
+
+    const size_t slabSize = 16 * MemoryConstants::pageSize;
+    const size_t maxAllocationSize = 4 * MemoryConstants::pageSize;
+    std::vector<std::unique_ptr<SlabBufferObject>> bos;
+    std::vector<BufferObject *> released;
+};
+
+TEST_F(DrmSlabAllocatorTest, GivenSizeAndAlignmentWhenCheckedForSuitabilityThenOnlySmallPageAlignedRequestsAreAccepted) {
+    DrmSlabAllocator allocator(slabSize, maxAllocationSize);
+    EXPECT_TRUE(allocator.isSuitable(MemoryConstants::pageSize, MemoryConstants::pageSize));
+    EXPECT_TRUE(allocator.isSuitable(maxAllocationSize, MemoryConstants::cacheLineSize));
+    EXPECT_FALSE(allocator.isSuitable(maxAllocationSize + MemoryConstants::pageSize, MemoryConstants::pageSize));
+    EXPECT_FALSE(allocator.isSuitable(MemoryConstants::pageSize, MemoryConstants::pageSize64k));
+}
+
+TEST_F(DrmSlabAllocatorTest, GivenNoSlabsWhenAllocatingThenNullIsReturnedAndNewSlabIsUsedForFollowingAllocations) {
+    DrmSlabAllocator allocator(slabSize, maxAllocationSize);
+    DrmSlab *slab = nullptr;
+    size_t size = MemoryConstants::pageSize;
+    EXPECT_EQ(nullptr, allocator.allocate(size, slab));
+    EXPECT_EQ(nullptr, slab);
+
+    auto bo = createSlabBo(0x100000);
+    auto ptr1 = allocator.allocateFromNewSlab(bo, size, slab);
+    ASSERT_NE(nullptr, ptr1);
+    ASSERT_NE(nullptr, slab);
+    EXPECT_EQ(bo, slab->bo);
+    EXPECT_EQ(1u, allocator.peekNumSlabs());
+
+    DrmSlab *slab2 = nullptr;
+    size_t size2 = 3 * MemoryConstants::pageSize - 1;
+    auto ptr2 = allocator.allocate(size2, slab2);
+    ASSERT_NE(nullptr, ptr2);
+    EXPECT_EQ(slab, slab2);
+    EXPECT_EQ(3 * MemoryConstants::pageSize, size2);
+    EXPECT_NE(ptr1, ptr2);
+    EXPECT_EQ(2u, slab->allocationCount);
+    EXPECT_EQ(4 * MemoryConstants::pageSize, slab->usedSize);
+
+    for (auto ptr : {ptr1, ptr2}) {
+        EXPECT_GE(reinterpret_cast<uintptr_t>(ptr), 0x100000u);
+        EXPECT_LT(reinterpret_cast<uintptr_t>(ptr), 0x100000u + slabSize);
+    }
+}
+
+TEST_F(DrmSlabAllocatorTest, GivenFullSlabWhenAllocatingThenNullIsReturned) {
+    DrmSlabAllocator allocator(slabSize, maxAllocationSize);
+    DrmSlab *slab = nullptr;
+    size_t size = maxAllocationSize;
+    ASSERT_NE(nullptr, allocator.allocateFromNewSlab(createSlabBo(0x100000), size, slab));
+    for (int i = 1; i < 4; i++) {
+        size = maxAllocationSize;
+        EXPECT_NE(nullptr, allocator.allocate(size, slab));
+    }
+    size = MemoryConstants::pageSize;
+    EXPECT_EQ(nullptr, allocator.allocate(size, slab));
+}
+
+TEST_F(DrmSlabAllocatorTest, GivenTwoEmptySlabsWhenLastAllocationIsFreedThenOnlyOneSlabIsKept) {
+    DrmSlabAllocator allocator(slabSize, maxAllocationSize);
+    DrmSlab *slab1 = nullptr;
+    DrmSlab *slab2 = nullptr;
+    size_t size1 = MemoryConstants::pageSize;
+    size_t size2 = MemoryConstants::pageSize;
+    auto bo1 = createSlabBo(0x100000);
+    auto bo2 = createSlabBo(0x200000);
+    auto ptr1 = allocator.allocateFromNewSlab(bo1, size1, slab1);
+    auto ptr2 = allocator.allocateFromNewSlab(bo2, size2, slab2);
+    EXPECT_EQ(2u, allocator.peekNumSlabs());
+
+    EXPECT_EQ(nullptr, allocator.free(slab1, ptr1, size1));
+    EXPECT_EQ(2u, allocator.peekNumSlabs());
+    EXPECT_EQ(0u, slab1->usedSize);
+
+    EXPECT_EQ(bo2, allocator.free(slab2, ptr2, size2));
+    EXPECT_EQ(1u, allocator.peekNumSlabs());
+
+    allocator.releaseAll(released);
+    ASSERT_EQ(1u, released.size());
+    EXPECT_EQ(bo1, released[0]);
+    EXPECT_EQ(0u, allocator.peekNumSlabs());
+}
@@ -171,6 +171,27 @@ TEST(DrmTest, GivenMockDrmWhenAskedForCoherencyStatusThatFailsThenFalseIsReturne
     delete pDrm;
 }
 
+#if defined(I915_PARAM_HAS_EXEC_BATCH_FIRST)
+TEST(DrmTest, GivenMockDrmWhenAskedForBatchFirstSupportThenKernelAnswerIsStored) {
+    Drm2 *pDrm = new Drm2;
+    EXPECT_FALSE(pDrm->peekExecBatchFirstSupported());
+
+    pDrm->obtainExecBatchFirstSupported();
+    EXPECT_TRUE(pDrm->peekExecBatchFirstSupported());
+    delete pDrm;
+}
+
+TEST(DrmTest, GivenMockDrmWhenAskedForBatchFirstSupportThatFailsThenFalseIsReturned) {
+    Drm2 *pDrm = new Drm2;
+    pDrm->StoredRetVal = -1;
+
+    pDrm->obtainExecBatchFirstSupported();
+    EXPECT_FALSE(pDrm->peekExecBatchFirstSupported());
+    pDrm->StoredRetVal = 0;
+    delete pDrm;
+}
+#endif
+
 TEST(DrmTest, GivenMockDrmWhenAskedFor48BitAddressCorrectValueReturned) {
     Drm2 *pDrm = new Drm2;
     pDrm->StoredPPGTT = 3;
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/linux/drm_buffer_object.h"
+#include "runtime/os_interface/linux/drm_userptr_cache.h"
+#include "test.h"
+
+#include <memory>
+
+using namespace OCLRT;
+
+class UserptrBufferObject : public BufferObject {
+  public:
+    UserptrBufferObject(uintptr_t address, size_t size) : BufferObject(nullptr, 1, false) {
+        this->address = reinterpret_cast<void *>(address);
+        this->size = size;
+    }
+};
+
+class DrmUserptrCacheTest : public ::testing::Test {
+  public:
+    BufferObject *createBo(uintptr_t address, size_t size) {
+        bos.emplace_back(new UserptrBufferObject(address, size));
+        return bos.back().get();
+    }
+
+    std::vector<std::unique_ptr<UserptrBufferObject>> bos;
+    std::vector<BufferObject *> evicted;
+};
+
+TEST_F(DrmUserptrCacheTest, GivenStoredBufferObjectWhenTakenWithSameAddressAndSizeThenItIsReturnedOnce) {
+    DrmUserptrCache cache(4, 0);
+    auto bo = createBo(0x10000, 0x2000);
+    cache.store(bo, evicted);
+    EXPECT_TRUE(evicted.empty());
+    EXPECT_EQ(1u, cache.peekNumEntries());
+    EXPECT_EQ(0x2000u, cache.peekBytes());
+
+    EXPECT_EQ(nullptr, cache.take(reinterpret_cast<void *>(0x10000), 0x1000));
+    EXPECT_EQ(bo, cache.take(reinterpret_cast<void *>(0x10000), 0x2000));
+    EXPECT_EQ(nullptr, cache.take(reinterpret_cast<void *>(0x10000), 0x2000));
+
+    EXPECT_EQ(1u, cache.peekHits());
+    EXPECT_EQ(2u, cache.peekMisses());
+    EXPECT_EQ(0u, cache.peekNumEntries());
+    EXPECT_EQ(0u, cache.peekBytes());
+}
+
+TEST_F(DrmUserptrCacheTest, GivenFullCacheWhenBufferObjectIsStoredThenLeastRecentlyStoredIsEvicted) {
+    DrmUserptrCache cache(2, 0x3000);
+    auto bo1 = createBo(0x10000, 0x1000);
+    auto bo2 = createBo(0x20000, 0x1000);
+    auto bo3 = createBo(0x30000, 0x1000);
+    auto bo4 = createBo(0x40000, 0x2000);
+
+    cache.store(bo1, evicted);
+    cache.store(bo2, evicted);
+    cache.store(bo3, evicted);
+    ASSERT_EQ(1u, evicted.size());
+    EXPECT_EQ(bo1, evicted[0]);
+
+    cache.store(bo4, evicted);
+    ASSERT_EQ(2u, evicted.size());
+    EXPECT_EQ(bo2, evicted[1]);
+    EXPECT_EQ(0x3000u, cache.peekBytes());
+
+    cache.evictAll(evicted);
+    EXPECT_EQ(4u, evicted.size());
+    EXPECT_EQ(0u, cache.peekNumEntries());
+}
+
+TEST_F(DrmUserptrCacheTest, GivenDisabledCacheOrDuplicateRangeWhenBufferObjectIsStoredThenItIsEvictedImmediately) {
+    DrmUserptrCache disabledCache(0, 0);
+    auto bo = createBo(0x10000, 0x1000);
+    disabledCache.store(bo, evicted);
+    ASSERT_EQ(1u, evicted.size());
+    EXPECT_EQ(bo, evicted[0]);
+
+    DrmUserptrCache cache(4, 0);
+    auto duplicate = createBo(0x10000, 0x1000);
+    cache.store(bo, evicted);
+    cache.store(duplicate, evicted);
+    ASSERT_EQ(2u, evicted.size());
+    EXPECT_EQ(duplicate, evicted[1]);
+    EXPECT_EQ(1u, cache.peekNumEntries());
+}
+
+TEST_F(DrmUserptrCacheTest, GivenCachedRangesWhenMemoryRangeIsInvalidatedThenOnlyOverlappingEntriesAreEvicted) {
+    DrmUserptrCache cache(8, 0);
+    auto before = createBo(0x10000, 0x1000);
+    auto overlappingStart = createBo(0x1f000, 0x4000);
+    auto inside = createBo(0x21000, 0x1000);
+    auto overlappingEnd = createBo(0x23000, 0x2000);
+    auto after = createBo(0x24000, 0x1000);
+    for (auto bo : {before, overlappingStart, inside, overlappingEnd, after}) {
+        cache.store(bo, evicted);
+    }
+
+    cache.invalidate(reinterpret_cast<void *>(0x20000), 0x4000, evicted);
+    EXPECT_EQ(3u, evicted.size());
+    EXPECT_EQ(2u, cache.peekNumEntries());
+    EXPECT_EQ(before, cache.take(reinterpret_cast<void *>(0x10000), 0x1000));
+    EXPECT_EQ(after, cache.take(reinterpret_cast<void *>(0x24000), 0x1000));
+}
+
+TEST_F(DrmUserptrCacheTest, GivenBytesToReleaseWhenLeastRecentlyStoredAreEvictedThenOldestEntriesGoFirst) {
+    DrmUserptrCache cache(8, 0);
+    auto oldest = createBo(0x10000, 0x2000);
+    auto middle = createBo(0x20000, 0x1000);
+    auto newest = createBo(0x30000, 0x1000);
+    for (auto bo : {oldest, middle, newest}) {
+        cache.store(bo, evicted);
+    }
+
+    cache.evictLeastRecentlyStored(0x2001, evicted);
+    ASSERT_EQ(2u, evicted.size());
+    EXPECT_EQ(oldest, evicted[0]);
+    EXPECT_EQ(middle, evicted[1]);
+    EXPECT_EQ(1u, cache.peekNumEntries());
+    EXPECT_EQ(0x1000u, cache.peekBytes());
+}
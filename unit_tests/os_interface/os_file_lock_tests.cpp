@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/os_file_lock.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+using namespace OCLRT;
+
+TEST(OsFileLockTest, givenNotExistingDirectoryWhenLockingThenNullptrIsReturned) {
+    std::unique_ptr<OsFileLock> fileLock(OsFileLock::lock("_not_existing_dir_/file.lock"));
+    EXPECT_EQ(nullptr, fileLock);
+}
+
+TEST(OsFileLockTest, givenLockHeldWhenOtherOwnerLocksSameFileThenItWaitsUntilLockIsReleased) {
+    const char *fileName = "os_file_lock_test.lock";
+    std::unique_ptr<OsFileLock> fileLock(OsFileLock::lock(fileName));
+    ASSERT_NE(nullptr, fileLock);
+    EXPECT_TRUE(fileLock->isLocked());
+
+    std::atomic<bool> otherLocked{false};
+    std::thread other([&] {
+        std::unique_ptr<OsFileLock> otherLock(OsFileLock::lock(fileName));
+        otherLocked = (otherLock != nullptr);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(otherLocked);
+
+    fileLock.reset();
+    other.join();
+    EXPECT_TRUE(otherLocked);
+
+    std::remove(fileName);
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/file_io.h"
+#include "runtime/os_interface/os_mapped_file.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+using namespace OCLRT;
+
+TEST(OsMappedFileTest, givenNotExistingFileWhenOpeningThenNullptrIsReturned) {
+    std::unique_ptr<OsMappedFile> mappedFile(OsMappedFile::open("_not_existing_file_"));
+    EXPECT_EQ(nullptr, mappedFile);
+}
+
+TEST(OsMappedFileTest, givenEmptyFileWhenOpeningThenNullptrIsReturned) {
+    const char *fileName = "os_mapped_file_empty.bin";
+    FILE *fp = nullptr;
+    fopen_s(&fp, fileName, "wb");
+    ASSERT_NE(nullptr, fp);
+    fclose(fp);
+
+    std::unique_ptr<OsMappedFile> mappedFile(OsMappedFile::open(fileName));
+    EXPECT_EQ(nullptr, mappedFile);
+
+    std::remove(fileName);
+}
+
+TEST(OsMappedFileTest, givenExistingFileWhenOpeningThenWholeContentIsMapped) {
+    const char *fileName = "os_mapped_file_content.bin";
+    const char content[] = "some mapped file content";
+    ASSERT_EQ(sizeof(content), writeDataToFile(fileName, content, sizeof(content)));
+
+    {
+        std::unique_ptr<OsMappedFile> mappedFile(OsMappedFile::open(fileName));
+        ASSERT_NE(nullptr, mappedFile);
+        EXPECT_TRUE(mappedFile->isMapped());
+        ASSERT_EQ(sizeof(content), mappedFile->getSize());
+        EXPECT_EQ(0, memcmp(content, mappedFile->getData(), sizeof(content)));
+    }
+
+    std::remove(fileName);
+}
+
+TEST(OsMappedFileTest, givenMappedFileWhenWritingThroughMappingThenFileIsNotModified) {
+    const char *fileName = "os_mapped_file_copy_on_write.bin";
+    const char content[] = "some mapped file content";
+    ASSERT_EQ(sizeof(content), writeDataToFile(fileName, content, sizeof(content)));
+
+    {
+        std::unique_ptr<OsMappedFile> mappedFile(OsMappedFile::open(fileName));
+        ASSERT_NE(nullptr, mappedFile);
+        auto pData = const_cast<char *>(reinterpret_cast<const char *>(mappedFile->getData()));
+        pData[0] = 'X';
+        EXPECT_EQ('X', reinterpret_cast<const char *>(mappedFile->getData())[0]);
+
+        void *pFileData = nullptr;
+        auto fileSize = loadDataFromFile(fileName, pFileData);
+        ASSERT_EQ(sizeof(content), fileSize);
+        EXPECT_EQ(0, memcmp(content, pFileData, sizeof(content)));
+        deleteDataReadFromFile(pFileData);
+    }
+
+    std::remove(fileName);
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2017, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/hash.h"
+#include "unit_tests/perf_tests/perf_test_utils.h"
+
+#include <cstring>
+#include <memory>
+
+using namespace OCLRT;
+
+namespace ULT {
+
+// multiplier of reference ratio that is compared ( checked if less than ) with current result
+const double hashMultiplier = 1.5000;
+// size of the hashed input, comparable to a large IR module fed to the binary cache
+const size_t hashInputSize = 16 * 1024 * 1024;
+
+template <typename HashT>
+long long measureHash(const char *data, size_t size) {
+    long long times[3] = {0, 0, 0};
+    volatile uint64_t sink = 0;
+
+    for (int i = 0; i < 3; i++) {
+        Timer t;
+        t.start();
+        HashT hash;
+        hash.update(data, size);
+        auto res = hash.finish();
+        t.end();
+
+        uint64_t value = 0;
+        memcpy(&value, &res, sizeof(value));
+        sink = sink + value;
+        times[i] = t.get();
+    }
+
+    return majorityVote(times[0], times[1], times[2]);
+}
+
+TEST(HashPerfTest, givenMultiMegabyteInputWhenHashingThenHash128IsFasterThanJenkinsHash) {
+    setReferenceTime();
+
+    std::unique_ptr<char[]> input(new char[hashInputSize + 1]);
+    for (size_t i = 0; i < hashInputSize + 1; i++) {
+        input[i] = static_cast<char>(i * 131 + 7);
+    }
+
+    for (size_t offset = 0; offset < 2; offset++) {
+        auto jenkinsTime = measureHash<Hash>(input.get() + offset, hashInputSize);
+        auto hash128Time = measureHash<Hash128>(input.get() + offset, hashInputSize);
+
+        EXPECT_LT(hash128Time, jenkinsTime) << "offset: " << offset;
+
+        std::string testName = std::string(__FUNCTION__) + std::to_string(offset);
+        uint64_t hash = Hash::hash(testName.c_str(), testName.size());
+        double previousRatio = -1.0;
+        bool success = getTestRatio(hash, previousRatio);
+
+        double ratio = static_cast<double>(hash128Time) / static_cast<double>(refTime);
+        if (success && previousRatio > 0.0) {
+            EXPECT_TRUE(isLowerThanReference(ratio, previousRatio, hashMultiplier)) << "Current: " << ratio << " previous: " << previousRatio << "\n";
+        }
+        updateTestRatio(hash, ratio);
+    }
+}
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/hash.h"
+#include "runtime/memory_manager/memory_constants.h"
+#include "runtime/utilities/heap_allocator.h"
+#include "unit_tests/perf_tests/perf_test_utils.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace ULT {
+
+// multiplier of reference ratio that is compared ( checked if less than ) with current result
+const double heapAllocatorMultiplier = 1.5000;
+// optional recorded trace, one operation per line: "a <id> <size>" or "f <id>"
+const char *heapAllocatorTraceFile = "heap_allocator_trace.txt";
+const uint64_t heapSize = 4 * MemoryConstants::gigaByte - MemoryConstants::pageSize;
+const size_t syntheticLiveAllocations = 32 * 1024;
+const size_t syntheticOperations = 256 * 1024;
+
+struct HeapTraceEntry {
+    bool allocate;
+    uint32_t id;
+    size_t size;
+};
+
+bool loadHeapTrace(std::vector<HeapTraceEntry> &trace, uint32_t &maxId) {
+    std::ifstream file(std::string(perfLogPath) + heapAllocatorTraceFile);
+    if (!file.is_open()) {
+        return false;
+    }
+    char op = 0;
+    while (file >> op) {
+        HeapTraceEntry entry = {op == 'a', 0, 0};
+        file >> entry.id;
+        if (entry.allocate) {
+            file >> entry.size;
+        }
+        maxId = std::max(maxId, entry.id);
+        trace.push_back(entry);
+    }
+    return !trace.empty();
+}
+
+// deterministic mix of small and big allocations freed in random order, keeping tens of thousands of them alive
+void generateHeapTrace(std::vector<HeapTraceEntry> &trace, uint32_t &maxId) {
+    uint32_t seed = 0x12345u;
+    auto next = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 8;
+    };
+    std::vector<uint32_t> live;
+    uint32_t id = 0;
+    for (size_t i = 0; i < syntheticOperations; i++) {
+        if (live.size() < syntheticLiveAllocations || (next() & 1)) {
+            auto r = next();
+            size_t pages = (r % 8 != 0) ? (1 + r % 16) : (17 + r % 256);
+            trace.push_back({true, id, pages * MemoryConstants::pageSize});
+            live.push_back(id++);
+        } else {
+            auto index = next() % live.size();
+            trace.push_back({false, live[index], 0});
+            live[index] = live.back();
+            live.pop_back();
+        }
+    }
+    for (auto liveId : live) {
+        trace.push_back({false, liveId, 0});
+    }
+    maxId = id;
+}
+
+void replayHeapTrace(HeapAllocator &heapAllocator, const std::vector<HeapTraceEntry> &trace, size_t begin, size_t end,
+                     std::vector<std::pair<void *, size_t>> &allocations) {
+    for (size_t i = begin; i < end; i++) {
+        auto &allocation = allocations[trace[i].id];
+        if (trace[i].allocate) {
+            allocation.second = trace[i].size;
+            allocation.first = heapAllocator.allocate(allocation.second);
+        } else {
+            heapAllocator.free(allocation.first, allocation.second);
+            allocation.first = nullptr;
+        }
+    }
+}
+
+// fragmentation is sampled between two timed halves of the trace, when the heap is most populated
+long long measureHeapTrace(const std::vector<HeapTraceEntry> &trace, uint32_t maxId, double &fragmentation) {
+    std::vector<std::pair<void *, size_t>> allocations(maxId + 1, {nullptr, 0});
+    HeapAllocator heapAllocator(reinterpret_cast<void *>(0x1000), heapSize);
+    auto half = trace.size() / 2;
+
+    Timer t1, t2;
+    t1.start();
+    replayHeapTrace(heapAllocator, trace, 0, half, allocations);
+    t1.end();
+
+    fragmentation = heapAllocator.getFragmentation();
+
+    t2.start();
+    replayHeapTrace(heapAllocator, trace, half, trace.size(), allocations);
+    t2.end();
+
+    return t1.get() + t2.get();
+}
+
+TEST(HeapAllocatorPerfTest, givenAllocationTraceWhenReplayedThenTimeIsLowerThanReference) {
+    setReferenceTime();
+
+    std::vector<HeapTraceEntry> trace;
+    uint32_t maxId = 0;
+    if (!loadHeapTrace(trace, maxId)) {
+        generateHeapTrace(trace, maxId);
+    }
+
+    long long times[3] = {0, 0, 0};
+    double fragmentation = 0.0;
+    for (int i = 0; i < 3; i++) {
+        times[i] = measureHeapTrace(trace, maxId, fragmentation);
+    }
+    auto replayTime = majorityVote(times[0], times[1], times[2]);
+    EXPECT_LE(0.0, fragmentation);
+    EXPECT_GE(1.0, fragmentation);
+
+    std::string testName = __FUNCTION__;
+    uint64_t hash = Hash::hash(testName.c_str(), testName.size());
+    double previousRatio = -1.0;
+    bool success = getTestRatio(hash, previousRatio);
+
+    double ratio = static_cast<double>(replayTime) / static_cast<double>(refTime);
+    if (success && previousRatio > 0.0) {
+        EXPECT_TRUE(isLowerThanReference(ratio, previousRatio, heapAllocatorMultiplier)) << "Current: " << ratio << " previous: " << previousRatio << "\n";
+    }
+    updateTestRatio(hash, ratio);
+}
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/debug_settings_manager.h"
+#include "runtime/program/async_build_handler.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace OCLRT;
+
+TEST(AsyncBuildHandlerTest, givenDefaultSettingsWhenCreatingHandlerThenAsyncBuildIsDisabled) {
+    DebugManagerStateRestore dbgRestore;
+    AsyncBuildHandler handler;
+    EXPECT_FALSE(handler.isAsyncBuildEnabled());
+}
+
+TEST(AsyncBuildHandlerTest, givenAsyncBuildThreadsCountSetWhenCreatingHandlerThenAsyncBuildIsEnabled) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.AsyncBuildThreadsCount.set(2);
+    AsyncBuildHandler handler;
+    EXPECT_TRUE(handler.isAsyncBuildEnabled());
+}
+
+TEST(AsyncBuildHandlerTest, givenZeroThreadsWhenEnqueuingBuildThenItRunsOnCallingThread) {
+    AsyncBuildHandler handler(0u);
+    EXPECT_FALSE(handler.isAsyncBuildEnabled());
+
+    std::thread::id buildThreadId;
+    handler.enqueueBuild([&buildThreadId] { buildThreadId = std::this_thread::get_id(); });
+
+    EXPECT_EQ(std::this_thread::get_id(), buildThreadId);
+    EXPECT_EQ(0u, handler.getThreadsCount());
+}
+
+TEST(AsyncBuildHandlerTest, givenThreadsWhenEnqueuingBuildsThenAllAreExecutedInBackground) {
+    AsyncBuildHandler handler(2u);
+    EXPECT_TRUE(handler.isAsyncBuildEnabled());
+
+    std::atomic<uint32_t> buildsDone{0};
+    std::atomic<uint32_t> buildsOnCallingThread{0};
+    auto callingThreadId = std::this_thread::get_id();
+    for (uint32_t i = 0; i < 16; i++) {
+        handler.enqueueBuild([&] {
+            if (std::this_thread::get_id() == callingThreadId) {
+                buildsOnCallingThread++;
+            }
+            buildsDone++;
+        });
+    }
+    handler.waitForBuilds();
+
+    EXPECT_EQ(16u, buildsDone.load());
+    EXPECT_EQ(0u, buildsOnCallingThread.load());
+    EXPECT_LE(handler.getThreadsCount(), 2u);
+    EXPECT_GE(handler.getThreadsCount(), 1u);
+}
+
+TEST(AsyncBuildHandlerTest, givenPendingBuildsWhenClosingThreadsThenBuildsAreCompletedFirst) {
+    AsyncBuildHandler handler(1u);
+
+    std::atomic<bool> releaseBuild{false};
+    std::atomic<uint32_t> buildsDone{0};
+    handler.enqueueBuild([&] {
+        while (!releaseBuild) {
+            std::this_thread::yield();
+        }
+        buildsDone++;
+    });
+    handler.enqueueBuild([&] { buildsDone++; });
+
+    releaseBuild = true;
+    handler.closeThreads();
+
+    EXPECT_EQ(2u, buildsDone.load());
+    EXPECT_EQ(0u, handler.getThreadsCount());
+
+    // handler can be used again after closing
+    handler.enqueueBuild([&] { buildsDone++; });
+    handler.waitForBuilds();
+    EXPECT_EQ(3u, buildsDone.load());
+}
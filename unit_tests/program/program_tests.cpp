@@ -33,16 +33,20 @@
 #include "runtime/program/create.inl"
 #include "program_tests.h"
 #include "unit_tests/fixtures/program_fixture.inl"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/helpers/kernel_binary_helper.h"
 #include "unit_tests/mocks/mock_kernel.h"
 #include "unit_tests/program/program_from_binary.h"
 #include "unit_tests/program/program_with_source.h"
 #include "test.h"
+#include <atomic>
 #include <memory>
+#include <thread>
 #include <vector>
 #include <map>
 #include "unit_tests/fixtures/device_fixture.h"
 #include "unit_tests/mocks/mock_program.h"
+#include "runtime/program/async_build_handler.h"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 #include "elf/reader.h"
@@ -742,6 +746,195 @@ TEST_P(ProgramFromSourceTest, CreateWithSource_Build) {
     delete[](char *) pSourceBuffer;
 }
 
+TEST_P(ProgramFromSourceTest, givenCallbackWhenBuildingAsyncThenCallbackIsCalledAfterBuildCompletes) {
+    KernelBinaryHelper kbHelper(BinaryFileName, false);
+    AsyncBuildHandler asyncBuildHandler(1u);
+    char data[4] = {0};
+
+    retVal = pProgram->buildAsync(0, nullptr, nullptr, notifyFunc, &data[0], false, asyncBuildHandler);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    asyncBuildHandler.waitForBuilds();
+    EXPECT_EQ('a', data[0]);
+
+    cl_build_status buildStatus = CL_BUILD_NONE;
+    retVal = pProgram->getBuildInfo(pPlatform->getDevice(0), CL_PROGRAM_BUILD_STATUS, sizeof(buildStatus), &buildStatus, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(CL_BUILD_SUCCESS, buildStatus);
+}
+
+TEST_P(ProgramFromSourceTest, givenEmbedKernelInfoOptionWhenBuildingThenOptionIsNotPassedToCompilerAndBinaryHasKernelInfoSection) {
+    KernelBinaryHelper kbHelper(BinaryFileName, false);
+
+    retVal = pProgram->build(0, nullptr, "-cl-intel-embed-kernel-info", nullptr, nullptr, false);
+    ASSERT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(std::string::npos, pProgram->getOptions().find("-cl-intel-embed-kernel-info"));
+
+    size_t elfBinarySize = 0;
+    ASSERT_EQ(CL_SUCCESS, pProgram->getInfo(CL_PROGRAM_BINARY_SIZES, sizeof(elfBinarySize), &elfBinarySize, nullptr));
+    std::vector<char> elfBinary(elfBinarySize);
+    auto pElfBinary = elfBinary.data();
+    ASSERT_EQ(CL_SUCCESS, pProgram->getInfo(CL_PROGRAM_BINARIES, sizeof(pElfBinary), &pElfBinary, nullptr));
+
+    auto pElfReader = CLElfLib::CElfReader::create(elfBinary.data(), elfBinary.size());
+    ASSERT_NE(nullptr, pElfReader);
+    auto pElfHeader = pElfReader->getElfHeader();
+    ASSERT_NE(nullptr, pElfHeader);
+    bool kernelInfoSectionFound = false;
+    for (uint32_t i = 1; i < pElfHeader->NumSectionHeaderEntries; i++) {
+        kernelInfoSectionFound |= (CLElfLib::SH_TYPE_OPENCL_KERNEL_INFO == pElfReader->getSectionHeader(i)->Type);
+    }
+    EXPECT_TRUE(kernelInfoSectionFound);
+    CLElfLib::CElfReader::destroy(pElfReader);
+}
+
+TEST_P(ProgramFromSourceTest, givenInvalidArgsWhenBuildingAsyncThenErrorIsReturnedAndCallbackIsNotCalled) {
+    AsyncBuildHandler asyncBuildHandler(1u);
+    char data[4] = {0};
+    cl_device_id device = pPlatform->getDevice(0);
+
+    retVal = pProgram->buildAsync(0, &device, nullptr, notifyFunc, &data[0], false, asyncBuildHandler);
+    EXPECT_EQ(CL_INVALID_VALUE, retVal);
+    EXPECT_EQ(0, data[0]);
+    EXPECT_EQ(0u, asyncBuildHandler.getThreadsCount());
+}
+
+TEST_P(ProgramFromSourceTest, givenBuildInProgressWhenBuildingAsyncThenInvalidOperationIsReturned) {
+    AsyncBuildHandler asyncBuildHandler(1u);
+    char data[4] = {0};
+    cl_device_id usedDevice = pPlatform->getDevice(0);
+
+    CreateProgramWithSource<MockProgram>(
+        pContext,
+        &usedDevice,
+        SourceFileName);
+    auto pMockProgram = static_cast<MockProgram *>(pProgram);
+
+    pMockProgram->SetBuildStatus(CL_BUILD_IN_PROGRESS);
+    retVal = pProgram->buildAsync(0, nullptr, nullptr, notifyFunc, &data[0], false, asyncBuildHandler);
+    EXPECT_EQ(CL_INVALID_OPERATION, retVal);
+}
+
+TEST_P(ProgramFromSourceTest, givenConcurrentBuildRequestsWhenStartingBuildThenOnlyOneSucceeds) {
+    cl_device_id usedDevice = pPlatform->getDevice(0);
+    CreateProgramWithSource<MockProgram>(
+        pContext,
+        &usedDevice,
+        SourceFileName);
+    auto pMockProgram = static_cast<MockProgram *>(pProgram);
+
+    std::atomic<uint32_t> startedBuilds{0};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.push_back(std::thread([&] {
+            if (pMockProgram->tryStartBuild()) {
+                startedBuilds++;
+            }
+        }));
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(1u, startedBuilds.load());
+    EXPECT_TRUE(pProgram->isBuildInProgress());
+    pMockProgram->SetBuildStatus(CL_BUILD_NONE);
+}
+
+TEST_P(ProgramFromSourceTest, givenBuildInProgressWhenCreatingKernelsOrQueryingKernelInfoThenInvalidProgramExecutableIsReturned) {
+    KernelBinaryHelper kbHelper(BinaryFileName, false);
+    cl_device_id usedDevice = pPlatform->getDevice(0);
+    CreateProgramWithSource<MockProgram>(
+        pContext,
+        &usedDevice,
+        SourceFileName);
+    auto pMockProgram = static_cast<MockProgram *>(pProgram);
+
+    retVal = pProgram->build(0, nullptr, nullptr, nullptr, nullptr, false);
+    ASSERT_EQ(CL_SUCCESS, retVal);
+    pMockProgram->SetBuildStatus(CL_BUILD_IN_PROGRESS);
+
+    cl_kernel kernel = clCreateKernel(pProgram, KernelName, &retVal);
+    EXPECT_EQ(nullptr, kernel);
+    EXPECT_EQ(CL_INVALID_PROGRAM_EXECUTABLE, retVal);
+
+    cl_uint numKernelsRet = 0;
+    retVal = clCreateKernelsInProgram(pProgram, 0, nullptr, &numKernelsRet);
+    EXPECT_EQ(CL_INVALID_PROGRAM_EXECUTABLE, retVal);
+
+    size_t numKernels = 0;
+    retVal = pProgram->getInfo(CL_PROGRAM_NUM_KERNELS, sizeof(numKernels), &numKernels, nullptr);
+    EXPECT_EQ(CL_INVALID_PROGRAM_EXECUTABLE, retVal);
+
+    size_t paramValueSizeRet = 0;
+    retVal = pProgram->getInfo(CL_PROGRAM_KERNEL_NAMES, 0, nullptr, &paramValueSizeRet);
+    EXPECT_EQ(CL_INVALID_PROGRAM_EXECUTABLE, retVal);
+
+    pMockProgram->SetBuildStatus(CL_BUILD_SUCCESS);
+}
+
+TEST_P(ProgramFromSourceTest, givenBuildInProgressWhenQueryingProgramBinaryThenNoBinaryIsReported) {
+    KernelBinaryHelper kbHelper(BinaryFileName, false);
+    cl_device_id usedDevice = pPlatform->getDevice(0);
+    CreateProgramWithSource<MockProgram>(
+        pContext,
+        &usedDevice,
+        SourceFileName);
+    auto pMockProgram = static_cast<MockProgram *>(pProgram);
+
+    retVal = pProgram->build(0, nullptr, nullptr, nullptr, nullptr, false);
+    ASSERT_EQ(CL_SUCCESS, retVal);
+    pMockProgram->SetBuildStatus(CL_BUILD_IN_PROGRESS);
+
+    size_t binarySize = 1;
+    retVal = pProgram->getInfo(CL_PROGRAM_BINARY_SIZES, sizeof(binarySize), &binarySize, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(0u, binarySize);
+
+    char binary[16] = {0x7f};
+    char *binaries[] = {binary};
+    size_t paramValueSizeRet = 0;
+    retVal = pProgram->getInfo(CL_PROGRAM_BINARIES, sizeof(binaries), binaries, &paramValueSizeRet);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(sizeof(binaries), paramValueSizeRet);
+    EXPECT_EQ(0x7f, binary[0]);
+
+    pMockProgram->SetBuildStatus(CL_BUILD_SUCCESS);
+}
+
+TEST_P(ProgramFromSourceTest, givenBuildInProgressWhenBuildCompileOrLinkIsRejectedThenStatusIsKeptAndCallbackIsNotCalled) {
+    cl_device_id usedDevice = pPlatform->getDevice(0);
+    CreateProgramWithSource<MockProgram>(
+        pContext,
+        &usedDevice,
+        SourceFileName);
+    auto pMockProgram = static_cast<MockProgram *>(pProgram);
+    char data[4] = {0};
+    cl_program inputProgram = pProgram;
+
+    pMockProgram->SetBuildStatus(CL_BUILD_IN_PROGRESS);
+
+    retVal = pProgram->build(0, nullptr, nullptr, notifyFunc, &data[0], false);
+    EXPECT_EQ(CL_INVALID_OPERATION, retVal);
+    retVal = pProgram->build(1, nullptr, nullptr, notifyFunc, &data[0], false);
+    EXPECT_EQ(CL_INVALID_VALUE, retVal);
+
+    retVal = pProgram->compile(0, nullptr, nullptr, 0, nullptr, nullptr, notifyFunc, &data[0]);
+    EXPECT_EQ(CL_INVALID_OPERATION, retVal);
+    retVal = pProgram->compile(1, nullptr, nullptr, 0, nullptr, nullptr, notifyFunc, &data[0]);
+    EXPECT_EQ(CL_INVALID_VALUE, retVal);
+
+    retVal = pProgram->link(0, nullptr, nullptr, 1, &inputProgram, notifyFunc, &data[0]);
+    EXPECT_EQ(CL_INVALID_OPERATION, retVal);
+    retVal = pProgram->link(0, nullptr, nullptr, 0, nullptr, notifyFunc, &data[0]);
+    EXPECT_EQ(CL_INVALID_VALUE, retVal);
+
+    EXPECT_TRUE(pProgram->isBuildInProgress());
+    EXPECT_EQ(0, data[0]);
+
+    pMockProgram->SetBuildStatus(CL_BUILD_NONE);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Program::Build (duplicate)
 ////////////////////////////////////////////////////////////////////////////////
@@ -2080,7 +2273,7 @@ TEST_F(ProgramTests, ProgramFromGenBinaryWithPATCH_TOKEN_GTPIN_FREE_GRF_INFO) {
         pKHdr->CheckSum = 0;
         pKHdr->ShaderHashCode = 0;
         pKHdr->KernelNameSize = 8;
-        pKHdr->PatchListSize = 24;
+        pKHdr->PatchListSize = sizeof(iOpenCL::SPatchGtpinFreeGRFInfo) + GRF_INFO_SIZE;
         pKHdr->KernelHeapSize = 0;
         pKHdr->GeneralStateHeapSize = 0;
         pKHdr->DynamicStateHeapSize = 0;
@@ -2895,3 +3088,212 @@ TEST_F(ProgramTests, givenSeparateBlockKernelsWhenSubgroupKernelWithChildKernelT
     EXPECT_EQ(1u, program.getBlockKernelManager()->getCount());
     EXPECT_EQ(0, strcmp("subgroup_kernel_dispatch_0", program.getBlockKernelManager()->getBlockKernelInfo(0)->name.c_str()));
 }
+
+static std::vector<char> createGenBinaryWithKernels(const std::vector<std::string> &kernelNames, const std::vector<char> &patchList = {}) {
+    std::vector<char> binary;
+
+    SProgramBinaryHeader programHeader = {};
+    programHeader.Magic = iOpenCL::MAGIC_CL;
+    programHeader.Version = iOpenCL::CURRENT_ICBE_VERSION;
+    programHeader.Device = platformDevices[0]->pPlatform->eRenderCoreFamily;
+    programHeader.GPUPointerSizeInBytes = 8;
+    programHeader.NumberOfKernels = static_cast<uint32_t>(kernelNames.size());
+    binary.insert(binary.end(), reinterpret_cast<char *>(&programHeader), reinterpret_cast<char *>(&programHeader) + sizeof(programHeader));
+
+    for (auto kernelName : kernelNames) {
+        kernelName.resize(alignUp(kernelName.size() + 1, 4), '\0');
+
+        SKernelBinaryHeaderCommon kernelHeader = {};
+        kernelHeader.KernelNameSize = static_cast<uint32_t>(kernelName.size());
+        kernelHeader.PatchListSize = static_cast<uint32_t>(patchList.size());
+        binary.insert(binary.end(), reinterpret_cast<char *>(&kernelHeader), reinterpret_cast<char *>(&kernelHeader) + sizeof(kernelHeader));
+        binary.insert(binary.end(), kernelName.begin(), kernelName.end());
+        binary.insert(binary.end(), patchList.begin(), patchList.end());
+    }
+    return binary;
+}
+
+TEST_F(ProgramTests, givenGenBinaryWhenProcessedThenPatchListsAreDecodedOnFirstAccess) {
+    MockProgram program(pContext);
+    auto binary = createGenBinaryWithKernels({"first_kernel", "second_kernel"});
+    program.storeGenBinary(binary.data(), binary.size());
+
+    EXPECT_EQ(CL_SUCCESS, program.processGenBinary());
+    ASSERT_EQ(2u, program.getKernelInfoArray().size());
+    EXPECT_FALSE(program.getKernelInfoArray()[0]->isPatchListDecoded);
+    EXPECT_FALSE(program.getKernelInfoArray()[1]->isPatchListDecoded);
+    EXPECT_EQ("first_kernel;second_kernel", program.getKernelNamesString());
+
+    Program &baseProgram = program;
+    auto pKernelInfo = baseProgram.getKernelInfo("second_kernel");
+    ASSERT_NE(nullptr, pKernelInfo);
+    EXPECT_TRUE(pKernelInfo->isPatchListDecoded);
+    EXPECT_FALSE(program.getKernelInfoArray()[0]->isPatchListDecoded);
+
+    pKernelInfo = baseProgram.getKernelInfo(size_t{0});
+    ASSERT_NE(nullptr, pKernelInfo);
+    EXPECT_TRUE(pKernelInfo->isPatchListDecoded);
+}
+
+TEST_F(ProgramTests, givenPatchTokenExceedingPatchListWhenGenBinaryIsProcessedThenBuildFails) {
+    SPatchItemHeader patchItem = {};
+    patchItem.Token = PATCH_TOKEN_STRING;
+    patchItem.Size = 2 * sizeof(SPatchItemHeader);
+    std::vector<char> patchList(reinterpret_cast<char *>(&patchItem), reinterpret_cast<char *>(&patchItem) + sizeof(patchItem));
+
+    MockProgram program(pContext);
+    auto binary = createGenBinaryWithKernels({"first_kernel"}, patchList);
+    program.storeGenBinary(binary.data(), binary.size());
+
+    EXPECT_EQ(CL_INVALID_KERNEL, program.processGenBinary());
+}
+
+TEST_F(ProgramTests, givenParentKernelWhenGenBinaryIsProcessedThenPatchListsAreDecodedAtBuildTime) {
+    SPatchExecutionEnvironment executionEnvironment = {};
+    executionEnvironment.Token = PATCH_TOKEN_EXECUTION_ENVIRONMENT;
+    executionEnvironment.Size = sizeof(SPatchExecutionEnvironment);
+    executionEnvironment.HasDeviceEnqueue = 1;
+    std::vector<char> patchList(reinterpret_cast<char *>(&executionEnvironment), reinterpret_cast<char *>(&executionEnvironment) + sizeof(executionEnvironment));
+
+    MockProgram program(pContext);
+    auto binary = createGenBinaryWithKernels({"first_kernel", "second_kernel"}, patchList);
+    program.storeGenBinary(binary.data(), binary.size());
+
+    EXPECT_EQ(CL_SUCCESS, program.processGenBinary());
+    ASSERT_EQ(2u, program.getKernelInfoArray().size());
+    EXPECT_TRUE(program.getKernelInfoArray()[0]->isPatchListDecoded);
+    EXPECT_TRUE(program.getKernelInfoArray()[1]->isPatchListDecoded);
+    EXPECT_TRUE(program.getKernelInfoArray()[0]->hasDeviceEnqueue());
+    EXPECT_EQ(2u, program.getParentKernelInfoArray().size());
+}
+
+TEST_F(ProgramTests, givenKernelInfoImageOfSameGenBinaryWhenProcessedThenKernelsAreRestoredDecoded) {
+    auto binary = createGenBinaryWithKernels({"first_kernel", "second_kernel"});
+
+    MockProgram sourceProgram(pContext);
+    sourceProgram.storeGenBinary(binary.data(), binary.size());
+    ASSERT_EQ(CL_SUCCESS, sourceProgram.processGenBinary());
+    std::vector<char> image;
+    ASSERT_TRUE(sourceProgram.serializeKernelInfoImage(image));
+    EXPECT_FALSE(image.empty());
+
+    MockProgram program(pContext);
+    program.storeGenBinary(binary.data(), binary.size());
+    program.setKernelInfoImage(image);
+    EXPECT_EQ(CL_SUCCESS, program.processGenBinary());
+    ASSERT_EQ(2u, program.getKernelInfoArray().size());
+    for (size_t i = 0; i < program.getKernelInfoArray().size(); i++) {
+        auto pKernelInfo = program.getKernelInfoArray()[i];
+        auto pSourceKernelInfo = sourceProgram.getKernelInfoArray()[i];
+        EXPECT_TRUE(pKernelInfo->isPatchListDecoded);
+        EXPECT_EQ(pSourceKernelInfo->name, pKernelInfo->name);
+        EXPECT_EQ(pSourceKernelInfo->isValid, pKernelInfo->isValid);
+        EXPECT_EQ(pSourceKernelInfo->kernelArgInfo.size(), pKernelInfo->kernelArgInfo.size());
+    }
+}
+
+TEST_F(ProgramTests, givenKernelInfoImageOfDifferentGenBinaryWhenProcessedThenImageIsIgnored) {
+    auto otherBinary = createGenBinaryWithKernels({"other_kernel", "second_kernel"});
+    MockProgram otherProgram(pContext);
+    otherProgram.storeGenBinary(otherBinary.data(), otherBinary.size());
+    ASSERT_EQ(CL_SUCCESS, otherProgram.processGenBinary());
+    std::vector<char> image;
+    ASSERT_TRUE(otherProgram.serializeKernelInfoImage(image));
+
+    auto binary = createGenBinaryWithKernels({"first_kernel", "second_kernel"});
+    MockProgram program(pContext);
+    program.storeGenBinary(binary.data(), binary.size());
+    program.setKernelInfoImage(image);
+    EXPECT_EQ(CL_SUCCESS, program.processGenBinary());
+    ASSERT_EQ(2u, program.getKernelInfoArray().size());
+    EXPECT_FALSE(program.getKernelInfoArray()[0]->isPatchListDecoded);
+    EXPECT_FALSE(program.getKernelInfoArray()[1]->isPatchListDecoded);
+}
+
+TEST_F(ProgramTests, givenTruncatedKernelInfoImageWhenProcessedThenImageIsIgnored) {
+    auto binary = createGenBinaryWithKernels({"first_kernel", "second_kernel"});
+    MockProgram sourceProgram(pContext);
+    sourceProgram.storeGenBinary(binary.data(), binary.size());
+    ASSERT_EQ(CL_SUCCESS, sourceProgram.processGenBinary());
+    std::vector<char> image;
+    ASSERT_TRUE(sourceProgram.serializeKernelInfoImage(image));
+    image.resize(image.size() - 1);
+
+    MockProgram program(pContext);
+    program.storeGenBinary(binary.data(), binary.size());
+    program.setKernelInfoImage(image);
+    EXPECT_EQ(CL_SUCCESS, program.processGenBinary());
+    ASSERT_EQ(2u, program.getKernelInfoArray().size());
+    EXPECT_FALSE(program.getKernelInfoArray()[0]->isPatchListDecoded);
+    EXPECT_FALSE(program.getKernelInfoArray()[1]->isPatchListDecoded);
+}
+
+TEST_P(ProgramFromBinaryTest, givenDefaultSettingsWhenProgramBinaryIsResolvedThenKernelInfoSectionIsNotAdded) {
+    size_t genBinarySize = 0;
+    auto genBinary = pProgram->getGenBinary(genBinarySize);
+    ASSERT_NE(nullptr, genBinary);
+
+    MockProgram builtProgram(pContext);
+    builtProgram.storeGenBinary(genBinary, genBinarySize);
+    builtProgram.setProgramBinaryType(CL_PROGRAM_BINARY_TYPE_EXECUTABLE);
+    ASSERT_EQ(CL_SUCCESS, builtProgram.processGenBinary());
+
+    size_t elfBinarySize = 0;
+    ASSERT_EQ(CL_SUCCESS, builtProgram.getInfo(CL_PROGRAM_BINARY_SIZES, sizeof(elfBinarySize), &elfBinarySize, nullptr));
+    std::vector<char> elfBinary(elfBinarySize);
+    auto pElfBinary = elfBinary.data();
+    ASSERT_EQ(CL_SUCCESS, builtProgram.getInfo(CL_PROGRAM_BINARIES, sizeof(pElfBinary), &pElfBinary, nullptr));
+
+    auto pElfReader = CLElfLib::CElfReader::create(elfBinary.data(), elfBinary.size());
+    ASSERT_NE(nullptr, pElfReader);
+    auto pElfHeader = pElfReader->getElfHeader();
+    ASSERT_NE(nullptr, pElfHeader);
+    EXPECT_EQ(CLElfLib::EH_TYPE_OPENCL_EXECUTABLE, pElfHeader->Type);
+    for (uint32_t i = 1; i < pElfHeader->NumSectionHeaderEntries; i++) {
+        EXPECT_NE(CLElfLib::SH_TYPE_OPENCL_KERNEL_INFO, pElfReader->getSectionHeader(i)->Type);
+    }
+    CLElfLib::CElfReader::destroy(pElfReader);
+}
+
+TEST_P(ProgramFromBinaryTest, givenResolvedProgramBinaryWhenProgramIsCreatedFromItThenKernelInfoIsRestoredFromImage) {
+    size_t genBinarySize = 0;
+    auto genBinary = pProgram->getGenBinary(genBinarySize);
+    ASSERT_NE(nullptr, genBinary);
+
+    MockProgram builtProgram(pContext);
+    builtProgram.setEmbedKernelInfo(true);
+    builtProgram.storeGenBinary(genBinary, genBinarySize);
+    builtProgram.setProgramBinaryType(CL_PROGRAM_BINARY_TYPE_EXECUTABLE);
+    ASSERT_EQ(CL_SUCCESS, builtProgram.processGenBinary());
+
+    size_t elfBinarySize = 0;
+    ASSERT_EQ(CL_SUCCESS, builtProgram.getInfo(CL_PROGRAM_BINARY_SIZES, sizeof(elfBinarySize), &elfBinarySize, nullptr));
+    std::vector<char> elfBinary(elfBinarySize);
+    auto pElfBinary = elfBinary.data();
+    ASSERT_EQ(CL_SUCCESS, builtProgram.getInfo(CL_PROGRAM_BINARIES, sizeof(pElfBinary), &pElfBinary, nullptr));
+
+    MockProgram loadedProgram(pContext);
+    ASSERT_EQ(CL_SUCCESS, loadedProgram.createProgramFromBinary(elfBinary.data(), elfBinary.size()));
+    ASSERT_EQ(CL_SUCCESS, loadedProgram.processGenBinary());
+    ASSERT_EQ(builtProgram.getKernelInfoArray().size(), loadedProgram.getKernelInfoArray().size());
+
+    Program &builtBaseProgram = builtProgram;
+    auto pBuiltKernelInfo = builtBaseProgram.getKernelInfo(KernelName);
+    ASSERT_NE(nullptr, pBuiltKernelInfo);
+
+    auto pLoadedKernelInfo = loadedProgram.getKernelInfoArray()[0];
+    EXPECT_TRUE(pLoadedKernelInfo->isPatchListDecoded);
+    EXPECT_EQ(pBuiltKernelInfo->isValid, pLoadedKernelInfo->isValid);
+    EXPECT_EQ(pBuiltKernelInfo->getMaxSimdSize(), pLoadedKernelInfo->getMaxSimdSize());
+    EXPECT_EQ(pBuiltKernelInfo->workloadInfo.simdSizeOffset, pLoadedKernelInfo->workloadInfo.simdSizeOffset);
+    EXPECT_EQ(pBuiltKernelInfo->patchInfo.dataParameterBuffers.size(), pLoadedKernelInfo->patchInfo.dataParameterBuffers.size());
+    ASSERT_EQ(pBuiltKernelInfo->kernelArgInfo.size(), pLoadedKernelInfo->kernelArgInfo.size());
+    for (size_t i = 0; i < pBuiltKernelInfo->kernelArgInfo.size(); i++) {
+        EXPECT_EQ(pBuiltKernelInfo->kernelArgInfo[i].name, pLoadedKernelInfo->kernelArgInfo[i].name);
+        EXPECT_EQ(pBuiltKernelInfo->kernelArgInfo[i].kernelArgPatchInfoVector.size(), pLoadedKernelInfo->kernelArgInfo[i].kernelArgPatchInfoVector.size());
+    }
+    if (pBuiltKernelInfo->patchInfo.dataParameterStream) {
+        ASSERT_NE(nullptr, pLoadedKernelInfo->crossThreadData);
+        EXPECT_EQ(0, memcmp(pBuiltKernelInfo->crossThreadData, pLoadedKernelInfo->crossThreadData, pBuiltKernelInfo->patchInfo.dataParameterStream->DataParameterStreamSize));
+    }
+}
@@ -43,14 +43,14 @@ class HeapAllocatorUnderTest : public HeapAllocator {
     size_t getThresholdSize() { return this->sizeThreshold; }
     void defragment() { return HeapAllocator::defragment(); }
 
-    void *getFromFreedChunks(size_t size, std::vector<HeapChunk> &vec) {
+    void *getFromFreedChunks(size_t size, HeapFreeChunks &chunks) {
         size_t sizeOfFreedChunk;
-        return HeapAllocator::getFromFreedChunks(size, vec, sizeOfFreedChunk);
+        return HeapAllocator::getFromFreedChunks(size, chunks, sizeOfFreedChunk);
     }
-    void storeInFreedChunks(void *ptr, size_t size, std::vector<HeapChunk> &vec) { return HeapAllocator::storeInFreedChunks(ptr, size, vec); }
+    void storeInFreedChunks(void *ptr, size_t size, HeapFreeChunks &chunks) { return HeapAllocator::storeInFreedChunks(ptr, size, chunks); }
 
-    std::vector<HeapChunk> &getFreedChunksSmall() { return this->freedChunksSmall; };
-    std::vector<HeapChunk> &getFreedChunksBig() { return this->freedChunksBig; };
+    HeapFreeChunks &getFreedChunksSmall() { return this->freedChunksSmall; };
+    HeapFreeChunks &getFreedChunksBig() { return this->freedChunksBig; };
 
     void overrideAlignement(size_t newAlignement) { allocationAlignment = newAlignement; }
     size_t peekAlignement() { return allocationAlignment; }
@@ -100,10 +100,10 @@ TEST(HeapAllocatorTest, GivenExactSizeChunkInFreedChunksWhenGetIsCalledThenChunk
     size_t size = 1024 * 4096;
     HeapAllocatorUnderTest *heapAllocator = new HeapAllocatorUnderTest(ptrBase, size, sizeThreshold);
 
-    std::vector<HeapChunk> freedChunks;
+    HeapFreeChunks freedChunks;
     void *ptrFreed = reinterpret_cast<void *>(0x101000);
     size_t sizeFreed = MemoryConstants::pageSize * 2;
-    freedChunks.emplace_back(ptrFreed, sizeFreed);
+    freedChunks.insert(ptrFreed, sizeFreed);
 
     void *ptrReturned = heapAllocator->getFromFreedChunks(sizeFreed, freedChunks);
 
@@ -118,15 +118,15 @@ TEST(HeapAllocatorTest, GivenOnlySmallerSizeChunksInFreedChunksWhenGetIsCalledTh
     size_t size = 1024 * 4096;
     HeapAllocatorUnderTest *heapAllocator = new HeapAllocatorUnderTest(ptrBase, size, sizeThreshold);
 
-    std::vector<HeapChunk> freedChunks;
+    HeapFreeChunks freedChunks;
 
-    freedChunks.emplace_back(reinterpret_cast<void *>(0x100000), 4096);
-    freedChunks.emplace_back(reinterpret_cast<void *>(0x101000), 4096);
-    freedChunks.emplace_back(reinterpret_cast<void *>(0x105000), 4096);
-    freedChunks.emplace_back(reinterpret_cast<void *>(0x104000), 4096);
-    freedChunks.emplace_back(reinterpret_cast<void *>(0x102000), 8192);
-    freedChunks.emplace_back(reinterpret_cast<void *>(0x109000), 8192);
-    freedChunks.emplace_back(reinterpret_cast<void *>(0x107000), 4096);
+    freedChunks.insert(reinterpret_cast<void *>(0x100000), 4096);
+    freedChunks.insert(reinterpret_cast<void *>(0x101000), 4096);
+    freedChunks.insert(reinterpret_cast<void *>(0x105000), 4096);
+    freedChunks.insert(reinterpret_cast<void *>(0x104000), 4096);
+    freedChunks.insert(reinterpret_cast<void *>(0x102000), 8192);
+    freedChunks.insert(reinterpret_cast<void *>(0x109000), 8192);
+    freedChunks.insert(reinterpret_cast<void *>(0x107000), 4096);
 
     EXPECT_EQ(7u, freedChunks.size());
 
@@ -145,21 +145,21 @@ TEST(HeapAllocatorTest, GivenOnlyBiggerSizeChunksInFreedChunksWhenGetIsCalledThe
 
     HeapAllocatorUnderTest *heapAllocator = new HeapAllocatorUnderTest(ptrBase, size, sizeThreshold);
 
-    std::vector<HeapChunk> freedChunks;
+    HeapFreeChunks freedChunks;
     void *ptrExpected = nullptr;
 
     pUpperBound -= 4096;
-    freedChunks.emplace_back(reinterpret_cast<void *>(pUpperBound), 4096);
+    freedChunks.insert(reinterpret_cast<void *>(pUpperBound), 4096);
     pUpperBound -= 5 * 4096;
-    freedChunks.emplace_back(reinterpret_cast<void *>(pUpperBound), 5 * 4096);
+    freedChunks.insert(reinterpret_cast<void *>(pUpperBound), 5 * 4096);
     pUpperBound -= 4 * 4096;
-    freedChunks.emplace_back(reinterpret_cast<void *>(pUpperBound), 4 * 4096);
+    freedChunks.insert(reinterpret_cast<void *>(pUpperBound), 4 * 4096);
     ptrExpected = reinterpret_cast<void *>(pUpperBound);
 
     pUpperBound -= 5 * 4096;
-    freedChunks.emplace_back(reinterpret_cast<void *>(pUpperBound), 5 * 4096);
+    freedChunks.insert(reinterpret_cast<void *>(pUpperBound), 5 * 4096);
     pUpperBound -= 4 * 4096;
-    freedChunks.emplace_back(reinterpret_cast<void *>(pUpperBound), 4 * 4096);
+    freedChunks.insert(reinterpret_cast<void *>(pUpperBound), 4 * 4096);
 
     EXPECT_EQ(5u, freedChunks.size());
 
@@ -178,15 +178,15 @@ TEST(HeapAllocatorTest, GivenOnlyMoreThanTwiceBiggerSizeChunksInFreedChunksWhenG
 
     HeapAllocatorUnderTest *heapAllocator = new HeapAllocatorUnderTest(ptrBase, size, sizeThreshold);
 
-    std::vector<HeapChunk> freedChunks;
+    HeapFreeChunks freedChunks;
     void *ptrExpected = nullptr;
     size_t requestedSize = 3 * 4096;
 
-    freedChunks.emplace_back(reinterpret_cast<void *>(pLowerBound), 4096);
+    freedChunks.insert(reinterpret_cast<void *>(pLowerBound), 4096);
     pLowerBound += 4096;
-    freedChunks.emplace_back(reinterpret_cast<void *>(pLowerBound), 9 * 4096);
+    freedChunks.insert(reinterpret_cast<void *>(pLowerBound), 9 * 4096);
     pLowerBound += 9 * 4096;
-    freedChunks.emplace_back(reinterpret_cast<void *>(pLowerBound), 7 * 4096);
+    freedChunks.insert(reinterpret_cast<void *>(pLowerBound), 7 * 4096);
 
     size_t deltaSize = 7 * 4096 - requestedSize;
     ptrExpected = reinterpret_cast<void *>(pLowerBound + deltaSize);
@@ -198,8 +198,7 @@ TEST(HeapAllocatorTest, GivenOnlyMoreThanTwiceBiggerSizeChunksInFreedChunksWhenG
     EXPECT_EQ(ptrExpected, ptrReturned);
     EXPECT_EQ(3u, freedChunks.size());
 
-    EXPECT_EQ(reinterpret_cast<void *>(pLowerBound), freedChunks[2].ptr);
-    EXPECT_EQ(deltaSize, freedChunks[2].size);
+    EXPECT_EQ(deltaSize, freedChunks.peekSize(reinterpret_cast<void *>(pLowerBound)));
 
     delete heapAllocator;
 }
@@ -211,18 +210,17 @@ TEST(HeapAllocatorTest, GivenStoredChunkAdjacentToLeftBoundaryOfIncomingChunkWhe
 
     HeapAllocatorUnderTest *heapAllocator = new HeapAllocatorUnderTest(ptrBase, size, sizeThreshold);
 
-    std::vector<HeapChunk> freedChunks;
+    HeapFreeChunks freedChunks;
     void *ptrExpected = nullptr;
     size_t expectedSize = 9 * 4096;
 
-    freedChunks.emplace_back(reinterpret_cast<void *>(pLowerBound), 4096);
+    freedChunks.insert(reinterpret_cast<void *>(pLowerBound), 4096);
     pLowerBound += 4096;
-    freedChunks.emplace_back(reinterpret_cast<void *>(pLowerBound), 9 * 4096);
+    freedChunks.insert(reinterpret_cast<void *>(pLowerBound), 9 * 4096);
     ptrExpected = reinterpret_cast<void *>(pLowerBound);
     pLowerBound += 9 * 4096;
 
-    EXPECT_EQ(ptrExpected, freedChunks[1].ptr);
-    EXPECT_EQ(expectedSize, freedChunks[1].size);
+    EXPECT_EQ(expectedSize, freedChunks.peekSize(ptrExpected));
 
     EXPECT_EQ(2u, freedChunks.size());
 
@@ -235,8 +233,7 @@ TEST(HeapAllocatorTest, GivenStoredChunkAdjacentToLeftBoundaryOfIncomingChunkWhe
 
     EXPECT_EQ(2u, freedChunks.size());
 
-    EXPECT_EQ(ptrExpected, freedChunks[1].ptr);
-    EXPECT_EQ(expectedSize, freedChunks[1].size);
+    EXPECT_EQ(expectedSize, freedChunks.peekSize(ptrExpected));
 
     delete heapAllocator;
 }
@@ -248,11 +245,11 @@ TEST(HeapAllocatorTest, GivenStoredChunkAdjacentToRightBoundaryOfIncomingChunkWh
 
     HeapAllocatorUnderTest *heapAllocator = new HeapAllocatorUnderTest(ptrBase, size, sizeThreshold);
 
-    std::vector<HeapChunk> freedChunks;
+    HeapFreeChunks freedChunks;
     void *ptrExpected = nullptr;
     size_t expectedSize = 9 * 4096;
 
-    freedChunks.emplace_back(reinterpret_cast<void *>(pLowerBound), 4096);
+    freedChunks.insert(reinterpret_cast<void *>(pLowerBound), 4096);
     pLowerBound += 4096;
     pLowerBound += 4096; // space between stored chunk and chunk to store
 
@@ -260,11 +257,10 @@ TEST(HeapAllocatorTest, GivenStoredChunkAdjacentToRightBoundaryOfIncomingChunkWh
     size_t sizeToStore = 2 * 4096;
     pLowerBound += sizeToStore;
 
-    freedChunks.emplace_back(reinterpret_cast<void *>(pLowerBound), 9 * 4096);
+    freedChunks.insert(reinterpret_cast<void *>(pLowerBound), 9 * 4096);
     ptrExpected = reinterpret_cast<void *>(pLowerBound);
 
-    EXPECT_EQ(ptrExpected, freedChunks[1].ptr);
-    EXPECT_EQ(expectedSize, freedChunks[1].size);
+    EXPECT_EQ(expectedSize, freedChunks.peekSize(ptrExpected));
 
     EXPECT_EQ(2u, freedChunks.size());
 
@@ -275,8 +271,7 @@ TEST(HeapAllocatorTest, GivenStoredChunkAdjacentToRightBoundaryOfIncomingChunkWh
 
     EXPECT_EQ(2u, freedChunks.size());
 
-    EXPECT_EQ(ptrExpected, freedChunks[1].ptr);
-    EXPECT_EQ(expectedSize, freedChunks[1].size);
+    EXPECT_EQ(expectedSize, freedChunks.peekSize(ptrExpected));
 
     delete heapAllocator;
 }
@@ -288,11 +283,11 @@ TEST(HeapAllocatorTest, GivenStoredChunkNotAdjacentToIncomingChunkWhenStoreIsCal
 
     HeapAllocatorUnderTest *heapAllocator = new HeapAllocatorUnderTest(ptrBase, size, sizeThreshold);
 
-    std::vector<HeapChunk> freedChunks;
+    HeapFreeChunks freedChunks;
 
-    freedChunks.emplace_back(reinterpret_cast<void *>(pLowerBound), 4096);
+    freedChunks.insert(reinterpret_cast<void *>(pLowerBound), 4096);
     pLowerBound += 4096;
-    freedChunks.emplace_back(reinterpret_cast<void *>(pLowerBound), 9 * 4096);
+    freedChunks.insert(reinterpret_cast<void *>(pLowerBound), 9 * 4096);
     pLowerBound += 9 * 4096;
 
     pLowerBound += 9 * 4096;
@@ -306,8 +301,7 @@ TEST(HeapAllocatorTest, GivenStoredChunkNotAdjacentToIncomingChunkWhenStoreIsCal
 
     EXPECT_EQ(3u, freedChunks.size());
 
-    EXPECT_EQ(ptrToStore, freedChunks[2].ptr);
-    EXPECT_EQ(sizeToStore, freedChunks[2].size);
+    EXPECT_EQ(sizeToStore, freedChunks.peekSize(ptrToStore));
 
     delete heapAllocator;
 }
@@ -818,7 +812,7 @@ TEST(HeapAllocatorTest, defragmentBig) {
 
     HeapAllocatorUnderTest *heapAllocator = new HeapAllocatorUnderTest(ptrBase, size, threshold);
 
-    std::vector<HeapChunk> &freedChunks = heapAllocator->getFreedChunksBig();
+    HeapFreeChunks &freedChunks = heapAllocator->getFreedChunksBig();
 
     // 0, 1, 2 - can be merged to one
     // 6,7,8,10 - can be merged to one
@@ -845,21 +839,16 @@ TEST(HeapAllocatorTest, defragmentBig) {
     heapAllocator->free(ptrs[7], allocSize);
     heapAllocator->free(ptrs[8], doubleallocSize);
 
-    // 0,1  merged on free,
-    // 2
-    // 6,7 - merged on free
-    // 8, 10 - merged on free
-    EXPECT_EQ(4u, freedChunks.size());
+    // 0, 1, 2 - merged on free
+    // 6, 7, 8, 10 - merged on free
+    EXPECT_EQ(2u, freedChunks.size());
 
     heapAllocator->defragment();
 
     ASSERT_EQ(2u, freedChunks.size());
 
-    EXPECT_EQ(reinterpret_cast<void *>(basePtr), freedChunks[0].ptr);
-    EXPECT_EQ(3 * allocSize, freedChunks[0].size);
-
-    EXPECT_EQ(reinterpret_cast<void *>(basePtr + 6 * allocSize), freedChunks[1].ptr);
-    EXPECT_EQ(5 * allocSize, freedChunks[1].size);
+    EXPECT_EQ(3 * allocSize, freedChunks.peekSize(reinterpret_cast<void *>(basePtr)));
+    EXPECT_EQ(5 * allocSize, freedChunks.peekSize(reinterpret_cast<void *>(basePtr + 6 * allocSize)));
 
     delete heapAllocator;
 }
@@ -877,7 +866,7 @@ TEST(HeapAllocatorTest, defragmentSmall) {
 
     HeapAllocatorUnderTest *heapAllocator = new HeapAllocatorUnderTest(ptrBase, size, threshold);
 
-    std::vector<HeapChunk> &freedChunks = heapAllocator->getFreedChunksSmall();
+    HeapFreeChunks &freedChunks = heapAllocator->getFreedChunksSmall();
 
     // 0, 1, 2 - can be merged to one
     // 6,7,8,10 - can be merged to one
@@ -904,21 +893,16 @@ TEST(HeapAllocatorTest, defragmentSmall) {
     heapAllocator->free(ptrs[7], allocSize);
     heapAllocator->free(ptrs[10], allocSize);
 
-    // 0,1  merged on free,
-    // 2
-    // 6, - merged on free
-    // 7, 8, 10 - merged on free
-    EXPECT_EQ(4u, freedChunks.size());
+    // 0, 1, 2 - merged on free
+    // 6, 7, 8, 10 - merged on free
+    EXPECT_EQ(2u, freedChunks.size());
 
     heapAllocator->defragment();
 
     ASSERT_EQ(2u, freedChunks.size());
 
-    EXPECT_EQ(reinterpret_cast<void *>(upperLimitPtr - 3 * allocSize), freedChunks[0].ptr);
-    EXPECT_EQ(3 * allocSize, freedChunks[0].size);
-
-    EXPECT_EQ(reinterpret_cast<void *>(upperLimitPtr - 10 * allocSize), freedChunks[1].ptr);
-    EXPECT_EQ(5 * allocSize, freedChunks[1].size);
+    EXPECT_EQ(3 * allocSize, freedChunks.peekSize(reinterpret_cast<void *>(upperLimitPtr - 3 * allocSize)));
+    EXPECT_EQ(5 * allocSize, freedChunks.peekSize(reinterpret_cast<void *>(upperLimitPtr - 10 * allocSize)));
 
     delete heapAllocator;
 }
@@ -930,7 +914,7 @@ TEST(HeapAllocatorTest, Given10SmallAllocationsWhenFreedInTheSameOrderThenLastCh
 
     HeapAllocatorUnderTest *heapAllocator = new HeapAllocatorUnderTest(ptrBase, size, threshold);
 
-    std::vector<HeapChunk> &freedChunks = heapAllocator->getFreedChunksSmall();
+    HeapFreeChunks &freedChunks = heapAllocator->getFreedChunksSmall();
 
     void *ptrs[10];
     size_t sizes[10];
@@ -967,8 +951,8 @@ TEST(HeapAllocatorTest, Given10SmallAllocationsWhenMergedToBigAllocatedAsSmallSp
 
     HeapAllocatorUnderTest *heapAllocator = new HeapAllocatorUnderTest(ptrBase, size, threshold);
 
-    std::vector<HeapChunk> &freedChunksSmall = heapAllocator->getFreedChunksSmall();
-    std::vector<HeapChunk> &freedChunksBig = heapAllocator->getFreedChunksBig();
+    HeapFreeChunks &freedChunksSmall = heapAllocator->getFreedChunksSmall();
+    HeapFreeChunks &freedChunksBig = heapAllocator->getFreedChunksBig();
 
     void *ptrs[10];
     size_t sizes[10];
@@ -1030,8 +1014,8 @@ TEST(HeapAllocatorTest, Given10SmallAllocationsWhenMergedToBigAllocatedAsSmallNo
 
     HeapAllocatorUnderTest *heapAllocator = new HeapAllocatorUnderTest(ptrBase, size, threshold);
 
-    std::vector<HeapChunk> &freedChunksSmall = heapAllocator->getFreedChunksSmall();
-    std::vector<HeapChunk> &freedChunksBig = heapAllocator->getFreedChunksBig();
+    HeapFreeChunks &freedChunksSmall = heapAllocator->getFreedChunksSmall();
+    HeapFreeChunks &freedChunksBig = heapAllocator->getFreedChunksBig();
 
     void *ptrs[10];
     size_t sizes[10];
@@ -1084,3 +1068,92 @@ TEST(HeapAllocatorTest, Given10SmallAllocationsWhenMergedToBigAllocatedAsSmallNo
 
     delete heapAllocator;
 }
+
+TEST(HeapAllocatorTest, GivenChunkFreedBetweenTwoFreeNeighboursWhenFreeIsCalledThenAllThreeAreCoalesced) {
+    void *ptrBase = reinterpret_cast<void *>(0x100000);
+    size_t size = 1024 * 4096;
+    size_t allocSize = 2 * sizeThreshold;
+    HeapAllocatorUnderTest *heapAllocator = new HeapAllocatorUnderTest(ptrBase, size, sizeThreshold);
+    HeapFreeChunks &freedChunks = heapAllocator->getFreedChunksBig();
+
+    void *ptrs[4];
+    for (auto &ptr : ptrs) {
+        ptr = heapAllocator->allocate(allocSize);
+        ASSERT_NE(nullptr, ptr);
+    }
+
+    heapAllocator->free(ptrs[0], allocSize);
+    heapAllocator->free(ptrs[2], allocSize);
+    EXPECT_EQ(2u, freedChunks.size());
+
+    heapAllocator->free(ptrs[1], allocSize);
+    ASSERT_EQ(1u, freedChunks.size());
+    EXPECT_EQ(3 * allocSize, freedChunks.peekSize(ptrBase));
+
+    heapAllocator->free(ptrs[3], allocSize);
+    delete heapAllocator;
+}
+
+TEST(HeapAllocatorTest, GivenScatteredFreedChunksWhenMetricsAreQueriedThenLargestBlockAndFragmentationAreReported) {
+    void *ptrBase = reinterpret_cast<void *>(0x100000);
+    size_t size = 64 * sizeThreshold;
+    size_t allocSize = 2 * sizeThreshold;
+    HeapAllocatorUnderTest *heapAllocator = new HeapAllocatorUnderTest(ptrBase, size, sizeThreshold);
+
+    EXPECT_EQ(size, heapAllocator->getLargestFreeBlockSize());
+    EXPECT_DOUBLE_EQ(0.0, heapAllocator->getFragmentation());
+    EXPECT_EQ(0u, heapAllocator->getFreedChunksCount());
+
+    void *ptrs[32];
+    for (auto &ptr : ptrs) {
+        ptr = heapAllocator->allocate(allocSize);
+        ASSERT_NE(nullptr, ptr);
+    }
+    EXPECT_EQ(0u, heapAllocator->getLargestFreeBlockSize());
+    EXPECT_DOUBLE_EQ(0.0, heapAllocator->getFragmentation());
+
+    for (uint32_t i = 0; i < 32; i += 2) {
+        heapAllocator->free(ptrs[i], allocSize);
+    }
+    EXPECT_EQ(16u, heapAllocator->getFreedChunksCount());
+    EXPECT_EQ(allocSize, heapAllocator->getLargestFreeBlockSize());
+    EXPECT_DOUBLE_EQ(1.0 - 1.0 / 16.0, heapAllocator->getFragmentation());
+
+    for (uint32_t i = 1; i < 32; i += 2) {
+        heapAllocator->free(ptrs[i], allocSize);
+    }
+    EXPECT_EQ(size, heapAllocator->getLargestFreeBlockSize());
+    EXPECT_DOUBLE_EQ(0.0, heapAllocator->getFragmentation());
+    EXPECT_EQ(0u, heapAllocator->getFreedChunksCount());
+
+    delete heapAllocator;
+}
+
+TEST(HeapFreeChunksTest, GivenChunksOfEqualSizeWhenBestFitIsQueriedThenChunkWithHighestAddressIsReturned) {
+    HeapFreeChunks chunks;
+    chunks.insert(0x1000llu, 0x3000);
+    chunks.insert(0x10000llu, 0x2000);
+    chunks.insert(0x20000llu, 0x2000);
+    chunks.insert(0x30000llu, 0x1000);
+
+    uint64_t ptr = 0;
+    size_t chunkSize = 0;
+    EXPECT_TRUE(chunks.peekBestFit(0x1800, ptr, chunkSize));
+    EXPECT_EQ(0x20000llu, ptr);
+    EXPECT_EQ(0x2000u, chunkSize);
+
+    EXPECT_FALSE(chunks.peekBestFit(0x4000, ptr, chunkSize));
+
+    EXPECT_TRUE(chunks.peekEndingAt(0x4000llu, ptr));
+    EXPECT_EQ(0x1000llu, ptr);
+    EXPECT_FALSE(chunks.peekEndingAt(0x5000llu, ptr));
+
+    chunks.resize(0x1000llu, 0x800);
+    EXPECT_EQ(0x800u, chunks.peekSize(reinterpret_cast<void *>(0x1000)));
+    EXPECT_EQ(0x2000u, chunks.getLargestChunkSize());
+    EXPECT_EQ(0x5800u, chunks.getTotalSize());
+
+    chunks.erase(0x20000llu);
+    EXPECT_EQ(0u, chunks.peekSize(reinterpret_cast<void *>(0x20000)));
+    EXPECT_EQ(3u, chunks.size());
+}